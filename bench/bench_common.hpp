@@ -0,0 +1,182 @@
+#ifndef TURBOGRAPH_BENCH_COMMON_HPP
+#define TURBOGRAPH_BENCH_COMMON_HPP
+
+#include "config.hpp"
+#include "types.hpp"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace turbograph {
+namespace bench {
+
+// ============================================
+// 测试数据
+// ============================================
+
+/**
+ * @brief 固定种子的随机ID，取值范围[0, range)
+ */
+inline std::vector<int64_t> random_ids(size_t n, int64_t range, uint32_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int64_t> dist(0, range - 1);
+    std::vector<int64_t> ids(n);
+    for (auto& id : ids) id = dist(rng);
+    return ids;
+}
+
+/**
+ * @brief 固定种子的随机浮点数，取值范围[lo, hi)
+ */
+inline std::vector<double> random_doubles(size_t n, double lo, double hi, uint32_t seed = 7) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> values(n);
+    for (auto& v : values) v = dist(rng);
+    return values;
+}
+
+/**
+ * @brief 名称加时间戳，得到新的指纹（用于冷启动编译，避免命中缓存）
+ */
+inline PipelineConfig unique_copy(const PipelineConfig& base, const std::string& tag) {
+    PipelineConfig config = base;
+    config.name += "_" + tag + "_" + std::to_string(
+        std::chrono::system_clock::now().time_since_epoch().count());
+    config.compute_fingerprint();
+    return config;
+}
+
+// ============================================
+// 与线上特征配置结构相同的管道
+// ============================================
+
+/**
+ * @brief 价格分桶：折扣差 -> 分段对数分桶，附带符号与整型输出
+ */
+inline PipelineConfig bucketing_config() {
+    PipelineConfig config;
+    config.name = "bench_bucketing";
+    config.inputs = {
+        {"discount_price", DataType::DOUBLE, true},
+        {"origin_price", DataType::DOUBLE, true},
+        {"sales", DataType::INT64, true}
+    };
+    config.steps = {
+        OpCallBuilder("price_diff")
+            .output("diff")
+            .args({Arg::variable("discount_price", DataType::DOUBLE), Arg::variable("origin_price", DataType::DOUBLE)})
+            .build(),
+        OpCallBuilder("mul")
+            .output("diff_cents")
+            .args({Arg::variable("diff", DataType::DOUBLE), Arg::literal("100.0", DataType::DOUBLE)})
+            .build(),
+        OpCallBuilder("avg_avg_log")
+            .output("diff_bucket")
+            .args({Arg::variable("diff_cents", DataType::DOUBLE), Arg::literal("1000", DataType::INT32),
+                   Arg::literal("15000", DataType::INT32), Arg::literal("5000", DataType::INT32),
+                   Arg::literal("250000", DataType::INT32)})
+            .build(),
+        OpCallBuilder("avg_avg_log")
+            .output("sales_bucket")
+            .args({Arg::variable("sales", DataType::INT64), Arg::literal("10", DataType::INT32),
+                   Arg::literal("100", DataType::INT32), Arg::literal("50", DataType::INT32),
+                   Arg::literal("5000", DataType::INT32)})
+            .build(),
+        OpCallBuilder("get_sign")
+            .output("diff_sign")
+            .args({Arg::variable("diff", DataType::DOUBLE)})
+            .build()
+    };
+    config.outputs = {
+        {"diff_bucket", DataType::INT64, true},
+        {"sales_bucket", DataType::INT64, true},
+        {"diff_sign", DataType::INT32, true}
+    };
+    config.compute_fingerprint();
+    return config;
+}
+
+/**
+ * @brief 用户历史与候选交叉：历史为请求级常量，每个候选一行
+ */
+inline PipelineConfig list_cross_config() {
+    PipelineConfig config;
+    config.name = "bench_list_cross";
+    config.inputs = {
+        {"item_id", DataType::INT64, true},
+        {"click_history", DataType::INT64_LIST, true, true},
+        {"cart_history", DataType::INT64_LIST, true, true}
+    };
+    config.steps = {
+        OpCallBuilder("catein_set_cross")
+            .output("clicked")
+            .args({Arg::variable("click_history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)})
+            .build(),
+        OpCallBuilder("catein_set_cross_count")
+            .output("click_count")
+            .args({Arg::variable("click_history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)})
+            .build(),
+        OpCallBuilder("catein_list_cross")
+            .output("carted")
+            .args({Arg::variable("cart_history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)})
+            .build(),
+        OpCallBuilder("len")
+            .output("history_len")
+            .args({Arg::variable("click_history", DataType::INT64_LIST)})
+            .build()
+    };
+    config.outputs = {
+        {"clicked", DataType::INT32, true},
+        {"click_count", DataType::INT32, true},
+        {"carted", DataType::INT32, true},
+        {"history_len", DataType::INT64, true}
+    };
+    config.compute_fingerprint();
+    return config;
+}
+
+/**
+ * @brief 类型转换：同一原始特征输出为多种类型（含字符串）
+ */
+inline PipelineConfig conversion_config() {
+    PipelineConfig config;
+    config.name = "bench_conversion";
+    config.inputs = {
+        {"score", DataType::DOUBLE, true},
+        {"item_id", DataType::INT64, true}
+    };
+    config.steps = {
+        OpCallBuilder("direct_output_int32")
+            .output("score_i32")
+            .args({Arg::variable("score", DataType::DOUBLE)})
+            .build(),
+        OpCallBuilder("direct_output_int64")
+            .output("item_i64")
+            .args({Arg::variable("item_id", DataType::INT64)})
+            .build(),
+        OpCallBuilder("direct_output_double")
+            .output("item_double")
+            .args({Arg::variable("item_id", DataType::INT64)})
+            .build(),
+        OpCallBuilder("direct_output_string")
+            .output("item_key")
+            .args({Arg::variable("item_id", DataType::INT64)})
+            .build()
+    };
+    config.outputs = {
+        {"score_i32", DataType::INT32, true},
+        {"item_i64", DataType::INT64, true},
+        {"item_double", DataType::DOUBLE, true},
+        {"item_key", DataType::STRING, true}
+    };
+    config.compute_fingerprint();
+    return config;
+}
+
+} // namespace bench
+} // namespace turbograph
+
+#endif // TURBOGRAPH_BENCH_COMMON_HPP
@@ -0,0 +1,327 @@
+/**
+ * @file bench_ops.cpp
+ * @brief 算子微基准：ops.hpp中每个算子单独计时，列表算子覆盖不同列表长度
+ *
+ * 运行：
+ *   ./turbograph_bench --benchmark_filter=BM_Op
+ */
+
+#include "bench_common.hpp"
+#include "ops.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace turbograph;
+using namespace turbograph::bench;
+
+namespace {
+
+// 每次迭代处理一批预生成的标量输入，避免被常量折叠
+constexpr size_t kScalarBatch = 1024;
+
+const std::vector<double>& scalar_doubles() {
+    static const std::vector<double> values = random_doubles(kScalarBatch, -300000.0, 300000.0);
+    return values;
+}
+
+const std::vector<double>& positive_doubles() {
+    static const std::vector<double> values = random_doubles(kScalarBatch, 1.0, 10000.0, 11);
+    return values;
+}
+
+const std::vector<int64_t>& scalar_ids() {
+    static const std::vector<int64_t> values = random_ids(kScalarBatch, 1 << 20);
+    return values;
+}
+
+/**
+ * @brief 对每个标量输入调用一元算子
+ */
+template<typename T, typename F>
+void run_unary(benchmark::State& state, const std::vector<T>& values, F op) {
+    for (auto _ : state) {
+        for (T v : values) {
+            benchmark::DoNotOptimize(op(v));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+/**
+ * @brief 对相邻的两个标量输入调用二元算子
+ */
+template<typename T, typename F>
+void run_binary(benchmark::State& state, const std::vector<T>& values, F op) {
+    for (auto _ : state) {
+        for (size_t i = 0; i + 1 < values.size(); i++) {
+            benchmark::DoNotOptimize(op(values[i], values[i + 1]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (values.size() - 1));
+}
+
+// 列表长度覆盖线性扫描、二分查找与哈希三种查找策略
+#define LIST_SIZES RangeMultiplier(8)->Range(8, 4096)
+
+} // namespace
+
+// ============================================
+// 符号与差值算子
+// ============================================
+
+static void BM_Op_GetSign(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::get_sign(v); });
+}
+BENCHMARK(BM_Op_GetSign);
+
+static void BM_Op_PriceDiff(benchmark::State& state) {
+    run_binary(state, positive_doubles(), [](double a, double b) { return ops::price_diff(a, b); });
+}
+BENCHMARK(BM_Op_PriceDiff);
+
+// ============================================
+// 分桶算子
+// ============================================
+
+static void BM_Op_AvgAvgLog(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::avg_avg_log(v, 1000, 15000, 5000, 250000); });
+}
+BENCHMARK(BM_Op_AvgAvgLog);
+
+// ============================================
+// 类型转换算子
+// ============================================
+
+static void BM_Op_DirectOutputInt32(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::direct_output_int32(v); });
+}
+BENCHMARK(BM_Op_DirectOutputInt32);
+
+static void BM_Op_DirectOutputInt64(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::direct_output_int64(v); });
+}
+BENCHMARK(BM_Op_DirectOutputInt64);
+
+static void BM_Op_DirectOutputDouble(benchmark::State& state) {
+    run_unary(state, scalar_ids(), [](int64_t v) { return ops::direct_output_double(v); });
+}
+BENCHMARK(BM_Op_DirectOutputDouble);
+
+static void BM_Op_DirectOutputString(benchmark::State& state) {
+    run_unary(state, scalar_ids(), [](int64_t v) { return ops::direct_output_string(v); });
+}
+BENCHMARK(BM_Op_DirectOutputString);
+
+static void BM_Op_DirectOutputStringArena(benchmark::State& state) {
+    ops::StringArena arena;
+    for (auto _ : state) {
+        arena.reset();
+        for (int64_t v : scalar_ids()) {
+            benchmark::DoNotOptimize(ops::direct_output_string(arena, v));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * scalar_ids().size());
+}
+BENCHMARK(BM_Op_DirectOutputStringArena);
+
+// ============================================
+// 算术与数学算子
+// ============================================
+
+static void BM_Op_Add(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::add_op(a, b); });
+}
+BENCHMARK(BM_Op_Add);
+
+static void BM_Op_Sub(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::sub_op(a, b); });
+}
+BENCHMARK(BM_Op_Sub);
+
+static void BM_Op_Mul(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::mul_op(a, b); });
+}
+BENCHMARK(BM_Op_Mul);
+
+static void BM_Op_Div(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::div_op(a, b); });
+}
+BENCHMARK(BM_Op_Div);
+
+static void BM_Op_IfElse(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::if_else(a > 0, a, b); });
+}
+BENCHMARK(BM_Op_IfElse);
+
+static void BM_Op_Max(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::max_op(a, b); });
+}
+BENCHMARK(BM_Op_Max);
+
+static void BM_Op_Min(benchmark::State& state) {
+    run_binary(state, scalar_doubles(), [](double a, double b) { return ops::min_op(a, b); });
+}
+BENCHMARK(BM_Op_Min);
+
+static void BM_Op_Abs(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::abs_op(v); });
+}
+BENCHMARK(BM_Op_Abs);
+
+static void BM_Op_Square(benchmark::State& state) {
+    run_unary(state, scalar_doubles(), [](double v) { return ops::square_op(v); });
+}
+BENCHMARK(BM_Op_Square);
+
+static void BM_Op_Sqrt(benchmark::State& state) {
+    run_unary(state, positive_doubles(), [](double v) { return ops::sqrt_op(v); });
+}
+BENCHMARK(BM_Op_Sqrt);
+
+static void BM_Op_Floor(benchmark::State& state) {
+    run_unary(state, positive_doubles(), [](double v) { return ops::floor_op<double>(v); });
+}
+BENCHMARK(BM_Op_Floor);
+
+static void BM_Op_Ceil(benchmark::State& state) {
+    run_unary(state, positive_doubles(), [](double v) { return ops::ceil_op<double>(v); });
+}
+BENCHMARK(BM_Op_Ceil);
+
+static void BM_Op_Percent(benchmark::State& state) {
+    run_binary(state, positive_doubles(), [](double a, double b) { return ops::percent_op(a, b); });
+}
+BENCHMARK(BM_Op_Percent);
+
+// ============================================
+// 容器算子
+// ============================================
+
+static void BM_Op_Len(benchmark::State& state) {
+    std::vector<int64_t> list = random_ids(static_cast<size_t>(state.range(0)), 1 << 20);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ops::len(list));
+    }
+}
+BENCHMARK(BM_Op_Len)->LIST_SIZES;
+
+static void BM_Op_ListToString(benchmark::State& state) {
+    std::vector<int64_t> list = random_ids(static_cast<size_t>(state.range(0)), 1 << 20);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ops::list_to_string(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Op_ListToString)->LIST_SIZES;
+
+static void BM_Op_ListToStringArena(benchmark::State& state) {
+    std::vector<int64_t> list = random_ids(static_cast<size_t>(state.range(0)), 1 << 20);
+    ops::StringArena arena;
+    for (auto _ : state) {
+        arena.reset();
+        benchmark::DoNotOptimize(ops::list_to_string(arena, list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Op_ListToStringArena)->LIST_SIZES;
+
+// ============================================
+// 列表交叉算子
+// ============================================
+
+/**
+ * @brief 列表与一批候选逐个交叉，约一半候选命中
+ */
+template<typename F>
+void run_cross(benchmark::State& state, F op) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> list = random_ids(size, static_cast<int64_t>(size) * 2);
+    std::vector<int64_t> items = random_ids(256, static_cast<int64_t>(size) * 2, 9);
+    for (auto _ : state) {
+        for (int64_t item : items) {
+            benchmark::DoNotOptimize(op(list, item));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+static void BM_Op_CateinListCross(benchmark::State& state) {
+    run_cross(state, [](const std::vector<int64_t>& l, int64_t v) { return ops::catein_list_cross(l, v); });
+}
+BENCHMARK(BM_Op_CateinListCross)->LIST_SIZES;
+
+static void BM_Op_CateinListCrossCount(benchmark::State& state) {
+    run_cross(state, [](const std::vector<int64_t>& l, int64_t v) { return ops::catein_list_cross_count(l, v); });
+}
+BENCHMARK(BM_Op_CateinListCrossCount)->LIST_SIZES;
+
+static void BM_Op_CateinSetCross(benchmark::State& state) {
+    run_cross(state, [](const std::vector<int64_t>& l, int64_t v) { return ops::catein_set_cross(l, v); });
+}
+BENCHMARK(BM_Op_CateinSetCross)->LIST_SIZES;
+
+static void BM_Op_CateinSetCrossCount(benchmark::State& state) {
+    run_cross(state, [](const std::vector<int64_t>& l, int64_t v) { return ops::catein_set_cross_count(l, v); });
+}
+BENCHMARK(BM_Op_CateinSetCrossCount)->LIST_SIZES;
+
+// 生成的批量入口对broadcast列表只构建一次查找结构，此处不计构建时间
+static void BM_Op_CateinSetCrossLookup(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> list = random_ids(size, static_cast<int64_t>(size) * 2);
+    std::vector<int64_t> items = random_ids(256, static_cast<int64_t>(size) * 2, 9);
+    ops::ListLookup<std::vector<int64_t>> lookup(list);
+    for (auto _ : state) {
+        for (int64_t item : items) {
+            benchmark::DoNotOptimize(ops::catein_set_cross(lookup, item));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+BENCHMARK(BM_Op_CateinSetCrossLookup)->LIST_SIZES;
+
+static void BM_Op_CateinSetCrossCountLookup(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> list = random_ids(size, static_cast<int64_t>(size) * 2);
+    std::vector<int64_t> items = random_ids(256, static_cast<int64_t>(size) * 2, 9);
+    ops::ListLookup<std::vector<int64_t>> lookup(list);
+    for (auto _ : state) {
+        for (int64_t item : items) {
+            benchmark::DoNotOptimize(ops::catein_set_cross_count(lookup, item));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+BENCHMARK(BM_Op_CateinSetCrossCountLookup)->LIST_SIZES;
+
+static void BM_Op_ListLookupBuild(benchmark::State& state) {
+    std::vector<int64_t> list = random_ids(static_cast<size_t>(state.range(0)), 1 << 20);
+    for (auto _ : state) {
+        ops::ListLookup<std::vector<int64_t>> lookup(list);
+        benchmark::DoNotOptimize(lookup);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Op_ListLookupBuild)->LIST_SIZES;
+
+// ============================================
+// 向量算子
+// ============================================
+
+#define VECTOR_OP_BENCHMARK(NAME, CALL)                                              \
+    static void NAME(benchmark::State& state) {                                      \
+        std::vector<double> vec = random_doubles(static_cast<size_t>(state.range(0)), \
+                                                 0.0, 100.0);                        \
+        for (auto _ : state) {                                                       \
+            benchmark::DoNotOptimize(CALL);                                          \
+        }                                                                            \
+        state.SetItemsProcessed(state.iterations() * state.range(0));                \
+    }                                                                                \
+    BENCHMARK(NAME)->LIST_SIZES
+
+VECTOR_OP_BENCHMARK(BM_Op_VectorSum, ops::vector_sum(vec));
+VECTOR_OP_BENCHMARK(BM_Op_VectorSumFast, ops::vector_sum_fast(vec));
+VECTOR_OP_BENCHMARK(BM_Op_VectorAvg, ops::vector_avg(vec));
+VECTOR_OP_BENCHMARK(BM_Op_VectorAvgFast, ops::vector_avg_fast(vec));
+VECTOR_OP_BENCHMARK(BM_Op_MovingAverage, ops::moving_average(vec, static_cast<int32_t>(vec.size())));
+VECTOR_OP_BENCHMARK(BM_Op_MovingAverageFast, ops::moving_average_fast(vec, static_cast<int32_t>(vec.size())));
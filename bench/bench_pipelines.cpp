@@ -0,0 +1,272 @@
+/**
+ * @file bench_pipelines.cpp
+ * @brief 端到端基准：按线上配置结构构造的管道，覆盖三种执行模式的逐行执行、
+ *        JIT批量执行、冷启动编译加载与命中缓存时的启动
+ *
+ * 运行：
+ *   ./turbograph_bench --benchmark_filter=BM_Pipeline
+ */
+
+#include "bench_common.hpp"
+#include "pipeline.hpp"
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <memory>
+
+using namespace turbograph;
+using namespace turbograph::bench;
+
+namespace {
+
+// 单个请求的候选数
+constexpr size_t kRows = 4096;
+// 用户历史长度（list_cross中为请求级常量）
+constexpr size_t kHistory = 512;
+
+/**
+ * @brief 一个管道与一个请求的输入输出数据
+ * 列式数据既用于批量入口，也用于逐行执行时按行写入上下文
+ */
+struct Workload {
+    PipelineConfig config;
+    size_t n = kRows;
+
+    std::vector<std::vector<double>> double_inputs;
+    std::vector<std::vector<int64_t>> int64_inputs;
+    std::vector<std::vector<std::vector<int64_t>>> list_inputs;   // broadcast列，只有一个元素
+
+    std::vector<std::vector<int32_t>> int32_outputs;
+    std::vector<std::vector<int64_t>> int64_outputs;
+    std::vector<std::vector<double>> double_outputs;
+    std::vector<std::vector<std::string>> string_outputs;
+
+    std::vector<const void*> in_columns;
+    std::vector<void*> out_columns;
+
+    // 逐行执行：把第row行写入上下文
+    std::function<void(ExecutionContext&, size_t)> fill_row;
+
+    ColumnBatch input() const { return {in_columns.data(), in_columns.size()}; }
+    OutputBatch output() { return {out_columns.data(), out_columns.size()}; }
+};
+
+/**
+ * @brief 按配置的输入输出顺序绑定列
+ * 数据成员先全部构造好再取地址，之后不再改变容器大小
+ */
+void bind_columns(Workload& w) {
+    size_t d = 0, i64 = 0, l = 0;
+    for (const auto& field : w.config.inputs) {
+        switch (field.type) {
+            case DataType::DOUBLE: w.in_columns.push_back(w.double_inputs[d++].data()); break;
+            case DataType::INT64: w.in_columns.push_back(w.int64_inputs[i64++].data()); break;
+            case DataType::INT64_LIST: w.in_columns.push_back(w.list_inputs[l++].data()); break;
+            default: break;
+        }
+    }
+    size_t o32 = 0, o64 = 0, od = 0, os = 0;
+    for (const auto& field : w.config.outputs) {
+        switch (field.type) {
+            case DataType::INT32: w.out_columns.push_back(w.int32_outputs[o32++].data()); break;
+            case DataType::INT64: w.out_columns.push_back(w.int64_outputs[o64++].data()); break;
+            case DataType::DOUBLE: w.out_columns.push_back(w.double_outputs[od++].data()); break;
+            case DataType::STRING: w.out_columns.push_back(w.string_outputs[os++].data()); break;
+            default: break;
+        }
+    }
+}
+
+std::unique_ptr<Workload> make_bucketing() {
+    auto w = std::make_unique<Workload>();
+    w->config = bucketing_config();
+    w->double_inputs = {random_doubles(w->n, 1.0, 5000.0, 1), random_doubles(w->n, 1.0, 5000.0, 2)};
+    w->int64_inputs = {random_ids(w->n, 100000, 3)};
+    w->int64_outputs.assign(2, std::vector<int64_t>(w->n));
+    w->int32_outputs.assign(1, std::vector<int32_t>(w->n));
+    bind_columns(*w);
+
+    Workload* raw = w.get();
+    auto layout = make_context_layout(raw->config);
+    const size_t discount = layout->slot_of("discount_price");
+    const size_t origin = layout->slot_of("origin_price");
+    const size_t sales = layout->slot_of("sales");
+    w->fill_row = [raw, discount, origin, sales](ExecutionContext& ctx, size_t row) {
+        ctx.set_slot(discount, raw->double_inputs[0][row]);
+        ctx.set_slot(origin, raw->double_inputs[1][row]);
+        ctx.set_slot(sales, raw->int64_inputs[0][row]);
+    };
+    return w;
+}
+
+std::unique_ptr<Workload> make_list_cross() {
+    auto w = std::make_unique<Workload>();
+    w->config = list_cross_config();
+    w->int64_inputs = {random_ids(w->n, kHistory * 4, 4)};
+    w->list_inputs = {{random_ids(kHistory, kHistory * 4, 5)}, {random_ids(kHistory / 8, kHistory * 4, 6)}};
+    w->int32_outputs.assign(3, std::vector<int32_t>(w->n));
+    w->int64_outputs.assign(1, std::vector<int64_t>(w->n));
+    bind_columns(*w);
+
+    Workload* raw = w.get();
+    auto layout = make_context_layout(raw->config);
+    const size_t item = layout->slot_of("item_id");
+    const size_t clicks = layout->slot_of("click_history");
+    const size_t carts = layout->slot_of("cart_history");
+    w->fill_row = [raw, item, clicks, carts](ExecutionContext& ctx, size_t row) {
+        // 同类型赋值复用槽位中已有的vector存储
+        ctx.set_slot(item, raw->int64_inputs[0][row]);
+        ctx.set_slot(clicks, raw->list_inputs[0][0]);
+        ctx.set_slot(carts, raw->list_inputs[1][0]);
+    };
+    return w;
+}
+
+std::unique_ptr<Workload> make_conversion() {
+    auto w = std::make_unique<Workload>();
+    w->config = conversion_config();
+    w->double_inputs = {random_doubles(w->n, -1000.0, 1000.0, 7)};
+    w->int64_inputs = {random_ids(w->n, int64_t(1) << 40, 8)};
+    w->int32_outputs.assign(1, std::vector<int32_t>(w->n));
+    w->int64_outputs.assign(1, std::vector<int64_t>(w->n));
+    w->double_outputs.assign(1, std::vector<double>(w->n));
+    w->string_outputs.assign(1, std::vector<std::string>(w->n));
+    bind_columns(*w);
+
+    Workload* raw = w.get();
+    auto layout = make_context_layout(raw->config);
+    const size_t score = layout->slot_of("score");
+    const size_t item = layout->slot_of("item_id");
+    w->fill_row = [raw, score, item](ExecutionContext& ctx, size_t row) {
+        ctx.set_slot(score, raw->double_inputs[0][row]);
+        ctx.set_slot(item, raw->int64_inputs[0][row]);
+    };
+    return w;
+}
+
+enum WorkloadKind { BUCKETING, LIST_CROSS, CONVERSION };
+
+Workload& workload(WorkloadKind kind) {
+    static std::unique_ptr<Workload> workloads[] = {make_bucketing(), make_list_cross(), make_conversion()};
+    return *workloads[kind];
+}
+
+/**
+ * @brief 创建执行器并执行一次（JIT在此完成编译加载，不计入计时）
+ */
+std::unique_ptr<IPipelineExecutor> ready_executor(benchmark::State& state, Workload& w, PipelineMode mode) {
+    auto executor = PipelineManager::instance().create(w.config, mode);
+    ExecutionContext ctx = executor->create_context();
+    w.fill_row(ctx, 0);
+    if (!executor->execute(ctx)) {
+        state.SkipWithError("pipeline execution failed");
+        return nullptr;
+    }
+    return executor;
+}
+
+} // namespace
+
+// ============================================
+// 逐行执行（复用上下文，按槽位写入输入）
+// ============================================
+
+static void BM_Pipeline_PerRow(benchmark::State& state, WorkloadKind kind, PipelineMode mode) {
+    Workload& w = workload(kind);
+    auto executor = ready_executor(state, w, mode);
+    if (!executor) return;
+
+    ExecutionContext ctx = executor->create_context();
+    for (auto _ : state) {
+        for (size_t row = 0; row < w.n; row++) {
+            ctx.reset();
+            w.fill_row(ctx, row);
+            if (!executor->execute(ctx)) {
+                state.SkipWithError("pipeline execution failed");
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * w.n);
+}
+// 解释执行只实现了标量数值算子，仅作为分桶配置的基线
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, bucketing/interpreter, BUCKETING, PipelineMode::INTERPRETER);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, bucketing/bytecode, BUCKETING, PipelineMode::BYTECODE);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, bucketing/jit, BUCKETING, PipelineMode::JIT);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, list_cross/bytecode, LIST_CROSS, PipelineMode::BYTECODE);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, list_cross/jit, LIST_CROSS, PipelineMode::JIT);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, conversion/bytecode, CONVERSION, PipelineMode::BYTECODE);
+BENCHMARK_CAPTURE(BM_Pipeline_PerRow, conversion/jit, CONVERSION, PipelineMode::JIT);
+
+// ============================================
+// 批量执行（列式入口，与逐行执行处理相同的行数）
+// ============================================
+
+static void BM_Pipeline_Batch(benchmark::State& state, WorkloadKind kind) {
+    Workload& w = workload(kind);
+    auto executor = ready_executor(state, w, PipelineMode::JIT);
+    if (!executor) return;
+
+    ColumnBatch input = w.input();
+    OutputBatch output = w.output();
+    for (auto _ : state) {
+        if (!executor->execute_batch(input, output, w.n)) {
+            state.SkipWithError("batch execution failed");
+            return;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * w.n);
+}
+BENCHMARK_CAPTURE(BM_Pipeline_Batch, bucketing/jit, BUCKETING);
+BENCHMARK_CAPTURE(BM_Pipeline_Batch, list_cross/jit, LIST_CROSS);
+BENCHMARK_CAPTURE(BM_Pipeline_Batch, conversion/jit, CONVERSION);
+
+// ============================================
+// 启动开销
+// ============================================
+
+// 冷启动：每次迭代使用新指纹，完整经历代码生成、编译与dlopen。
+// 编译在子进程中进行，按墙钟时间计时
+static void BM_Pipeline_ColdStart(benchmark::State& state, WorkloadKind kind) {
+    const PipelineConfig& base = workload(kind).config;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PipelineConfig config = unique_copy(base, "cold");
+        state.ResumeTiming();
+
+        JITExecutor executor(config);
+        if (!executor.prepare()) {
+            state.SkipWithError("JIT compilation failed");
+            return;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_Pipeline_ColdStart, bucketing, BUCKETING)
+    ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(3);
+BENCHMARK_CAPTURE(BM_Pipeline_ColdStart, list_cross, LIST_CROSS)
+    ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(3);
+BENCHMARK_CAPTURE(BM_Pipeline_ColdStart, conversion, CONVERSION)
+    ->Unit(benchmark::kMillisecond)->UseRealTime()->Iterations(3);
+
+// 命中缓存：SO已在缓存目录中，新执行器只需校验指纹并加载
+static void BM_Pipeline_CacheHitStart(benchmark::State& state, WorkloadKind kind) {
+    const PipelineConfig& config = workload(kind).config;
+    {
+        JITExecutor warm(config);
+        if (!warm.prepare()) {
+            state.SkipWithError("JIT compilation failed");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        JITExecutor executor(config);
+        if (!executor.prepare()) {
+            state.SkipWithError("cached module failed to load");
+            return;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_Pipeline_CacheHitStart, bucketing, BUCKETING)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pipeline_CacheHitStart, list_cross, LIST_CROSS)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_Pipeline_CacheHitStart, conversion, CONVERSION)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -3,7 +3,7 @@
 
 set -e
 
-PROJECT_DIR="/workspace/turbograph_jit"
+PROJECT_DIR="$(cd "$(dirname "$0")" && pwd)"
 BUILD_DIR="$PROJECT_DIR/build"
 
 echo "创建构建目录..."
@@ -11,16 +11,55 @@ mkdir -p "$BUILD_DIR"
 
 echo "编译项目..."
 
+# 可选：TURBOGRAPH_WITH_LLVM=1 时构建进程内LLVM ORC编译后端
+LLVM_FLAGS=()
+if [ "${TURBOGRAPH_WITH_LLVM:-0}" = "1" ]; then
+    LLVM_LIB_DIR="$(llvm-config --libdir)"
+    LLVM_FLAGS=(-DTURBOGRAPH_WITH_LLVM -isystem "$(llvm-config --includedir)"
+                -L"$LLVM_LIB_DIR" -Wl,-rpath,"$LLVM_LIB_DIR" $(llvm-config --libs orcjit native passes))
+fi
+
+# 构建期代码生成工具，生成测试用的AOT管道
+g++ -std=c++17 -O2 -I"$PROJECT_DIR/include" -I"$PROJECT_DIR/third_party" \
+    -DTURBOGRAPH_INCLUDE_DIR="\"$PROJECT_DIR/include\"" \
+    "$PROJECT_DIR/tools/turbograph_aot.cpp" \
+    "$PROJECT_DIR/src/config_parser.cpp" \
+    "$PROJECT_DIR/src/code_generator.cpp" \
+    "$PROJECT_DIR/src/optimizer.cpp" \
+    "$PROJECT_DIR/src/hash.cpp" \
+    -o "$BUILD_DIR/turbograph_aot"
+"$BUILD_DIR/turbograph_aot" --name test_aot_pipelines --output-dir "$BUILD_DIR/aot" \
+    "$PROJECT_DIR/tests/aot_pipeline.json"
+
 # 编译测试程序
 g++ -std=c++17 -O3 -march=native -I"$PROJECT_DIR/include" -I"$PROJECT_DIR/third_party" \
+    -I"$BUILD_DIR/aot" -DTURBOGRAPH_TEST_DATA_DIR="\"$PROJECT_DIR/tests\"" \
+    -DTURBOGRAPH_INCLUDE_DIR="\"$PROJECT_DIR/include\"" \
     "$PROJECT_DIR/tests/test_runner.cpp" \
+    "$BUILD_DIR/aot/test_aot_pipelines.cpp" \
     "$PROJECT_DIR/src/config_parser.cpp" \
     "$PROJECT_DIR/src/code_generator.cpp" \
+    "$PROJECT_DIR/src/bytecode.cpp" \
     "$PROJECT_DIR/src/compiler.cpp" \
     "$PROJECT_DIR/src/loader.cpp" \
     "$PROJECT_DIR/src/pipeline.cpp" \
+    "$PROJECT_DIR/src/pipeline_group.cpp" \
+    "$PROJECT_DIR/src/result_cache.cpp" \
+    "$PROJECT_DIR/src/differential.cpp" \
+    "$PROJECT_DIR/src/thread_pool.cpp" \
+    "$PROJECT_DIR/src/batch_scheduler.cpp" \
+    "$PROJECT_DIR/src/epoch.cpp" \
+    "$PROJECT_DIR/src/registry.cpp" \
+    "$PROJECT_DIR/src/stats.cpp" \
+    "$PROJECT_DIR/src/arrow_adapter.cpp" \
+    "$PROJECT_DIR/src/aot.cpp" \
+    "$PROJECT_DIR/src/hash.cpp" \
+    "$PROJECT_DIR/src/compiler_backend.cpp" \
+    "$PROJECT_DIR/src/orc_backend.cpp" \
+    "$PROJECT_DIR/src/optimizer.cpp" \
+    "${LLVM_FLAGS[@]}" \
     -o "$BUILD_DIR/test_runner" \
-    -ldl
+    -ldl -lpthread
 
 echo "编译测试程序成功!"
 echo ""
@@ -30,19 +69,72 @@ echo "运行测试..."
 echo ""
 echo "编译性能测试程序..."
 g++ -std=c++17 -O3 -march=native -I"$PROJECT_DIR/include" -I"$PROJECT_DIR/third_party" \
-    "$PROJECT_DIR/examples/benchmark.cpp" \
+    -DTURBOGRAPH_INCLUDE_DIR="\"$PROJECT_DIR/include\"" \
+    "$PROJECT_DIR/example/benchmark.cpp" \
     "$PROJECT_DIR/src/config_parser.cpp" \
     "$PROJECT_DIR/src/code_generator.cpp" \
+    "$PROJECT_DIR/src/bytecode.cpp" \
     "$PROJECT_DIR/src/compiler.cpp" \
     "$PROJECT_DIR/src/loader.cpp" \
     "$PROJECT_DIR/src/pipeline.cpp" \
+    "$PROJECT_DIR/src/pipeline_group.cpp" \
+    "$PROJECT_DIR/src/result_cache.cpp" \
+    "$PROJECT_DIR/src/differential.cpp" \
+    "$PROJECT_DIR/src/thread_pool.cpp" \
+    "$PROJECT_DIR/src/batch_scheduler.cpp" \
+    "$PROJECT_DIR/src/epoch.cpp" \
+    "$PROJECT_DIR/src/registry.cpp" \
+    "$PROJECT_DIR/src/stats.cpp" \
+    "$PROJECT_DIR/src/arrow_adapter.cpp" \
+    "$PROJECT_DIR/src/aot.cpp" \
+    "$PROJECT_DIR/src/hash.cpp" \
+    "$PROJECT_DIR/src/compiler_backend.cpp" \
+    "$PROJECT_DIR/src/orc_backend.cpp" \
+    "$PROJECT_DIR/src/optimizer.cpp" \
+    "${LLVM_FLAGS[@]}" \
     -o "$BUILD_DIR/benchmark" \
-    -ldl
+    -ldl -lpthread
 
 echo "编译性能测试程序成功!"
 echo ""
 echo "运行性能测试..."
 "$BUILD_DIR/benchmark"
 
+# 可选：TURBOGRAPH_BENCH=1 时构建并运行基准测试（需要Google Benchmark），结果写入build/bench_results.json
+if [ "${TURBOGRAPH_BENCH:-0}" = "1" ]; then
+    echo ""
+    echo "编译基准测试..."
+    g++ -std=c++17 -O3 -march=native -I"$PROJECT_DIR/include" -I"$PROJECT_DIR/third_party" \
+        -DTURBOGRAPH_INCLUDE_DIR="\"$PROJECT_DIR/include\"" \
+        "$PROJECT_DIR/bench/bench_ops.cpp" \
+        "$PROJECT_DIR/bench/bench_pipelines.cpp" \
+        "$PROJECT_DIR/src/config_parser.cpp" \
+        "$PROJECT_DIR/src/code_generator.cpp" \
+        "$PROJECT_DIR/src/bytecode.cpp" \
+        "$PROJECT_DIR/src/compiler.cpp" \
+        "$PROJECT_DIR/src/loader.cpp" \
+        "$PROJECT_DIR/src/pipeline.cpp" \
+        "$PROJECT_DIR/src/pipeline_group.cpp" \
+        "$PROJECT_DIR/src/result_cache.cpp" \
+        "$PROJECT_DIR/src/differential.cpp" \
+        "$PROJECT_DIR/src/thread_pool.cpp" \
+        "$PROJECT_DIR/src/batch_scheduler.cpp" \
+        "$PROJECT_DIR/src/epoch.cpp" \
+        "$PROJECT_DIR/src/registry.cpp" \
+        "$PROJECT_DIR/src/stats.cpp" \
+        "$PROJECT_DIR/src/arrow_adapter.cpp" \
+        "$PROJECT_DIR/src/aot.cpp" \
+        "$PROJECT_DIR/src/hash.cpp" \
+        "$PROJECT_DIR/src/compiler_backend.cpp" \
+        "$PROJECT_DIR/src/orc_backend.cpp" \
+        "$PROJECT_DIR/src/optimizer.cpp" \
+        "${LLVM_FLAGS[@]}" \
+        -o "$BUILD_DIR/turbograph_bench" \
+        -lbenchmark -lbenchmark_main -ldl -lpthread
+
+    echo "运行基准测试..."
+    (cd "$BUILD_DIR" && ./turbograph_bench --benchmark_out=bench_results.json --benchmark_out_format=json)
+fi
+
 echo ""
 echo "完成!"
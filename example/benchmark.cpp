@@ -11,10 +11,14 @@
  */
 
 #include "pipeline.hpp"
+#include "pipeline_group.hpp"
+#include "result_cache.hpp"
+#include "differential.hpp"
 #include "config.hpp"
 #include "code_generator.hpp"
 #include "compiler.hpp"
 #include "loader.hpp"
+#include "ops.hpp"
 
 #include <iostream>
 #include <chrono>
@@ -23,6 +27,8 @@
 #include <random>
 #include <algorithm>
 #include <numeric>
+#include <sstream>
+#include <cstdio>
 
 using namespace turbograph;
 using namespace std::chrono;
@@ -133,6 +139,13 @@ BenchmarkResult run_benchmark(const TestCase& test) {
         inputs_c[i] = dist(rng);
     }
     
+    // 上下文槽位（每个配置解析一次）
+    auto layout = make_context_layout(config);
+    const size_t slot_a = layout->slot_of("a");
+    const size_t slot_b = layout->slot_of("b");
+    const size_t slot_c = layout->slot_of("c");
+    const size_t slot_out = layout->slot_of("var_" + std::to_string(test.complexity - 1));
+    
     // 清理缓存
     PipelineManager::instance().clear_cache();
     
@@ -140,21 +153,24 @@ BenchmarkResult run_benchmark(const TestCase& test) {
     {
         auto executor = PipelineManager::instance().create(config, PipelineMode::INTERPRETER);
         
+        // 复用同一个上下文，按槽位读写
+        ExecutionContext ctx = executor->create_context();
+        
         auto start = high_resolution_clock::now();
         
         result.interpreter_success = true;
         for (int i = 0; i < test.iterations; i++) {
-            ExecutionContext ctx;
-            ctx.set_variable("a", DataType::DOUBLE, inputs_a[i]);
-            ctx.set_variable("b", DataType::DOUBLE, inputs_b[i]);
-            ctx.set_variable("c", DataType::DOUBLE, inputs_c[i]);
+            ctx.reset();
+            ctx.set_slot(slot_a, inputs_a[i]);
+            ctx.set_slot(slot_b, inputs_b[i]);
+            ctx.set_slot(slot_c, inputs_c[i]);
             
             if (!executor->execute(ctx)) {
                 result.interpreter_success = false;
                 break;
             }
             
-            outputs_interpreter[i] = ctx.get<double>("var_" + std::to_string(test.complexity - 1));
+            outputs_interpreter[i] = ctx.get_slot<double>(slot_out);
         }
         
         auto end = high_resolution_clock::now();
@@ -174,21 +190,23 @@ BenchmarkResult run_benchmark(const TestCase& test) {
             jit_executor->recompile();
         }
         
+        ExecutionContext ctx = executor->create_context();
+        
         auto start = high_resolution_clock::now();
         
         result.jit_success = true;
         for (int i = 0; i < test.iterations; i++) {
-            ExecutionContext ctx;
-            ctx.set_variable("a", DataType::DOUBLE, inputs_a[i]);
-            ctx.set_variable("b", DataType::DOUBLE, inputs_b[i]);
-            ctx.set_variable("c", DataType::DOUBLE, inputs_c[i]);
+            ctx.reset();
+            ctx.set_slot(slot_a, inputs_a[i]);
+            ctx.set_slot(slot_b, inputs_b[i]);
+            ctx.set_slot(slot_c, inputs_c[i]);
             
             if (!executor->execute(ctx)) {
                 result.jit_success = false;
                 break;
             }
             
-            outputs_jit[i] = ctx.get<double>("var_" + std::to_string(test.complexity - 1));
+            outputs_jit[i] = ctx.get_slot<double>(slot_out);
         }
         
         auto end = high_resolution_clock::now();
@@ -205,6 +223,552 @@ BenchmarkResult run_benchmark(const TestCase& test) {
     return result;
 }
 
+// ============================================
+// 编译耗时测试
+// ============================================
+
+/**
+ * @brief 编译一次配置并返回耗时（毫秒），名称加时间戳避免命中缓存
+ */
+double measure_compile(const PipelineConfig& base, const std::string& tag,
+                       const CodeGenOptions& gen_opts, const CompileOptions& comp_opts) {
+    PipelineConfig config = base;
+    config.name += "_compile_" + tag + "_" +
+        std::to_string(system_clock::now().time_since_epoch().count());
+    config.compute_fingerprint();
+    
+    auto start = high_resolution_clock::now();
+    bool ok = JITCompiler::instance().compile(config, gen_opts, comp_opts);
+    auto end = high_resolution_clock::now();
+    return ok ? duration_cast<microseconds>(end - start).count() / 1000.0 : -1.0;
+}
+
+void run_compile_benchmark() {
+    auto base = create_test_config(20);
+    
+    CodeGenOptions full_headers;
+    full_headers.minimal_includes = false;
+    CodeGenOptions minimal_headers;
+    
+    CompileOptions no_pch;
+    no_pch.use_pch = false;
+    CompileOptions with_pch;
+    
+    // 预编译头每个工具链+编译选项只生成一次，单独计时
+    auto pch_start = high_resolution_clock::now();
+    bool pch_ok = !JITCompiler::instance().ensure_pch(with_pch).empty();
+    auto pch_end = high_resolution_clock::now();
+    double pch_ms = duration_cast<microseconds>(pch_end - pch_start).count() / 1000.0;
+    
+    // 优化级别不同则PCH不同，先预热，避免计入下面的单次编译
+    CompileOptions fast_opt = with_pch;
+    fast_opt.optimization = "-O1 -march=native";
+    JITCompiler::instance().ensure_pch(fast_opt);
+    
+    struct Variant {
+        std::string name;
+        double ms;
+    };
+    std::vector<Variant> variants = {
+        {"完整头文件, 无PCH", measure_compile(base, "full", full_headers, no_pch)},
+        {"轻量头文件, 无PCH", measure_compile(base, "core", minimal_headers, no_pch)},
+        {"完整头文件, PCH", measure_compile(base, "pch", full_headers, with_pch)},
+        {"PCH + -O1", measure_compile(base, "o1", full_headers, fast_opt)}
+    };
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 生成代码编译耗时 (20个算子)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "PCH生成(一次性): " << std::setw(10) << pch_ms << " ms"
+              << (pch_ok ? "" : " (失败)") << "\n";
+    
+    double baseline = variants[0].ms;
+    for (const auto& v : variants) {
+        std::cout << std::left << std::setw(24) << v.name << std::right;
+        if (v.ms < 0) {
+            std::cout << "     编译失败\n";
+            continue;
+        }
+        std::cout << std::setw(10) << v.ms << " ms";
+        if (baseline > 0 && &v != &variants[0]) {
+            std::cout << "  (节省 " << (1.0 - v.ms / baseline) * 100.0 << "%)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 列表算子内核测试
+// ============================================
+
+/**
+ * @brief 重复执行fn并返回每次调用的平均耗时（纳秒）
+ */
+template<typename F>
+double measure_ns(int iterations, F&& fn) {
+    volatile double sink = 0;
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink = sink + fn();
+    }
+    auto end = high_resolution_clock::now();
+    return duration_cast<nanoseconds>(end - start).count() / static_cast<double>(iterations);
+}
+
+void run_list_kernel_benchmark() {
+    const size_t n = 2000;
+    const int iterations = 20000;
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> history(n);
+    std::vector<double> prices(n);
+    for (size_t i = 0; i < n; i++) {
+        history[i] = static_cast<int64_t>(rng() >> 1);
+        prices[i] = static_cast<double>(rng() % 100000) / 100.0;
+    }
+    const int64_t missing = -1;  // 不存在的ID：查找遍历整个列表
+    
+    // 逐元素参考实现（与向量化前的算子相同）
+    auto scalar_cross = [&] {
+        for (size_t i = 0; i < history.size(); i++) {
+            if (history[i] == missing) return 1.0;
+        }
+        return 0.0;
+    };
+    auto scalar_count = [&] {
+        int count = 0;
+        for (size_t i = 0; i < history.size(); i++) count += history[i] == missing;
+        return static_cast<double>(count);
+    };
+    
+    struct Row {
+        std::string name;
+        double scalar_ns;
+        double simd_ns;
+    };
+    std::vector<Row> rows = {
+        {"catein_list_cross", measure_ns(iterations, scalar_cross),
+         measure_ns(iterations, [&] { return static_cast<double>(ops::catein_list_cross(history, missing)); })},
+        {"catein_list_cross_count", measure_ns(iterations, scalar_count),
+         measure_ns(iterations, [&] { return static_cast<double>(ops::catein_list_cross_count(history, missing)); })},
+        {"vector_sum (顺序/_fast)", measure_ns(iterations, [&] { return ops::vector_sum(prices); }),
+         measure_ns(iterations, [&] { return ops::vector_sum_fast(prices); })}
+    };
+    
+    // 一次请求内同一历史列表与所有候选交叉：逐个扫描 vs 预构建查找结构（含构建耗时）
+    std::vector<int64_t> candidates(400);
+    for (size_t i = 0; i < candidates.size(); i++) {
+        candidates[i] = i % 4 == 0 ? history[i * 3] : static_cast<int64_t>(rng() >> 1);
+    }
+    rows.push_back({"catein_set_cross (400个候选)",
+        measure_ns(iterations / 100, [&] {
+            int hits = 0;
+            for (int64_t id : candidates) hits += ops::catein_list_cross(history, id);
+            return static_cast<double>(hits);
+        }),
+        measure_ns(iterations / 100, [&] {
+            ops::ListLookup<std::vector<int64_t>> lookup(history);
+            int hits = 0;
+            for (int64_t id : candidates) hits += ops::catein_set_cross(lookup, id);
+            return static_cast<double>(hits);
+        })});
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 列表算子内核 (" << n << "个元素, 指令集: " << simd::isa_name() << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(28) << row.name << std::right
+                  << std::setw(10) << row.scalar_ns << " ns -> "
+                  << std::setw(8) << row.simd_ns << " ns  ("
+                  << std::setprecision(2) << row.scalar_ns / row.simd_ns << "x)\n"
+                  << std::setprecision(1);
+    }
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 多线程批量调度测试
+// ============================================
+
+void run_batch_scheduler_benchmark() {
+    PipelineConfig config;
+    config.name = "bench_batch_scheduler";
+    config.inputs = {
+        {"item_id", DataType::INT64, true},
+        {"history", DataType::INT64_LIST, true, true},
+        {"price", DataType::DOUBLE, true}
+    };
+    config.steps = {
+        OpCallBuilder("catein_set_cross").output("hit")
+            .args({Arg::variable("history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)}).build(),
+        OpCallBuilder("mul").output("scaled")
+            .args({Arg::variable("price", DataType::DOUBLE), Arg::literal("1.5", DataType::DOUBLE)}).build(),
+        OpCallBuilder("add").output("score")
+            .args({Arg::variable("scaled", DataType::DOUBLE), Arg::variable("hit", DataType::INT32)}).build()
+    };
+    config.outputs = {
+        {"hit", DataType::INT32, true},
+        {"score", DataType::DOUBLE, true}
+    };
+    config.compute_fingerprint();
+    
+    // 单个请求携带5万个候选
+    const size_t n = 50000;
+    std::mt19937_64 rng(7);
+    std::vector<std::vector<int64_t>> history(1, std::vector<int64_t>(2000));
+    for (auto& id : history[0]) id = static_cast<int64_t>(rng() % 100000);
+    std::vector<int64_t> items(n);
+    std::vector<double> prices(n);
+    for (size_t i = 0; i < n; i++) {
+        items[i] = static_cast<int64_t>(rng() % 100000);
+        prices[i] = static_cast<double>(rng() % 10000) / 100.0;
+    }
+    std::vector<int32_t> hit(n);
+    std::vector<double> score(n);
+    const void* in_columns[] = {items.data(), history.data(), prices.data()};
+    void* out_columns[] = {hit.data(), score.data()};
+    ColumnBatch input{in_columns, 3};
+    OutputBatch output{out_columns, 2};
+    
+    JITExecutor jit(config);
+    if (!jit.prepare()) {
+        std::cout << "JIT编译失败，跳过\n";
+        return;
+    }
+    BatchScheduler& scheduler = PipelineManager::instance().batch_scheduler();
+    const int iterations = 50;
+    double single_ns = measure_ns(iterations, [&] {
+        return jit.execute_batch(input, output, n) ? 1.0 : 0.0;
+    });
+    double parallel_ns = measure_ns(iterations, [&] {
+        return scheduler.run(jit, config, input, output, n) ? 1.0 : 0.0;
+    });
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 多线程批量调度 (" << n << "个候选, " << scheduler.num_threads() + 1 << "个线程, 每块"
+              << scheduler.chunk_rows(config, n) << "行)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "单线程批量入口: " << single_ns / 1e6 << " ms/请求\n";
+    std::cout << "工作窃取调度:   " << parallel_ns / 1e6 << " ms/请求  ("
+              << std::setprecision(2) << single_ns / parallel_ns << "x)\n";
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 多管道融合测试
+// ============================================
+
+void run_pipeline_group_benchmark() {
+    // 16个管道读取相同的输入，共享缩放与历史交叉两个步骤
+    const int num_members = 16;
+    std::vector<PipelineConfig> members;
+    for (int m = 0; m < num_members; m++) {
+        PipelineConfig config;
+        config.name = "bench_member_" + std::to_string(m);
+        config.inputs = {
+            {"price", DataType::DOUBLE, true},
+            {"item_id", DataType::INT64, true},
+            {"history", DataType::INT64_LIST, true}
+        };
+        config.steps = {
+            OpCallBuilder("mul").output("scaled")
+                .args({Arg::variable("price", DataType::DOUBLE), Arg::literal("1.5", DataType::DOUBLE)}).build(),
+            OpCallBuilder("catein_list_cross").output("hit")
+                .args({Arg::variable("history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)}).build(),
+            OpCallBuilder("mul").output("weighted")
+                .args({Arg::variable("scaled", DataType::DOUBLE),
+                       Arg::literal(std::to_string(m + 1) + ".0", DataType::DOUBLE)}).build(),
+            OpCallBuilder("add").output("score")
+                .args({Arg::variable("weighted", DataType::DOUBLE), Arg::variable("hit", DataType::INT32)}).build()
+        };
+        config.outputs = {{"score", DataType::DOUBLE, true}};
+        config.compute_fingerprint();
+        members.push_back(std::move(config));
+    }
+    PipelineGroup group("bench_group", members);
+    
+    const size_t n = 10000;
+    std::mt19937_64 rng(11);
+    std::vector<double> prices(n);
+    std::vector<int64_t> items(n);
+    std::vector<std::vector<int64_t>> history(n, std::vector<int64_t>(64));
+    for (size_t i = 0; i < n; i++) {
+        prices[i] = static_cast<double>(rng() % 10000) / 100.0;
+        items[i] = static_cast<int64_t>(rng() % 1000);
+        for (auto& id : history[i]) id = static_cast<int64_t>(rng() % 1000);
+    }
+    const void* in_columns[] = {prices.data(), items.data(), history.data()};
+    ColumnBatch input{in_columns, 3};
+    std::vector<std::vector<double>> scores(num_members, std::vector<double>(n));
+    std::vector<void*> out_columns(num_members);
+    std::vector<OutputBatch> outputs;
+    for (int m = 0; m < num_members; m++) {
+        out_columns[m] = scores[m].data();
+    }
+    for (int m = 0; m < num_members; m++) {
+        outputs.push_back({&out_columns[m], 1});
+    }
+    
+    std::vector<std::unique_ptr<JITExecutor>> separate;
+    for (const auto& config : members) {
+        separate.push_back(std::make_unique<JITExecutor>(config));
+        if (!separate.back()->prepare()) {
+            std::cout << "JIT编译失败，跳过\n";
+            return;
+        }
+    }
+    JITExecutor fused(group.fused_config());
+    if (!fused.prepare()) {
+        std::cout << "JIT编译失败，跳过\n";
+        return;
+    }
+    
+    const int iterations = 20;
+    double separate_ns = measure_ns(iterations, [&] {
+        bool ok = true;
+        for (int m = 0; m < num_members; m++) {
+            ok &= separate[m]->execute_batch(input, outputs[m], n);
+        }
+        return ok ? 1.0 : 0.0;
+    });
+    double fused_ns = measure_ns(iterations, [&] {
+        return group.execute_batch(fused, input, outputs, n) ? 1.0 : 0.0;
+    });
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 多管道融合 (" << num_members << "个管道, " << n << "行, 步骤 "
+              << group.member_steps() << " -> " << group.fused_steps() << ")\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "逐个管道批量执行: " << separate_ns / 1e6 << " ms/批\n";
+    std::cout << "融合批量执行:     " << fused_ns / 1e6 << " ms/批  ("
+              << std::setprecision(2) << separate_ns / fused_ns << "x)\n";
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 输出掩码测试
+// ============================================
+
+void run_output_mask_benchmark() {
+    // 第一阶段只需要价格分，第二阶段才需要历史交叉与列表统计
+    PipelineConfig config;
+    config.name = "bench_output_mask";
+    config.inputs = {
+        {"price", DataType::DOUBLE, true},
+        {"item_id", DataType::INT64, true},
+        {"history", DataType::INT64_LIST, true}
+    };
+    config.variables = {{"hit_count", DataType::INT64, false}};
+    config.steps = {
+        OpCallBuilder("mul").output("price_score")
+            .args({Arg::variable("price", DataType::DOUBLE), Arg::literal("1.5", DataType::DOUBLE)}).build(),
+        OpCallBuilder("catein_list_cross_count").output("hit_count")
+            .args({Arg::variable("history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)}).build(),
+        OpCallBuilder("len").output("history_len")
+            .args({Arg::variable("history", DataType::INT64_LIST)}).build(),
+        OpCallBuilder("percent").output("hit_rate")
+            .args({Arg::variable("hit_count", DataType::INT64), Arg::variable("history_len", DataType::INT64)}).build()
+    };
+    config.outputs = {
+        {"price_score", DataType::DOUBLE, true},
+        {"hit_rate", DataType::DOUBLE, true}
+    };
+    config.compute_fingerprint();
+    
+    const size_t n = 10000;
+    std::mt19937_64 rng(13);
+    std::vector<double> prices(n);
+    std::vector<int64_t> items(n);
+    std::vector<std::vector<int64_t>> history(n, std::vector<int64_t>(256));
+    for (size_t i = 0; i < n; i++) {
+        prices[i] = static_cast<double>(rng() % 10000) / 100.0;
+        items[i] = static_cast<int64_t>(rng() % 1000);
+        for (auto& id : history[i]) id = static_cast<int64_t>(rng() % 1000);
+    }
+    std::vector<double> price_score(n), hit_rate(n);
+    const void* in_columns[] = {prices.data(), items.data(), history.data()};
+    void* out_columns[] = {price_score.data(), hit_rate.data()};
+    ColumnBatch input{in_columns, 3};
+    OutputBatch output{out_columns, 2};
+    
+    JITExecutor jit(config);
+    if (!jit.prepare()) {
+        std::cout << "JIT编译失败，跳过\n";
+        return;
+    }
+    OutputMask stage1 = OutputMask::of(config, {"price_score"});
+    const int iterations = 20;
+    double full_ns = measure_ns(iterations, [&] {
+        return jit.execute_batch(input, output, n) ? 1.0 : 0.0;
+    });
+    double masked_ns = measure_ns(iterations, [&] {
+        return jit.execute_batch_masked(input, output, n, stage1) ? 1.0 : 0.0;
+    });
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 按输出掩码执行 (" << n << "行, 请求1/" << config.outputs.size() << "个输出)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "全部输出:   " << full_ns / 1e6 << " ms/批\n";
+    std::cout << "只请求price_score: " << masked_ns / 1e6 << " ms/批  ("
+              << std::setprecision(2) << full_ns / masked_ns << "x)\n";
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 结果缓存测试
+// ============================================
+
+void run_result_cache_benchmark() {
+    // 商品侧特征：结果只由商品ID决定，批次内与跨请求大量重复
+    PipelineConfig config;
+    config.name = "bench_result_cache";
+    config.inputs = {
+        {"item_id", DataType::INT64, true},
+        {"item_history", DataType::INT64_LIST, true}
+    };
+    config.variables = {{"hit_count", DataType::INT64, false}};
+    config.steps = {
+        OpCallBuilder("catein_list_cross_count").output("hit_count")
+            .args({Arg::variable("item_history", DataType::INT64_LIST), Arg::variable("item_id", DataType::INT64)}).build(),
+        OpCallBuilder("len").output("history_len")
+            .args({Arg::variable("item_history", DataType::INT64_LIST)}).build(),
+        OpCallBuilder("percent").output("hit_rate")
+            .args({Arg::variable("hit_count", DataType::INT64), Arg::variable("history_len", DataType::INT64)}).build()
+    };
+    config.outputs = {{"hit_rate", DataType::DOUBLE, true}};
+    config.compute_fingerprint();
+    PipelineConfig cached_config = config;
+    cached_config.cache.keys = {"item_id"};
+    cached_config.cache.capacity = 4096;
+    
+    const size_t n = 10000;
+    const size_t distinct = 200;
+    std::mt19937_64 rng(17);
+    std::vector<std::vector<int64_t>> item_histories(distinct, std::vector<int64_t>(256));
+    for (auto& history : item_histories) {
+        for (auto& id : history) id = static_cast<int64_t>(rng() % distinct);
+    }
+    std::vector<int64_t> items(n);
+    std::vector<std::vector<int64_t>> history(n);
+    for (size_t i = 0; i < n; i++) {
+        items[i] = static_cast<int64_t>(rng() % distinct);
+        history[i] = item_histories[items[i]];
+    }
+    std::vector<double> hit_rate(n);
+    const void* in_columns[] = {items.data(), history.data()};
+    void* out_columns[] = {hit_rate.data()};
+    ColumnBatch input{in_columns, 2};
+    OutputBatch output{out_columns, 1};
+    
+    auto plain = PipelineManager::instance().create(config, PipelineMode::JIT);
+    auto cached = PipelineManager::instance().create(cached_config, PipelineMode::JIT);
+    if (!plain->execute_batch(input, output, n) || !cached->execute_batch(input, output, n)) {
+        std::cout << "JIT编译失败，跳过\n";
+        return;
+    }
+    const int iterations = 20;
+    double plain_ns = measure_ns(iterations, [&] {
+        return plain->execute_batch(input, output, n) ? 1.0 : 0.0;
+    });
+    double cached_ns = measure_ns(iterations, [&] {
+        return cached->execute_batch(input, output, n) ? 1.0 : 0.0;
+    });
+    auto stats = static_cast<CachedExecutor&>(*cached).cache().stats();
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 结果缓存 (" << n << "行, " << distinct << "个不同商品)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "不缓存:   " << plain_ns / 1e6 << " ms/批\n";
+    std::cout << "缓存:     " << cached_ns / 1e6 << " ms/批  ("
+              << std::setprecision(2) << plain_ns / cached_ns << "x, 命中率 "
+              << stats.hit_rate() * 100 << "%)\n";
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 差分测试
+// ============================================
+
+void run_differential_benchmark() {
+    // 随机配置在各执行方式下的吞吐与延迟，同时校验结果与解释执行一致
+    DifferentialOptions options;
+    options.seed = 42;
+    options.num_configs = 16;
+    options.rows = 2048;
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 差分测试 (解释执行 / 字节码 / JIT / 批量调度)\n";
+    std::cout << std::string(60, '=') << "\n";
+    DifferentialReport report = run_differential(options);
+    report.print(std::cout);
+    std::cout << std::string(60, '-') << "\n";
+}
+
+// ============================================
+// 配置加载耗时测试
+// ============================================
+
+void run_config_load_benchmark() {
+    const int num_pipelines = 500;
+    std::vector<PipelineConfig> configs;
+    std::vector<std::string> documents;
+    std::string array = "[";
+    for (int i = 0; i < num_pipelines; i++) {
+        auto config = create_test_config(20);
+        config.name = "load_" + std::to_string(i);
+        config.compute_fingerprint();
+        documents.push_back(ConfigGenerator::generate_json(config));
+        array += (i ? "," : "") + documents.back();
+        configs.push_back(std::move(config));
+    }
+    array += "]";
+    const std::string path = "./bench_configs.tgpc";
+    ConfigGenerator::save_binary(configs, path);
+    
+    auto elapsed_ms = [](auto start) {
+        return duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+    };
+    
+    JsonConfigParser parser;
+    size_t checksum = 0;
+    auto start = high_resolution_clock::now();
+    for (const auto& doc : documents) {
+        checksum += parser.parse_string(doc).steps.size();
+    }
+    double dom_ms = elapsed_ms(start);
+    
+    start = high_resolution_clock::now();
+    std::istringstream input(array);
+    parser.parse_bulk(input, [&](PipelineConfig&& config) { checksum += config.steps.size(); });
+    double sax_ms = elapsed_ms(start);
+    
+    start = high_resolution_clock::now();
+    {
+        MappedConfigFile file(path);
+        for (size_t i = 0; i < file.size(); i++) {
+            checksum += file.config(i).steps.size();
+        }
+    }
+    double binary_ms = elapsed_ms(start);
+    std::remove(path.c_str());
+    
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "测试: 配置加载耗时 (" << num_pipelines << "个管道, 每个20个算子)\n";
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(24) << "JSON (DOM, 逐个)" << std::right << std::setw(10) << dom_ms << " ms\n";
+    std::cout << std::left << std::setw(24) << "JSON (SAX, 数组)" << std::right << std::setw(10) << sax_ms << " ms\n";
+    std::cout << std::left << std::setw(24) << "二进制 (mmap)" << std::right << std::setw(10) << binary_ms << " ms\n";
+    std::cout << "(校验和 " << checksum << ")\n";
+    std::cout << std::string(60, '-') << "\n";
+}
+
 // ============================================
 // 主函数
 // ============================================
@@ -242,6 +806,39 @@ int main() {
         std::cout << "\n";
     }
     
+    // 编译耗时
+    std::cout << "运行测试: 生成代码编译耗时...\n";
+    run_compile_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 列表算子内核...\n";
+    run_list_kernel_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 多线程批量调度...\n";
+    run_batch_scheduler_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 多管道融合...\n";
+    run_pipeline_group_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 按输出掩码执行...\n";
+    run_output_mask_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 结果缓存...\n";
+    run_result_cache_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 差分测试...\n";
+    run_differential_benchmark();
+    std::cout << "\n";
+    
+    std::cout << "运行测试: 配置加载...\n";
+    run_config_load_benchmark();
+    std::cout << "\n";
+    
     // 总结
     std::cout << R"(
 ╔══════════════════════════════════════════════════════════════╗
@@ -0,0 +1,122 @@
+#ifndef TURBOGRAPH_ABI_HPP
+#define TURBOGRAPH_ABI_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// 本头文件同时被宿主程序和生成的SO包含，只允许定义POD结构
+
+namespace turbograph {
+
+// ============================================
+// 单行执行接口数据结构（打包结构体）
+// ============================================
+
+/**
+ * @brief ABI版本号，输入输出结构布局规则变化时递增
+ */
+constexpr uint32_t kAbiVersion = 2;
+
+/**
+ * @brief 非拥有的连续元素视图
+ * 输入结构中的列表/字符串字段为视图，可直接指向调用方自己的缓冲区
+ * （std::vector、protobuf repeated字段、Arrow数组等），生成代码不拷贝元素；
+ * 缓冲区需在调用期间保持有效。提供容器接口，可直接传给列表算子
+ */
+template<typename T>
+struct ListView {
+    using value_type = T;
+
+    const T* items = nullptr;
+    size_t count = 0;
+
+    const T* data() const { return items; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    const T& operator[](size_t i) const { return items[i]; }
+};
+
+/**
+ * @brief 字符串输入字段（UTF-8字节视图，不要求以'\0'结尾）
+ */
+using StringView = ListView<char>;
+
+/**
+ * @brief 结构体字段描述
+ * 标量字段按值存放；输入的字符串/列表字段为ListView视图，
+ * 输出的字符串/列表字段为指向调用方对象的T*
+ */
+struct AbiField {
+    const char* name;
+    uint32_t type;    // DataType 枚举值
+    uint32_t offset;  // 字段在结构体中的偏移
+    uint32_t size;    // 字段大小
+};
+
+/**
+ * @brief 输入/输出结构体布局描述
+ * 由生成的SO以 pipeline_abi_<fp> 符号导出
+ */
+struct AbiLayout {
+    uint32_t version;
+    uint32_t input_size;
+    uint32_t input_align;
+    uint32_t num_inputs;
+    const AbiField* inputs;
+    uint32_t output_size;
+    uint32_t output_align;
+    uint32_t num_outputs;
+    const AbiField* outputs;
+};
+
+// ============================================
+// 批量执行接口数据结构（列式存储）
+// ============================================
+
+/**
+ * @brief 列式输入批次
+ * columns[i] 指向 config.inputs[i] 的连续缓冲区，元素类型为
+ * get_cpp_type_name(inputs[i].type)，长度为批次行数
+ */
+struct ColumnBatch {
+    const void* const* columns = nullptr;
+    size_t num_columns = 0;
+};
+
+/**
+ * @brief 列式输出批次
+ * columns[i] 指向 config.outputs[i] 的连续缓冲区，由调用方分配
+ */
+struct OutputBatch {
+    void* const* columns = nullptr;
+    size_t num_columns = 0;
+};
+
+/**
+ * @brief 偏移编码的输入列（Arrow列存布局，不拷贝调用方的缓冲区）
+ * 标量列：values为元素数组，offsets为空；
+ * 字符串列：第i行为 values(char)[offsets[i], offsets[i+1])；
+ * 数值列表列：第i行为 values(元素类型)[offsets[i], offsets[i+1])；
+ * 字符串列表列：第i行为第offsets[i]到offsets[i+1]个字符串，
+ *   第k个字符串为 values(char)[value_offsets[k], value_offsets[k+1])。
+ * 偏移已包含数组切片的起始位置
+ */
+struct OffsetColumn {
+    const void* values = nullptr;
+    const int32_t* offsets = nullptr;
+    const int32_t* value_offsets = nullptr;
+};
+
+/**
+ * @brief 偏移编码的列式输入批次，columns[i]对应config.inputs[i]
+ */
+struct OffsetBatch {
+    const OffsetColumn* columns = nullptr;
+    size_t num_columns = 0;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_ABI_HPP
@@ -0,0 +1,72 @@
+#ifndef TURBOGRAPH_AOT_HPP
+#define TURBOGRAPH_AOT_HPP
+
+#include "abi.hpp"
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace turbograph {
+
+// ============================================
+// 构建期生成的管道（AOT）
+// ============================================
+
+/**
+ * @brief 一个静态链接的管道，各入口与JIT生成的SO导出的同名符号一致
+ * 由turbograph_aot生成的源文件在静态初始化时注册
+ */
+struct AotPipeline {
+    const char* fingerprint;
+    const char* name;
+    const AbiLayout* abi;
+    bool (*execute)(void*, void*);
+    bool (*execute_batch)(const ColumnBatch*, OutputBatch*, size_t);
+    bool (*execute_offsets)(const OffsetBatch*, OutputBatch*, size_t);
+    bool (*execute_batch_masked)(const ColumnBatch*, OutputBatch*, size_t, const uint64_t*);  // 单输出管道为空
+};
+
+/**
+ * @brief AOT管道表，按指纹查找
+ */
+class AotRegistry {
+public:
+    static AotRegistry& instance();
+
+    AotRegistry(const AotRegistry&) = delete;
+    AotRegistry& operator=(const AotRegistry&) = delete;
+
+    /**
+     * @brief 注册管道，pipeline需在程序生命期内有效；同一指纹重复注册时保留先注册的
+     */
+    void add(const AotPipeline& pipeline);
+
+    /**
+     * @brief 按指纹查找，未注册时返回nullptr
+     */
+    const AotPipeline* find(const std::string& fingerprint) const;
+
+    size_t size() const;
+
+private:
+    AotRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, const AotPipeline*> pipelines_;
+};
+
+/**
+ * @brief 静态注册器，生成的源文件中以命名空间作用域对象定义
+ */
+struct AotRegistrar {
+    AotRegistrar(const AotPipeline* pipelines, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            AotRegistry::instance().add(pipelines[i]);
+        }
+    }
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_AOT_HPP
@@ -0,0 +1,119 @@
+#ifndef TURBOGRAPH_ARROW_ADAPTER_HPP
+#define TURBOGRAPH_ARROW_ADAPTER_HPP
+
+#include "config.hpp"
+#include "abi.hpp"
+#include "pipeline.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================
+// Arrow C数据接口
+// ============================================
+
+// 与arrow/c/abi.h中的定义一致（ABI稳定），不依赖Arrow库；
+// Arrow C++通过arrow::ExportRecordBatch / arrow::ImportRecordBatch与之互通
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace turbograph {
+
+// ============================================
+// Arrow记录批次适配器
+// ============================================
+
+/**
+ * @brief 以Arrow记录批次（struct数组）为输入输出执行管道
+ *
+ * 输入按名称映射到config.inputs：标量列为int32/int64/float32/float64，字符串为utf8，
+ * 列表为list<int32|int64|float64|utf8>（32位偏移）。输入列不拷贝，值缓冲区与偏移数组
+ * 直接交给执行器的execute_offsets；字符串列表的元素在生成代码中逐行物化为std::string。
+ * 输入不允许包含null。
+ *
+ * 输出为新分配的记录批次，子列顺序与config.outputs一致：标量输出由生成代码直接写入
+ * 导出数组的数据缓冲区；字符串/列表输出按行结果编码为偏移与值缓冲区。
+ *
+ * 同一实例复用每批的临时缓冲区，不可并发使用；每个线程各持有一个实例
+ */
+class ArrowBatchAdapter {
+public:
+    explicit ArrowBatchAdapter(const PipelineConfig& config);
+
+    /**
+     * @brief 按名称绑定记录批次schema中的输入列并校验类型
+     * @return 缺少输入列或类型不匹配时返回false
+     */
+    bool bind(const ArrowSchema& schema);
+
+    /**
+     * @brief 执行一个记录批次
+     * @param executor 执行器，配置需与构造时一致
+     * @param batch 与bind的schema对应的struct数组
+     * @param out 输出记录批次，成功时由调用方负责release
+     * @return 未绑定、批次结构不符、输入包含null或执行失败时返回false，out不被写入
+     */
+    bool execute(IPipelineExecutor& executor, const ArrowArray& batch, ArrowArray* out);
+
+    /**
+     * @brief 导出输出记录批次的schema（struct，子字段与config.outputs一致），由调用方负责release
+     */
+    void export_schema(ArrowSchema* out) const;
+
+    /**
+     * @brief DataType对应的Arrow格式字符串（列表类型为元素的格式），不支持的类型返回nullptr
+     */
+    static const char* format_of(DataType type);
+
+private:
+    PipelineConfig config_;
+    std::vector<size_t> children_;                   // 每个输入在struct子列中的下标
+    bool bound_ = false;
+    std::vector<OffsetColumn> columns_;
+    std::vector<std::shared_ptr<void>> scratch_;     // 字符串/列表输出的逐行结果，跨批次复用
+
+    /**
+     * @brief 由struct子列构造偏移编码输入列
+     */
+    bool resolve_column(size_t input, const ArrowArray& child, int64_t row_offset);
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_ARROW_ADAPTER_HPP
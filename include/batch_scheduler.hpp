@@ -0,0 +1,101 @@
+#ifndef TURBOGRAPH_BATCH_SCHEDULER_HPP
+#define TURBOGRAPH_BATCH_SCHEDULER_HPP
+
+#include "abi.hpp"
+#include "config.hpp"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace turbograph {
+
+class IPipelineExecutor;
+
+// ============================================
+// 批量调度选项
+// ============================================
+
+/**
+ * @brief 批量调度选项
+ */
+struct BatchSchedulerOptions {
+    size_t num_threads = 0;               // 工作线程数（不含调用线程），0表示CPU核数-1
+    size_t chunk_bytes = 256 * 1024;      // 每块输入输出列的目标字节数（约为L2容量）
+    size_t min_chunk_rows = 256;          // 每块最少行数，摊薄每次调用批量入口的开销
+    size_t max_chunk_rows = 16384;        // 每块最多行数
+    size_t parallel_threshold = 4096;     // 行数低于该值时直接在调用线程执行
+    bool pin_threads = false;             // 工作线程绑定到固定CPU（线程局部上下文留在本地NUMA节点）
+};
+
+// ============================================
+// 批量调度器
+// ============================================
+
+/**
+ * @brief 多线程批量调度器
+ * 将一个列式批次按缓存大小切块，在工作窃取线程池上并行调用执行器的批量入口。
+ * 每个参与线程先按顺序处理自己的连续分段，做完后从其他线程分段的尾部窃取，
+ * 调用线程同样参与执行；多个调用方可以并发调用run（包括同一执行器），各批次独立调度。
+ * 请求级常量输入（broadcast）的列在所有块间共享，其余列按行偏移
+ */
+class BatchScheduler {
+public:
+    explicit BatchScheduler(const BatchSchedulerOptions& options = {});
+
+    /**
+     * @brief 析构时等待工作线程退出，需保证没有正在执行的run
+     */
+    ~BatchScheduler();
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /**
+     * @brief 并行执行批次，返回前所有块均已执行完毕
+     * @param executor 执行器，execute_batch需可并发调用
+     * @param config 执行器的管道配置（决定每列的元素类型与是否为broadcast）
+     * @return 所有块均执行成功
+     */
+    bool run(IPipelineExecutor& executor, const PipelineConfig& config,
+             const ColumnBatch& input, OutputBatch& output, size_t n);
+
+    /**
+     * @brief 按配置计算每块行数
+     */
+    size_t chunk_rows(const PipelineConfig& config, size_t n) const;
+
+    /**
+     * @brief 工作线程数（不含调用线程）
+     */
+    size_t num_threads() const { return workers_.size(); }
+
+    /**
+     * @brief 调度选项
+     */
+    const BatchSchedulerOptions& options() const { return options_; }
+
+private:
+    struct Job;
+
+    void worker_loop(size_t index);
+
+    /**
+     * @brief 以slot身份参与执行批次，直到没有可领取的块
+     */
+    static void participate(Job& job, size_t slot);
+
+    BatchSchedulerOptions options_;
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    bool stopping_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable job_cv_;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_BATCH_SCHEDULER_HPP
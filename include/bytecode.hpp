@@ -0,0 +1,140 @@
+#ifndef TURBOGRAPH_BYTECODE_HPP
+#define TURBOGRAPH_BYTECODE_HPP
+
+#include "types.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace turbograph {
+
+// ============================================
+// 字节码定义
+// ============================================
+
+/**
+ * @brief 操作码，与OperatorRegistry中的算子一一对应
+ */
+enum class Opcode : uint8_t {
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MAX,
+    MIN,
+    ABS,
+    SQUARE,
+    SQRT,
+    FLOOR,
+    CEIL,
+    IF_ELSE,
+    GET_SIGN,
+    PRICE_DIFF,
+    PERCENT,
+    AVG_AVG_LOG,
+    TO_INT32,
+    TO_INT64,
+    TO_DOUBLE,
+    TO_STRING,
+    LEN,
+    LIST_TO_STRING,
+    LIST_CROSS,
+    LIST_CROSS_COUNT,
+    MOVING_AVERAGE,
+    VECTOR_SUM,
+    VECTOR_AVG,
+    SET_CROSS,
+    SET_CROSS_COUNT,
+    COUNT
+};
+
+/**
+ * @brief 单条指令最多的操作数个数（avg_avg_log为5个）
+ */
+constexpr size_t kMaxOperands = 5;
+
+/**
+ * @brief 指令操作数
+ * is_const为true时index为常量池下标，否则为上下文槽位
+ */
+struct Operand {
+    uint32_t index = 0;
+    bool is_const = false;
+};
+
+struct Instruction;
+struct BytecodeProgram;
+
+/**
+ * @brief 指令处理函数，降级时直接写入指令，执行时无需再按操作码分派
+ */
+using OpHandler = bool(*)(const Instruction&, const BytecodeProgram&, ExecutionContext&);
+
+/**
+ * @brief 字节码指令
+ */
+struct Instruction {
+    OpHandler handler = nullptr;
+    Opcode opcode = Opcode::COUNT;
+    DataType output_type = DataType::DOUBLE;
+    uint8_t argc = 0;
+    uint32_t output = 0;
+    Operand args[kMaxOperands];
+};
+
+/**
+ * @brief 字节码程序
+ */
+struct BytecodeProgram {
+    std::vector<Instruction> code;
+    std::vector<ValueVariant> constants;  // 预解析的字面量
+    std::vector<double> numbers;          // 字面量的数值形式（非数值为0）
+    std::shared_ptr<const ContextLayout> layout;
+
+    /**
+     * @brief 执行程序，上下文必须绑定同一布局
+     */
+    bool run(ExecutionContext& ctx) const {
+        for (const auto& ins : code) {
+            if (!ins.handler(ins, *this, ctx)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ============================================
+// 字节码编译器
+// ============================================
+
+/**
+ * @brief 将管道配置降级为字节码
+ */
+class BytecodeCompiler {
+public:
+    /**
+     * @brief 编译管道配置
+     * @param config 管道配置
+     * @param layout 上下文布局（变量槽位来源）
+     * @return 字节码程序，遇到未知算子或参数个数不符时抛出异常
+     */
+    static BytecodeProgram compile(const PipelineConfig& config,
+                                   std::shared_ptr<const ContextLayout> layout);
+
+    /**
+     * @brief 查找算子对应的操作码
+     * @return 未知算子返回Opcode::COUNT
+     */
+    static Opcode opcode_of(const std::string& op_name);
+
+    /**
+     * @brief 获取操作码的处理函数
+     */
+    static OpHandler handler_of(Opcode opcode);
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_BYTECODE_HPP
@@ -6,6 +6,7 @@
 #include <string>
 #include <sstream>
 #include <unordered_map>
+#include <set>
 #include <ctime>
 #include <iomanip>
 
@@ -15,19 +16,137 @@ namespace turbograph {
 // 代码生成选项
 // ============================================
 
+/**
+ * @brief 生成代码的格式版本，代码生成逻辑变化时递增（参与SO缓存键）
+ */
+constexpr uint32_t kCodegenVersion = 11;
+
+/**
+ * @brief 默认头文件目录
+ * 优先取环境变量TURBOGRAPH_INCLUDE_DIR，其次为构建时定义的同名宏
+ */
+std::string default_include_dir();
+
 /**
  * @brief 代码生成选项
  */
 struct CodeGenOptions {
-    bool enable_inline = true;
-    bool enable_vectorize = true;
-    bool use_fast_math = true;
-    std::string compiler_flags = "-O3 -march=native -std=c++17";
+    bool enable_inline = true;        // 关闭时以-fno-inline编译
+    bool enable_vectorize = true;     // 关闭时以-fno-tree-vectorize -fno-tree-slp-vectorize编译
+    bool use_fast_math = false;       // 求和类列表算子使用重排求和顺序的向量变体（结果与字节码不再逐位一致），按管道开启
+    std::string compiler_flags;       // 附加的编译器选项（在CompileOptions::optimization之后）
+    std::string include_root;         // 生成代码引用算子库的目录，为空时按-I搜索路径引用
+    bool minimal_includes = true;     // 仅用轻量算子且IO均为标量时只包含ops_core.hpp
+    bool optimize = true;             // 生成前做数据流优化（常量折叠、公共子表达式与无用步骤消除）
+    bool profile_steps = false;       // 插桩模式：每个步骤前后读取计时器，导出pipeline_profile_<fp>；关闭时不生成任何计时代码
     std::string output_dir = "./generated";
     bool use_cache = true;
     bool verbose = false;
 };
 
+// ============================================
+// 算子注册表
+// ============================================
+
+/**
+ * @brief 算子元数据
+ */
+struct OperatorMetadata {
+    std::string config_name;      // 配置中的名称
+    std::string function_name;    // ops.hpp中的函数名
+    DataType return_type;         // 返回类型
+    int param_count;              // 参数个数
+    bool needs_template;          // 是否需要模板参数
+    std::string default_template; // 默认模板参数
+    bool core = false;            // 是否定义在ops_core.hpp中
+    std::string fast_function_name; // use_fast_math时调用的低精度变体，为空时无变体
+};
+
+/**
+ * @brief 算子注册表
+ * 自动发现并注册所有可用的算子
+ */
+class OperatorRegistry {
+public:
+    static OperatorRegistry& instance();
+    
+    /**
+     * @brief 获取算子元数据
+     */
+    const OperatorMetadata* get_operator(const std::string& config_name) const;
+    
+    /**
+     * @brief 获取所有算子名称
+     */
+    std::vector<std::string> get_all_operator_names() const;
+    
+    /**
+     * @brief 检查算子是否存在
+     */
+    bool has_operator(const std::string& config_name) const;
+    
+private:
+    OperatorRegistry();
+    
+    void register_all_operators();
+    
+    void register_operator(const std::string& config_name, 
+                           const std::string& function_name,
+                           DataType return_type,
+                           int param_count,
+                           bool needs_template,
+                           const std::string& default_template = "");
+    
+    std::unordered_map<std::string, OperatorMetadata> operators_;
+};
+
+// ============================================
+// ABI布局
+// ============================================
+
+/**
+ * @brief ABI字段布局
+ */
+struct AbiFieldLayout {
+    std::string name;
+    DataType type;
+    size_t offset;
+    size_t size;
+};
+
+/**
+ * @brief ABI结构体布局
+ */
+struct AbiStructLayout {
+    std::vector<AbiFieldLayout> fields;
+    size_t size = 0;
+    size_t alignment = 1;
+};
+
+/**
+ * @brief 计算输入/输出结构体布局
+ * 按字段顺序排列，每个字段按自然对齐；非标量输入字段为ListView，非标量输出字段为指针
+ * @param is_input 是否为输入结构
+ */
+AbiStructLayout compute_abi_layout(const std::vector<PipelineConfig::IOField>& fields, bool is_input);
+
+/**
+ * @brief 步骤结果在生成代码中的类型
+ * Precision::DOUBLE时为注册表中算子的返回类型（未注册的算子为double）。
+ * Precision::FLOAT时取能精确表示结果的最窄类型：max/min/abs的参数均为int32
+ * （int32的输入、声明变量或整数字面量）时为int32，avg_avg_log的分段参数为字面量且
+ * 最大分桶编号在int32范围内时为int32，
+ * 其余返回double的算子为float（direct_output_double显式要求double，不变）
+ */
+DataType compute_step_type(const PipelineConfig& config, const OpCall& step);
+
+/**
+ * @brief 生成代码中每个变量的静态类型
+ * 输入和变量取声明类型；其余步骤输出取最后一个写入步骤的compute_step_type；
+ * 只出现在输出中的字段取输出类型
+ */
+std::unordered_map<std::string, DataType> compute_field_types(const PipelineConfig& config);
+
 // ============================================
 // 代码生成器
 // ============================================
@@ -46,6 +165,37 @@ public:
      */
     std::string generate();
     
+    /**
+     * @brief 将多个管道生成到同一编译单元
+     * 公共头文件只包含一次，每个管道的导出符号均带指纹后缀
+     * （pipeline_execute_<fp>、pipeline_abi_<fp>、pipeline_name_<fp>等）
+     * @param configs 管道配置，指纹需已计算且互不相同
+     */
+    static std::string generate_unit(const std::vector<PipelineConfig>& configs,
+                                     const CodeGenOptions& options = {});
+    
+    /**
+     * @brief 生成构建期静态链接的编译单元（AOT）
+     * 在generate_unit之后追加AotPipeline表与静态注册器，链接进程序后
+     * PipelineManager::create按指纹直接使用，不再编译和dlopen
+     * @param configs 管道配置，指纹需已计算且互不相同
+     */
+    static std::string generate_aot_source(const std::vector<PipelineConfig>& configs,
+                                           const CodeGenOptions& options = {});
+    
+    /**
+     * @brief 生成AOT编译单元的头文件
+     * 在turbograph::aot::<管道名>中声明直接调用生成入口的内联函数（可被调用方内联/LTO），
+     * 以及kFingerprint常量
+     */
+    static std::string generate_aot_header(const std::vector<PipelineConfig>& configs,
+                                           const std::string& guard);
+    
+    /**
+     * @brief 配置生成的代码是否导出输出掩码入口pipeline_execute_batch_masked_<fp>
+     */
+    static bool exports_masked_entry(const PipelineConfig& config) { return config.outputs.size() > 1; }
+    
     /**
      * @brief 生成并保存到文件
      * @param path 输出文件路径
@@ -63,12 +213,32 @@ private:
     CodeGenOptions options_;
     std::string code_;
     std::unordered_map<std::string, DataType> variables_;
+    std::unordered_map<std::string, DataType> locals_;   // 生成为execute_internal局部变量的中间变量
+    std::vector<std::string> lookups_;   // 批量入口预构建查找结构的请求级常量列表输入
+    std::set<std::string> views_;        // 上下文中以视图引用调用方缓冲区的列表/字符串输入（没有步骤改写）
+    std::set<std::string> arena_strings_; // 写入线程局部字符串缓冲区、以string_view保存的字符串中间变量与输出
+    std::vector<std::vector<uint64_t>> step_outputs_;  // 每个步骤被哪些输出依赖（按64位字的输出位图）
     
     /**
      * @brief 收集所有变量
      */
     void collect_variables();
     
+    /**
+     * @brief 局部变量名（加前缀，避免与ctx及生成代码中的其他名称冲突）
+     */
+    static std::string local_name(const std::string& name);
+    
+    /**
+     * @brief 变量在execute_internal中的引用（局部变量或ctx成员）
+     */
+    std::string field_ref(const std::string& name) const;
+    
+    /**
+     * @brief 输入字段在上下文中的类型（视图输入为ListView/std::string_view）
+     */
+    std::string context_type_name(const PipelineConfig::IOField& input) const;
+    
     /**
      * @brief 推断输出类型
      */
@@ -79,6 +249,28 @@ private:
      */
     void generate_header(std::ostream& oss);
     
+    /**
+     * @brief 生成公共头文件包含
+     * @param minimal 只包含ops_core.hpp及数值相关标准头文件
+     */
+    static void generate_includes(std::ostream& oss, const CodeGenOptions& options, bool minimal);
+    
+    /**
+     * @brief 是否可只包含轻量头文件（所有算子为core且变量均为标量）
+     */
+    bool uses_core_only() const;
+    
+    /**
+     * @brief 生成管道主体（命名空间内的结构、执行函数与导出函数）
+     */
+    void generate_pipeline(std::ostream& oss);
+    
+    /**
+     * @brief 生成管道信息导出函数
+     * @param unsuffixed 是否额外导出不带后缀的pipeline_name/pipeline_fingerprint
+     */
+    void generate_info_functions(std::ostream& oss, bool unsuffixed);
+    
     /**
      * @brief 生成命名空间开始
      */
@@ -94,6 +286,11 @@ private:
      */
     void generate_context_struct(std::ostream& oss);
     
+    /**
+     * @brief 生成输入输出ABI结构及布局描述符
+     */
+    void generate_abi_structs(std::ostream& oss);
+    
     /**
      * @brief 生成辅助函数
      */
@@ -134,6 +331,18 @@ private:
      */
     void generate_export_function(std::ostream& oss);
     
+    /**
+     * @brief 生成批量导出函数（列式输入，循环调用execute_internal）
+     * @param offsets 为true时生成偏移编码列入口pipeline_execute_offsets_<fp>
+     * @param masked 为true时生成按输出掩码执行的入口pipeline_execute_batch_masked_<fp>
+     */
+    void generate_batch_function(std::ostream& oss, bool offsets, bool masked = false);
+    
+    /**
+     * @brief 是否生成输出掩码入口（多于一个输出时）
+     */
+    bool has_masked_entry() const { return exports_masked_entry(config_); }
+    
     /**
      * @brief 获取当前时间字符串
      */
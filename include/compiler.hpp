@@ -8,22 +8,81 @@
 #include <unordered_map>
 #include <optional>
 #include <iostream>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <memory>
 
 namespace turbograph {
 
+class ICompilerBackend;
+class CompiledModule;
+
 // ============================================
 // 编译选项
 // ============================================
 
+/**
+ * @brief PGO阶段
+ */
+enum class ProfileMode : uint8_t {
+    NONE,
+    GENERATE,   // 插桩编译，SO卸载（dlclose）时写出计数文件
+    USE         // 按已收集的计数文件编译，缺少计数时等同普通编译
+};
+
 /**
  * @brief 编译选项
  */
 struct CompileOptions {
     std::string compiler_path = "g++";
-    std::string include_dir = ".";
+    std::string include_dir = default_include_dir();
+    std::string optimization = "-O3 -march=native";  // 优化选项，降低可缩短编译时间
     std::string extra_flags = "";
     bool verbose = false;
     bool keep_source = true;  // 是否保留源文件
+    bool use_pch = true;      // 使用预编译头（由JITCompiler按工具链和编译选项生成）
+    std::string pch_header;   // 通过-include注入的预编译头，为空时不使用（不参与缓存校验）
+    ProfileMode profile = ProfileMode::NONE;
+    std::string profile_dir;  // 计数文件目录，为空时取JITCompiler缓存目录下的profile子目录
+};
+
+// ============================================
+// 优化层级
+// ============================================
+
+/**
+ * @brief JIT优化层级
+ */
+enum class OptimizationTier : uint8_t {
+    BASELINE,    // 低优化级别，编译快，尽快可用
+    OPTIMIZED,   // CompileOptions::optimization（默认-O3 -march=native），use_fast_math时允许重排浮点运算
+    PROFILING,   // OPTIMIZED的插桩版本，执行时收集分支计数
+    PROFILED     // 按收集的计数重新编译的OPTIMIZED版本
+};
+
+/**
+ * @brief 获取优化层级名称
+ */
+const char* optimization_tier_name(OptimizationTier tier);
+
+/**
+ * @brief 按优化层级调整编译选项
+ * @param base 基础编译选项，OPTIMIZED及以上层级沿用其optimization
+ * @param baseline_optimization BASELINE层级使用的优化选项
+ */
+CompileOptions tier_compile_options(OptimizationTier tier, const CodeGenOptions& gen_options,
+                                    CompileOptions base,
+                                    const std::string& baseline_optimization = "-O1 -march=native");
+
+/**
+ * @brief 批量编译选项
+ */
+struct BatchCompileOptions {
+    size_t max_parallel = 0;        // 同时运行的编译器进程数，0表示CPU核数
+    size_t pipelines_per_unit = 1;  // 每个编译单元（SO）包含的管道数，大于1时合并编译
+    bool skip_cached = true;        // 跳过已有有效缓存的管道
 };
 
 // ============================================
@@ -80,6 +139,21 @@ public:
      */
     static long long file_size(const std::string& path);
     
+    /**
+     * @brief 获取文件修改时间（纳秒），文件不存在返回-1
+     */
+    static long long file_mtime(const std::string& path);
+    
+    /**
+     * @brief 构建编译选项（不含输入输出路径），参与缓存校验
+     */
+    static std::string build_flags(const CompileOptions& options);
+    
+    /**
+     * @brief 获取编译器版本（--version首行），结果按编译器路径缓存
+     */
+    static std::string compiler_version(const std::string& compiler_path);
+    
     /**
      * @brief 读取文件
      */
@@ -91,44 +165,106 @@ public:
     static bool write_file(const std::string& path, const std::string& content);
     
     /**
-     * @brief 创建目录
+     * @brief 写入文件（先写同目录下的临时文件再重命名，读者只会看到旧文件或完整的新文件）
+     */
+    static bool write_file_atomic(const std::string& path, const std::string& content);
+    
+    /**
+     * @brief 同目录下的临时文件名（按进程号和进程内序号区分，用于写完后重命名到path）
+     */
+    static std::string temp_path(const std::string& path);
+    
+    /**
+     * @brief 创建目录及缺失的上级目录（不经shell），目录已存在时返回true
      */
     static bool create_directory(const std::string& path);
 };
 
+// ============================================
+// 跨进程文件锁
+// ============================================
+
+/**
+ * @brief 基于flock的排他锁（RAII）
+ * 锁文件不存在时创建，析构时释放。锁属于打开的文件描述，同一进程的不同线程
+ * 各自构造时同样互斥；持锁进程退出时内核自动释放，不会遗留死锁。
+ * 锁文件不删除：删除后新打开的进程会锁住另一个inode，失去互斥
+ */
+class FileLock {
+public:
+    explicit FileLock(const std::string& path);
+    ~FileLock();
+    
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+    
+    /**
+     * @brief 是否持有锁（打开或加锁失败时为false，调用方按未协调继续）
+     */
+    bool locked() const { return fd_ >= 0; }
+    
+private:
+    int fd_ = -1;
+};
+
 // ============================================
 // 编译缓存
 // ============================================
 
+/**
+ * @brief 构建环境标识
+ * 编译器版本、编译选项或算子头文件任一变化时，已缓存的SO都不可复用
+ */
+struct BuildIdentity {
+    std::string compiler_version;  // 编译器 --version 首行
+    std::string flags;             // 除输入输出路径外的全部编译选项
+    std::string ops_hash;          // 算子库头文件（ops.hpp、ops_core.hpp、abi.hpp）内容哈希
+    long long ops_mtime = 0;       // 算子库头文件最新修改时间（纳秒）
+};
+
 /**
  * @brief 编译缓存条目
  */
 struct CacheEntry {
-    std::string fingerprint;
+    std::string key;           // 缓存键（配置指纹 + 构建环境），SO按此命名
+    std::string fingerprint;   // 配置指纹
     std::string source_path;
     std::string so_path;
     std::chrono::steady_clock::time_point compile_time;
+    
+    BuildIdentity build;
+    long long so_mtime = 0;    // 记录时SO的修改时间（纳秒）
+    long long so_size = 0;     // 记录时SO的大小
+    long long last_used = 0;   // 最近一次命中（Unix时间，秒），用于LRU淘汰
 };
 
 /**
  * @brief 编译缓存
+ * 后台编译线程与执行线程会并发访问，所有操作内部加锁。
+ * 索引可持久化为缓存目录下的清单文件，进程重启后无需重新编译
  */
 class CompilationCache {
 public:
     /**
      * @brief 检查缓存是否有效
+     * SO需存在且未被改动（修改时间、大小与记录一致），且不早于源文件
+     */
+    bool is_valid(const std::string& key) const;
+    
+    /**
+     * @brief 检查缓存是否有效且与当前构建环境一致
      */
-    bool is_valid(const std::string& fingerprint) const;
+    bool is_valid(const std::string& key, const BuildIdentity& build) const;
     
     /**
      * @brief 添加缓存
      */
-    void add(const std::string& fingerprint, const CacheEntry& entry);
+    void add(const std::string& key, const CacheEntry& entry);
     
     /**
      * @brief 移除缓存
      */
-    void remove(const std::string& fingerprint);
+    void remove(const std::string& key);
     
     /**
      * @brief 清空缓存
@@ -138,14 +274,50 @@ public:
     /**
      * @brief 获取缓存
      */
-    std::optional<CacheEntry> get(const std::string& fingerprint) const;
+    std::optional<CacheEntry> get(const std::string& key) const;
+    
+    /**
+     * @brief 记录一次命中
+     */
+    void touch(const std::string& key, long long now);
     
     /**
      * @brief 获取缓存大小
      */
     size_t size() const;
     
+    /**
+     * @brief 缓存SO的总字节数（共享的SO只计一次）
+     */
+    long long total_bytes() const;
+    
+    /**
+     * @brief 是否仍有条目引用该SO
+     */
+    bool references(const std::string& so_path) const;
+    
+    /**
+     * @brief 按最近最少使用淘汰，直到条目数和总字节数都不超过上限
+     * @param max_entries 条目上限，0表示不限
+     * @param max_bytes 字节上限，0表示不限
+     * @return 被淘汰的条目（文件由调用方删除）
+     */
+    std::vector<CacheEntry> evict(size_t max_entries, long long max_bytes);
+    
+    /**
+     * @brief 从清单文件加载，丢弃SO已不存在的条目
+     * 内存中已有且仍有效的键保留内存中的条目，可用于合并其他进程写入的清单
+     * @return 清单不存在或无法解析时返回false
+     */
+    bool load(const std::string& manifest_path);
+    
+    /**
+     * @brief 写入清单文件（先写临时文件再重命名）
+     */
+    bool save(const std::string& manifest_path) const;
+    
 private:
+    mutable std::mutex mutex_;
     std::unordered_map<std::string, CacheEntry> cache_;
 };
 
@@ -166,39 +338,202 @@ public:
      * @param config 管道配置
      * @param gen_options 代码生成选项
      * @param comp_options 编译选项
+     * @param rebuild 强制重新编译，共享缓存模式下也不复用磁盘上已有的SO
      * @return 是否成功
      */
     bool compile(const PipelineConfig& config,
                 const CodeGenOptions& gen_options = {},
-                const CompileOptions& comp_options = {});
+                const CompileOptions& comp_options = {},
+                bool rebuild = false);
+    
+    /**
+     * @brief 批量编译管道配置
+     * 以有界并发运行多个编译器进程；pipelines_per_unit大于1时将多个管道
+     * 生成到同一编译单元，公共头文件只解析一次，加载时共享同一SO句柄
+     * @return 与configs一一对应的编译结果
+     */
+    std::vector<bool> compile_many(const std::vector<PipelineConfig>& configs,
+                                   const CodeGenOptions& gen_options = {},
+                                   const CompileOptions& comp_options = {},
+                                   const BatchCompileOptions& batch_options = {});
+    
+    /**
+     * @brief 编译（或命中缓存）并加载管道
+     * 优先使用set_backend设置的后端；后端不支持该配置或编译失败时退回g++后端
+     * @param rebuild 忽略已有缓存，强制重新编译
+     * @return 失败返回nullptr
+     */
+    std::unique_ptr<CompiledModule> load(const PipelineConfig& config,
+                                         const CodeGenOptions& gen_options = {},
+                                         const CompileOptions& comp_options = {},
+                                         bool rebuild = false);
+    
+    /**
+     * @brief 设置编译后端，为空时恢复为g++后端
+     */
+    void set_backend(std::shared_ptr<ICompilerBackend> backend);
+    
+    /**
+     * @brief 当前编译后端
+     */
+    std::shared_ptr<ICompilerBackend> backend() const;
     
     /**
      * @brief 获取SO路径
+     * 缓存条目的构建环境需与选项一致，命中时更新LRU时间
+     */
+    std::optional<std::string> get_so_path(const std::string& fingerprint,
+                                           const CompileOptions& comp_options = {},
+                                           const CodeGenOptions& gen_options = {});
+    
+    /**
+     * @brief 计算当前构建环境标识
+     */
+    BuildIdentity current_build(const CompileOptions& options);
+    
+    /**
+     * @brief 合并代码生成选项中的编译器选项，得到实际使用的编译选项
+     * compiler_flags附加在optimization之后，enable_inline/enable_vectorize关闭时附加对应的-fno-*，
+     * 并补全PGO计数目录。compile/compile_many/get_so_path内部调用，cache_key需传入合并后的选项
      */
-    std::optional<std::string> get_so_path(const std::string& fingerprint) const;
+    CompileOptions resolve_options(const CodeGenOptions& gen_options,
+                                   const CompileOptions& comp_options) const;
     
     /**
-     * @brief 设置缓存目录
+     * @brief 计算缓存键
+     * 覆盖配置指纹、影响生成代码的选项、代码生成与ABI版本、编译器版本、
+     * 编译选项和ops.hpp内容，任一不同都会得到不同的SO，可安全跨主机共享缓存目录；
+     * 按计数编译（ProfileMode::USE）时还覆盖该管道的计数文件内容
+     */
+    std::string cache_key(const std::string& fingerprint,
+                          const CodeGenOptions& gen_options,
+                          const CompileOptions& comp_options);
+    
+    /**
+     * @brief 设置缓存目录（重新加载该目录下的清单）
      */
     void set_cache_dir(const std::string& dir);
     
+    /**
+     * @brief 获取（必要时生成）与编译选项匹配的预编译头
+     * 每个工具链+编译选项+算子库版本只生成一次，位于缓存目录的pch/子目录
+     * @return 预编译头路径，未启用或生成失败时返回空字符串
+     */
+    std::string ensure_pch(const CompileOptions& options);
+    
+    /**
+     * @brief 设置缓存上限，超过时按LRU淘汰SO
+     * @param max_entries 条目上限，0表示不限
+     * @param max_bytes 字节上限，0表示不限
+     */
+    void set_cache_limits(size_t max_entries, long long max_bytes);
+    
     /**
      * @brief 清除缓存
      */
     void clear_cache();
     
+    /**
+     * @brief 将内存中的缓存索引写入清单
+     */
+    bool flush();
+    
     /**
      * @brief 获取缓存目录
      */
     const std::string& cache_dir() const { return cache_dir_; }
     
+    /**
+     * @brief 获取缓存索引
+     */
+    const CompilationCache& cache() const { return cache_; }
+    
+    /**
+     * @brief 清单文件路径
+     */
+    std::string manifest_path() const;
+    
+    /**
+     * @brief 设置多进程共享缓存模式（默认取环境变量TURBOGRAPH_SHARED_CACHE，非0时开启）
+     * 同一主机上的多个进程使用同一缓存目录时开启：每个SO编译前持有locks/下按SO命名的文件锁，
+     * 持锁后SO已存在（其他进程已生成，不论清单是否已登记）时直接登记复用，不再编译；预编译头同样只生成一次；
+     * 写清单时持有清单锁并先合并磁盘上其他进程登记的条目；查找未命中且清单被其他进程更新过时
+     * 重新合并清单。未开启时不加锁，SO与源文件同样先写临时文件再重命名
+     */
+    void set_shared_cache(bool enabled) { shared_cache_ = enabled; }
+    
+    /**
+     * @brief 是否为多进程共享缓存模式
+     */
+    bool shared_cache() const { return shared_cache_; }
+    
+    /**
+     * @brief 共享缓存模式下持锁后直接复用已有SO（不再编译）的次数
+     */
+    uint64_t adopted_builds() const { return adopted_builds_; }
+    
 private:
-    JITCompiler() = default;
+    JITCompiler();
+    ~JITCompiler();
     
-    std::string get_cache_path(const std::string& fingerprint) const;
+    std::string get_cache_path(const std::string& key) const;
+    
+    /**
+     * @brief 文件对应的跨进程锁文件（缓存目录下locks/子目录，按文件名命名）
+     */
+    std::string lock_path(const std::string& path) const;
+    
+    /**
+     * @brief 清单被其他进程更新过时合并到内存索引（共享缓存模式）
+     */
+    void refresh_shared();
+    
+    /**
+     * @brief 写入源文件、编译并登记缓存条目
+     * @param members 编译单元包含的（指纹, 缓存键）
+     * @param rebuild 不复用持锁后已存在的SO
+     */
+    bool build_and_register(const std::string& code, const std::string& so_path,
+                            const std::vector<std::pair<std::string, std::string>>& members,
+                            const CodeGenOptions& gen_options,
+                            const CompileOptions& comp_options,
+                            bool rebuild = false);
+    
+    /**
+     * @brief 首次使用时从清单加载缓存索引
+     */
+    void ensure_loaded();
+    
+    /**
+     * @brief 按上限淘汰并删除文件
+     */
+    void evict_and_save();
     
     std::string cache_dir_ = "./generated";
+    
+    std::shared_ptr<ICompilerBackend> gcc_backend_;
+    std::shared_ptr<ICompilerBackend> backend_;
+    mutable std::mutex backend_mutex_;
     CompilationCache cache_;
+    
+    size_t max_entries_ = 1024;
+    long long max_bytes_ = 512LL * 1024 * 1024;
+    
+    std::mutex manifest_mutex_;
+    bool manifest_loaded_ = false;
+    std::atomic<bool> dirty_{false};
+    
+    std::atomic<bool> shared_cache_{false};
+    std::atomic<long long> manifest_mtime_{-1};  // 最近一次合并或写入时清单的修改时间
+    std::atomic<uint64_t> adopted_builds_{0};
+    
+    // 算子库哈希按目录缓存，修改时间不变时不重新读取
+    std::mutex ops_mutex_;
+    std::unordered_map<std::string, std::pair<long long, std::string>> ops_hashes_;
+    
+    // 预编译头按构建标识缓存（生成失败记为空字符串，不再重试）
+    std::mutex pch_mutex_;
+    std::unordered_map<std::string, std::string> pch_headers_;
 };
 
 } // namespace turbograph
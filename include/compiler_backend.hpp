@@ -0,0 +1,94 @@
+#ifndef TURBOGRAPH_COMPILER_BACKEND_HPP
+#define TURBOGRAPH_COMPILER_BACKEND_HPP
+
+#include "compiler.hpp"
+#include <memory>
+#include <string>
+
+namespace turbograph {
+
+// ============================================
+// 编译后端接口
+// ============================================
+
+/**
+ * @brief 已加载的管道模块
+ * 持有可执行代码（SO句柄或进程内JIT内存），析构时释放，
+ * 通过symbol()取得的地址在模块存活期间有效
+ */
+class CompiledModule {
+public:
+    virtual ~CompiledModule() = default;
+
+    /**
+     * @brief 查找导出符号（pipeline_execute_<fp>、pipeline_abi_<fp>等）
+     * @return 符号地址，不存在时返回nullptr
+     */
+    virtual void* symbol(const std::string& name) const = 0;
+
+    /**
+     * @brief 产生本模块的后端名称
+     */
+    virtual const char* backend() const = 0;
+};
+
+/**
+ * @brief 编译后端
+ * 将管道配置编译为可执行模块。导出符号与生成的C++代码一致，
+ * 执行器不区分模块来自哪个后端
+ */
+class ICompilerBackend {
+public:
+    virtual ~ICompilerBackend() = default;
+
+    /**
+     * @brief 后端名称
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief 是否能编译该配置（不支持时JITCompiler退回g++后端）
+     */
+    virtual bool supports(const PipelineConfig& config) const = 0;
+
+    /**
+     * @brief 编译并加载
+     * @param rebuild 忽略已有缓存，强制重新编译
+     * @return 失败返回nullptr
+     */
+    virtual std::unique_ptr<CompiledModule> load(const PipelineConfig& config,
+                                                 const CodeGenOptions& gen_options,
+                                                 const CompileOptions& comp_options,
+                                                 bool rebuild) = 0;
+};
+
+/**
+ * @brief g++后端
+ * 生成C++源文件，调用系统编译器输出SO（经JITCompiler的持久化缓存），再dlopen加载
+ */
+class GccBackend : public ICompilerBackend {
+public:
+    const char* name() const override { return "gcc"; }
+    bool supports(const PipelineConfig& /*config*/) const override { return true; }
+    std::unique_ptr<CompiledModule> load(const PipelineConfig& config,
+                                         const CodeGenOptions& gen_options,
+                                         const CompileOptions& comp_options,
+                                         bool rebuild) override;
+};
+
+/**
+ * @brief 进程内后端是否可用（构建时启用TURBOGRAPH_WITH_LLVM）
+ */
+bool inprocess_backend_available();
+
+/**
+ * @brief 创建进程内后端
+ * 将配置降级为LLVM IR，经ORC JIT直接编译到可执行内存，
+ * 不写临时文件、不启动子进程。支持IO均为标量且只使用数值算子的管道
+ * @return 构建时未启用LLVM时返回nullptr
+ */
+std::shared_ptr<ICompilerBackend> make_inprocess_backend();
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_COMPILER_BACKEND_HPP
@@ -7,6 +7,8 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <istream>
+#include <string_view>
 
 namespace turbograph {
 
@@ -43,18 +45,44 @@ public:
     virtual bool validate(const PipelineConfig& config) = 0;
 };
 
+/**
+ * @brief 批量加载结果
+ */
+struct BulkParseResult {
+    size_t accepted = 0;   // 通过校验并交给回调的配置数
+    size_t rejected = 0;   // 未通过validate的配置数
+};
+
 /**
  * @brief JSON配置解析器实现
  */
 class JsonConfigParser : public IConfigParser {
 public:
+    using ConfigCallback = std::function<void(PipelineConfig&& config)>;
+    
     JsonConfigParser() = default;
     
     PipelineConfig parse(const std::string& config_path) override;
     PipelineConfig parse_string(const std::string& json_str) override;
     bool validate(const PipelineConfig& config) override;
     
+    /**
+     * @brief 流式解析管道配置数组
+     * 以SAX方式读取顶层数组，不构建DOM，内存占用与单个配置的大小相当；
+     * 每个配置解析完成后计算指纹、校验，通过时立即交给on_config，未通过时跳过。
+     * 字段语义与parse_string一致（参数中嵌套的数组/对象不支持）
+     * @throws std::runtime_error JSON格式错误、顶层不是数组或字段类型不符
+     */
+    BulkParseResult parse_bulk(std::istream& input, const ConfigCallback& on_config);
+    
+    /**
+     * @brief 流式解析配置数组文件
+     */
+    BulkParseResult parse_bulk_file(const std::string& path, const ConfigCallback& on_config);
+    
 private:
+    friend class ConfigSaxHandler;
+    
     /**
      * @brief 解析IO字段数组
      */
@@ -106,6 +134,76 @@ public:
      * @return 是否成功
      */
     static bool save_to_file(const PipelineConfig& config, const std::string& path);
+    
+    /**
+     * @brief 生成二进制配置文件内容（格式见MappedConfigFile），指纹为空的配置先计算指纹
+     */
+    static std::string generate_binary(const std::vector<PipelineConfig>& configs);
+    
+    /**
+     * @brief 保存二进制配置文件
+     * @return 是否成功
+     */
+    static bool save_binary(const std::vector<PipelineConfig>& configs, const std::string& path);
+};
+
+// ============================================
+// 二进制配置文件
+// ============================================
+
+/**
+ * @brief 二进制配置格式版本，布局变化时递增
+ */
+constexpr uint32_t kBinaryConfigVersion = 2;
+
+/**
+ * @brief 只读映射的二进制配置文件
+ *
+ * 布局（主机字节序）：
+ *   头部   magic "TGPC" | u32 格式版本 | u32 指纹序列化版本 | u32 字节序标记 | u64 配置数 | u64 文件长度
+ *   偏移表 每个配置一个u64，为其记录在文件中的偏移
+ *   记录   str名称 | str指纹 | u8精度 | 缓存策略 | 输入/变量/输出字段表 | 步骤表
+ *          缓存策略：u32键个数，每项 str输入名 | u64 ttl_ms | u64容量
+ *          字段表：u32个数，每项 str名称 | u8类型 | u8标志(required|broadcast<<1)
+ *          步骤表：u32个数，每项 str算子 | str输出 | u32参数个数，每项 u8参数类型 | u8数据类型 | str取值
+ *                  | u32选项个数，每项 str键 | str值
+ *   str为u32长度加字节（无结尾'\0'）
+ * 字面量的数据类型在写入时已确定，读取时不再识别数字；名称与指纹可直接以string_view读取，不解码记录。
+ * 文件由ConfigGenerator::generate_binary生成，映射期间不应被修改（替换文件请写入新文件后rename）
+ */
+class MappedConfigFile {
+public:
+    /**
+     * @throws std::runtime_error 文件无法打开、不是二进制配置文件、版本不符或已截断
+     */
+    explicit MappedConfigFile(const std::string& path);
+    ~MappedConfigFile();
+    
+    MappedConfigFile(const MappedConfigFile&) = delete;
+    MappedConfigFile& operator=(const MappedConfigFile&) = delete;
+    
+    size_t size() const { return count_; }
+    
+    std::string_view name(size_t index) const;
+    
+    /**
+     * @brief 写入时的配置指纹；指纹序列化版本与kConfigHashVersion不同时为空
+     */
+    std::string_view fingerprint(size_t index) const;
+    
+    /**
+     * @brief 解码第index个配置；指纹过期时重新计算
+     * @throws std::runtime_error 记录越界
+     */
+    PipelineConfig config(size_t index) const;
+    
+private:
+    const unsigned char* data_ = nullptr;
+    size_t length_ = 0;
+    size_t count_ = 0;
+    bool fingerprints_valid_ = false;
+    
+    size_t record_offset(size_t index) const;
 };
 
 // ============================================
@@ -148,6 +246,19 @@ private:
     std::unordered_map<std::string, Creator> registry_;
 };
 
+// ============================================
+// 缓存策略校验
+// ============================================
+
+/**
+ * @brief 校验配置的缓存策略
+ * 缓存键需为不重复的输入，输出需为数值标量（int32/int64/double/float）。
+ * 不检查输出是否只依赖键中的输入：其余输入视为由键决定（如商品ID决定的商品侧属性），
+ * 由配置方保证，否则键相同的行会得到先写入缓存的结果
+ * @throws std::runtime_error 策略不满足上述条件
+ */
+void validate_cache_policy(const PipelineConfig& config);
+
 // ============================================
 // 宏辅助
 // ============================================
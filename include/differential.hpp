@@ -0,0 +1,143 @@
+#ifndef TURBOGRAPH_DIFFERENTIAL_HPP
+#define TURBOGRAPH_DIFFERENTIAL_HPP
+
+#include "code_generator.hpp"
+#include "config.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 差分测试
+// ============================================
+
+/**
+ * @brief 差分测试中被比较的执行方式
+ */
+enum class DifferentialMode : uint8_t {
+    INTERPRETER,   // InterpreterExecutor逐行执行（参考结果）
+    BYTECODE,      // BytecodeExecutor逐行执行
+    JIT_ROW,       // JITExecutor经ExecutionContext逐行执行
+    JIT_BATCH,     // JITExecutor::execute_batch
+    SCHEDULER      // BatchScheduler多线程调用JIT批量入口
+};
+
+constexpr size_t kDifferentialModes = 5;
+
+/**
+ * @brief 获取执行方式名称
+ */
+const char* differential_mode_name(DifferentialMode mode);
+
+/**
+ * @brief 差分测试选项
+ */
+struct DifferentialOptions {
+    uint64_t seed = 1;              // 随机种子，相同种子生成相同的配置与输入
+    size_t num_configs = 16;        // 随机配置数
+    size_t max_steps = 8;           // 每个配置的步骤数上限
+    size_t rows = 512;              // 每个配置的输入行数
+    size_t max_list_size = 16;      // 列表输入的长度上限
+    size_t iterations = 3;          // 计时重复次数（每次执行全部行，只比较第一次的结果）
+    size_t num_threads = 4;         // 调度器工作线程数
+    size_t min_chunk_rows = 64;     // 调度器每块最少行数（较小时少量行也会切成多块并行）
+    double tolerance = 1e-9;        // 浮点输出允许的误差（相对量级，量级小于1时为绝对误差）
+    size_t max_reported = 32;       // 报告中保留的不一致明细条数
+    CodeGenOptions gen_options = [] {
+        CodeGenOptions options;
+        options.use_fast_math = false;   // 求和顺序与参考实现一致，结果逐位可比
+        return options;
+    }();
+};
+
+/**
+ * @brief 一种执行方式的吞吐与延迟
+ * 逐行方式的一次调用为一行，批量方式为一个批次（DifferentialOptions::rows行）
+ */
+struct DifferentialTiming {
+    DifferentialMode mode = DifferentialMode::INTERPRETER;
+    uint64_t rows = 0;
+    uint64_t calls = 0;
+    uint64_t total_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t mismatches = 0;     // 与参考结果不一致的值（执行失败计为一个）
+    uint64_t failures = 0;       // 执行失败的配置数
+
+    double rows_per_sec() const {
+        return total_ns ? static_cast<double>(rows) * 1e9 / static_cast<double>(total_ns) : 0.0;
+    }
+};
+
+/**
+ * @brief 一处与参考结果的不一致
+ */
+struct DifferentialMismatch {
+    std::string config;          // 配置名
+    DifferentialMode mode = DifferentialMode::INTERPRETER;
+    size_t row = 0;              // 行号，执行失败时为npos
+    std::string output;          // 输出字段
+    std::string expected;        // 解释执行的结果
+    std::string actual;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+};
+
+/**
+ * @brief 差分测试报告
+ */
+struct DifferentialReport {
+    uint64_t seed = 0;
+    size_t configs = 0;
+    size_t rows = 0;                                   // 每个配置的行数
+    std::vector<DifferentialTiming> modes;             // 按DifferentialMode顺序
+    std::vector<DifferentialMismatch> mismatches;      // 前max_reported条明细
+    uint64_t total_mismatches = 0;
+    std::map<std::string, size_t> operator_coverage;   // 注册表中每个算子出现的步骤数
+    std::vector<PipelineConfig> failing_configs;       // 出现不一致的配置（可直接复现）
+
+    bool ok() const { return total_mismatches == 0; }
+
+    /**
+     * @brief 注册表中未被任何配置覆盖的算子
+     */
+    std::vector<std::string> uncovered_operators() const;
+
+    /**
+     * @brief 输出覆盖情况、各执行方式的吞吐与p50/p99延迟，以及不一致明细
+     */
+    void print(std::ostream& os) const;
+};
+
+/**
+ * @brief 生成随机配置
+ * 输入为固定的一组字段，覆盖全部标量、字符串、列表类型及一个请求级常量列表；
+ * 步骤的算子按打乱的顺序轮流取自OperatorRegistry（configs * max_steps不小于算子数时覆盖全部算子），
+ * 参数从已有的输入、步骤结果与字面量中按算子的类型约束随机选取：
+ * 按参数推导类型的多参数算子（price_diff、percent、if_else的两个分支）参数类型相同，
+ * 列表交叉的查找值与列表元素类型匹配，转换为int32/int64的算子只取值域不会溢出的变量。
+ * 每个步骤的结果都作为输出
+ */
+std::vector<PipelineConfig> generate_differential_configs(const DifferentialOptions& options);
+
+/**
+ * @brief 以各执行方式运行配置并与解释执行的结果比较
+ * 输入按配置的输入字段随机生成（种子取自options.seed）
+ */
+DifferentialReport run_differential(const std::vector<PipelineConfig>& configs,
+                                    const DifferentialOptions& options = {});
+
+/**
+ * @brief 生成随机配置并运行差分测试
+ */
+DifferentialReport run_differential(const DifferentialOptions& options = {});
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_DIFFERENTIAL_HPP
@@ -0,0 +1,124 @@
+#ifndef TURBOGRAPH_EPOCH_HPP
+#define TURBOGRAPH_EPOCH_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 基于纪元的延迟回收（RCU）
+// ============================================
+
+/**
+ * @brief 纪元回收域
+ * 读者进入临界区时在一个槽位中登记当前纪元，之后以一次原子读取获得发布的指针；
+ * 写者原子地替换指针后将旧对象retire，旧对象在所有可能读到它的读者离开后才释放
+ * （如dlclose旧版本SO）。读者路径无锁、不修改共享计数
+ */
+class EpochDomain {
+public:
+    static constexpr size_t kSlots = 128;   // 同时处于临界区的读者上限，超出时等待空闲槽位
+
+    /**
+     * @brief 全局回收域（管道注册表与JIT执行器共用）
+     */
+    static EpochDomain& instance();
+
+    EpochDomain();
+
+    /**
+     * @brief 退出时仍未回收的对象不再释放，避免在其他单例析构后执行dlclose
+     */
+    ~EpochDomain() = default;
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief 读者临界区，析构时离开；临界区内读到的指针在离开前一直有效
+     */
+    class Guard {
+    public:
+        Guard() = default;
+        explicit Guard(EpochDomain& domain);
+        ~Guard() { release(); }
+
+        Guard(Guard&& other) noexcept : slot_(other.slot_) { other.slot_ = nullptr; }
+        Guard& operator=(Guard&& other) noexcept {
+            if (this != &other) {
+                release();
+                slot_ = other.slot_;
+                other.slot_ = nullptr;
+            }
+            return *this;
+        }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        void release() {
+            if (slot_) {
+                slot_->store(0, std::memory_order_release);
+                slot_ = nullptr;
+            }
+        }
+
+        std::atomic<uint64_t>* slot_ = nullptr;
+    };
+
+    /**
+     * @brief 进入读者临界区
+     */
+    Guard enter() { return Guard(*this); }
+
+    /**
+     * @brief 延迟释放已从所有发布位置摘下的对象
+     * 调用方需先完成指针替换；deleter在当前所有读者离开后执行
+     */
+    void retire(std::function<void()> deleter);
+
+    /**
+     * @brief 执行已满足条件的deleter，不等待读者
+     * @return 仍在等待的对象数
+     */
+    size_t reclaim();
+
+    /**
+     * @brief 等待到此前retire的对象全部释放，不能在读者临界区内调用
+     */
+    void synchronize();
+
+    /**
+     * @brief 等待释放的对象数
+     */
+    size_t pending() const;
+
+private:
+    /**
+     * @brief 独占缓存行的读者槽位：0表示空闲，否则为读者进入时的纪元
+     */
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{0};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        std::function<void()> deleter;
+    };
+
+    std::atomic<uint64_t>* acquire_slot();
+
+    std::atomic<uint64_t> epoch_{1};
+    Slot slots_[kSlots];
+
+    mutable std::mutex mutex_;
+    std::vector<Retired> retired_;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_EPOCH_HPP
@@ -0,0 +1,68 @@
+#ifndef TURBOGRAPH_HASH_HPP
+#define TURBOGRAPH_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace turbograph {
+
+// ============================================
+// 稳定内容哈希
+// ============================================
+
+/**
+ * @brief 128位哈希值
+ */
+struct Hash128 {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    /**
+     * @brief 32位十六进制表示（高位在前）
+     */
+    std::string hex() const;
+
+    bool operator==(const Hash128& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief MurmurHash3 x64_128
+ * 结果与平台字节序、编译器和进程无关，可用于跨主机共享的缓存键
+ */
+Hash128 murmur3_128(const void* data, size_t len, uint64_t seed = 0);
+
+/**
+ * @brief 规范化序列化后求哈希
+ * 每个字段带类型标记和长度前缀写入，字段边界不会因拼接产生歧义
+ * （例如 "ab"+"c" 与 "a"+"bc" 的结果不同）
+ */
+class HashBuilder {
+public:
+    HashBuilder& add(std::string_view value);
+    HashBuilder& add(const char* value) { return add(std::string_view(value)); }
+    HashBuilder& add(const std::string& value) { return add(std::string_view(value)); }
+    HashBuilder& add(uint64_t value);
+    HashBuilder& add(bool value) { return add(static_cast<uint64_t>(value ? 1 : 0)); }
+
+    /**
+     * @brief 计算哈希
+     */
+    Hash128 finish() const;
+
+    /**
+     * @brief 规范化后的字节序列（调试用）
+     */
+    const std::string& bytes() const { return buffer_; }
+
+private:
+    void append_u64(uint64_t value);
+
+    std::string buffer_;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_HASH_HPP
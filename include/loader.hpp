@@ -3,6 +3,7 @@
 
 #include "compiler.hpp"
 #include <string>
+#include <mutex>
 #include <memory>
 #include <functional>
 #include <unordered_map>
@@ -100,7 +101,7 @@ public:
     bool load(const std::string& fingerprint, const std::string& so_path);
     
     /**
-     * @brief 卸载管道
+     * @brief 卸载管道（SO经回收域延迟关闭）
      */
     void unload(const std::string& fingerprint);
     
@@ -147,7 +148,8 @@ private:
 
 /**
  * @brief 加载管理器
- * 单例模式，管理全局管道加载
+ * 单例模式，管理全局管道加载。各方法可并发调用；
+ * 卸载与execute并发时，SO在正在执行的调用返回后才关闭
  */
 class LoadManager {
 public:
@@ -197,6 +199,12 @@ public:
 private:
     LoadManager() = default;
     
+    /**
+     * @brief 加载管道（调用方已持有mutex_）
+     */
+    bool load_pipeline_locked(const PipelineConfig& config);
+    
+    mutable std::mutex mutex_;
     PipelineLoader loader_;
     std::string cache_dir_ = "./generated";
     std::string include_dir_ = ".";
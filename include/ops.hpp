@@ -1,6 +1,9 @@
 #ifndef TURBOGRAPH_OPS_HPP
 #define TURBOGRAPH_OPS_HPP
 
+#include "ops_core.hpp"
+#include "simd.hpp"
+#include "abi.hpp"
 #include <cmath>
 #include <string>
 #include <sstream>
@@ -8,141 +11,196 @@
 #include <algorithm>
 #include <cstdint>
 #include <type_traits>
+#include <limits>
+#include <cstring>
+#include <string_view>
+#include <charconv>
+#include <iterator>
+#include <memory>
 
 namespace turbograph::ops {
 
-// ============================================
-// 基础数学算子
-// ============================================
+namespace detail {
 
 /**
- * @brief 获取数值的符号
- * @tparam T 支持数值类型
- * @param value 输入值
- * @return -1, 0, 或 1
+ * @brief 是否为连续存储的列表（std::vector或输入视图ListView）
  */
-template<typename T>
-inline int get_sign(T value) {
-    if (value < 0) return -1;
-    if (value > 0) return 1;
-    return 0;
-}
+template<typename LIST_TYPE>
+inline constexpr bool kContiguous =
+    std::is_same_v<LIST_TYPE, std::vector<typename LIST_TYPE::value_type>> ||
+    std::is_same_v<LIST_TYPE, ListView<typename LIST_TYPE::value_type>>;
 
 /**
- * @brief 计算价格差值
- * @tparam T 支持数值类型
- * @param discount_price 折扣价格
- * @param dprice_ori 原始价格
- * @return 差价
+ * @brief 列表查找能否使用向量内核
+ * 要求连续存储的int32/int64/double列表；整数列表只接受有符号整数查找值
+ * （浮点查找值与无符号类型的比较语义无法转换为同类型比较，走逐元素比较）
  */
-template<typename T>
-inline T price_diff(T discount_price, T dprice_ori) {
-    if (discount_price == 0) return 0;
-    return discount_price - dprice_ori;
-}
-
-// ============================================
-// 对数分段算子（用于数据分桶）
-// ============================================
+template<typename LIST_TYPE, typename ITEM_TYPE>
+inline constexpr bool kSimdSearchable = [] {
+    using E = typename LIST_TYPE::value_type;
+    if constexpr (!kContiguous<LIST_TYPE> || !simd::is_supported_v<E> ||
+                  !std::is_arithmetic_v<ITEM_TYPE>) {
+        return false;
+    } else if constexpr (std::is_floating_point_v<E>) {
+        return true;
+    } else {
+        return std::is_integral_v<ITEM_TYPE> && std::is_signed_v<ITEM_TYPE>;
+    }
+}();
 
 /**
- * @brief 对数分段映射算子
- * @tparam T 支持数值类型
- * @param origin 原始值
- * @param inter1 第一区间的间隔
- * @param threshold1 第一区间的阈值
- * @param inter2 第二区间的间隔
- * @param threshold2 第二区间的阈值
- * @return 分段映射结果
+ * @brief 将查找值转换为列表元素类型，转换后的同类型比较与list[i] == item一致
+ * @return false表示查找值超出元素类型范围，不可能与任何元素相等
  */
-template<typename T>
-inline int64_t avg_avg_log(T origin, 
-                           int32_t inter1 = 1000, 
-                           int32_t threshold1 = 15000,
-                           int32_t inter2 = 5000, 
-                           int32_t threshold2 = 250000) {
-    if (origin == 0) return 0;
-    int64_t ori_abs = static_cast<int64_t>(std::abs(origin));
-    int64_t res;
-
-    if (ori_abs <= threshold1) {
-        res = ori_abs / inter1 + 1;
-        return origin >= 0 ? res : -res;
+template<typename E, typename ITEM_TYPE>
+inline bool search_key(ITEM_TYPE item, E& key) {
+    if constexpr (std::is_floating_point_v<E>) {
+        key = static_cast<E>(item);
+        return true;
+    } else {
+        if (item < std::numeric_limits<E>::min() || item > std::numeric_limits<E>::max()) {
+            return false;
+        }
+        key = static_cast<E>(item);
+        return true;
     }
+}
 
-    int64_t start;
-    if (ori_abs <= threshold2) {
-        start = threshold1 / inter1 + 1;
-        res = start + (ori_abs - threshold1) / inter2 + 1;
-        return origin >= 0 ? res : -res;
-    }
+/**
+ * @brief 是否按数值格式化（std::ostream将bool与字符类型按字符输出）
+ */
+template<typename T>
+inline constexpr bool kFormatsAsNumber =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char> &&
+    !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>;
 
-    start = threshold1 / inter1 + 1 + (threshold2 - threshold1) / inter2 + 1;
-    int64_t realLog = ori_abs / inter2;
-    res = start + static_cast<int64_t>(std::log(realLog) / std::log(1.5));
-    return origin >= 0 ? res : -res;
-}
+constexpr size_t kNumberChars = 64;
 
-// ============================================
-// 类型转换算子
-// ============================================
+/**
+ * @brief format_number结果的最大长度（整数含符号，浮点数为6位有效数字的%g格式）
+ */
+template<typename T>
+inline constexpr size_t kMaxNumberChars =
+    std::is_floating_point_v<T> ? 16 : static_cast<size_t>(std::numeric_limits<T>::digits10) + 2;
 
 /**
- * @brief 统一输出为int32_t
- * @tparam T 任意输入类型
- * @param value 输入值
- * @return int32_t类型的结果
+ * @brief 用std::to_chars格式化数值，与std::ostream的默认格式一致（浮点数为%g、6位有效数字）
+ * @return 写入结束位置，缓冲区需至少kNumberChars字节
  */
 template<typename T>
-inline int32_t direct_output_int32(T value) {
-    if constexpr (std::is_same_v<T, int32_t>) {
-        return value;
-    } else if constexpr (std::is_same_v<T, int64_t>) {
-        return static_cast<int32_t>(value);
-    } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
-        return static_cast<int32_t>(value);
+inline char* format_number(char* first, T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::to_chars(first, first + kNumberChars, value, std::chars_format::general, 6).ptr;
     } else {
-        return static_cast<int32_t>(value);
+        return std::to_chars(first, first + kNumberChars, value).ptr;
     }
 }
 
 /**
- * @brief 统一输出为int64_t
- * @tparam T 任意输入类型
- * @param value 输入值
- * @return int64_t类型的结果
+ * @brief 将值的文本表示追加到out，数值不经过流对象
  */
 template<typename T>
-inline int64_t direct_output_int64(T value) {
-    if constexpr (std::is_same_v<T, int64_t>) {
-        return value;
-    } else if constexpr (std::is_same_v<T, int32_t>) {
-        return static_cast<int64_t>(value);
-    } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
-        return static_cast<int64_t>(value);
+inline void append_text(std::string& out, const T& value) {
+    if constexpr (kFormatsAsNumber<T>) {
+        char buffer[kNumberChars];
+        out.append(buffer, format_number(buffer, value));
+    } else if constexpr (std::is_same_v<T, bool>) {
+        out += value ? '1' : '0';
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        out += static_cast<char>(value);
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        out += std::string_view(value);
     } else {
-        return static_cast<int64_t>(value);
+        std::ostringstream oss;
+        oss << value;
+        out += oss.str();
     }
 }
 
+} // namespace detail
+
+// ============================================
+// 字符串缓冲区
+// ============================================
+
 /**
- * @brief 统一输出为double
- * @tparam T 任意输入类型
- * @param value 输入值
- * @return double类型的结果
+ * @brief 字符串结果的调用方缓冲区
+ * 按块分配，追加的内容在reset()之前地址不变，返回的string_view一直有效；
+ * reset()只回绕写入位置、保留已分配的块，稳定运行后不再分配堆内存
  */
-template<typename T>
-inline double direct_output_double(T value) {
-    if constexpr (std::is_same_v<T, double>) {
-        return value;
-    } else if constexpr (std::is_same_v<T, float>) {
-        return static_cast<double>(value);
-    } else if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
-        return static_cast<double>(value);
-    } else {
-        return static_cast<double>(value);
+class StringArena {
+public:
+    static constexpr size_t kBlockSize = 4096;
+
+    StringArena() = default;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /**
+     * @brief 分配n字节的连续空间
+     */
+    char* allocate(size_t n) {
+        // 当前块剩余空间不足时换到下一块，没有可用块时按需分配
+        while (current_ < blocks_.size() && used_ + n > blocks_[current_].size) {
+            current_++;
+            used_ = 0;
+        }
+        if (current_ == blocks_.size()) {
+            size_t size = std::max(n, kBlockSize);
+            blocks_.push_back({std::make_unique<char[]>(size), size});
+        }
+        char* p = blocks_[current_].data.get() + used_;
+        used_ += n;
+        return p;
+    }
+
+    /**
+     * @brief 归还最近一次allocate末尾未用的n字节（按上界分配、写入后收缩）
+     */
+    void release(size_t n) {
+        used_ -= n;
     }
-}
+
+    /**
+     * @brief 拷贝一段文本并返回指向缓冲区的视图
+     */
+    std::string_view append(std::string_view text) {
+        if (text.empty()) return {};
+        char* p = allocate(text.size());
+        std::memcpy(p, text.data(), text.size());
+        return {p, text.size()};
+    }
+
+    /**
+     * @brief 丢弃所有内容（之前返回的视图失效）
+     */
+    void reset() {
+        current_ = 0;
+        used_ = 0;
+    }
+
+    /**
+     * @brief 已分配的总容量（字节）
+     */
+    size_t capacity() const {
+        size_t total = 0;
+        for (const auto& block : blocks_) total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+    std::vector<Block> blocks_;
+    size_t current_ = 0;
+    size_t used_ = 0;
+};
+
+// ============================================
+// 字符串转换算子
+// ============================================
 
 /**
  * @brief 任意类型转字符串
@@ -152,9 +210,39 @@ inline double direct_output_double(T value) {
  */
 template<typename T>
 inline std::string direct_output_string(T value) {
-    std::ostringstream oss;
-    oss << value;
-    return oss.str();
+    std::string out;
+    detail::append_text(out, value);
+    return out;
+}
+
+/**
+ * @brief 任意类型转字符串，写入out并复用其已有容量（字节码按槽位复用字符串存储）
+ */
+template<typename T>
+inline void direct_output_string_to(std::string& out, const T& value) {
+    out.clear();
+    detail::append_text(out, value);
+}
+
+/**
+ * @brief 任意类型转字符串，结果写入调用方缓冲区
+ * @return 指向arena的视图，arena.reset()前有效
+ */
+template<typename T>
+inline std::string_view direct_output_string(StringArena& arena, T value) {
+    if constexpr (detail::kFormatsAsNumber<T>) {
+        // 直接格式化到缓冲区，再归还未用的部分
+        char* begin = arena.allocate(detail::kNumberChars);
+        char* end = detail::format_number(begin, value);
+        arena.release(detail::kNumberChars - static_cast<size_t>(end - begin));
+        return {begin, static_cast<size_t>(end - begin)};
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return arena.append(std::string_view(value));
+    } else {
+        std::string text;
+        detail::append_text(text, value);
+        return arena.append(text);
+    }
 }
 
 // ============================================
@@ -180,16 +268,67 @@ inline size_t len(const T& container) {
  * @return 连接后的字符串
  */
 template<typename LIST_TYPE>
-inline std::string list_to_string(const LIST_TYPE& list, const std::string& delimiter = "|") {
-    if (list.empty()) return "";
-    std::ostringstream oss;
+inline void list_to_string_to(std::string& out, const LIST_TYPE& list, std::string_view delimiter = "|") {
+    out.clear();
     bool first = true;
     for (const auto& item : list) {
-        if (!first) oss << delimiter;
-        oss << item;
+        if (!first) out += delimiter;
+        detail::append_text(out, item);
         first = false;
     }
-    return oss.str();
+}
+
+template<typename LIST_TYPE>
+inline std::string list_to_string(const LIST_TYPE& list, std::string_view delimiter = "|") {
+    std::string out;
+    list_to_string_to(out, list, delimiter);
+    return out;
+}
+
+/**
+ * @brief 将列表转换为分隔符连接的字符串，结果写入调用方缓冲区
+ * 数值与字符串元素按长度上界一次分配后直接写入（数值用std::to_chars），不经过中间字符串
+ * @return 指向arena的视图，arena.reset()前有效
+ */
+template<typename LIST_TYPE>
+inline std::string_view list_to_string(StringArena& arena, const LIST_TYPE& list,
+                                       std::string_view delimiter = "|") {
+    using E = std::decay_t<decltype(*std::begin(list))>;
+    size_t count = static_cast<size_t>(std::distance(std::begin(list), std::end(list)));
+    if (count == 0) {
+        return {};
+    }
+    size_t bound = (count - 1) * delimiter.size();
+    if constexpr (detail::kFormatsAsNumber<E>) {
+        // format_number要求写入位置之后至少有kNumberChars字节
+        bound += (count - 1) * detail::kMaxNumberChars<E> + detail::kNumberChars;
+    } else if constexpr (std::is_convertible_v<const E&, std::string_view>) {
+        for (const auto& item : list) bound += std::string_view(item).size();
+    } else {
+        thread_local std::string buffer;
+        list_to_string_to(buffer, list, delimiter);
+        return arena.append(buffer);
+    }
+    char* begin = arena.allocate(bound);
+    char* p = begin;
+    bool first = true;
+    for (const auto& item : list) {
+        if (!first) {
+            std::memcpy(p, delimiter.data(), delimiter.size());
+            p += delimiter.size();
+        }
+        if constexpr (detail::kFormatsAsNumber<E>) {
+            p = detail::format_number(p, item);
+        } else {
+            std::string_view text(item);
+            std::memcpy(p, text.data(), text.size());
+            p += text.size();
+        }
+        first = false;
+    }
+    size_t used = static_cast<size_t>(p - begin);
+    arena.release(bound - used);
+    return {begin, used};
 }
 
 /**
@@ -203,6 +342,11 @@ inline std::string list_to_string(const LIST_TYPE& list, const std::string& deli
 template<typename LIST_TYPE, typename ITEM_TYPE>
 inline int catein_list_cross(const LIST_TYPE& list, ITEM_TYPE item_id) {
     if (list.empty()) return 0;
+    if constexpr (detail::kSimdSearchable<LIST_TYPE, ITEM_TYPE>) {
+        typename LIST_TYPE::value_type key;
+        if (!detail::search_key(item_id, key)) return 0;
+        return simd::contains(list.data(), list.size(), key) ? 1 : 0;
+    }
     for (size_t i = 0; i < list.size(); i++) {
         if (list[i] == item_id) {
             return 1;
@@ -222,6 +366,11 @@ inline int catein_list_cross(const LIST_TYPE& list, ITEM_TYPE item_id) {
 template<typename LIST_TYPE, typename ITEM_TYPE>
 inline int catein_list_cross_count(const LIST_TYPE& list, ITEM_TYPE item_id) {
     if (list.empty()) return 0;
+    if constexpr (detail::kSimdSearchable<LIST_TYPE, ITEM_TYPE>) {
+        typename LIST_TYPE::value_type key;
+        if (!detail::search_key(item_id, key)) return 0;
+        return simd::count_equal(list.data(), list.size(), key);
+    }
     int count = 0;
     for (size_t i = 0; i < list.size(); i++) {
         if (list[i] == item_id) {
@@ -232,150 +381,298 @@ inline int catein_list_cross_count(const LIST_TYPE& list, ITEM_TYPE item_id) {
 }
 
 // ============================================
-// 扩展算子（为了演示更复杂的场景）
+// 预构建查找结构（列表交叉）
 // ============================================
 
 /**
- * @brief 加法算子
+ * @brief 查找结构的实现方式，按列表长度选择
  */
-template<typename T>
-inline T add_op(T a, T b) {
-    return a + b;
-}
+enum class LookupStrategy {
+    LINEAR,   // 短列表：向量内核顺序扫描
+    SORTED,   // 中等列表：排序后二分查找
+    HASH      // 长列表：开放寻址哈希表，特别长时加布隆过滤器预筛
+};
 
 /**
- * @brief 减法算子
+ * @brief 由列表预构建的查找结构
+ * 同一列表与大量查找值交叉时（如一次请求内用户历史与所有候选）只构建一次，
+ * 每次查找为O(1)或O(log n)。结果与catein_list_cross/catein_list_cross_count逐元素比较一致
+ * @tparam LIST_TYPE 列表类型（std::vector<E>），可由同元素类型的任意列表（如ListView）构建
  */
-template<typename T>
-inline T sub_op(T a, T b) {
-    return a - b;
-}
+template<typename LIST_TYPE>
+class ListLookup {
+public:
+    using value_type = typename LIST_TYPE::value_type;
 
-/**
- * @brief 乘法算子
- */
-template<typename T>
-inline T mul_op(T a, T b) {
-    return a * b;
-}
+    static constexpr size_t kLinearMax = 32;        // 不超过该长度时顺序扫描
+    static constexpr size_t kSortedMax = 512;       // 不超过该长度时二分查找
+    static constexpr size_t kBloomMin = 1 << 16;    // 哈希表超出缓存时先查布隆过滤器
 
-/**
- * @brief 除法算子
- */
-template<typename T>
-inline T div_op(T a, T b) {
-    if (b == 0) return 0;
-    return a / b;
-}
+    ListLookup() = default;
 
-/**
- * @brief 条件选择算子
- */
-template<typename T>
-inline T if_else(bool condition, T true_val, T false_val) {
-    return condition ? true_val : false_val;
-}
+    template<typename SOURCE, typename = std::enable_if_t<!std::is_same_v<SOURCE, ListLookup>>>
+    explicit ListLookup(const SOURCE& list) : size_(list.size()), values_(list.begin(), list.end()) {
+        if (size_ <= kLinearMax) {
+            strategy_ = LookupStrategy::LINEAR;
+            return;
+        }
+        if constexpr (std::is_floating_point_v<value_type>) {
+            // NaN不等于任何值，也不满足严格弱序
+            values_.erase(std::remove_if(values_.begin(), values_.end(),
+                                         [](value_type v) { return v != v; }),
+                          values_.end());
+        }
+        if (!kHashable || size_ <= kSortedMax) {
+            strategy_ = LookupStrategy::SORTED;
+            std::sort(values_.begin(), values_.end());
+            return;
+        }
+        if constexpr (kHashable) {
+            strategy_ = LookupStrategy::HASH;
+            build_hash();
+        }
+    }
 
-/**
- * @brief 最大值算子
- */
-template<typename T>
-inline T max_op(T a, T b) {
-    return a > b ? a : b;
-}
+    LookupStrategy strategy() const { return strategy_; }
+    size_t size() const { return size_; }
+
+    /**
+     * @brief 查找值在列表中出现的次数
+     */
+    template<typename ITEM_TYPE>
+    int count(const ITEM_TYPE& item) const {
+        if constexpr (std::is_arithmetic_v<value_type>) {
+            if constexpr (detail::kSimdSearchable<std::vector<value_type>, ITEM_TYPE>) {
+                value_type key;
+                if (!detail::search_key(item, key) || key != key) return 0;
+                return count_key(key);
+            } else {
+                return count_linear(item);
+            }
+        } else if constexpr (std::is_convertible_v<const ITEM_TYPE&, std::string_view>) {
+            if (strategy_ == LookupStrategy::LINEAR) return count_linear(item);
+            auto range = std::equal_range(values_.begin(), values_.end(), std::string_view(item),
+                                          [](const auto& a, const auto& b) {
+                                              return std::string_view(a) < std::string_view(b);
+                                          });
+            return static_cast<int>(range.second - range.first);
+        } else {
+            return count_linear(item);
+        }
+    }
+
+    /**
+     * @brief 查找值是否在列表中
+     */
+    template<typename ITEM_TYPE>
+    bool contains(const ITEM_TYPE& item) const {
+        if constexpr (std::is_arithmetic_v<value_type> &&
+                      detail::kSimdSearchable<std::vector<value_type>, ITEM_TYPE>) {
+            value_type key;
+            if (!detail::search_key(item, key) || key != key) return false;
+            if (strategy_ == LookupStrategy::LINEAR) {
+                return simd::contains(values_.data(), values_.size(), key);
+            }
+            if (strategy_ == LookupStrategy::SORTED) {
+                return std::binary_search(values_.begin(), values_.end(), key);
+            }
+        }
+        return count(item) > 0;
+    }
+
+private:
+    static constexpr bool kHashable = simd::is_supported_v<value_type>;
+
+    struct Slot {
+        value_type key{};
+        int32_t count = 0;   // 0表示空槽
+    };
+
+    size_t size_ = 0;
+    LookupStrategy strategy_ = LookupStrategy::LINEAR;
+    std::vector<value_type> values_;   // LINEAR为原序，SORTED/HASH为去除NaN后的元素（SORTED为升序）
+    std::vector<Slot> slots_;
+    std::vector<uint64_t> bloom_;
+
+    static value_type normalize(value_type key) {
+        if constexpr (std::is_floating_point_v<value_type>) {
+            return key == 0 ? value_type(0) : key;   // -0.0与0.0相等，哈希值也需相同
+        } else {
+            return key;
+        }
+    }
+
+    static uint64_t hash_key(value_type key) {
+        uint64_t h = 0;
+        std::memcpy(&h, &key, sizeof(key));
+        // MurmurHash3 fmix64
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    void build_hash() {
+        size_t capacity = 16;
+        while (capacity < values_.size() * 2) capacity <<= 1;
+        slots_.assign(capacity, Slot{});
+        if (values_.size() >= kBloomMin) {
+            bloom_.assign(capacity * 4 / 64, 0);   // 每个元素约8位
+        }
+        const size_t mask = capacity - 1;
+        for (value_type v : values_) {
+            value_type key = normalize(v);
+            uint64_t h = hash_key(key);
+            for (size_t i = h & mask;; i = (i + 1) & mask) {
+                if (slots_[i].count == 0) {
+                    slots_[i].key = key;
+                    slots_[i].count = 1;
+                    break;
+                }
+                if (slots_[i].key == key) {
+                    slots_[i].count++;
+                    break;
+                }
+            }
+            if (!bloom_.empty()) {
+                for (uint64_t bit : {h >> 40, (h >> 16) & 0xffffff}) {
+                    bit %= bloom_.size() * 64;
+                    bloom_[bit / 64] |= uint64_t(1) << (bit % 64);
+                }
+            }
+        }
+    }
+
+    // key不为NaN（NaN不与任何元素相等，不满足严格弱序）
+    int count_key(value_type key) const {
+        switch (strategy_) {
+            case LookupStrategy::LINEAR:
+                return simd::count_equal(values_.data(), values_.size(), key);
+            case LookupStrategy::SORTED: {
+                auto range = std::equal_range(values_.begin(), values_.end(), key);
+                return static_cast<int>(range.second - range.first);
+            }
+            case LookupStrategy::HASH:
+                break;
+        }
+        if constexpr (kHashable) {
+            key = normalize(key);
+            uint64_t h = hash_key(key);
+            if (!bloom_.empty()) {
+                for (uint64_t bit : {h >> 40, (h >> 16) & 0xffffff}) {
+                    bit %= bloom_.size() * 64;
+                    if (!(bloom_[bit / 64] & (uint64_t(1) << (bit % 64)))) return 0;
+                }
+            }
+            const size_t mask = slots_.size() - 1;
+            for (size_t i = h & mask; slots_[i].count != 0; i = (i + 1) & mask) {
+                if (slots_[i].key == key) return slots_[i].count;
+            }
+        }
+        return 0;
+    }
+
+    // 查找值无法转换为元素类型比较时（整数列表查找浮点值等）逐元素比较
+    template<typename ITEM_TYPE>
+    int count_linear(const ITEM_TYPE& item) const {
+        int count = 0;
+        for (const auto& v : values_) {
+            count += v == item;
+        }
+        return count;
+    }
+};
 
 /**
- * @brief 最小值算子
+ * @brief 检查元素是否在列表中（可预构建查找结构的版本）
+ * 生成的批量入口中，列表为请求级常量输入（broadcast）时查找结构在循环外只构建一次；
+ * 其余情况与catein_list_cross相同
  */
-template<typename T>
-inline T min_op(T a, T b) {
-    return a < b ? a : b;
+template<typename LIST_TYPE, typename ITEM_TYPE>
+inline int catein_set_cross(const LIST_TYPE& list, ITEM_TYPE item_id) {
+    return catein_list_cross(list, item_id);
 }
 
-/**
- * @brief 绝对值算子
- */
-template<typename T>
-inline T abs_op(T value) {
-    return value >= 0 ? value : -value;
+template<typename LIST_TYPE, typename ITEM_TYPE>
+inline int catein_set_cross(const ListLookup<LIST_TYPE>& lookup, ITEM_TYPE item_id) {
+    return lookup.contains(item_id) ? 1 : 0;
 }
 
 /**
- * @brief 平方算子
+ * @brief 统计元素在列表中出现的次数（可预构建查找结构的版本）
  */
-template<typename T>
-inline T square_op(T value) {
-    return value * value;
+template<typename LIST_TYPE, typename ITEM_TYPE>
+inline int catein_set_cross_count(const LIST_TYPE& list, ITEM_TYPE item_id) {
+    return catein_list_cross_count(list, item_id);
 }
 
-/**
- * @brief 平方根算子
- */
-template<typename T>
-inline double sqrt_op(T value) {
-    if (value < 0) return 0;
-    return std::sqrt(static_cast<double>(value));
+template<typename LIST_TYPE, typename ITEM_TYPE>
+inline int catein_set_cross_count(const ListLookup<LIST_TYPE>& lookup, ITEM_TYPE item_id) {
+    return lookup.count(item_id);
 }
 
+// ============================================
+// 向量算子
+// ============================================
+
+// 求和类算子各有两个变体：默认变体按下标顺序累加，结果与字节码/解释器逐位一致；
+// _fast变体重排求和顺序以使用向量累加器，CodeGenOptions::use_fast_math开启时生成代码调用。
+// 列表参数为连续存储的double列表（std::vector<double>或ListView<double>）
+
 /**
- * @brief 取整算子（向下取整）
+ * @brief 移动平均算子
  */
-template<typename T>
-inline int32_t floor_op(double value) {
-    return static_cast<int32_t>(std::floor(value));
+template<typename LIST_TYPE>
+inline double moving_average(const LIST_TYPE& history, int32_t window) {
+    if (history.empty() || window <= 0) return 0.0;
+    size_t count = std::min(history.size(), static_cast<size_t>(window));
+    return simd::sum_ordered(history.data() + history.size() - count, count) / static_cast<double>(count);
 }
 
 /**
- * @brief 取整算子（向上取整）
+ * @brief 移动平均算子（低精度变体）
  */
-template<typename T>
-inline int32_t ceil_op(double value) {
-    return static_cast<int32_t>(std::ceil(value));
+template<typename LIST_TYPE>
+inline double moving_average_fast(const LIST_TYPE& history, int32_t window) {
+    if (history.empty() || window <= 0) return 0.0;
+    size_t count = std::min(history.size(), static_cast<size_t>(window));
+    return simd::sum_reassociated(history.data() + history.size() - count, count) / static_cast<double>(count);
 }
 
 /**
- * @brief 百分比计算算子
+ * @brief 向量元素求和
  */
-template<typename T>
-inline double percent_op(T part, T total) {
-    if (total == 0) return 0.0;
-    return static_cast<double>(part) / static_cast<double>(total) * 100.0;
+template<typename LIST_TYPE>
+inline double vector_sum(const LIST_TYPE& vec) {
+    return simd::sum_ordered(vec.data(), vec.size());
 }
 
 /**
- * @brief 移动平均算子
+ * @brief 向量元素求和（低精度变体）
  */
-inline double moving_average(const std::vector<double>& history, int32_t window) {
-    if (history.empty() || window <= 0) return 0.0;
-    int32_t start_idx = static_cast<int32_t>(history.size()) - window;
-    if (start_idx < 0) start_idx = 0;
-    
-    double sum = 0.0;
-    int32_t count = 0;
-    for (size_t i = start_idx; i < history.size(); i++) {
-        sum += history[i];
-        count++;
-    }
-    return count > 0 ? sum / count : 0.0;
+template<typename LIST_TYPE>
+inline double vector_sum_fast(const LIST_TYPE& vec) {
+    return simd::sum_reassociated(vec.data(), vec.size());
 }
 
 /**
- * @brief 向量元素求和
+ * @brief 向量元素平均值
  */
-inline double vector_sum(const std::vector<double>& vec) {
-    double sum = 0.0;
-    for (const auto& v : vec) {
-        sum += v;
-    }
-    return sum;
+template<typename LIST_TYPE>
+inline double vector_avg(const LIST_TYPE& vec) {
+    if (vec.empty()) return 0.0;
+    return vector_sum(vec) / static_cast<double>(vec.size());
 }
 
 /**
- * @brief 向量元素平均值
+ * @brief 向量元素平均值（低精度变体）
  */
-inline double vector_avg(const std::vector<double>& vec) {
+template<typename LIST_TYPE>
+inline double vector_avg_fast(const LIST_TYPE& vec) {
     if (vec.empty()) return 0.0;
-    return vector_sum(vec) / static_cast<double>(vec.size());
+    return vector_sum_fast(vec) / static_cast<double>(vec.size());
 }
 
 } // namespace turbograph::ops
@@ -0,0 +1,89 @@
+#ifndef TURBOGRAPH_OPTIMIZER_HPP
+#define TURBOGRAPH_OPTIMIZER_HPP
+
+#include "config.hpp"
+#include "types.hpp"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace turbograph {
+
+// ============================================
+// 数据流图
+// ============================================
+
+/**
+ * @brief 数据流图节点（一个步骤）
+ */
+struct DataflowNode {
+    size_t step = 0;            // 在config.steps中的下标
+    std::vector<int> deps;      // 每个参数的到达定义（步骤下标），输入/字面量/未赋值为-1
+};
+
+/**
+ * @brief 由管道配置构建的数据流图（DAG）
+ * 变量可以被多次赋值，边按到达定义连接，因此重复赋值不会产生环
+ */
+struct DataflowGraph {
+    std::vector<DataflowNode> nodes;   // 与config.steps一一对应
+    std::vector<int> output_defs;      // 每个输出的最终定义，-1表示来自输入或未赋值
+
+    /**
+     * @brief 构建数据流图
+     */
+    static DataflowGraph build(const PipelineConfig& config);
+
+    /**
+     * @brief 输出依赖的步骤（按步骤下标标记）
+     */
+    std::vector<bool> live_steps() const;
+    
+    /**
+     * @brief 指定输出（按config.outputs下标标记）依赖的步骤
+     */
+    std::vector<bool> live_steps(const std::vector<bool>& outputs) const;
+};
+
+// ============================================
+// 数据流优化
+// ============================================
+
+/**
+ * @brief 优化选项
+ */
+struct OptimizerOptions {
+    bool fold_constants = true;        // 参数全为字面量的数值步骤在生成前求值
+    bool eliminate_common = true;      // 公共子表达式消除（算子、参数与选项均相同的步骤）
+    bool eliminate_dead = true;        // 删除不影响输出的步骤
+};
+
+/**
+ * @brief 优化统计
+ */
+struct OptimizerStats {
+    size_t folded = 0;       // 折叠为常量的步骤
+    size_t common = 0;       // 被公共子表达式替换的步骤
+    size_t dead = 0;         // 删除的无用步骤
+};
+
+/**
+ * @brief 管道优化器
+ * 在代码生成与字节码降级之前对配置做数据流优化。
+ * 名称与指纹保持不变（生成代码的符号仍按原指纹命名）；
+ * 只保证输出字段的值与原配置一致，中间变量可能不再被计算
+ */
+class PipelineOptimizer {
+public:
+    /**
+     * @brief 优化配置
+     * @param stats 非空时写入优化统计
+     */
+    static PipelineConfig optimize(const PipelineConfig& config,
+                                   const OptimizerOptions& options = {},
+                                   OptimizerStats* stats = nullptr);
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_OPTIMIZER_HPP
@@ -3,19 +3,109 @@
 
 #include "config.hpp"
 #include "types.hpp"
+#include "abi.hpp"
+#include "aot.hpp"
+#include "bytecode.hpp"
 #include "code_generator.hpp"
+#include "compiler.hpp"
+#include "optimizer.hpp"
+#include "thread_pool.hpp"
+#include "batch_scheduler.hpp"
+#include "stats.hpp"
 #include <string>
 #include <memory>
 #include <functional>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
 
 namespace turbograph {
 
+class CompiledModule;
+class PipelineRegistry;
+
 // ============================================
 // 管道执行器接口
 // ============================================
 
+/**
+ * @brief IO字段在上下文布局中的槽位
+ */
+struct IOSlots {
+    std::vector<size_t> inputs;
+    std::vector<size_t> outputs;
+    
+    static IOSlots resolve(const PipelineConfig& config, const ContextLayout& layout);
+};
+
+/**
+ * @brief 请求的输出集合，第j位对应config.outputs[j]
+ * 按64位字存放，words()直接传给生成代码的掩码入口
+ */
+class OutputMask {
+public:
+    OutputMask() = default;
+    
+    /**
+     * @param num_outputs 输出个数
+     * @param all 是否请求全部输出
+     */
+    explicit OutputMask(size_t num_outputs, bool all = false)
+        : size_(num_outputs), words_((num_outputs + 63) / 64, 0) {
+        if (all) {
+            for (size_t j = 0; j < num_outputs; j++) {
+                set(j);
+            }
+        }
+    }
+    
+    /**
+     * @brief 按输出名称构造
+     * @throws std::runtime_error 名称不是config的输出
+     */
+    static OutputMask of(const PipelineConfig& config, const std::vector<std::string>& names) {
+        OutputMask mask(config.outputs.size());
+        for (const auto& name : names) {
+            size_t j = 0;
+            while (j < config.outputs.size() && config.outputs[j].name != name) {
+                j++;
+            }
+            if (j == config.outputs.size()) {
+                throw std::runtime_error("Unknown output: " + name + " (pipeline " + config.name + ")");
+            }
+            mask.set(j);
+        }
+        return mask;
+    }
+    
+    void set(size_t j) { words_[j / 64] |= uint64_t(1) << (j % 64); }
+    void reset(size_t j) { words_[j / 64] &= ~(uint64_t(1) << (j % 64)); }
+    bool test(size_t j) const { return (words_[j / 64] >> (j % 64)) & 1; }
+    
+    size_t size() const { return size_; }
+    const uint64_t* words() const { return words_.data(); }
+    
+    /**
+     * @brief 请求的输出个数
+     */
+    size_t count() const {
+        size_t n = 0;
+        for (size_t j = 0; j < size_; j++) {
+            n += test(j);
+        }
+        return n;
+    }
+    
+    bool all() const { return count() == size_; }
+    bool none() const { return count() == 0; }
+    
+private:
+    size_t size_ = 0;
+    std::vector<uint64_t> words_;
+};
+
 /**
  * @brief 管道执行器接口
  */
@@ -30,6 +120,31 @@ public:
      */
     virtual bool execute(ExecutionContext& context) = 0;
     
+    /**
+     * @brief 批量执行管道（列式输入输出）
+     * @param input 输入列，顺序与config.inputs一致
+     * @param output 输出列，顺序与config.outputs一致，由调用方分配
+     * @param n 行数
+     * @return 执行是否成功
+     */
+    virtual bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) = 0;
+    
+    /**
+     * @brief 批量执行管道（偏移编码输入列，见OffsetColumn）
+     * 字符串/列表输入直接引用调用方的值缓冲区与偏移数组，用于Arrow等列存格式；输出同execute_batch
+     */
+    virtual bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) = 0;
+    
+    /**
+     * @brief 只计算请求的输出（列式输入输出）
+     * 只执行被请求输出依赖的步骤，多个输出共用的步骤每行只执行一次；
+     * 未请求的输出列不写入，可为空指针
+     * @param mask 请求的输出，size()需与config.outputs一致
+     * @return 执行失败或掩码大小不符时返回false
+     */
+    virtual bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                      const OutputMask& mask) = 0;
+    
     /**
      * @brief 获取管道名称
      */
@@ -44,6 +159,18 @@ public:
      * @brief 检查是否需要重新编译
      */
     virtual bool needs_recompile() const = 0;
+    
+    /**
+     * @brief 获取上下文布局（每个配置计算一次）
+     */
+    virtual std::shared_ptr<const ContextLayout> context_layout() const = 0;
+    
+    /**
+     * @brief 创建绑定本管道布局的执行上下文，可reset()后跨请求复用
+     */
+    ExecutionContext create_context() const {
+        return ExecutionContext(context_layout());
+    }
 };
 
 // ============================================
@@ -52,86 +179,347 @@ public:
 
 /**
  * @brief 解释执行器
- * 使用反射和虚函数调用，逐条解释执行配置中的算子
+ * 使用反射和虚函数调用，逐条解释执行配置中的算子。
+ * 支持OperatorRegistry中的全部算子，计算委托给ops中的实现，作为差分测试的参考结果
  */
 class InterpreterExecutor : public IPipelineExecutor {
 public:
     explicit InterpreterExecutor(const PipelineConfig& config);
     
     bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
     const std::string& name() const override { return config_.name; }
     const std::string& fingerprint() const override { return config_.fingerprint; }
     bool needs_recompile() const override { return false; }
+    std::shared_ptr<const ContextLayout> context_layout() const override { return layout_; }
     
 private:
+    /**
+     * @brief 步骤的预解析槽位
+     */
+    struct StepSlots {
+        size_t output = ContextLayout::npos;
+        std::vector<size_t> args;
+    };
+    
     PipelineConfig config_;
+    std::shared_ptr<const ContextLayout> layout_;
+    IOSlots io_slots_;
+    std::vector<StepSlots> step_slots_;
+    DataflowGraph graph_;      // 按输出掩码裁剪步骤
     
     /**
      * @brief 执行单个算子
+     * @param slots 预解析槽位，上下文未绑定布局时为nullptr
+     */
+    bool execute_op(const OpCall& op, const StepSlots* slots, ExecutionContext& ctx);
+    
+    /**
+     * @brief 写入算子输出
      */
-    bool execute_op(const OpCall& op, ExecutionContext& ctx);
+    void set_output(ExecutionContext& ctx, const StepSlots* slots, const OpCall& op,
+                    DataType type, const ValueVariant& value);
     
     /**
      * @brief 获取参数值
      */
-    ValueVariant get_arg_value(const Arg& arg, const ExecutionContext& ctx);
+    ValueVariant get_arg_value(const Arg& arg, size_t slot, const ExecutionContext& ctx);
+};
+
+// ============================================
+// 字节码解释执行器（预解析指令）
+// ============================================
+
+/**
+ * @brief 字节码解释执行器
+ * 构造时将config_.steps降级为指令数组（操作码、预解析常量、槽位下标），
+ * 执行时通过指令中预先绑定的处理函数直接分派，无字符串比较和字面量解析
+ */
+class BytecodeExecutor : public IPipelineExecutor {
+public:
+    /**
+     * @param layout 上下文布局，为空时按配置计算（分层执行器传入共享布局）
+     * @param optimize 降级前做数据流优化（只保证输出字段与原配置一致，中间变量可能不再被写入）
+     */
+    explicit BytecodeExecutor(const PipelineConfig& config,
+                              std::shared_ptr<const ContextLayout> layout = nullptr,
+                              bool optimize = true);
+    
+    bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
+    const std::string& name() const override { return config_.name; }
+    const std::string& fingerprint() const override { return config_.fingerprint; }
+    bool needs_recompile() const override { return false; }
+    std::shared_ptr<const ContextLayout> context_layout() const override { return layout_; }
+    
+    /**
+     * @brief 获取字节码程序
+     */
+    const BytecodeProgram& program() const { return program_; }
+    
+private:
+    PipelineConfig config_;
+    std::shared_ptr<const ContextLayout> layout_;
+    IOSlots io_slots_;
+    BytecodeProgram program_;
 };
 
 // ============================================
 // JIT执行器（动态代码生成）
 // ============================================
 
+/**
+ * @brief JIT执行器的分级编译选项
+ */
+struct JitTierOptions {
+    bool enabled = false;                                     // 关闭时直接以OPTIMIZED编译
+    std::string baseline_optimization = "-O1 -march=native";  // BASELINE层级的优化选项
+    uint64_t promote_after = 10000;   // BASELINE版本执行的行数（单次execute计1行）达到该值后后台升级
+    bool use_pgo = false;             // 升级时先加载插桩版本收集计数，再按计数重新编译
+    uint64_t profile_rows = 100000;   // 插桩版本执行的行数达到该值后按计数重新编译
+};
+
 /**
  * @brief JIT编译执行器
- * 动态生成C++代码，编译为SO后加载执行
+ * 动态生成C++代码，编译为SO后加载执行。
+ * execute/execute_batch可由多个线程并发调用（首次调用并发时只编译一次）；
+ * set_options与recompile可与执行并发：新模块加载成功后原子替换，
+ * 旧模块在所有正在执行的调用返回后才卸载
  */
 class JITExecutor : public IPipelineExecutor {
 public:
-    explicit JITExecutor(const PipelineConfig& config);
+    /**
+     * @param layout 上下文布局，为空时按配置计算（分层执行器传入共享布局）
+     */
+    explicit JITExecutor(const PipelineConfig& config,
+                         std::shared_ptr<const ContextLayout> layout = nullptr);
     ~JITExecutor() override;
     
     bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
     const std::string& name() const override { return config_.name; }
     const std::string& fingerprint() const override { return fingerprint_; }
     bool needs_recompile() const override;
+    std::shared_ptr<const ContextLayout> context_layout() const override { return layout_; }
     
     /**
-     * @brief 强制重新编译
+     * @brief 强制重新编译，失败时卸载当前模块
      */
     void recompile();
     
     /**
-     * @brief 设置代码生成选项
+     * @brief 按需编译并加载SO，成功后execute不再触发编译
+     * @return SO是否可用
+     */
+    bool prepare();
+    
+    /**
+     * @brief 设置代码生成选项，下次执行时按新选项编译并替换模块
      */
     void set_options(const CodeGenOptions& options);
     
+    /**
+     * @brief 产生当前模块的编译后端名称，未加载时返回空字符串
+     */
+    const char* backend_name() const;
+    
+    /**
+     * @brief 设置分级编译
+     * 开启后首次以BASELINE编译；执行计数达到阈值时在pool上后台编译更高层级，
+     * 成功后原子替换模块。需在首次执行前调用，pool需比执行器存活更久
+     */
+    void set_tier_options(const JitTierOptions& options, ThreadPool& pool);
+    
+    /**
+     * @brief 当前模块的优化层级，未加载时为下次加载使用的层级
+     */
+    OptimizationTier tier() const;
+    
+    /**
+     * @brief 等待升级到至少tier层级
+     * @return 超时前达到返回true；升级失败或不再升级时立即返回false
+     */
+    bool wait_for_tier(OptimizationTier tier, std::chrono::milliseconds timeout);
+    
 private:
+    // 函数指针类型
+    using ExecuteFunc = bool(*)(void*, void*);
+    using ExecuteBatchFunc = bool(*)(const ColumnBatch*, OutputBatch*, size_t);
+    using ExecuteOffsetsFunc = bool(*)(const OffsetBatch*, OutputBatch*, size_t);
+    using ExecuteMaskedFunc = bool(*)(const ColumnBatch*, OutputBatch*, size_t, const uint64_t*);
+    
+    /**
+     * @brief 已加载的模块及解析出的导出符号，发布后不再修改
+     */
+    struct LoadedModule;
+    
+    /**
+     * @brief 与后台升级任务共享，执行器析构后任务直接返回
+     */
+    struct Promotion;
+    
     PipelineConfig config_;
     std::string fingerprint_;
-    void* so_handle_ = nullptr;
-    bool needs_recompile_ = true;
+    std::shared_ptr<const ContextLayout> layout_;
+    IOSlots io_slots_;
+    std::atomic<bool> needs_recompile_{true};
+    
+    // 当前模块，执行方在回收域临界区内读取，替换时旧模块延迟释放
+    std::atomic<LoadedModule*> loaded_{nullptr};
+    std::mutex load_mutex_;
     
     // 编译选项
     CodeGenOptions gen_options_;
     
-    // 函数指针类型
-    using ExecuteFunc = bool(*)(void*, void*);
-    ExecuteFunc execute_func_ = nullptr;
+    // 分级编译：执行计数只在还会升级时累加
+    JitTierOptions tier_options_;
+    ThreadPool* tier_pool_ = nullptr;
+    std::atomic<OptimizationTier> tier_{OptimizationTier::OPTIMIZED};   // 下次加载使用的层级
+    std::atomic<bool> counting_{false};
+    std::atomic<uint64_t> executed_rows_{0};
+    std::atomic<uint64_t> promote_at_{0};
+    std::atomic<bool> promoting_{false};
+    std::shared_ptr<Promotion> promotion_;
+    std::mutex tier_mutex_;
+    std::condition_variable tier_cv_;
+    
+    /**
+     * @brief 经JITCompiler编译（或命中缓存）并解析导出符号
+     * @param rebuild 忽略已有缓存，强制重新编译
+     * @param tier 优化层级
+     * @return 失败返回nullptr
+     */
+    std::unique_ptr<LoadedModule> load_module(bool rebuild, OptimizationTier tier);
+    
+    /**
+     * @brief 累加执行行数，达到阈值时提交后台升级
+     */
+    void count_rows(size_t rows);
     
     /**
-     * @brief 检查缓存
+     * @brief 编译并切换到下一层级（在后台线程上执行）
      */
-    bool check_cache();
+    void promote();
     
     /**
-     * @brief 加载SO
+     * @brief 发布新模块（可为空），旧模块交给回收域
      */
-    bool load_so();
+    void publish_module(std::unique_ptr<LoadedModule> next);
+};
+
+// ============================================
+// 分层执行器（字节码 -> 后台JIT）
+// ============================================
+
+/**
+ * @brief 分层执行器的JIT状态
+ */
+enum class JitState : uint8_t {
+    INTERPRETING,  // 解释执行，编译任务尚未提交（编译队列已满时稍后重试）
+    COMPILING,     // 后台编译中，仍为解释执行
+    JIT,           // 已切换到JIT执行
+    FAILED         // 编译或加载失败，保持解释执行
+};
+
+/**
+ * @brief 获取JIT状态名称
+ */
+const char* jit_state_name(JitState state);
+
+/**
+ * @brief 分层执行器
+ * 创建后立即以字节码解释执行提供服务，同时将编译提交到后台线程池；
+ * dlopen成功后原子切换到JIT执行器，调用线程从不等待编译。
+ * 两个层级共享同一上下文布局，create_context()得到的上下文在切换前后均可按槽位访问
+ */
+class TieredExecutor : public IPipelineExecutor {
+public:
+    /**
+     * @param config 管道配置
+     * @param pool 后台编译线程池，需比执行器存活更久
+     */
+    TieredExecutor(const PipelineConfig& config, ThreadPool& pool);
+    ~TieredExecutor() override;
+    
+    bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
+    const std::string& name() const override { return interpreter_.name(); }
+    const std::string& fingerprint() const override { return interpreter_.fingerprint(); }
+    bool needs_recompile() const override { return state() != JitState::JIT; }
+    std::shared_ptr<const ContextLayout> context_layout() const override { return layout_; }
     
     /**
-     * @brief 卸载SO
+     * @brief 获取当前JIT状态
      */
-    void unload_so();
+    JitState state() const;
+    
+    /**
+     * @brief 等待后台编译结束
+     * @return 在超时前切换到JIT返回true
+     */
+    bool wait_for_jit(std::chrono::milliseconds timeout);
+    
+private:
+    /**
+     * @brief 与后台编译任务共享的状态，执行器先析构时任务仍可安全完成
+     */
+    struct SharedState;
+    
+    std::shared_ptr<const ContextLayout> layout_;
+    BytecodeExecutor interpreter_;
+    ThreadPool& pool_;
+    std::shared_ptr<SharedState> shared_;
+    
+    /**
+     * @brief 提交后台编译（仅在INTERPRETING状态下生效）
+     */
+    void try_submit();
+};
+
+// ============================================
+// 静态链接执行器（构建期生成）
+// ============================================
+
+/**
+ * @brief AOT执行器
+ * 调用构建期由turbograph_aot生成并静态链接的入口（见aot.hpp），创建时不编译、不dlopen；
+ * 输入输出的打包方式与JITExecutor相同。PipelineManager::create在JIT/AUTO模式下
+ * 按指纹优先返回该执行器
+ */
+class AotExecutor : public IPipelineExecutor {
+public:
+    /**
+     * @param pipeline 注册表中的管道，指纹需与config一致
+     */
+    AotExecutor(const PipelineConfig& config, const AotPipeline& pipeline);
+    
+    bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
+    const std::string& name() const override { return config_.name; }
+    const std::string& fingerprint() const override { return config_.fingerprint; }
+    bool needs_recompile() const override { return false; }
+    std::shared_ptr<const ContextLayout> context_layout() const override { return layout_; }
+    
+private:
+    PipelineConfig config_;
+    const AotPipeline& pipeline_;
+    std::shared_ptr<const ContextLayout> layout_;
+    IOSlots io_slots_;
 };
 
 // ============================================
@@ -143,8 +531,21 @@ private:
  */
 enum class PipelineMode {
     INTERPRETER,  // 解释执行
+    BYTECODE,     // 字节码解释执行
     JIT,          // JIT编译执行
-    AUTO          // 自动选择（首次解释，后续JIT）
+    AUTO          // 分层执行（先字节码解释，后台编译完成后切换JIT）
+};
+
+/**
+ * @brief 精度校验结果：执行器的标量输出相对double解释执行的最大偏差
+ */
+struct PrecisionReport {
+    size_t rows = 0;               // 参与比较的样本行数
+    size_t failed_rows = 0;        // 任一方执行失败的样本行数
+    double max_abs_error = 0.0;    // 最大绝对误差
+    double max_rel_error = 0.0;    // 最大相对误差（参考值绝对值小于1时按绝对误差计）
+    std::string worst_output;      // 相对误差最大的输出字段
+    size_t worst_row = 0;          // 其所在的样本行
 };
 
 /**
@@ -160,15 +561,27 @@ public:
      */
     std::unique_ptr<IPipelineExecutor> create_interpreter(const PipelineConfig& config);
     
+    /**
+     * @brief 创建字节码解释执行器
+     */
+    std::unique_ptr<IPipelineExecutor> create_bytecode(const PipelineConfig& config);
+    
     /**
      * @brief 创建JIT执行器
      */
     std::unique_ptr<IPipelineExecutor> create_jit(const PipelineConfig& config);
     
+    /**
+     * @brief 创建分层执行器（立即可用，后台编译JIT）
+     */
+    std::unique_ptr<IPipelineExecutor> create_tiered(const PipelineConfig& config);
+    
     /**
      * @brief 创建执行器
+     * 配置启用了结果缓存（PipelineConfig::cache）时返回包在外层的CachedExecutor
      * @param config 管道配置
      * @param mode 执行模式
+     * @throws std::runtime_error 缓存策略无效
      */
     std::unique_ptr<IPipelineExecutor> create(const PipelineConfig& config, PipelineMode mode);
     
@@ -179,11 +592,80 @@ public:
         const std::string& config_path, 
         PipelineMode mode);
     
+    /**
+     * @brief 流式加载配置数组并按名称发布到注册表
+     * 以JsonConfigParser::parse_bulk逐个解析、校验，每个配置解析完成后立即发布（同update）：
+     * JIT模式下编译与加载提交到后台编译线程池，与后续配置的解析并行（队列满时在调用线程上执行），
+     * 返回前等待全部完成。同名配置以后发布的为准，未通过校验的配置跳过
+     * @return 成功发布的管道数
+     * @throws std::runtime_error 文件无法打开或JSON格式错误（已解析的配置仍会发布）
+     */
+    size_t load_bulk(std::istream& input, PipelineMode mode = PipelineMode::JIT);
+    size_t load_bulk(const std::string& path, PipelineMode mode = PipelineMode::JIT);
+    
+    /**
+     * @brief 从二进制配置文件（ConfigGenerator::generate_binary）加载并按名称发布到注册表
+     * 文件以mmap映射，配置按记录直接解码，不解析JSON、不重新计算指纹；
+     * 与SO缓存配合时JIT执行器只需加载已缓存的SO。发布方式同load_bulk
+     * @return 成功发布的管道数
+     * @throws std::runtime_error 文件无法打开或格式不符
+     */
+    size_t load_binary(const std::string& path, PipelineMode mode = PipelineMode::JIT);
+    
+    /**
+     * @brief 发布管道的新版本
+     * 在调用线程上创建执行器（JIT模式下完成编译与加载）后原子替换注册表中的同名版本，
+     * 正在执行旧版本的读者不受影响，旧版本在其全部返回后释放
+     * @param name 注册名称
+     * @param new_config 新版本配置
+     * @param mode 执行模式
+     * @return 新版本号，失败返回0（当前版本继续服务）
+     */
+    uint64_t update(const std::string& name, const PipelineConfig& new_config,
+                    PipelineMode mode = PipelineMode::JIT);
+    
+    /**
+     * @brief 精度校验：以mode创建执行器，逐行与解释执行器（始终按double计算）比较标量输出，
+     * 用于确认Precision::FLOAT等低精度策略在样本上的误差可以接受
+     * @param samples 已填入输入的样本上下文，不修改
+     */
+    PrecisionReport validate_precision(const PipelineConfig& config,
+                                       const std::vector<ExecutionContext>& samples,
+                                       PipelineMode mode = PipelineMode::JIT);
+    
+    /**
+     * @brief 按名称查找执行器的注册表（读取无锁）
+     */
+    PipelineRegistry& registry() { return *registry_; }
+    
     /**
      * @brief 设置JIT选项
      */
     void set_jit_options(const CodeGenOptions& options);
     
+    /**
+     * @brief 设置JIT执行器的分级编译选项（对之后创建的JIT执行器生效，升级任务使用后台编译线程池）
+     */
+    void set_jit_tier_options(const JitTierOptions& options);
+    
+    /**
+     * @brief 开启或关闭插桩模式（对之后创建的JIT执行器生效）
+     * 开启后记录编译与加载耗时、缓存命中、执行次数与延迟分布，生成代码带逐步骤计数
+     * （CodeGenOptions::profile_steps）；关闭时生成代码与执行路径不含计时。
+     * 以TURBOGRAPH_NO_STATS编译时调用无效
+     */
+    void set_instrumentation(bool enabled);
+    
+    /**
+     * @brief 所有管道的统计
+     */
+    std::vector<PipelineStatsSnapshot> stats() const;
+    
+    /**
+     * @brief 以Prometheus文本格式导出统计
+     */
+    std::string dump_metrics() const;
+    
     /**
      * @brief 设置缓存目录
      */
@@ -199,13 +681,54 @@ public:
      */
     const std::string& cache_dir() const { return cache_dir_; }
     
+    /**
+     * @brief 设置后台编译线程池规模，需在第一次创建AUTO执行器前调用
+     * @param num_threads 编译线程数
+     * @param max_pending 等待编译队列上限
+     */
+    void set_compile_pool_size(size_t num_threads, size_t max_pending);
+    
+    /**
+     * @brief 获取后台编译线程池（首次调用时创建）
+     */
+    ThreadPool& compile_pool();
+    
+    /**
+     * @brief 设置批量调度选项，需在第一次调用batch_scheduler()前调用
+     */
+    void set_batch_scheduler_options(const BatchSchedulerOptions& options);
+    
+    /**
+     * @brief 获取多线程批量调度器（首次调用时创建）
+     */
+    BatchScheduler& batch_scheduler();
+    
 private:
-    PipelineManager() = default;
+    PipelineManager();
+    ~PipelineManager();
+    
+    std::unique_ptr<PipelineRegistry> registry_;
+    
+    std::mutex pool_mutex_;
+    std::unique_ptr<ThreadPool> compile_pool_;
+    size_t compile_threads_ = 2;
+    size_t compile_max_pending_ = 64;
+    std::unique_ptr<BatchScheduler> batch_scheduler_;
+    BatchSchedulerOptions batch_options_;
+    
+    std::mutex settings_mutex_;
     
     CodeGenOptions jit_options_;
+    JitTierOptions jit_tier_options_;
+    bool instrumented_ = false;
     std::string cache_dir_ = "./generated";
     std::unordered_map<std::string, void*> loaded_handles_;
     
+    /**
+     * @brief 按模式创建执行器，不加结果缓存
+     */
+    std::unique_ptr<IPipelineExecutor> create_uncached(const PipelineConfig& config, PipelineMode mode);
+    
     std::string get_cache_path(const std::string& fingerprint) const;
     std::string get_source_path(const std::string& fingerprint) const;
 };
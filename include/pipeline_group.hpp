@@ -0,0 +1,109 @@
+#ifndef TURBOGRAPH_PIPELINE_GROUP_HPP
+#define TURBOGRAPH_PIPELINE_GROUP_HPP
+
+#include "abi.hpp"
+#include "config.hpp"
+#include "pipeline.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 管道组（多管道融合）
+// ============================================
+
+/**
+ * @brief 将对同一批输入求值的多个管道合并为一个配置，一次批量调用写出所有成员的输出
+ *
+ * 融合配置的输入为各成员输入按名称取并集；成员的步骤改写为单次赋值的变量
+ * （"<成员名>__<变量>"），参数按到达定义解析后，算子、参数、选项与结果类型
+ * 均相同的步骤（步骤指纹相同）只保留第一次出现，跨成员共享结果。
+ * 融合配置的输出依次为各成员的输出；数值相同的输出只写一列，
+ * execute_batch在融合执行后复制给其余成员。
+ * 融合配置按普通管道编译（一个SO、一个批量入口），输入每行只加载一次
+ */
+class PipelineGroup {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief 合并成员配置
+     * @param name 融合配置的名称
+     * @param members 成员配置，名称需唯一
+     * @throws std::runtime_error 成员为空或重名、同名输入的类型或广播属性不一致、精度策略不一致
+     */
+    PipelineGroup(const std::string& name, std::vector<PipelineConfig> members);
+
+    /**
+     * @brief 融合后的配置（指纹已计算）
+     */
+    const PipelineConfig& fused_config() const { return fused_; }
+
+    size_t size() const { return members_.size(); }
+    const PipelineConfig& member(size_t i) const { return members_[i].config; }
+
+    /**
+     * @brief 按名称查找成员下标，不存在返回npos
+     */
+    size_t find(const std::string& name) const;
+
+    /**
+     * @brief 成员的第i个输入在融合配置输入中的列号
+     */
+    const std::vector<size_t>& input_columns(size_t member) const { return members_[member].inputs; }
+
+    /**
+     * @brief 成员的第j个输出在融合配置输出中的列号（数值相同的输出共用一列）
+     */
+    const std::vector<size_t>& output_columns(size_t member) const { return members_[member].outputs; }
+
+    /**
+     * @brief 成员步骤总数与融合后的步骤数
+     */
+    size_t member_steps() const { return member_steps_; }
+    size_t fused_steps() const { return fused_.steps.size(); }
+
+    /**
+     * @brief 创建融合配置的执行器
+     */
+    std::unique_ptr<IPipelineExecutor> create(PipelineMode mode = PipelineMode::JIT) const;
+
+    /**
+     * @brief 批量执行所有成员
+     * @param executor create()创建的执行器（融合配置）
+     * @param input 列式输入，columns[i]对应fused_config().inputs[i]
+     * @param outputs 每个成员一个输出批次，columns[j]对应member(k).outputs[j]
+     * @param n 行数
+     * @return 执行器失败或outputs与成员数、列数不符时返回false
+     */
+    bool execute_batch(IPipelineExecutor& executor, const ColumnBatch& input,
+                       const std::vector<OutputBatch>& outputs, size_t n) const;
+
+private:
+    struct Member {
+        PipelineConfig config;
+        std::vector<size_t> inputs;
+        std::vector<size_t> outputs;
+    };
+
+    /**
+     * @brief 融合输出列的写入者：第一个映射到该列的成员输出
+     */
+    struct OutputOwner {
+        size_t member;
+        size_t output;
+    };
+
+    PipelineConfig fused_;
+    std::vector<Member> members_;
+    std::vector<OutputOwner> owners_;   // 与fused_.outputs一一对应
+    size_t member_steps_ = 0;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_PIPELINE_GROUP_HPP
@@ -0,0 +1,79 @@
+#ifndef TURBOGRAPH_PROBE_HPP
+#define TURBOGRAPH_PROBE_HPP
+
+// 逐步骤计时探针，宿主程序和以插桩模式生成的SO共同包含，只定义POD结构与内联函数
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace turbograph {
+
+// ============================================
+// 步骤计数（插桩模式）
+// ============================================
+
+/**
+ * @brief 单个步骤的累计计数，由宿主分配，生成代码以relaxed原子加更新
+ */
+struct StepCounter {
+    uint64_t calls;
+    uint64_t ticks;   // probe::now()的差值之和
+};
+
+/**
+ * @brief 插桩描述符
+ * 由生成的SO以 pipeline_profile_<fp> 符号导出；宿主向*counters写入
+ * 每步一项的计数数组后开始计数，写入nullptr停止
+ */
+struct StepProfile {
+    uint32_t num_steps;
+    const char* const* names;   // "算子名:输出变量"，与生成代码中的步骤顺序一致
+    StepCounter** counters;
+};
+
+namespace probe {
+
+/**
+ * @brief 计数单位：x86上为TSC周期，其他平台为纳秒
+ */
+#if defined(__x86_64__) || defined(__i386__)
+inline constexpr const char* kTickUnit = "cycles";
+#else
+inline constexpr const char* kTickUnit = "nanoseconds";
+#endif
+
+/**
+ * @brief 读取计时器（rdtsc不串行化，单步较短时只是采样估计）
+ */
+inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+/**
+ * @brief 累加第step步自start以来的耗时，未挂接计数数组时不记录
+ */
+inline void record(StepCounter* counters, size_t step, uint64_t start) {
+    if (!counters) {
+        return;
+    }
+    uint64_t elapsed = now() - start;
+    __atomic_fetch_add(&counters[step].calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&counters[step].ticks, elapsed, __ATOMIC_RELAXED);
+}
+
+} // namespace probe
+} // namespace turbograph
+
+#endif // TURBOGRAPH_PROBE_HPP
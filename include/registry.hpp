@@ -0,0 +1,145 @@
+#ifndef TURBOGRAPH_REGISTRY_HPP
+#define TURBOGRAPH_REGISTRY_HPP
+
+#include "config.hpp"
+#include "epoch.hpp"
+#include "pipeline.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 管道版本
+// ============================================
+
+/**
+ * @brief 一个已发布的管道版本，发布后不再修改
+ */
+struct PipelineVersion {
+    std::string name;
+    uint64_t version = 0;                          // 同名管道内单调递增，从1开始
+    PipelineConfig config;
+    std::unique_ptr<IPipelineExecutor> executor;   // execute/execute_batch需可并发调用
+};
+
+/**
+ * @brief 读者持有的管道快照
+ * 持有期间处于回收域的读者临界区，所指版本（及其SO）不会被释放；
+ * 应在单次请求内短暂持有，不要跨请求保存
+ */
+class PipelineHandle {
+public:
+    PipelineHandle() = default;
+    PipelineHandle(EpochDomain::Guard guard, const PipelineVersion* version)
+        : guard_(std::move(guard)), version_(version) {}
+
+    explicit operator bool() const { return version_ != nullptr; }
+    const PipelineVersion* operator->() const { return version_; }
+    const PipelineVersion& operator*() const { return *version_; }
+
+    /**
+     * @brief 版本号，空句柄返回0
+     */
+    uint64_t version() const { return version_ ? version_->version : 0; }
+
+    /**
+     * @brief 版本的执行器，空句柄返回nullptr
+     */
+    IPipelineExecutor* executor() const { return version_ ? version_->executor.get() : nullptr; }
+
+private:
+    EpochDomain::Guard guard_;
+    const PipelineVersion* version_ = nullptr;
+};
+
+// ============================================
+// 管道注册表
+// ============================================
+
+/**
+ * @brief 按名称查找执行器的注册表，支持热替换
+ * 所有名称到版本的映射是一份不可变快照，读者进入回收域后以一次原子读取拿到快照，
+ * 查找与执行均不加锁；写者复制快照、替换条目后原子发布，被替换的版本在
+ * 所有可能读到它的读者离开后才析构（JIT版本随之卸载SO）
+ */
+class PipelineRegistry {
+public:
+    explicit PipelineRegistry(EpochDomain& domain = EpochDomain::instance());
+
+    /**
+     * @brief 析构时直接释放当前快照，需保证没有读者
+     */
+    ~PipelineRegistry();
+
+    PipelineRegistry(const PipelineRegistry&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+
+    /**
+     * @brief 获取管道当前版本的快照
+     * @return 管道不存在时返回空句柄
+     */
+    PipelineHandle acquire(const std::string& name) const;
+
+    /**
+     * @brief 以当前版本执行
+     * @return 管道不存在或执行失败返回false
+     */
+    bool execute(const std::string& name, ExecutionContext& context) const;
+
+    /**
+     * @brief 以当前版本批量执行
+     */
+    bool execute_batch(const std::string& name, const ColumnBatch& input,
+                       OutputBatch& output, size_t n) const;
+
+    /**
+     * @brief 发布新版本，替换同名的旧版本
+     * @param executor 已准备好的执行器（发布后立即对读者可见，不应再触发编译）
+     * @return 新版本号
+     */
+    uint64_t publish(const std::string& name, const PipelineConfig& config,
+                     std::unique_ptr<IPipelineExecutor> executor);
+
+    /**
+     * @brief 移除管道，旧版本延迟释放
+     * @return 管道是否存在
+     */
+    bool remove(const std::string& name);
+
+    /**
+     * @brief 管道当前版本号，不存在返回0
+     */
+    uint64_t version(const std::string& name) const;
+
+    /**
+     * @brief 已注册的管道名称
+     */
+    std::vector<std::string> names() const;
+
+    /**
+     * @brief 等待被替换的版本全部释放，不能在持有句柄时调用
+     */
+    void synchronize() { domain_.synchronize(); }
+
+private:
+    using Snapshot = std::unordered_map<std::string, std::shared_ptr<const PipelineVersion>>;
+
+    /**
+     * @brief 发布新快照，旧快照交给回收域
+     */
+    void swap_snapshot(std::unique_ptr<Snapshot> next);
+
+    EpochDomain& domain_;
+    std::atomic<const Snapshot*> current_;
+    std::mutex write_mutex_;   // 串行化写者（复制-替换-发布）
+    std::unordered_map<std::string, uint64_t> last_versions_;   // 移除后重新发布时版本号继续递增
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_REGISTRY_HPP
@@ -0,0 +1,198 @@
+#ifndef TURBOGRAPH_RESULT_CACHE_HPP
+#define TURBOGRAPH_RESULT_CACHE_HPP
+
+#include "abi.hpp"
+#include "config.hpp"
+#include "hash.hpp"
+#include "pipeline.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 结果缓存
+// ============================================
+
+/**
+ * @brief 某一时刻的缓存统计
+ */
+struct ResultCacheStats {
+    std::string name;
+    std::string fingerprint;
+    size_t capacity = 0;      // 实际条目数
+    uint64_t hits = 0;
+    uint64_t misses = 0;      // 含过期
+    uint64_t expired = 0;     // 命中键但已过期
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;   // 替换仍有效的条目
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @brief 固定内存的分片结果缓存
+ *
+ * 条目数在构造时确定（按分片数与组相联路数向上取整为2的幂），之后不再分配内存。
+ * 键为128位哈希：高位选分片，低位选组，组内kWays路按完整键比较。
+ * 每个条目带版本号（seqlock）：读者无锁地复制条目后校验版本，读到写入中的条目按未命中处理；
+ * 写者以CAS占用条目，条目正被其他写者占用时放弃本次写入，不等待。
+ * 组满时按CLOCK（二次机会）淘汰：命中置访问位，淘汰时从轮转位置开始清除访问位，
+ * 替换第一个未被访问的条目。每个条目的值为width个64位字（标量输出的位模式）
+ */
+class ResultCache {
+public:
+    static constexpr size_t kShards = 16;
+    static constexpr size_t kWays = 8;
+
+    /**
+     * @param capacity 期望的条目数
+     * @param width 每个条目的值字数（输出个数）
+     */
+    ResultCache(std::string name, std::string fingerprint, size_t capacity, size_t width);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /**
+     * @brief 查找条目，命中时复制width个字到values
+     * @param now_ns stats_now_ns()时刻，用于判断过期
+     */
+    bool lookup(const Hash128& key, uint64_t now_ns, uint64_t* values);
+
+    /**
+     * @brief 写入条目，同键的条目原地更新，其次使用空条目或已过期的条目，都没有时按CLOCK淘汰
+     * @param expires_ns 过期时刻（stats_now_ns()），0表示不过期
+     */
+    void insert(const Hash128& key, uint64_t now_ns, uint64_t expires_ns, const uint64_t* values);
+
+    size_t capacity() const { return num_slots_; }
+    size_t width() const { return width_; }
+
+    ResultCacheStats stats() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> version{0};    // 0为空条目，奇数为写入中
+        std::atomic<uint64_t> key_lo{0};
+        std::atomic<uint64_t> key_hi{0};
+        std::atomic<uint64_t> expires_ns{0};
+        std::atomic<uint8_t> referenced{0};
+    };
+
+    /**
+     * @brief 分片计数（独占缓存行，避免分片间伪共享）
+     */
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> expired{0};
+        std::atomic<uint64_t> inserts{0};
+        std::atomic<uint64_t> evictions{0};
+        std::atomic<uint32_t> hand{0};       // CLOCK轮转位置
+    };
+
+    size_t first_slot(const Hash128& key) const;
+
+    const std::string name_;
+    const std::string fingerprint_;
+    size_t width_;
+    size_t sets_per_shard_;
+    size_t num_slots_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<std::atomic<uint64_t>[]> values_;
+    Shard shards_[kShards];
+};
+
+/**
+ * @brief 按指纹共享的结果缓存注册表
+ * 同一管道（指纹）的所有执行器共用一个缓存；容量或输出个数变化时换新缓存，
+ * 仍持有旧缓存的执行器继续使用旧缓存
+ */
+class ResultCacheRegistry {
+public:
+    static ResultCacheRegistry& instance();
+
+    ResultCacheRegistry(const ResultCacheRegistry&) = delete;
+    ResultCacheRegistry& operator=(const ResultCacheRegistry&) = delete;
+
+    /**
+     * @brief 获取或创建配置的缓存
+     */
+    std::shared_ptr<ResultCache> cache(const PipelineConfig& config);
+
+    /**
+     * @brief 所有缓存的统计，按名称、指纹排序
+     */
+    std::vector<ResultCacheStats> stats() const;
+
+    /**
+     * @brief 丢弃所有缓存（已创建的执行器继续持有各自的缓存）
+     */
+    void clear();
+
+private:
+    ResultCacheRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<ResultCache>> caches_;
+};
+
+// ============================================
+// 带结果缓存的执行器
+// ============================================
+
+/**
+ * @brief 在执行器前加一层按输入取值记忆的缓存
+ * 缓存键为配置指纹与CachePolicy::keys中输入的取值（按类型规范化序列化后求128位哈希），
+ * 单行与批量执行共用同一缓存。execute_batch先逐行查找，未命中的行（批次内键相同的只算一次）
+ * 收集为一个子批次交给内层执行器，结果写回并插入缓存。
+ * execute_offsets与execute_batch_masked直接交给内层执行器，不经过缓存。
+ * PipelineManager::create对启用了缓存策略的配置返回该执行器
+ */
+class CachedExecutor : public IPipelineExecutor {
+public:
+    /**
+     * @param cache 为空时取ResultCacheRegistry中按指纹共享的缓存
+     * @throws std::runtime_error 缓存策略无效（见validate_cache_policy）
+     */
+    CachedExecutor(const PipelineConfig& config, std::unique_ptr<IPipelineExecutor> inner,
+                   std::shared_ptr<ResultCache> cache);
+
+    bool execute(ExecutionContext& context) override;
+    bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) override;
+    bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                              const OutputMask& mask) override;
+    const std::string& name() const override { return inner_->name(); }
+    const std::string& fingerprint() const override { return inner_->fingerprint(); }
+    bool needs_recompile() const override { return inner_->needs_recompile(); }
+    std::shared_ptr<const ContextLayout> context_layout() const override { return inner_->context_layout(); }
+
+    IPipelineExecutor& inner() { return *inner_; }
+    ResultCache& cache() { return *cache_; }
+
+private:
+    PipelineConfig config_;
+    std::unique_ptr<IPipelineExecutor> inner_;
+    std::shared_ptr<ResultCache> cache_;
+    std::vector<size_t> keys_;   // 缓存键输入在config_.inputs中的下标
+    uint64_t seed_ = 0;          // 由指纹导出的哈希种子
+    uint64_t ttl_ns_ = 0;
+
+    uint64_t expires_at(uint64_t now_ns) const { return ttl_ns_ ? now_ns + ttl_ns_ : 0; }
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_RESULT_CACHE_HPP
@@ -0,0 +1,336 @@
+#ifndef TURBOGRAPH_SIMD_HPP
+#define TURBOGRAPH_SIMD_HPP
+
+// 列表算子使用的SIMD抽象（接口仿照std::experimental::simd）。
+// 按编译目标选择指令集：AVX-512F > AVX2 > NEON(aarch64) > 标量实现；
+// 生成代码以-march=native编译，自动使用本机支持的最宽指令集
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace turbograph::simd {
+
+// ============================================
+// 指令集选择
+// ============================================
+
+#if defined(__AVX512F__)
+#define TURBOGRAPH_SIMD_AVX512 1
+#elif defined(__AVX2__)
+#define TURBOGRAPH_SIMD_AVX2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define TURBOGRAPH_SIMD_NEON 1
+#endif
+
+/**
+ * @brief 当前编译目标使用的指令集名称
+ */
+inline constexpr const char* isa_name() {
+#if defined(TURBOGRAPH_SIMD_AVX512)
+    return "avx512";
+#elif defined(TURBOGRAPH_SIMD_AVX2)
+    return "avx2";
+#elif defined(TURBOGRAPH_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * @brief 是否有向量实现的元素类型
+ */
+template<typename T>
+inline constexpr bool is_supported_v =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> || std::is_same_v<T, double>;
+
+// ============================================
+// 比较掩码
+// ============================================
+
+/**
+ * @brief 逐元素比较结果，第i位对应第i个元素
+ */
+struct mask {
+    uint32_t bits = 0;
+
+    bool any() const { return bits != 0; }
+    int count() const { return __builtin_popcount(bits); }
+
+    friend mask operator|(mask a, mask b) { return {a.bits | b.bits}; }
+};
+
+// ============================================
+// 定长向量
+// ============================================
+
+/**
+ * @brief 本机宽度的向量
+ * 提供size、load（非对齐）、broadcast、operator+、operator==与reduce_add
+ */
+template<typename T>
+struct batch;
+
+#if defined(TURBOGRAPH_SIMD_AVX512)
+
+template<>
+struct batch<double> {
+    static constexpr size_t size = 8;
+    __m512d v;
+
+    static batch load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static batch broadcast(double x) { return {_mm512_set1_pd(x)}; }
+    friend batch operator+(batch a, batch b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend mask operator==(batch a, batch b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ)}; }
+    double reduce_add() const {
+        // 两半都用零掩码提取：_mm512_reduce_add_pd与_mm512_castpd512_pd256（GCC实现）以未定义向量
+        // 为合并源提取，会报-Wmaybe-uninitialized
+        __m256d half = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xFF, v, 0),
+                                     _mm512_maskz_extractf64x4_pd(0xFF, v, 1));
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(half), _mm256_extractf128_pd(half, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+};
+
+template<>
+struct batch<int64_t> {
+    static constexpr size_t size = 8;
+    __m512i v;
+
+    static batch load(const int64_t* p) { return {_mm512_loadu_si512(p)}; }
+    static batch broadcast(int64_t x) { return {_mm512_set1_epi64(x)}; }
+    friend mask operator==(batch a, batch b) { return {_mm512_cmpeq_epi64_mask(a.v, b.v)}; }
+};
+
+template<>
+struct batch<int32_t> {
+    static constexpr size_t size = 16;
+    __m512i v;
+
+    static batch load(const int32_t* p) { return {_mm512_loadu_si512(p)}; }
+    static batch broadcast(int32_t x) { return {_mm512_set1_epi32(x)}; }
+    friend mask operator==(batch a, batch b) { return {_mm512_cmpeq_epi32_mask(a.v, b.v)}; }
+};
+
+#elif defined(TURBOGRAPH_SIMD_AVX2)
+
+template<>
+struct batch<double> {
+    static constexpr size_t size = 4;
+    __m256d v;
+
+    static batch load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static batch broadcast(double x) { return {_mm256_set1_pd(x)}; }
+    friend batch operator+(batch a, batch b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend mask operator==(batch a, batch b) {
+        return {static_cast<uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)))};
+    }
+    double reduce_add() const {
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+};
+
+template<>
+struct batch<int64_t> {
+    static constexpr size_t size = 4;
+    __m256i v;
+
+    static batch load(const int64_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+    static batch broadcast(int64_t x) { return {_mm256_set1_epi64x(x)}; }
+    friend mask operator==(batch a, batch b) {
+        __m256d eq = _mm256_castsi256_pd(_mm256_cmpeq_epi64(a.v, b.v));
+        return {static_cast<uint32_t>(_mm256_movemask_pd(eq))};
+    }
+};
+
+template<>
+struct batch<int32_t> {
+    static constexpr size_t size = 8;
+    __m256i v;
+
+    static batch load(const int32_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+    static batch broadcast(int32_t x) { return {_mm256_set1_epi32(x)}; }
+    friend mask operator==(batch a, batch b) {
+        __m256 eq = _mm256_castsi256_ps(_mm256_cmpeq_epi32(a.v, b.v));
+        return {static_cast<uint32_t>(_mm256_movemask_ps(eq))};
+    }
+};
+
+#elif defined(TURBOGRAPH_SIMD_NEON)
+
+inline mask to_mask(uint64x2_t eq) {
+    return {static_cast<uint32_t>((vgetq_lane_u64(eq, 0) & 1) | ((vgetq_lane_u64(eq, 1) & 1) << 1))};
+}
+
+template<>
+struct batch<double> {
+    static constexpr size_t size = 2;
+    float64x2_t v;
+
+    static batch load(const double* p) { return {vld1q_f64(p)}; }
+    static batch broadcast(double x) { return {vdupq_n_f64(x)}; }
+    friend batch operator+(batch a, batch b) { return {vaddq_f64(a.v, b.v)}; }
+    friend mask operator==(batch a, batch b) { return to_mask(vceqq_f64(a.v, b.v)); }
+    double reduce_add() const { return vaddvq_f64(v); }
+};
+
+template<>
+struct batch<int64_t> {
+    static constexpr size_t size = 2;
+    int64x2_t v;
+
+    static batch load(const int64_t* p) { return {vld1q_s64(p)}; }
+    static batch broadcast(int64_t x) { return {vdupq_n_s64(x)}; }
+    friend mask operator==(batch a, batch b) { return to_mask(vceqq_s64(a.v, b.v)); }
+};
+
+template<>
+struct batch<int32_t> {
+    static constexpr size_t size = 4;
+    int32x4_t v;
+
+    static batch load(const int32_t* p) { return {vld1q_s32(p)}; }
+    static batch broadcast(int32_t x) { return {vdupq_n_s32(x)}; }
+    friend mask operator==(batch a, batch b) {
+        // 每个通道取最低位后按位权相加
+        static const int32_t kShifts[4] = {0, 1, 2, 3};
+        uint32x4_t bits = vshlq_u32(vandq_u32(vceqq_s32(a.v, b.v), vdupq_n_u32(1)), vld1q_s32(kShifts));
+        return {vaddvq_u32(bits)};
+    }
+};
+
+#else
+
+/**
+ * @brief 标量实现：固定4个通道，块内无提前退出，编译器可以自动向量化
+ */
+template<typename T>
+struct batch {
+    static constexpr size_t size = 4;
+    T v[size];
+
+    static batch load(const T* p) {
+        batch b;
+        for (size_t i = 0; i < size; i++) b.v[i] = p[i];
+        return b;
+    }
+    static batch broadcast(T x) {
+        batch b;
+        for (size_t i = 0; i < size; i++) b.v[i] = x;
+        return b;
+    }
+    friend batch operator+(batch a, batch b) {
+        for (size_t i = 0; i < size; i++) a.v[i] += b.v[i];
+        return a;
+    }
+    friend mask operator==(batch a, batch b) {
+        uint32_t bits = 0;
+        for (size_t i = 0; i < size; i++) bits |= static_cast<uint32_t>(a.v[i] == b.v[i]) << i;
+        return {bits};
+    }
+    T reduce_add() const { return (v[0] + v[1]) + (v[2] + v[3]); }
+};
+
+#endif
+
+// ============================================
+// 列表内核
+// ============================================
+
+/**
+ * @brief 是否存在等于value的元素
+ * 每次比较4个向量，合并掩码后判断一次，提前退出的粒度为4个向量
+ */
+template<typename T>
+inline bool contains(const T* data, size_t n, T value) {
+    using B = batch<T>;
+    constexpr size_t W = B::size;
+    const B key = B::broadcast(value);
+    size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+        mask m = (B::load(data + i) == key) | (B::load(data + i + W) == key) |
+                 (B::load(data + i + 2 * W) == key) | (B::load(data + i + 3 * W) == key);
+        if (m.any()) return true;
+    }
+    for (; i + W <= n; i += W) {
+        if ((B::load(data + i) == key).any()) return true;
+    }
+    for (; i < n; i++) {
+        if (data[i] == value) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 等于value的元素个数
+ */
+template<typename T>
+inline int count_equal(const T* data, size_t n, T value) {
+    using B = batch<T>;
+    constexpr size_t W = B::size;
+    const B key = B::broadcast(value);
+    // 整向量部分的上界先算出来，GCC据此推不出尾部循环下标溢出（-Waggressive-loop-optimizations）
+    const size_t vector_end = n - n % W;
+    int count = 0;
+    size_t i = 0;
+    for (; i < vector_end; i += W) {
+        count += (B::load(data + i) == key).count();
+    }
+    for (; i < n; i++) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+/**
+ * @brief 按下标顺序累加（结果与逐元素相加逐位一致）
+ * 浮点加法不满足结合律，保持顺序的求和只能逐元素进行
+ */
+inline double sum_ordered(const double* data, size_t n) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief 重排求和顺序的累加（低精度变体）
+ * 4个向量累加器并行累加后合并，与顺序求和的差异在舍入误差量级
+ */
+inline double sum_reassociated(const double* data, size_t n) {
+    using B = batch<double>;
+    constexpr size_t W = B::size;
+    const size_t vector_end = n - n % (4 * W);   // 同count_equal，整向量部分的上界先算出来
+    size_t i = 0;
+    double sum = 0.0;
+    if (vector_end > 0) {
+        B acc0 = B::load(data);
+        B acc1 = B::load(data + W);
+        B acc2 = B::load(data + 2 * W);
+        B acc3 = B::load(data + 3 * W);
+        for (i = 4 * W; i < vector_end; i += 4 * W) {
+            acc0 = acc0 + B::load(data + i);
+            acc1 = acc1 + B::load(data + i + W);
+            acc2 = acc2 + B::load(data + i + 2 * W);
+            acc3 = acc3 + B::load(data + i + 3 * W);
+        }
+        sum = ((acc0 + acc1) + (acc2 + acc3)).reduce_add();
+    }
+    for (; i < n; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+} // namespace turbograph::simd
+
+#endif // TURBOGRAPH_SIMD_HPP
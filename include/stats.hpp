@@ -0,0 +1,211 @@
+#ifndef TURBOGRAPH_STATS_HPP
+#define TURBOGRAPH_STATS_HPP
+
+#include "probe.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 编译期开关
+// ============================================
+
+/**
+ * @brief 是否编译统计代码
+ * 定义TURBOGRAPH_NO_STATS（CMake选项TURBOGRAPH_WITH_STATS=OFF）时所有记录点在编译期消除，
+ * 执行路径上不再有任何判断；接口保留，查询结果为空
+ */
+#ifdef TURBOGRAPH_NO_STATS
+inline constexpr bool kStatsCompiled = false;
+#else
+inline constexpr bool kStatsCompiled = true;
+#endif
+
+/**
+ * @brief 统计用单调时钟（纳秒）
+ */
+inline uint64_t stats_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ============================================
+// 延迟直方图
+// ============================================
+
+/**
+ * @brief 按2的幂分桶的无锁延迟直方图
+ * 第i个桶的上界为 2^(i+kMinShift) 纳秒（64ns起），最后一个桶不设上界
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t kBuckets = 24;
+    static constexpr unsigned kMinShift = 6;
+
+    struct Snapshot {
+        std::array<uint64_t, kBuckets> counts{};   // 各桶计数（非累计）
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+    };
+
+    void record(uint64_t ns);
+    Snapshot snapshot() const;
+
+    /**
+     * @brief 第i个桶的上界（纳秒），最后一个桶返回0表示无上界
+     */
+    static uint64_t upper_bound_ns(size_t i);
+
+private:
+    std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+    std::atomic<uint64_t> sum_ns_{0};
+};
+
+// ============================================
+// 管道统计
+// ============================================
+
+/**
+ * @brief 单个步骤的累计耗时
+ */
+struct StepStats {
+    std::string op;
+    std::string output;
+    uint64_t calls = 0;
+    uint64_t ticks = 0;   // 单位见probe::kTickUnit
+};
+
+/**
+ * @brief 某一时刻的管道统计
+ */
+struct PipelineStatsSnapshot {
+    std::string name;
+    std::string fingerprint;
+
+    uint64_t compiles = 0;            // 实际调用编译器的次数（缓存未命中）
+    uint64_t compile_ns = 0;
+    uint64_t loads = 0;               // 成功加载模块的次数
+    uint64_t load_ns = 0;             // dlopen等加载耗时（不含编译）
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+
+    uint64_t executions = 0;          // execute/execute_batch调用次数
+    uint64_t failures = 0;
+    uint64_t rows = 0;                // 执行的总行数（逐行调用计1行）
+    LatencyHistogram::Snapshot latency;   // 每次调用的耗时
+
+    std::vector<StepStats> steps;     // 插桩模式下的逐步骤计数，否则为空
+};
+
+/**
+ * @brief 一个管道（按指纹区分）的累计统计，各记录方法可并发调用
+ */
+class PipelineStats {
+public:
+    PipelineStats(std::string name, std::string fingerprint);
+
+    PipelineStats(const PipelineStats&) = delete;
+    PipelineStats& operator=(const PipelineStats&) = delete;
+
+    void record_compile(uint64_t ns);
+    void record_load(uint64_t ns, bool cache_hit);
+
+    void record_execute(uint64_t ns, size_t rows, bool ok) {
+        executions_.fetch_add(1, std::memory_order_relaxed);
+        rows_.fetch_add(rows, std::memory_order_relaxed);
+        if (!ok) {
+            failures_.fetch_add(1, std::memory_order_relaxed);
+        }
+        latency_.record(ns);
+    }
+
+    /**
+     * @brief 为插桩模块分配步骤计数数组
+     * 步骤与当前数组一致时复用（同一管道的多个模块累计到一起），否则换新数组并清零；
+     * 旧数组不释放，仍挂接在旧模块上的写入不会越界
+     */
+    StepCounter* attach_steps(const char* const* names, uint32_t num_steps);
+
+    PipelineStatsSnapshot snapshot() const;
+
+    const std::string& name() const { return name_; }
+    const std::string& fingerprint() const { return fingerprint_; }
+
+private:
+    const std::string name_;
+    const std::string fingerprint_;
+
+    std::atomic<uint64_t> compiles_{0};
+    std::atomic<uint64_t> compile_ns_{0};
+    std::atomic<uint64_t> loads_{0};
+    std::atomic<uint64_t> load_ns_{0};
+    std::atomic<uint64_t> cache_hits_{0};
+    std::atomic<uint64_t> cache_misses_{0};
+
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> rows_{0};
+    LatencyHistogram latency_;
+
+    mutable std::mutex steps_mutex_;
+    std::vector<std::string> step_names_;
+    StepCounter* step_counters_ = nullptr;
+    std::vector<std::unique_ptr<StepCounter[]>> step_tables_;
+};
+
+// ============================================
+// 统计注册表
+// ============================================
+
+/**
+ * @brief 全局统计注册表
+ * 运行时默认关闭；关闭时执行器与编译器不取统计对象，执行路径只多一次空指针判断
+ */
+class StatsRegistry {
+public:
+    static StatsRegistry& instance();
+
+    StatsRegistry(const StatsRegistry&) = delete;
+    StatsRegistry& operator=(const StatsRegistry&) = delete;
+
+    /**
+     * @brief 开启或关闭统计（只影响之后加载的模块），未编译统计代码时忽略
+     */
+    void set_enabled(bool enabled) { enabled_.store(enabled && kStatsCompiled, std::memory_order_relaxed); }
+    bool enabled() const { return kStatsCompiled && enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取或创建管道的统计对象，统计关闭时返回nullptr
+     */
+    std::shared_ptr<PipelineStats> pipeline(const std::string& name, const std::string& fingerprint);
+
+    /**
+     * @brief 所有管道的统计，按名称、指纹排序
+     */
+    std::vector<PipelineStatsSnapshot> snapshot() const;
+
+    /**
+     * @brief Prometheus文本格式（text/plain; version=0.0.4）
+     */
+    static std::string format_prometheus(const std::vector<PipelineStatsSnapshot>& snapshots);
+
+private:
+    StatsRegistry() = default;
+
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex mutex_;
+    // 按指纹，不删除：SO中挂接的计数数组归统计对象所有
+    std::unordered_map<std::string, std::shared_ptr<PipelineStats>> pipelines_;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_STATS_HPP
@@ -0,0 +1,75 @@
+#ifndef TURBOGRAPH_THREAD_POOL_HPP
+#define TURBOGRAPH_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace turbograph {
+
+// ============================================
+// 有界线程池（后台编译）
+// ============================================
+
+/**
+ * @brief 固定线程数、有界队列的线程池
+ * 用于后台JIT编译：队列满时submit直接返回false，由调用方稍后重试，
+ * 保证一次推送大量配置时不会无限堆积编译任务
+ */
+class ThreadPool {
+public:
+    /**
+     * @param num_threads 工作线程数（至少为1）
+     * @param max_pending 等待队列上限（不含正在执行的任务）
+     */
+    explicit ThreadPool(size_t num_threads, size_t max_pending = 64);
+
+    /**
+     * @brief 析构时丢弃尚未开始的任务，等待正在执行的任务结束
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief 提交任务
+     * @return 队列已满或线程池已停止时返回false
+     */
+    bool submit(std::function<void()> task);
+
+    /**
+     * @brief 等待队列清空且没有正在执行的任务
+     */
+    void wait_idle();
+
+    /**
+     * @brief 等待中的任务数
+     */
+    size_t pending() const;
+
+    /**
+     * @brief 工作线程数
+     */
+    size_t num_threads() const { return workers_.size(); }
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    size_t max_pending_;
+    size_t active_ = 0;
+    bool stopping_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable task_cv_;
+    std::condition_variable idle_cv_;
+};
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_THREAD_POOL_HPP
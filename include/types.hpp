@@ -9,6 +9,8 @@
 #include <functional>
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <cstdint>
 
 namespace turbograph {
 
@@ -126,6 +128,16 @@ inline DataType get_list_element_type(DataType list_type) {
     }
 }
 
+/**
+ * @brief 中间结果的计算精度策略
+ * DOUBLE：浮点算子按double计算与存储（默认）
+ * FLOAT：浮点算子按float计算与存储，整数结果按值域收窄（见compute_step_type）
+ */
+enum class Precision {
+    DOUBLE,
+    FLOAT
+};
+
 // ============================================
 // 执行上下文
 // ============================================
@@ -152,8 +164,53 @@ struct Variable {
     }
 };
 
+/**
+ * @brief 上下文布局
+ * 每个PipelineConfig计算一次，将变量名映射为连续的槽位下标
+ */
+class ContextLayout {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    ContextLayout() = default;
+    
+    /**
+     * @brief 添加槽位（已存在则返回原下标）
+     */
+    size_t add_slot(const std::string& name, DataType type) {
+        auto it = index_.find(name);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        size_t slot = names_.size();
+        index_.emplace(name, slot);
+        names_.push_back(name);
+        types_.push_back(type);
+        return slot;
+    }
+    
+    /**
+     * @brief 查找槽位，不存在返回npos
+     */
+    size_t slot_of(const std::string& name) const {
+        auto it = index_.find(name);
+        return it != index_.end() ? it->second : npos;
+    }
+    
+    size_t size() const { return names_.size(); }
+    const std::string& name(size_t slot) const { return names_[slot]; }
+    DataType type(size_t slot) const { return types_[slot]; }
+    
+private:
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<std::string> names_;
+    std::vector<DataType> types_;
+};
+
 /**
  * @brief 执行上下文
+ * 绑定ContextLayout时，布局内的变量存放在连续的槽位数组中，
+ * 可通过set_slot/get_slot按下标访问；reset()后可跨请求复用，不释放存储
  */
 class ExecutionContext {
 public:
@@ -162,7 +219,20 @@ public:
     
     ExecutionContext() = default;
     
+    explicit ExecutionContext(std::shared_ptr<const ContextLayout> layout)
+        : layout_(std::move(layout)) {
+        if (layout_) {
+            slots_.resize(layout_->size());
+            present_.assign(layout_->size(), 0);
+        }
+    }
+    
     void set_variable(const std::string& name, DataType type, const ValueVariant& value) {
+        size_t slot = layout_ ? layout_->slot_of(name) : ContextLayout::npos;
+        if (slot != ContextLayout::npos) {
+            set_slot(slot, value);
+            return;
+        }
         Variable var(name, type);
         var.value = value;
         variables[name] = std::move(var);
@@ -170,20 +240,74 @@ public:
     
     template<typename T>
     T get(const std::string& name) const {
-        auto it = variables.find(name);
-        if (it == variables.end()) {
+        const ValueVariant* value = find(name);
+        if (!value) {
             throw std::runtime_error("Variable not found: " + name);
         }
-        return it->second.get<T>();
+        return std::get<T>(*value);
     }
     
     bool has_variable(const std::string& name) const {
-        return variables.find(name) != variables.end();
+        return find(name) != nullptr;
+    }
+    
+    /**
+     * @brief 按名称查找变量值，不存在返回nullptr
+     */
+    const ValueVariant* find(const std::string& name) const {
+        size_t slot = layout_ ? layout_->slot_of(name) : ContextLayout::npos;
+        if (slot != ContextLayout::npos) {
+            return present_[slot] ? &slots_[slot] : nullptr;
+        }
+        auto it = variables.find(name);
+        return it != variables.end() ? &it->second.value : nullptr;
+    }
+    
+    // ---------- 槽位访问（要求已绑定布局） ----------
+    
+    /**
+     * @brief 写入槽位，同类型时复用已有存储
+     */
+    template<typename T>
+    void set_slot(size_t slot, T&& value) {
+        slots_[slot] = std::forward<T>(value);
+        present_[slot] = 1;
+    }
+    
+    template<typename T>
+    const T& get_slot(size_t slot) const {
+        return std::get<T>(slots_[slot]);
+    }
+    
+    /**
+     * @brief 获取槽位存储（可原地修改，调用方负责mark_slot）
+     */
+    ValueVariant& slot_ref(size_t slot) { return slots_[slot]; }
+    const ValueVariant& slot_ref(size_t slot) const { return slots_[slot]; }
+    
+    void mark_slot(size_t slot) { present_[slot] = 1; }
+    bool has_slot(size_t slot) const { return present_[slot] != 0; }
+    
+    const ContextLayout* layout() const { return layout_.get(); }
+    
+    /**
+     * @brief 重置上下文以便复用（保留槽位存储）
+     */
+    void reset() {
+        std::fill(present_.begin(), present_.end(), 0);
+        if (!variables.empty()) {
+            variables.clear();
+        }
     }
     
     void clear() {
-        variables.clear();
+        reset();
     }
+    
+private:
+    std::shared_ptr<const ContextLayout> layout_;
+    std::vector<ValueVariant> slots_;
+    std::vector<uint8_t> present_;
 };
 
 // ============================================
@@ -218,6 +342,29 @@ struct Arg {
     static Arg literal(const std::string& val, DataType type) {
         return Arg(val, ArgType::LITERAL, type);
     }
+    
+    /**
+     * @brief 字符串字面量的取值
+     * 生成代码按原文嵌入字面量，字符串字面量写作带引号的C++字符串（如"\"|\""）；
+     * 解释执行时去掉引号并处理\\、\"、\n、\t转义，未加引号时按原文
+     */
+    std::string string_value() const {
+        if (value.size() < 2 || value.front() != '"' || value.back() != '"') {
+            return value;
+        }
+        std::string result;
+        result.reserve(value.size() - 2);
+        for (size_t i = 1; i + 1 < value.size(); i++) {
+            char c = value[i];
+            if (c == '\\' && i + 2 < value.size()) {
+                c = value[++i];
+                if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+            }
+            result.push_back(c);
+        }
+        return result;
+    }
 };
 
 /**
@@ -231,6 +378,7 @@ struct OpCall {
     
     OpCall() = default;
     OpCall(const std::string& name) : op_name(name) {}
+    OpCall(const OpCall&) = default;   // 有自定义赋值运算符时隐式拷贝构造已弃用（-Wdeprecated-copy）
     
     // 赋值运算符重载，支持链式赋值
     OpCall& operator=(const OpCall& other) {
@@ -291,12 +439,26 @@ struct PipelineConfig {
         std::string name;
         DataType type;
         bool required;
+        bool broadcast = false;   // 请求级常量输入：批量执行时该列只有一个元素，所有行共用
     };
     
     std::vector<IOField> inputs;
     std::vector<IOField> outputs;
     std::vector<IOField> variables;
     
+    // 生成代码中间结果的精度策略；解释器与字节码始终按double计算
+    Precision precision = Precision::DOUBLE;
+    
+    // 跨请求结果缓存（见result_cache.hpp）；不影响计算结果，不参与指纹
+    struct CachePolicy {
+        std::vector<std::string> keys;   // 缓存键包含的输入（需决定所有输出），为空时不缓存
+        uint64_t ttl_ms = 0;             // 条目有效期，0表示不过期
+        size_t capacity = 4096;          // 条目数上限（按分片和组相联向上取整为2的幂）
+        
+        bool enabled() const { return !keys.empty(); }
+    };
+    CachePolicy cache;
+    
     // 哈希指纹（用于缓存）
     std::string fingerprint;
     
@@ -306,6 +468,39 @@ struct PipelineConfig {
     std::string compute_fingerprint();
 };
 
+/**
+ * @brief 配置指纹的规范化序列化版本，序列化规则变化时递增
+ */
+constexpr uint32_t kConfigHashVersion = 1;
+
+/**
+ * @brief 计算配置指纹（128位MurmurHash3，32位十六进制）
+ * 覆盖名称、输入/变量/输出定义、算子、参数类型与取值及算子选项，
+ * 结果在不同进程和主机间稳定
+ */
+std::string compute_config_fingerprint(const PipelineConfig& config);
+
+/**
+ * @brief 根据管道配置构建上下文布局
+ * 槽位顺序：inputs、variables、步骤输出、outputs
+ */
+inline std::shared_ptr<const ContextLayout> make_context_layout(const PipelineConfig& config) {
+    auto layout = std::make_shared<ContextLayout>();
+    for (const auto& input : config.inputs) {
+        layout->add_slot(input.name, input.type);
+    }
+    for (const auto& var : config.variables) {
+        layout->add_slot(var.name, var.type);
+    }
+    for (const auto& step : config.steps) {
+        layout->add_slot(step.output_var, DataType::UNKNOWN);
+    }
+    for (const auto& output : config.outputs) {
+        layout->add_slot(output.name, output.type);
+    }
+    return layout;
+}
+
 } // namespace turbograph
 
 #endif // TURBOGRAPH_TYPES_HPP
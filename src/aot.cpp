@@ -0,0 +1,31 @@
+#include "aot.hpp"
+
+namespace turbograph {
+
+// ============================================
+// AOT管道表实现
+// ============================================
+
+AotRegistry& AotRegistry::instance() {
+    // 函数内静态对象：其他翻译单元的静态注册器先于首次调用构造时也能正确初始化
+    static AotRegistry registry;
+    return registry;
+}
+
+void AotRegistry::add(const AotPipeline& pipeline) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pipelines_.emplace(pipeline.fingerprint, &pipeline);
+}
+
+const AotPipeline* AotRegistry::find(const std::string& fingerprint) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pipelines_.find(fingerprint);
+    return it == pipelines_.end() ? nullptr : it->second;
+}
+
+size_t AotRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pipelines_.size();
+}
+
+} // namespace turbograph
@@ -0,0 +1,417 @@
+#include "arrow_adapter.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace turbograph {
+
+// ============================================
+// 导出数组与schema的内存管理
+// ============================================
+
+namespace {
+
+struct FreeDeleter {
+    void operator()(void* p) const { std::free(p); }
+};
+
+/**
+ * @brief 导出数组的私有数据：缓冲区与子数组归数组所有，release时一并释放
+ */
+struct ArrayData {
+    std::vector<std::unique_ptr<void, FreeDeleter>> storage;
+    std::vector<const void*> buffers;
+    std::vector<ArrowArray*> children;
+};
+
+void release_array(ArrowArray* array) {
+    auto* data = static_cast<ArrayData*>(array->private_data);
+    for (ArrowArray* child : data->children) {
+        // 消费方可能已移走子数组（release置空）
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+/**
+ * @brief 初始化导出数组，所有缓冲区先置空（第0个为validity，输出不含null）
+ */
+ArrayData* init_array(ArrowArray* array, int64_t length, size_t n_buffers) {
+    auto* data = new ArrayData();
+    data->buffers.assign(n_buffers, nullptr);
+    *array = ArrowArray{};
+    array->length = length;
+    array->n_buffers = static_cast<int64_t>(n_buffers);
+    array->buffers = data->buffers.data();
+    array->release = &release_array;
+    array->private_data = data;
+    return data;
+}
+
+ArrowArray* add_child(ArrowArray* parent, ArrayData* data) {
+    data->children.push_back(new ArrowArray{});
+    parent->n_children = static_cast<int64_t>(data->children.size());
+    parent->children = data->children.data();
+    return data->children.back();
+}
+
+/**
+ * @brief 分配64字节对齐的缓冲区（Arrow推荐对齐），由数组持有
+ */
+void* allocate(ArrayData* data, size_t bytes) {
+    size_t size = (std::max<size_t>(bytes, 1) + 63) / 64 * 64;
+    void* buffer = std::aligned_alloc(64, size);
+    if (!buffer) {
+        throw std::bad_alloc();
+    }
+    data->storage.emplace_back(buffer);
+    return buffer;
+}
+
+struct SchemaData {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema*> children;
+};
+
+void release_schema(ArrowSchema* schema) {
+    auto* data = static_cast<SchemaData*>(schema->private_data);
+    for (ArrowSchema* child : data->children) {
+        if (child->release) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+SchemaData* init_schema(ArrowSchema* schema, const std::string& format, const std::string& name) {
+    auto* data = new SchemaData{format, name, {}};
+    *schema = ArrowSchema{};
+    schema->format = data->format.c_str();
+    schema->name = data->name.c_str();
+    schema->release = &release_schema;
+    schema->private_data = data;
+    return data;
+}
+
+ArrowSchema* add_child(ArrowSchema* parent, SchemaData* data) {
+    data->children.push_back(new ArrowSchema{});
+    parent->n_children = static_cast<int64_t>(data->children.size());
+    parent->children = data->children.data();
+    return data->children.back();
+}
+
+template<typename T>
+struct TypeTag {
+    using type = T;
+};
+
+/**
+ * @brief 按DataType分派到对应的C++类型
+ */
+template<typename F>
+bool visit_type(DataType type, F&& f) {
+    switch (type) {
+        case DataType::INT32: f(TypeTag<int32_t>{}); return true;
+        case DataType::INT64: f(TypeTag<int64_t>{}); return true;
+        case DataType::DOUBLE: f(TypeTag<double>{}); return true;
+        case DataType::FLOAT: f(TypeTag<float>{}); return true;
+        case DataType::STRING: f(TypeTag<std::string>{}); return true;
+        case DataType::INT32_LIST: f(TypeTag<std::vector<int32_t>>{}); return true;
+        case DataType::INT64_LIST: f(TypeTag<std::vector<int64_t>>{}); return true;
+        case DataType::DOUBLE_LIST: f(TypeTag<std::vector<double>>{}); return true;
+        case DataType::STRING_LIST: f(TypeTag<std::vector<std::string>>{}); return true;
+        default: return false;
+    }
+}
+
+size_t scalar_size(DataType type) {
+    switch (type) {
+        case DataType::INT32:
+        case DataType::FLOAT: return 4;
+        case DataType::INT64:
+        case DataType::DOUBLE: return 8;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief 数组是否可能包含null（null_count未知时以validity缓冲区是否存在判断）
+ */
+bool may_have_nulls(const ArrowArray& array) {
+    return array.null_count > 0 || (array.null_count < 0 && array.n_buffers > 0 && array.buffers[0]);
+}
+
+/**
+ * @brief 偏移数组，总长度超出int32时返回nullptr
+ */
+template<typename Rows, typename Size>
+int32_t* fill_offsets(ArrayData* data, const Rows& rows, size_t n, Size&& size) {
+    auto* offsets = static_cast<int32_t*>(allocate(data, (n + 1) * sizeof(int32_t)));
+    int64_t total = 0;
+    offsets[0] = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += static_cast<int64_t>(size(rows[i]));
+        if (total > INT32_MAX) {
+            std::cerr << "Arrow output exceeds 32-bit offsets" << std::endl;
+            return nullptr;
+        }
+        offsets[i + 1] = static_cast<int32_t>(total);
+    }
+    return offsets;
+}
+
+/**
+ * @brief 将字符串编码为utf8数组
+ */
+bool fill_utf8(ArrowArray* array, const std::string* const* strings, size_t n) {
+    ArrayData* data = init_array(array, static_cast<int64_t>(n), 3);
+    int32_t* offsets = fill_offsets(data, strings, n, [](const std::string* s) { return s->size(); });
+    if (!offsets) {
+        return false;
+    }
+    auto* chars = static_cast<char*>(allocate(data, offsets[n]));
+    for (size_t i = 0; i < n; i++) {
+        std::memcpy(chars + offsets[i], strings[i]->data(), strings[i]->size());
+    }
+    data->buffers[1] = offsets;
+    data->buffers[2] = chars;
+    return true;
+}
+
+/**
+ * @brief 将逐行结果编码为Arrow数组
+ */
+template<typename T>
+bool encode_column(ArrowArray* array, const std::vector<T>& rows, size_t n) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::vector<const std::string*> strings(n);
+        for (size_t i = 0; i < n; i++) {
+            strings[i] = &rows[i];
+        }
+        return fill_utf8(array, strings.data(), n);
+    } else {
+        using E = typename T::value_type;
+        ArrayData* data = init_array(array, static_cast<int64_t>(n), 2);
+        int32_t* offsets = fill_offsets(data, rows, n, [](const T& row) { return row.size(); });
+        if (!offsets) {
+            return false;
+        }
+        data->buffers[1] = offsets;
+        const size_t total = static_cast<size_t>(offsets[n]);
+        ArrowArray* child = add_child(array, data);
+        if constexpr (std::is_same_v<E, std::string>) {
+            std::vector<const std::string*> strings;
+            strings.reserve(total);
+            for (size_t i = 0; i < n; i++) {
+                for (const auto& s : rows[i]) {
+                    strings.push_back(&s);
+                }
+            }
+            return fill_utf8(child, strings.data(), total);
+        } else {
+            ArrayData* child_data = init_array(child, static_cast<int64_t>(total), 2);
+            auto* items = static_cast<E*>(allocate(child_data, total * sizeof(E)));
+            for (size_t i = 0; i < n; i++) {
+                std::copy(rows[i].begin(), rows[i].end(), items + offsets[i]);
+            }
+            child_data->buffers[1] = items;
+            return true;
+        }
+    }
+}
+
+} // namespace
+
+// ============================================
+// Arrow记录批次适配器实现
+// ============================================
+
+ArrowBatchAdapter::ArrowBatchAdapter(const PipelineConfig& config)
+    : config_(config), columns_(config.inputs.size()), scratch_(config.outputs.size()) {}
+
+const char* ArrowBatchAdapter::format_of(DataType type) {
+    switch (type) {
+        case DataType::INT32: return "i";
+        case DataType::INT64: return "l";
+        case DataType::FLOAT: return "f";
+        case DataType::DOUBLE: return "g";
+        case DataType::STRING: return "u";
+        case DataType::INT32_LIST:
+        case DataType::INT64_LIST:
+        case DataType::DOUBLE_LIST:
+        case DataType::STRING_LIST: return format_of(get_list_element_type(type));
+        default: return nullptr;
+    }
+}
+
+bool ArrowBatchAdapter::bind(const ArrowSchema& schema) {
+    bound_ = false;
+    if (!schema.format || std::strcmp(schema.format, "+s") != 0) {
+        std::cerr << "Arrow record batch schema must be a struct for pipeline: " << config_.name << std::endl;
+        return false;
+    }
+
+    children_.assign(config_.inputs.size(), 0);
+    for (size_t i = 0; i < config_.inputs.size(); i++) {
+        const auto& input = config_.inputs[i];
+        const ArrowSchema* field = nullptr;
+        for (int64_t c = 0; c < schema.n_children; c++) {
+            const ArrowSchema* child = schema.children[c];
+            if (child->name && input.name == child->name) {
+                field = child;
+                children_[i] = static_cast<size_t>(c);
+                break;
+            }
+        }
+        if (!field) {
+            std::cerr << "Arrow column missing for input: " << input.name << std::endl;
+            return false;
+        }
+
+        // 列表为32位偏移的list，元素类型与列表元素一致
+        const char* expected = format_of(input.type);
+        bool matches = false;
+        if (is_list_type(input.type)) {
+            matches = std::strcmp(field->format, "+l") == 0 && field->n_children == 1 &&
+                      std::strcmp(field->children[0]->format, expected) == 0;
+        } else {
+            matches = expected && std::strcmp(field->format, expected) == 0;
+        }
+        if (!matches) {
+            std::cerr << "Arrow column type mismatch for input: " << input.name << " (format '"
+                      << field->format << "', expected " << data_type_to_string(input.type) << ")" << std::endl;
+            return false;
+        }
+    }
+
+    bound_ = true;
+    return true;
+}
+
+bool ArrowBatchAdapter::resolve_column(size_t input, const ArrowArray& child, int64_t row_offset) {
+    const auto& field = config_.inputs[input];
+    if (may_have_nulls(child)) {
+        std::cerr << "Arrow column contains nulls for input: " << field.name << std::endl;
+        return false;
+    }
+
+    OffsetColumn& column = columns_[input];
+    column = OffsetColumn{};
+    if (!is_list_type(field.type) && field.type != DataType::STRING) {
+        column.values = static_cast<const char*>(child.buffers[1]) + row_offset * scalar_size(field.type);
+        return true;
+    }
+
+    // 偏移指向子数组（或utf8的字节缓冲区），数组切片只作用于偏移缓冲区
+    column.offsets = static_cast<const int32_t*>(child.buffers[1]) + row_offset;
+    if (field.type == DataType::STRING) {
+        column.values = child.buffers[2];
+        return true;
+    }
+
+    const ArrowArray& items = *child.children[0];
+    if (may_have_nulls(items)) {
+        std::cerr << "Arrow list elements contain nulls for input: " << field.name << std::endl;
+        return false;
+    }
+    if (field.type == DataType::STRING_LIST) {
+        column.value_offsets = static_cast<const int32_t*>(items.buffers[1]) + items.offset;
+        column.values = items.buffers[2];
+    } else {
+        column.values = static_cast<const char*>(items.buffers[1]) +
+                        items.offset * scalar_size(get_list_element_type(field.type));
+    }
+    return true;
+}
+
+bool ArrowBatchAdapter::execute(IPipelineExecutor& executor, const ArrowArray& batch, ArrowArray* out) {
+    if (!bound_) {
+        std::cerr << "Arrow adapter used before bind() for pipeline: " << config_.name << std::endl;
+        return false;
+    }
+    if (!batch.release) {
+        std::cerr << "Arrow record batch already released" << std::endl;
+        return false;
+    }
+    const size_t n = static_cast<size_t>(batch.length);
+    for (size_t i = 0; i < config_.inputs.size(); i++) {
+        if (children_[i] >= static_cast<size_t>(batch.n_children)) {
+            std::cerr << "Arrow record batch does not match bound schema" << std::endl;
+            return false;
+        }
+        const ArrowArray& child = *batch.children[children_[i]];
+        if (n > 0 && !resolve_column(i, child, batch.offset + child.offset)) {
+            return false;
+        }
+    }
+
+    // 输出批次：标量列直接作为执行器的输出缓冲区
+    ArrowArray result;
+    ArrayData* data = init_array(&result, static_cast<int64_t>(n), 1);
+    std::vector<void*> out_columns(config_.outputs.size());
+    for (size_t i = 0; i < config_.outputs.size(); i++) {
+        ArrowArray* child = add_child(&result, data);
+        DataType type = config_.outputs[i].type;
+        visit_type(type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (std::is_arithmetic_v<T>) {
+                ArrayData* child_data = init_array(child, static_cast<int64_t>(n), 2);
+                out_columns[i] = allocate(child_data, n * sizeof(T));
+                child_data->buffers[1] = out_columns[i];
+            } else {
+                if (!scratch_[i]) {
+                    scratch_[i] = std::make_shared<std::vector<T>>();
+                }
+                auto& rows = *static_cast<std::vector<T>*>(scratch_[i].get());
+                rows.resize(n);
+                out_columns[i] = rows.data();
+            }
+        });
+    }
+
+    OffsetBatch input{columns_.data(), columns_.size()};
+    OutputBatch output{out_columns.data(), out_columns.size()};
+    bool ok = n == 0 || executor.execute_offsets(input, output, n);
+
+    // 字符串/列表输出编码为偏移与值缓冲区
+    for (size_t i = 0; ok && i < config_.outputs.size(); i++) {
+        visit_type(config_.outputs[i].type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (!std::is_arithmetic_v<T>) {
+                ok = encode_column(result.children[i], *static_cast<std::vector<T>*>(scratch_[i].get()), n);
+            }
+        });
+    }
+
+    if (!ok) {
+        result.release(&result);
+        return false;
+    }
+    *out = result;
+    return true;
+}
+
+void ArrowBatchAdapter::export_schema(ArrowSchema* out) const {
+    SchemaData* data = init_schema(out, "+s", "");
+    for (const auto& output : config_.outputs) {
+        ArrowSchema* child = add_child(out, data);
+        if (is_list_type(output.type)) {
+            SchemaData* list = init_schema(child, "+l", output.name);
+            init_schema(add_child(child, list), format_of(output.type), "item");
+        } else {
+            init_schema(child, format_of(output.type), output.name);
+        }
+    }
+}
+
+} // namespace turbograph
@@ -0,0 +1,289 @@
+#include "batch_scheduler.hpp"
+#include "pipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace turbograph {
+
+// ============================================
+// 辅助函数
+// ============================================
+
+/**
+ * @brief 列中每个元素的字节数（与get_cpp_type_name对应的C++类型一致）
+ */
+static size_t column_stride(DataType type) {
+    switch (type) {
+        case DataType::INT32: return sizeof(int32_t);
+        case DataType::INT64: return sizeof(int64_t);
+        case DataType::DOUBLE: return sizeof(double);
+        case DataType::FLOAT: return sizeof(float);
+        case DataType::STRING: return sizeof(std::string);
+        case DataType::INT32_LIST: return sizeof(std::vector<int32_t>);
+        case DataType::INT64_LIST: return sizeof(std::vector<int64_t>);
+        case DataType::DOUBLE_LIST: return sizeof(std::vector<double>);
+        case DataType::STRING_LIST: return sizeof(std::vector<std::string>);
+        default: return 0;
+    }
+}
+
+static void pin_current_thread(size_t cpu) {
+#ifdef __linux__
+    unsigned cpus = std::thread::hardware_concurrency();
+    if (cpus == 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % cpus, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "Failed to pin batch worker to CPU " << cpu % cpus << std::endl;
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+// ============================================
+// 批次任务
+// ============================================
+
+struct BatchScheduler::Job {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief 一个参与线程的连续分段 [next, end)，本线程从头部取，其他线程从尾部窃取
+     */
+    struct Segment {
+        std::mutex mutex;
+        size_t next = 0;
+        size_t end = 0;
+    };
+
+    IPipelineExecutor* executor = nullptr;
+    ColumnBatch input;
+    OutputBatch output;
+    std::vector<size_t> input_strides;   // broadcast列为0，所有块共用第0行
+    std::vector<size_t> output_strides;
+    size_t n = 0;
+    size_t chunk_rows = 0;
+    size_t num_chunks = 0;
+
+    std::vector<Segment> segments;
+    std::atomic<size_t> next_slot{1};    // 0号分段属于调用线程
+    std::atomic<size_t> done_chunks{0};
+    std::atomic<bool> ok{true};
+
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+
+    explicit Job(size_t participants) : segments(participants) {}
+
+    /**
+     * @brief 领取一个块：先取自己分段的头部，再从其他分段尾部窃取
+     */
+    size_t take(size_t slot) {
+        {
+            Segment& own = segments[slot];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.next < own.end) {
+                return own.next++;
+            }
+        }
+        for (size_t k = 1; k < segments.size(); k++) {
+            Segment& victim = segments[(slot + k) % segments.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.next < victim.end) {
+                return --victim.end;
+            }
+        }
+        return npos;
+    }
+
+    /**
+     * @brief 对第chunk块调用执行器的批量入口
+     */
+    void run_chunk(size_t chunk) {
+        size_t begin = chunk * chunk_rows;
+        size_t rows = std::min(chunk_rows, n - begin);
+
+        // 列指针数组为线程局部，稳态无分配
+        thread_local std::vector<const void*> in_columns;
+        thread_local std::vector<void*> out_columns;
+        in_columns.resize(input_strides.size());
+        out_columns.resize(output_strides.size());
+        for (size_t i = 0; i < input_strides.size(); i++) {
+            in_columns[i] = static_cast<const char*>(input.columns[i]) + begin * input_strides[i];
+        }
+        for (size_t i = 0; i < output_strides.size(); i++) {
+            out_columns[i] = static_cast<char*>(output.columns[i]) + begin * output_strides[i];
+        }
+        ColumnBatch chunk_input{in_columns.data(), in_columns.size()};
+        OutputBatch chunk_output{out_columns.data(), out_columns.size()};
+
+        try {
+            if (!executor->execute_batch(chunk_input, chunk_output, rows)) {
+                ok.store(false, std::memory_order_relaxed);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Batch chunk failed: " << e.what() << std::endl;
+            ok.store(false, std::memory_order_relaxed);
+        }
+
+        if (done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == num_chunks) {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            done_cv.notify_all();
+        }
+    }
+};
+
+// ============================================
+// 批量调度器实现
+// ============================================
+
+BatchScheduler::BatchScheduler(const BatchSchedulerOptions& options)
+    : options_(options) {
+    size_t num_threads = options_.num_threads;
+    if (num_threads == 0) {
+        unsigned cpus = std::thread::hardware_concurrency();
+        num_threads = cpus > 1 ? cpus - 1 : 0;
+    }
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+BatchScheduler::~BatchScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    job_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t BatchScheduler::chunk_rows(const PipelineConfig& config, size_t n) const {
+    size_t row_bytes = 0;
+    for (const auto& input : config.inputs) {
+        if (!input.broadcast) {
+            row_bytes += column_stride(input.type);
+        }
+    }
+    for (const auto& output : config.outputs) {
+        row_bytes += column_stride(output.type);
+    }
+    size_t rows = options_.chunk_bytes / std::max<size_t>(row_bytes, 1);
+    rows = std::clamp(rows, options_.min_chunk_rows, std::max(options_.min_chunk_rows, options_.max_chunk_rows));
+
+    // 每个参与线程至少分到约4块，负载不均时有块可窃取
+    size_t participants = workers_.size() + 1;
+    size_t balanced = (n + 4 * participants - 1) / (4 * participants);
+    rows = std::min(rows, std::max(balanced, options_.min_chunk_rows));
+    return std::max<size_t>(rows, 1);
+}
+
+bool BatchScheduler::run(IPipelineExecutor& executor, const PipelineConfig& config,
+                         const ColumnBatch& input, OutputBatch& output, size_t n) {
+    if (input.num_columns < config.inputs.size() || output.num_columns < config.outputs.size()) {
+        std::cerr << "Batch column count mismatch for pipeline: " << config.name << std::endl;
+        return false;
+    }
+    if (workers_.empty() || n < options_.parallel_threshold) {
+        return executor.execute_batch(input, output, n);
+    }
+
+    size_t rows = chunk_rows(config, n);
+    size_t num_chunks = (n + rows - 1) / rows;
+    if (num_chunks <= 1) {
+        return executor.execute_batch(input, output, n);
+    }
+
+    // 块按连续分段均分给各参与线程，线程按顺序处理本段，访问的列区间连续
+    size_t participants = std::min(workers_.size() + 1, num_chunks);
+    auto job = std::make_shared<Job>(participants);
+    job->executor = &executor;
+    job->input = input;
+    job->output = output;
+    job->n = n;
+    job->chunk_rows = rows;
+    job->num_chunks = num_chunks;
+    for (const auto& field : config.inputs) {
+        job->input_strides.push_back(field.broadcast ? 0 : column_stride(field.type));
+    }
+    for (const auto& field : config.outputs) {
+        job->output_strides.push_back(column_stride(field.type));
+    }
+    for (size_t slot = 0; slot < participants; slot++) {
+        job->segments[slot].next = num_chunks * slot / participants;
+        job->segments[slot].end = num_chunks * (slot + 1) / participants;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(job);
+    }
+    job_cv_.notify_all();
+
+    participate(*job, 0);
+
+    {
+        std::unique_lock<std::mutex> lock(job->done_mutex);
+        job->done_cv.wait(lock, [&] {
+            return job->done_chunks.load(std::memory_order_acquire) == job->num_chunks;
+        });
+    }
+
+    // 全部块已完成；还未被工作线程取走的任务直接移除
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find(jobs_.begin(), jobs_.end(), job);
+        if (it != jobs_.end()) {
+            jobs_.erase(it);
+        }
+    }
+    return job->ok.load(std::memory_order_relaxed);
+}
+
+void BatchScheduler::participate(Job& job, size_t slot) {
+    for (size_t chunk = job.take(slot); chunk != Job::npos; chunk = job.take(slot)) {
+        job.run_chunk(chunk);
+    }
+}
+
+void BatchScheduler::worker_loop(size_t index) {
+    if (options_.pin_threads) {
+        // 调用线程通常在0号CPU附近，工作线程从1号开始
+        pin_current_thread(index + 1);
+    }
+    while (true) {
+        std::shared_ptr<Job> job;
+        size_t slot;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = jobs_.front();
+            slot = job->next_slot.fetch_add(1, std::memory_order_relaxed);
+            // 参与线程已满的任务出队，后续工作线程服务下一个批次
+            if (slot + 1 >= job->segments.size()) {
+                jobs_.pop_front();
+            }
+        }
+        if (slot < job->segments.size()) {
+            participate(*job, slot);
+        }
+    }
+}
+
+} // namespace turbograph
@@ -0,0 +1,416 @@
+#include "bytecode.hpp"
+#include "code_generator.hpp"
+#include "ops.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace turbograph {
+
+// ============================================
+// 操作数读取与结果写入
+// ============================================
+
+namespace {
+
+/**
+ * @brief 读取数值操作数（整数与浮点统一转换为double）
+ */
+inline double read_number(const Operand& operand, const BytecodeProgram& program,
+                          const ExecutionContext& ctx) {
+    if (operand.is_const) {
+        return program.numbers[operand.index];
+    }
+    if (!ctx.has_slot(operand.index)) {
+        return 0.0;
+    }
+    const ValueVariant& value = ctx.slot_ref(operand.index);
+    switch (value.index()) {
+        case 0: return static_cast<double>(*std::get_if<int32_t>(&value));
+        case 1: return static_cast<double>(*std::get_if<int64_t>(&value));
+        case 2: return *std::get_if<double>(&value);
+        case 3: return static_cast<double>(*std::get_if<float>(&value));
+        default: return 0.0;
+    }
+}
+
+/**
+ * @brief 读取任意操作数，缺失的变量返回nullptr
+ */
+inline const ValueVariant* read_value(const Operand& operand, const BytecodeProgram& program,
+                                      const ExecutionContext& ctx) {
+    if (operand.is_const) {
+        return &program.constants[operand.index];
+    }
+    return ctx.has_slot(operand.index) ? &ctx.slot_ref(operand.index) : nullptr;
+}
+
+/**
+ * @brief 按指令的输出类型写入数值结果
+ */
+template<typename T>
+inline void store_number(const Instruction& ins, ExecutionContext& ctx, T value) {
+    switch (ins.output_type) {
+        case DataType::INT32: ctx.set_slot(ins.output, static_cast<int32_t>(value)); break;
+        case DataType::INT64: ctx.set_slot(ins.output, static_cast<int64_t>(value)); break;
+        case DataType::FLOAT: ctx.set_slot(ins.output, static_cast<float>(value)); break;
+        default: ctx.set_slot(ins.output, static_cast<double>(value)); break;
+    }
+}
+
+inline bool type_error(const Instruction& ins, const char* expected) {
+    std::cerr << "Bytecode type error at opcode " << static_cast<int>(ins.opcode)
+              << ": expected " << expected << std::endl;
+    return false;
+}
+
+// ============================================
+// 指令处理函数
+// ============================================
+
+template<double (*F)(double, double)>
+bool binary_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    double a = read_number(ins.args[0], program, ctx);
+    double b = read_number(ins.args[1], program, ctx);
+    store_number(ins, ctx, F(a, b));
+    return true;
+}
+
+template<typename R, R (*F)(double)>
+bool unary_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    store_number(ins, ctx, F(read_number(ins.args[0], program, ctx)));
+    return true;
+}
+
+/**
+ * @brief 类型转换：整数输入按整数读取，避免int64经double丢失精度
+ */
+template<typename T>
+bool convert_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const ValueVariant* value = read_value(ins.args[0], program, ctx);
+    T result{};
+    if (value && !ins.args[0].is_const) {
+        std::visit([&result](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_arithmetic_v<V>) {
+                result = static_cast<T>(v);
+            }
+        }, *value);
+    } else if (value) {
+        result = static_cast<T>(program.numbers[ins.args[0].index]);
+    }
+    store_number(ins, ctx, result);
+    return true;
+}
+
+bool if_else_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    bool cond = read_number(ins.args[0], program, ctx) != 0.0;
+    store_number(ins, ctx, read_number(ins.args[cond ? 1 : 2], program, ctx));
+    return true;
+}
+
+bool avg_avg_log_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    // 缺省参数与ops::avg_avg_log保持一致
+    int32_t params[4] = {1000, 15000, 5000, 250000};
+    for (size_t i = 1; i < ins.argc; i++) {
+        params[i - 1] = static_cast<int32_t>(read_number(ins.args[i], program, ctx));
+    }
+    double origin = read_number(ins.args[0], program, ctx);
+    store_number(ins, ctx, ops::avg_avg_log(origin, params[0], params[1], params[2], params[3]));
+    return true;
+}
+
+bool to_string_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const ValueVariant* value = read_value(ins.args[0], program, ctx);
+    ValueVariant& out = ctx.slot_ref(ins.output);
+    if (!std::holds_alternative<std::string>(out)) {
+        out.emplace<std::string>();
+    }
+    std::string& str = *std::get_if<std::string>(&out);
+    str.clear();
+    if (value) {
+        std::visit([&str](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_arithmetic_v<V>) {
+                ops::direct_output_string_to(str, v);
+            } else if constexpr (std::is_same_v<V, std::string>) {
+                str = v;
+            }
+        }, *value);
+    }
+    ctx.mark_slot(ins.output);
+    return true;
+}
+
+bool len_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const ValueVariant* value = read_value(ins.args[0], program, ctx);
+    int64_t length = 0;
+    if (value) {
+        std::visit([&length](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (!std::is_arithmetic_v<V>) {
+                length = static_cast<int64_t>(ops::len(v));
+            }
+        }, *value);
+    }
+    store_number(ins, ctx, length);
+    return true;
+}
+
+bool list_to_string_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const ValueVariant* list = read_value(ins.args[0], program, ctx);
+    // 写入槽位已有的字符串，复用上一次执行留下的容量
+    ValueVariant& out = ctx.slot_ref(ins.output);
+    std::string_view delimiter = "|";
+    std::string aliased;
+    if (ins.argc > 1) {
+        const ValueVariant* delim = read_value(ins.args[1], program, ctx);
+        if (delim && std::holds_alternative<std::string>(*delim)) {
+            delimiter = *std::get_if<std::string>(delim);
+            if (delim == &out) {
+                aliased = delimiter;   // 分隔符就是输出变量，清空前拷贝
+                delimiter = aliased;
+            }
+        }
+    }
+    if (!std::holds_alternative<std::string>(out)) {
+        out.emplace<std::string>();
+    }
+    std::string& result = *std::get_if<std::string>(&out);
+    result.clear();
+    if (list && list != &out) {
+        std::visit([&](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (!std::is_arithmetic_v<V> && !std::is_same_v<V, std::string>) {
+                ops::list_to_string_to(result, v, delimiter);
+            }
+        }, *list);
+    }
+    ctx.mark_slot(ins.output);
+    return true;
+}
+
+template<bool Count>
+bool list_cross_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const ValueVariant* list = read_value(ins.args[0], program, ctx);
+    const ValueVariant* item = read_value(ins.args[1], program, ctx);
+    int result = 0;
+    if (list && item) {
+        std::visit([&](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, std::vector<std::string>>) {
+                if (const auto* s = std::get_if<std::string>(item)) {
+                    result = Count ? ops::catein_list_cross_count(v, *s) : ops::catein_list_cross(v, *s);
+                }
+            } else if constexpr (!std::is_arithmetic_v<V> && !std::is_same_v<V, std::string>) {
+                using E = typename V::value_type;
+                // 查找值转换为列表元素类型后比较
+                E key = std::visit([](const auto& x) -> E {
+                    using X = std::decay_t<decltype(x)>;
+                    if constexpr (std::is_arithmetic_v<X>) {
+                        return static_cast<E>(x);
+                    } else {
+                        return E{};
+                    }
+                }, *item);
+                result = Count ? ops::catein_list_cross_count(v, key) : ops::catein_list_cross(v, key);
+            }
+        }, *list);
+    }
+    store_number(ins, ctx, result);
+    return true;
+}
+
+inline const std::vector<double>* read_double_list(const Instruction& ins, const BytecodeProgram& program,
+                                                   const ExecutionContext& ctx) {
+    const ValueVariant* value = read_value(ins.args[0], program, ctx);
+    return value ? std::get_if<std::vector<double>>(value) : nullptr;
+}
+
+bool moving_average_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const auto* history = read_double_list(ins, program, ctx);
+    if (!history) return type_error(ins, "double_list");
+    int32_t window = static_cast<int32_t>(read_number(ins.args[1], program, ctx));
+    store_number(ins, ctx, ops::moving_average(*history, window));
+    return true;
+}
+
+bool vector_sum_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const auto* vec = read_double_list(ins, program, ctx);
+    if (!vec) return type_error(ins, "double_list");
+    store_number(ins, ctx, ops::vector_sum(*vec));
+    return true;
+}
+
+bool vector_avg_handler(const Instruction& ins, const BytecodeProgram& program, ExecutionContext& ctx) {
+    const auto* vec = read_double_list(ins, program, ctx);
+    if (!vec) return type_error(ins, "double_list");
+    store_number(ins, ctx, ops::vector_avg(*vec));
+    return true;
+}
+
+// ============================================
+// 操作码表
+// ============================================
+
+struct OpcodeInfo {
+    const char* op_name;
+    Opcode opcode;
+    OpHandler handler;
+    uint8_t min_args;
+    uint8_t max_args;
+};
+
+const OpcodeInfo kOpcodeTable[] = {
+    {"add", Opcode::ADD, binary_handler<ops::add_op<double>>, 2, 2},
+    {"sub", Opcode::SUB, binary_handler<ops::sub_op<double>>, 2, 2},
+    {"mul", Opcode::MUL, binary_handler<ops::mul_op<double>>, 2, 2},
+    {"div", Opcode::DIV, binary_handler<ops::div_op<double>>, 2, 2},
+    {"max", Opcode::MAX, binary_handler<ops::max_op<double>>, 2, 2},
+    {"min", Opcode::MIN, binary_handler<ops::min_op<double>>, 2, 2},
+    {"abs", Opcode::ABS, unary_handler<double, ops::abs_op<double>>, 1, 1},
+    {"square", Opcode::SQUARE, unary_handler<double, ops::square_op<double>>, 1, 1},
+    {"sqrt", Opcode::SQRT, unary_handler<double, ops::sqrt_op<double>>, 1, 1},
+    {"floor", Opcode::FLOOR, unary_handler<int32_t, ops::floor_op<double>>, 1, 1},
+    {"ceil", Opcode::CEIL, unary_handler<int32_t, ops::ceil_op<double>>, 1, 1},
+    {"if_else", Opcode::IF_ELSE, if_else_handler, 3, 3},
+    {"get_sign", Opcode::GET_SIGN, unary_handler<int, ops::get_sign<double>>, 1, 1},
+    {"price_diff", Opcode::PRICE_DIFF, binary_handler<ops::price_diff<double>>, 2, 2},
+    {"percent", Opcode::PERCENT, binary_handler<ops::percent_op<double>>, 2, 2},
+    {"avg_avg_log", Opcode::AVG_AVG_LOG, avg_avg_log_handler, 1, 5},
+    {"direct_output_int32", Opcode::TO_INT32, convert_handler<int32_t>, 1, 1},
+    {"direct_output_int64", Opcode::TO_INT64, convert_handler<int64_t>, 1, 1},
+    {"direct_output_double", Opcode::TO_DOUBLE, convert_handler<double>, 1, 1},
+    {"direct_output_string", Opcode::TO_STRING, to_string_handler, 1, 1},
+    {"len", Opcode::LEN, len_handler, 1, 1},
+    {"list_to_string", Opcode::LIST_TO_STRING, list_to_string_handler, 1, 2},
+    {"catein_list_cross", Opcode::LIST_CROSS, list_cross_handler<false>, 2, 2},
+    {"catein_list_cross_count", Opcode::LIST_CROSS_COUNT, list_cross_handler<true>, 2, 2},
+    {"moving_average", Opcode::MOVING_AVERAGE, moving_average_handler, 2, 2},
+    {"vector_sum", Opcode::VECTOR_SUM, vector_sum_handler, 1, 1},
+    {"vector_avg", Opcode::VECTOR_AVG, vector_avg_handler, 1, 1},
+    // 逐行执行时不预构建查找结构，语义与列表交叉相同
+    {"catein_set_cross", Opcode::SET_CROSS, list_cross_handler<false>, 2, 2},
+    {"catein_set_cross_count", Opcode::SET_CROSS_COUNT, list_cross_handler<true>, 2, 2},
+};
+
+const OpcodeInfo* find_opcode_info(const std::string& op_name) {
+    static const std::unordered_map<std::string, const OpcodeInfo*> index = [] {
+        std::unordered_map<std::string, const OpcodeInfo*> m;
+        for (const auto& info : kOpcodeTable) {
+            m[info.op_name] = &info;
+        }
+        return m;
+    }();
+    auto it = index.find(op_name);
+    return it != index.end() ? it->second : nullptr;
+}
+
+/**
+ * @brief 预解析字面量
+ */
+void parse_literal(const Arg& arg, ValueVariant& value, double& number) {
+    const char* begin = arg.value.c_str();
+    char* end = nullptr;
+    double parsed = std::strtod(begin, &end);
+    bool is_number = !arg.value.empty() && end == begin + arg.value.size();
+
+    number = is_number ? parsed : 0.0;
+    if (arg.data_type == DataType::STRING) {
+        value = arg.string_value();
+    } else if (!is_number) {
+        value = arg.value;
+    } else if (arg.data_type == DataType::INT32) {
+        value = static_cast<int32_t>(parsed);
+    } else if (arg.data_type == DataType::INT64) {
+        value = static_cast<int64_t>(std::strtoll(begin, nullptr, 10));
+    } else {
+        value = parsed;
+    }
+}
+
+/**
+ * @brief 确定步骤输出类型：已声明的变量使用声明类型，否则使用算子返回类型
+ */
+DataType resolve_output_type(const PipelineConfig& config, const OpCall& step) {
+    for (const auto& input : config.inputs) {
+        if (input.name == step.output_var) return input.type;
+    }
+    for (const auto& var : config.variables) {
+        if (var.name == step.output_var) return var.type;
+    }
+    const auto* meta = OperatorRegistry::instance().get_operator(step.op_name);
+    return meta ? meta->return_type : DataType::DOUBLE;
+}
+
+} // namespace
+
+// ============================================
+// 字节码编译器实现
+// ============================================
+
+Opcode BytecodeCompiler::opcode_of(const std::string& op_name) {
+    const auto* info = find_opcode_info(op_name);
+    return info ? info->opcode : Opcode::COUNT;
+}
+
+OpHandler BytecodeCompiler::handler_of(Opcode opcode) {
+    for (const auto& info : kOpcodeTable) {
+        if (info.opcode == opcode) {
+            return info.handler;
+        }
+    }
+    return nullptr;
+}
+
+BytecodeProgram BytecodeCompiler::compile(const PipelineConfig& config,
+                                          std::shared_ptr<const ContextLayout> layout) {
+    BytecodeProgram program;
+    program.layout = std::move(layout);
+
+    for (const auto& step : config.steps) {
+        const auto* info = find_opcode_info(step.op_name);
+        if (!info) {
+            throw std::runtime_error("Unknown operator: " + step.op_name);
+        }
+        if (step.args.size() < info->min_args || step.args.size() > info->max_args) {
+            throw std::runtime_error("Wrong argument count for operator: " + step.op_name);
+        }
+
+        Instruction ins;
+        ins.handler = info->handler;
+        ins.opcode = info->opcode;
+        ins.output_type = resolve_output_type(config, step);
+        ins.argc = static_cast<uint8_t>(step.args.size());
+        ins.output = static_cast<uint32_t>(program.layout->slot_of(step.output_var));
+
+        for (size_t i = 0; i < step.args.size(); i++) {
+            const auto& arg = step.args[i];
+            if (arg.type == ArgType::VARIABLE) {
+                size_t slot = program.layout->slot_of(arg.value);
+                if (slot == ContextLayout::npos) {
+                    throw std::runtime_error("Unknown variable: " + arg.value);
+                }
+                ins.args[i].index = static_cast<uint32_t>(slot);
+                ins.args[i].is_const = false;
+            } else {
+                ValueVariant value;
+                double number = 0.0;
+                parse_literal(arg, value, number);
+                ins.args[i].index = static_cast<uint32_t>(program.constants.size());
+                ins.args[i].is_const = true;
+                program.constants.push_back(std::move(value));
+                program.numbers.push_back(number);
+            }
+        }
+
+        program.code.push_back(ins);
+    }
+
+    return program;
+}
+
+} // namespace turbograph
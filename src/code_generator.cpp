@@ -1,14 +1,33 @@
 #include "code_generator.hpp"
+#include "optimizer.hpp"
 #include "ops.hpp"
+#include "abi.hpp"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <map>
 #include <set>
 #include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 
 namespace turbograph {
 
+// 构建时未定义时的后备路径
+#ifndef TURBOGRAPH_INCLUDE_DIR
+#define TURBOGRAPH_INCLUDE_DIR "/workspace/turbograph_jit/include"
+#endif
+
+std::string default_include_dir() {
+    const char* env = std::getenv("TURBOGRAPH_INCLUDE_DIR");
+    if (env && *env) {
+        return env;
+    }
+    return TURBOGRAPH_INCLUDE_DIR;
+}
+
 // ============================================
 // 辅助函数：生成合法的C++标识符
 // ============================================
@@ -30,125 +49,271 @@ std::string make_valid_identifier(const std::string& str) {
 }
 
 // ============================================
-// 算子注册表 - 自动从ops.hpp发现算子
+// ABI布局计算
 // ============================================
 
 /**
- * @brief 算子元数据
+ * @brief 是否为按值存放的标量字段
  */
-struct OperatorMetadata {
-    std::string config_name;      // 配置中的名称
-    std::string function_name;    // ops.hpp中的函数名
-    DataType return_type;         // 返回类型
-    int param_count;              // 参数个数
-    bool needs_template;          // 是否需要模板参数
-    std::string default_template; // 默认模板参数
-};
+static bool is_abi_scalar(DataType type) {
+    return type == DataType::INT32 || type == DataType::INT64 ||
+           type == DataType::DOUBLE || type == DataType::FLOAT;
+}
 
 /**
- * @brief 算子注册表
- * 自动发现并注册所有可用的算子
+ * @brief 字段大小；非标量输入为ListView（指针+长度），非标量输出为指针
  */
-class OperatorRegistry {
-public:
-    static OperatorRegistry& instance() {
-        static OperatorRegistry registry;
-        return registry;
+static size_t abi_field_size(DataType type, bool is_input) {
+    switch (type) {
+        case DataType::INT32: return sizeof(int32_t);
+        case DataType::INT64: return sizeof(int64_t);
+        case DataType::DOUBLE: return sizeof(double);
+        case DataType::FLOAT: return sizeof(float);
+        default: return is_input ? sizeof(ListView<char>) : sizeof(void*);
     }
-    
-    // 获取算子元数据
-    const OperatorMetadata* get_operator(const std::string& config_name) const {
-        auto it = operators_.find(config_name);
-        if (it != operators_.end()) {
-            return &it->second;
+}
+
+static size_t abi_field_alignment(DataType type, bool is_input) {
+    return is_abi_scalar(type) ? abi_field_size(type, is_input) : alignof(void*);
+}
+
+AbiStructLayout compute_abi_layout(const std::vector<PipelineConfig::IOField>& fields, bool is_input) {
+    AbiStructLayout layout;
+    size_t offset = 0;
+    for (const auto& field : fields) {
+        size_t size = abi_field_size(field.type, is_input);
+        size_t align = abi_field_alignment(field.type, is_input);
+        // 自然对齐
+        offset = (offset + align - 1) / align * align;
+        layout.fields.push_back({field.name, field.type, offset, size});
+        offset += size;
+        layout.alignment = std::max(layout.alignment, align);
+    }
+    layout.size = (offset + layout.alignment - 1) / layout.alignment * layout.alignment;
+    return layout;
+}
+
+/**
+ * @brief 参数在生成代码中是否一定为int32（int32的输入/声明变量或整数字面量）
+ */
+static bool is_int32_arg(const PipelineConfig& config, const Arg& arg) {
+    if (arg.type != ArgType::VARIABLE) {
+        return arg.data_type == DataType::INT32;
+    }
+    for (const auto* fields : {&config.inputs, &config.variables}) {
+        for (const auto& field : *fields) {
+            if (field.name == arg.value) {
+                return field.type == DataType::INT32;
+            }
         }
-        return nullptr;
     }
-    
-    // 获取所有算子名称
-    std::vector<std::string> get_all_operator_names() const {
-        std::vector<std::string> names;
-        for (const auto& op : operators_) {
-            names.push_back(op.first);
+    return false;
+}
+
+/**
+ * @brief avg_avg_log的分段参数均为字面量（或缺省）且最大分桶编号在int32范围内
+ */
+static bool bucket_fits_int32(const OpCall& step) {
+    int64_t params[] = {1000, 15000, 5000, 250000};  // 与ops::avg_avg_log的缺省参数一致
+    for (size_t i = 1; i < step.args.size() && i <= 4; i++) {
+        const Arg& arg = step.args[i];
+        if (arg.type == ArgType::VARIABLE || arg.data_type != DataType::INT32) {
+            return false;
         }
-        return names;
+        params[i - 1] = std::strtoll(arg.value.c_str(), nullptr, 10);
+    }
+    auto [inter1, threshold1, inter2, threshold2] = params;
+    if (inter1 <= 0 || inter2 <= 0 || threshold1 < 0 || threshold2 < threshold1) {
+        return false;
+    }
+    // |origin|取int64上限时分桶编号最大
+    double max_bucket = double(threshold1 / inter1 + 1) + double((threshold2 - threshold1) / inter2 + 1) +
+                        std::log(double(INT64_MAX / inter2)) / std::log(1.5) + 1;
+    return max_bucket < double(INT32_MAX);
+}
+
+DataType compute_step_type(const PipelineConfig& config, const OpCall& step) {
+    const auto* meta = OperatorRegistry::instance().get_operator(step.op_name);
+    DataType type = meta ? meta->return_type : DataType::DOUBLE;
+    if (config.precision == Precision::DOUBLE || !meta) {
+        return type;
     }
     
-    // 检查算子是否存在
-    bool has_operator(const std::string& config_name) const {
-        return operators_.find(config_name) != operators_.end();
+    if (step.op_name == "max" || step.op_name == "min" || step.op_name == "abs") {
+        bool all_int32 = !step.args.empty();
+        for (const auto& arg : step.args) {
+            all_int32 = all_int32 && is_int32_arg(config, arg);
+        }
+        if (all_int32) {
+            return DataType::INT32;
+        }
+    }
+    if (step.op_name == "avg_avg_log" && bucket_fits_int32(step)) {
+        return DataType::INT32;
+    }
+    if (type == DataType::DOUBLE && step.op_name != "direct_output_double") {
+        return DataType::FLOAT;
     }
+    return type;
+}
+
+std::unordered_map<std::string, DataType> compute_field_types(const PipelineConfig& config) {
+    std::unordered_map<std::string, DataType> types;
+    for (const auto& input : config.inputs) {
+        types.emplace(input.name, input.type);
+    }
+    for (const auto& var : config.variables) {
+        types.emplace(var.name, var.type);
+    }
+    std::unordered_map<std::string, DataType> step_types;
+    for (const auto& step : config.steps) {
+        step_types[step.output_var] = compute_step_type(config, step);
+    }
+    for (const auto& [name, type] : step_types) {
+        types.emplace(name, type);
+    }
+    for (const auto& output : config.outputs) {
+        types.emplace(output.name, output.type);
+    }
+    return types;
+}
+
+static size_t abi_struct_size(const std::vector<PipelineConfig::IOField>& fields, bool is_input) {
+    return compute_abi_layout(fields, is_input).size;
+}
+
+static size_t abi_struct_alignment(const std::vector<PipelineConfig::IOField>& fields, bool is_input) {
+    return compute_abi_layout(fields, is_input).alignment;
+}
+
+// ============================================
+// 算子注册表 - 自动从ops.hpp发现算子
+// ============================================
+
+OperatorRegistry& OperatorRegistry::instance() {
+    static OperatorRegistry registry;
+    return registry;
+}
+
+const OperatorMetadata* OperatorRegistry::get_operator(const std::string& config_name) const {
+    auto it = operators_.find(config_name);
+    if (it != operators_.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+std::vector<std::string> OperatorRegistry::get_all_operator_names() const {
+    std::vector<std::string> names;
+    for (const auto& op : operators_) {
+        names.push_back(op.first);
+    }
+    return names;
+}
+
+bool OperatorRegistry::has_operator(const std::string& config_name) const {
+    return operators_.find(config_name) != operators_.end();
+}
+
+OperatorRegistry::OperatorRegistry() {
+    register_all_operators();
+}
+
+void OperatorRegistry::register_all_operators() {
+    // 基础数学算子（无模板）
+    register_operator("get_sign", "get_sign", DataType::INT32, 1, false);
+    register_operator("price_diff", "price_diff", DataType::DOUBLE, 2, false);
+    register_operator("avg_avg_log", "avg_avg_log", DataType::INT64, 5, false);
+    
+    // 类型转换算子（需要模板）
+    register_operator("direct_output_int32", "direct_output_int32", DataType::INT32, 1, true, "int32_t");
+    register_operator("direct_output_int64", "direct_output_int64", DataType::INT64, 1, true, "int64_t");
+    register_operator("direct_output_double", "direct_output_double", DataType::DOUBLE, 1, true, "double");
+    // 按参数类型推导，与字节码/解释器一样按实际值格式化（整数不经double，字符串原样输出）
+    register_operator("direct_output_string", "direct_output_string", DataType::STRING, 1, false);
+    
+    // 容器操作算子
+    register_operator("len", "len", DataType::INT64, 1, false);
+    register_operator("list_to_string", "list_to_string", DataType::STRING, 2, false);
+    register_operator("catein_list_cross", "catein_list_cross", DataType::INT32, 2, false);
+    register_operator("catein_list_cross_count", "catein_list_cross_count", DataType::INT32, 2, false);
+    register_operator("catein_set_cross", "catein_set_cross", DataType::INT32, 2, false);
+    register_operator("catein_set_cross_count", "catein_set_cross_count", DataType::INT32, 2, false);
     
-private:
-    OperatorRegistry() {
-        register_all_operators();
+    // 扩展算子（需要模板）
+    register_operator("add", "add_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("sub", "sub_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("mul", "mul_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("div", "div_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("if_else", "if_else", DataType::DOUBLE, 3, false);
+    register_operator("max", "max_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("min", "min_op", DataType::DOUBLE, 2, true, "double");
+    register_operator("abs", "abs_op", DataType::DOUBLE, 1, true, "double");
+    register_operator("square", "square_op", DataType::DOUBLE, 1, true, "double");
+    register_operator("sqrt", "sqrt_op", DataType::DOUBLE, 1, true, "double");
+    register_operator("floor", "floor_op", DataType::INT32, 1, true, "double");
+    register_operator("ceil", "ceil_op", DataType::INT32, 1, true, "double");
+    register_operator("percent", "percent_op", DataType::DOUBLE, 2, false);
+    register_operator("moving_average", "moving_average", DataType::DOUBLE, 2, false);
+    register_operator("vector_sum", "vector_sum", DataType::DOUBLE, 1, false);
+    register_operator("vector_avg", "vector_avg", DataType::DOUBLE, 1, false);
+    
+    // ops_core.hpp中的轻量算子
+    for (const char* name : {"get_sign", "price_diff", "avg_avg_log",
+                             "direct_output_int32", "direct_output_int64", "direct_output_double",
+                             "add", "sub", "mul", "div", "if_else", "max", "min", "abs",
+                             "square", "sqrt", "floor", "ceil", "percent"}) {
+        operators_[name].core = true;
     }
     
-    void register_all_operators() {
-        // 基础数学算子（无模板）
-        register_operator("get_sign", "get_sign", DataType::INT32, 1, false);
-        register_operator("price_diff", "price_diff", DataType::DOUBLE, 2, false);
-        register_operator("avg_avg_log", "avg_avg_log", DataType::INT64, 5, false);
-        
-        // 类型转换算子（需要模板）
-        register_operator("direct_output_int32", "direct_output_int32", DataType::INT32, 1, true, "int32_t");
-        register_operator("direct_output_int64", "direct_output_int64", DataType::INT64, 1, true, "int64_t");
-        register_operator("direct_output_double", "direct_output_double", DataType::DOUBLE, 1, true, "double");
-        register_operator("direct_output_string", "direct_output_string", DataType::STRING, 1, true, "double");
-        
-        // 容器操作算子
-        register_operator("len", "len", DataType::INT64, 1, false);
-        register_operator("list_to_string", "list_to_string", DataType::STRING, 2, false);
-        register_operator("catein_list_cross", "catein_list_cross", DataType::INT32, 2, false);
-        register_operator("catein_list_cross_count", "catein_list_cross_count", DataType::INT32, 2, false);
-        
-        // 扩展算子（需要模板）
-        register_operator("add", "add_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("sub", "sub_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("mul", "mul_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("div", "div_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("if_else", "if_else", DataType::DOUBLE, 3, false);
-        register_operator("max", "max_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("min", "min_op", DataType::DOUBLE, 2, true, "double");
-        register_operator("abs", "abs_op", DataType::DOUBLE, 1, true, "double");
-        register_operator("square", "square_op", DataType::DOUBLE, 1, true, "double");
-        register_operator("sqrt", "sqrt_op", DataType::DOUBLE, 1, true, "double");
-        register_operator("floor", "floor_op", DataType::INT32, 1, true, "double");
-        register_operator("ceil", "ceil_op", DataType::INT32, 1, true, "double");
-        register_operator("percent", "percent_op", DataType::DOUBLE, 2, false);
-        register_operator("moving_average", "moving_average", DataType::DOUBLE, 2, false);
-        register_operator("vector_sum", "vector_sum", DataType::DOUBLE, 1, false);
-        register_operator("vector_avg", "vector_avg", DataType::DOUBLE, 1, false);
-    }
-    
-    void register_operator(const std::string& config_name, 
-                          const std::string& function_name,
-                          DataType return_type,
-                          int param_count,
-                          bool needs_template,
-                          const std::string& default_template = "") {
-        OperatorMetadata meta;
-        meta.config_name = config_name;
-        meta.function_name = function_name;
-        meta.return_type = return_type;
-        meta.param_count = param_count;
-        meta.needs_template = needs_template;
-        meta.default_template = default_template;
-        operators_[config_name] = meta;
-    }
-    
-    std::unordered_map<std::string, OperatorMetadata> operators_;
-};
+    // 有低精度向量变体的算子
+    operators_["moving_average"].fast_function_name = "moving_average_fast";
+    operators_["vector_sum"].fast_function_name = "vector_sum_fast";
+    operators_["vector_avg"].fast_function_name = "vector_avg_fast";
+}
+
+void OperatorRegistry::register_operator(const std::string& config_name, 
+                                         const std::string& function_name,
+                                         DataType return_type,
+                                         int param_count,
+                                         bool needs_template,
+                                         const std::string& default_template) {
+    OperatorMetadata meta;
+    meta.config_name = config_name;
+    meta.function_name = function_name;
+    meta.return_type = return_type;
+    meta.param_count = param_count;
+    meta.needs_template = needs_template;
+    meta.default_template = default_template;
+    operators_[config_name] = meta;
+}
 
 // ============================================
 // 代码生成器实现
 // ============================================
 
 CodeGenerator::CodeGenerator(const PipelineConfig& config, const CodeGenOptions& options)
-    : config_(config), options_(options) {
+    : config_(options.optimize ? PipelineOptimizer::optimize(config) : config), options_(options) {
     
     // 收集所有使用的变量
     collect_variables();
+    
+    // 每个输出的依赖切片：掩码入口只执行被请求输出依赖的步骤
+    if (has_masked_entry()) {
+        DataflowGraph graph = DataflowGraph::build(config_);
+        size_t words = (config_.outputs.size() + 63) / 64;
+        step_outputs_.assign(config_.steps.size(), std::vector<uint64_t>(words, 0));
+        for (size_t j = 0; j < config_.outputs.size(); j++) {
+            std::vector<bool> requested(config_.outputs.size(), false);
+            requested[j] = true;
+            std::vector<bool> live = graph.live_steps(requested);
+            for (size_t i = 0; i < live.size(); i++) {
+                if (live[i]) {
+                    step_outputs_[i][j / 64] |= uint64_t(1) << (j % 64);
+                }
+            }
+        }
+    }
 }
 
 void CodeGenerator::collect_variables() {
@@ -168,13 +333,89 @@ void CodeGenerator::collect_variables() {
         DataType out_type = infer_output_type(step);
         variables_[step.output_var] = out_type;
     }
+    
+    // 既不是输入也不是输出的变量只在execute_internal内使用，生成为局部变量，
+    // 编译器可以将其保存在寄存器中，不必经上下文结构读写内存
+    std::set<std::string> io_names;
+    for (const auto& input : config_.inputs) {
+        io_names.insert(input.name);
+    }
+    for (const auto& output : config_.outputs) {
+        io_names.insert(output.name);
+    }
+    for (const auto& [name, type] : compute_field_types(config_)) {
+        if (!io_names.count(name)) {
+            locals_[name] = type;
+        }
+    }
+    
+    // 列表交叉的列表参数为请求级常量输入（且没有步骤改写）时，批量入口在循环外预构建查找结构
+    std::set<std::string> written;
+    for (const auto& step : config_.steps) {
+        written.insert(step.output_var);
+    }
+    // 没有步骤改写的列表/字符串输入在上下文中只保存视图，不拷贝调用方的元素
+    for (const auto& input : config_.inputs) {
+        if ((is_list_type(input.type) || input.type == DataType::STRING) && !written.count(input.name)) {
+            views_.insert(input.name);
+        }
+    }
+    
+    // 只由字符串格式化算子写入的字符串中间变量与输出写入线程局部缓冲区，不逐次分配堆字符串；
+    // 输出在行末拷贝到调用方的字符串（复用其容量）
+    std::map<std::string, bool> arena_writers;
+    for (const auto& step : config_.steps) {
+        bool formats = step.op_name == "direct_output_string" || step.op_name == "list_to_string";
+        auto [it, inserted] = arena_writers.emplace(step.output_var, formats);
+        if (!inserted) it->second = it->second && formats;
+    }
+    std::set<std::string> declared;   // 输入与声明变量的上下文字段保持原类型
+    for (const auto& input : config_.inputs) {
+        declared.insert(input.name);
+    }
+    for (const auto& var : config_.variables) {
+        declared.insert(var.name);
+    }
+    for (const auto& [name, formats] : arena_writers) {
+        if (!formats) {
+            continue;
+        }
+        auto local = locals_.find(name);
+        if (local != locals_.end()) {
+            if (local->second == DataType::STRING) {
+                arena_strings_.insert(name);
+            }
+            continue;
+        }
+        bool string_output = std::any_of(config_.outputs.begin(), config_.outputs.end(),
+            [&](const PipelineConfig::IOField& output) {
+                return output.name == name && output.type == DataType::STRING;
+            });
+        if (string_output && !declared.count(name) &&
+            variables_.at(name) == DataType::STRING) {
+            arena_strings_.insert(name);
+        }
+    }
+    
+    for (const auto& step : config_.steps) {
+        if ((step.op_name != "catein_set_cross" && step.op_name != "catein_set_cross_count") ||
+            step.args.empty() || step.args[0].type != ArgType::VARIABLE) {
+            continue;
+        }
+        const std::string& list = step.args[0].value;
+        for (const auto& input : config_.inputs) {
+            if (input.name == list && input.broadcast && is_list_type(input.type) && !written.count(list) &&
+                std::find(lookups_.begin(), lookups_.end(), list) == lookups_.end()) {
+                lookups_.push_back(list);
+            }
+        }
+    }
 }
 
 DataType CodeGenerator::infer_output_type(const OpCall& step) {
-    // 从注册表获取算子信息
-    const auto* meta = OperatorRegistry::instance().get_operator(step.op_name);
-    if (meta) {
-        return meta->return_type;
+    // 注册的算子按精度策略推断
+    if (OperatorRegistry::instance().has_operator(step.op_name)) {
+        return compute_step_type(config_, step);
     }
     
     // 备用：推断类型
@@ -190,6 +431,8 @@ DataType CodeGenerator::infer_output_type(const OpCall& step) {
         {"list_to_string", DataType::STRING},
         {"catein_list_cross", DataType::INT32},
         {"catein_list_cross_count", DataType::INT32},
+        {"catein_set_cross", DataType::INT32},
+        {"catein_set_cross_count", DataType::INT32},
         {"add", DataType::DOUBLE},
         {"sub", DataType::DOUBLE},
         {"mul", DataType::DOUBLE},
@@ -222,12 +465,164 @@ std::string CodeGenerator::generate() {
     // 生成头部
     generate_header(oss);
     
+    // 生成管道主体
+    generate_pipeline(oss);
+    
+    // 单管道SO额外导出不带后缀的信息函数（兼容旧加载方式）
+    generate_info_functions(oss, true);
+    
+    oss << "\n#endif  // TURBOGRAPH_GENERATED_" << config_.fingerprint << "\n";
+    
+    code_ = oss.str();
+    return code_;
+}
+
+std::string CodeGenerator::generate_unit(const std::vector<PipelineConfig>& configs,
+                                         const CodeGenOptions& options) {
+    std::ostringstream oss;
+    
+    oss << R"(// ============================================================
+// Auto-generated fused pipeline unit
+// Pipelines: )" << configs.size() << R"(
+// Generated by: TurboGraph-JIT Code Generator
+// ============================================================
+)";
+    for (const auto& config : configs) {
+        oss << "// - " << config.name << " (" << config.fingerprint << ")\n";
+    }
+    oss << "\n";
+    
+    // 公共头文件只解析一次
+    bool minimal = true;
+    for (const auto& config : configs) {
+        minimal = minimal && CodeGenerator(config, options).uses_core_only();
+    }
+    generate_includes(oss, options, minimal);
+    
+    // 每个管道位于独立命名空间，导出符号均带指纹后缀
+    for (const auto& config : configs) {
+        CodeGenerator generator(config, options);
+        generator.generate_pipeline(oss);
+        generator.generate_info_functions(oss, false);
+    }
+    
+    return oss.str();
+}
+
+std::string CodeGenerator::generate_aot_source(const std::vector<PipelineConfig>& configs,
+                                               const CodeGenOptions& options) {
+    std::ostringstream oss;
+    oss << generate_unit(configs, options);
+    
+    oss << R"(
+// ============================================================
+// 静态注册（AOT）
+// ============================================================
+
+#include )" << (options.include_root.empty() ? "\"aot.hpp\"" : "\"" + options.include_root + "/aot.hpp\"") << R"(
+
+namespace {
+
+const ::turbograph::AotPipeline kAotPipelines[] = {
+)";
+    for (const auto& config : configs) {
+        std::string ns = make_valid_identifier(config.fingerprint);
+        std::string qualified = "::turbograph::generated::" + ns + "::";
+        oss << "    {\"" << config.fingerprint << "\", \"" << config.name << "\",\n"
+            << "     &" << qualified << "pipeline_abi_" << ns << ",\n"
+            << "     &" << qualified << "pipeline_execute_" << ns << ",\n"
+            << "     &" << qualified << "pipeline_execute_batch_" << ns << ",\n"
+            << "     &" << qualified << "pipeline_execute_offsets_" << ns << ",\n"
+            << "     " << (exports_masked_entry(config) ? "&" + qualified + "pipeline_execute_batch_masked_" + ns
+                                                        : std::string("nullptr")) << "},\n";
+    }
+    oss << R"(};
+
+const ::turbograph::AotRegistrar kAotRegistrar(kAotPipelines, )" << configs.size() << R"();
+
+}  // namespace
+)";
+    return oss.str();
+}
+
+std::string CodeGenerator::generate_aot_header(const std::vector<PipelineConfig>& configs,
+                                               const std::string& guard) {
+    std::ostringstream oss;
+    oss << R"(// ============================================================
+// Auto-generated AOT pipeline declarations (turbograph_aot)
+// ============================================================
+
+#ifndef )" << guard << R"(
+#define )" << guard << R"(
+
+#include "abi.hpp"
+#include <cstddef>
+)";
+    for (const auto& config : configs) {
+        std::string ns = make_valid_identifier(config.fingerprint);
+        oss << R"(
+namespace turbograph {
+namespace generated {
+namespace )" << ns << R"( {
+extern "C" {
+extern const ::turbograph::AbiLayout pipeline_abi_)" << ns << R"(;
+bool pipeline_execute_)" << ns << R"((void* input_data, void* output_data);
+bool pipeline_execute_batch_)" << ns << R"((const ::turbograph::ColumnBatch* input,
+                             ::turbograph::OutputBatch* output, size_t n);
+bool pipeline_execute_offsets_)" << ns << R"((const ::turbograph::OffsetBatch* input,
+                             ::turbograph::OutputBatch* output, size_t n);
+)";
+        if (exports_masked_entry(config)) {
+            oss << "bool pipeline_execute_batch_masked_" << ns << R"((const ::turbograph::ColumnBatch* input,
+                             ::turbograph::OutputBatch* output, size_t n, const uint64_t* mask);
+)";
+        }
+        oss << R"(}  // extern "C"
+}  // namespace )" << ns << R"(
+}  // namespace generated
+
+// 管道 )" << config.name << R"(：直接调用生成的入口，不经函数指针
+namespace aot {
+namespace )" << make_valid_identifier(config.name) << R"( {
+
+inline constexpr const char* kFingerprint = ")" << config.fingerprint << R"(";
+
+inline bool execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    return ::turbograph::generated::)" << ns << "::pipeline_execute_batch_" << ns << R"((&input, &output, n);
+}
+
+inline bool execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    return ::turbograph::generated::)" << ns << "::pipeline_execute_offsets_" << ns << R"((&input, &output, n);
+}
+)";
+        if (exports_masked_entry(config)) {
+            oss << R"(
+// mask第j位对应第j个输出
+inline bool execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n, const uint64_t* mask) {
+    return ::turbograph::generated::)" << ns << "::pipeline_execute_batch_masked_" << ns << R"((&input, &output, n, mask);
+}
+)";
+        }
+        oss << R"(
+}  // namespace )" << make_valid_identifier(config.name) << R"(
+}  // namespace aot
+}  // namespace turbograph
+)";
+    }
+    oss << "\n#endif  // " << guard << "\n";
+    return oss.str();
+}
+
+void CodeGenerator::generate_pipeline(std::ostream& oss) {
     // 生成命名空间
     generate_namespace_begin(oss);
     
     // 生成上下文结构
     generate_context_struct(oss);
     
+    // 生成输入输出ABI结构
+    generate_abi_structs(oss);
+    
     // 生成辅助函数
     generate_helper_functions(oss);
     
@@ -237,11 +632,15 @@ std::string CodeGenerator::generate() {
     // 生成导出函数
     generate_export_function(oss);
     
+    // 生成批量导出函数（数组列与偏移编码列两种入口）
+    generate_batch_function(oss, false);
+    generate_batch_function(oss, true);
+    if (has_masked_entry()) {
+        generate_batch_function(oss, false, true);
+    }
+    
     // 结束命名空间
     generate_namespace_end(oss);
-    
-    code_ = oss.str();
-    return code_;
 }
 
 void CodeGenerator::generate_header(std::ostream& oss) {
@@ -259,17 +658,74 @@ void CodeGenerator::generate_header(std::ostream& oss) {
 #ifndef TURBOGRAPH_GENERATED_)" << config_.fingerprint << R"(
 #define TURBOGRAPH_GENERATED_)" << config_.fingerprint << R"(
 
-#include <cmath>
+)";
+    generate_includes(oss, options_, uses_core_only());
+}
+
+void CodeGenerator::generate_includes(std::ostream& oss, const CodeGenOptions& options, bool minimal) {
+    // include_root为空时按编译器-I路径查找，生成的源码与主机路径无关
+    std::string prefix = options.include_root.empty() ? "" : options.include_root + "/";
+    
+    if (minimal) {
+        oss << R"(#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+// 引入轻量算子库
+#include ")" << prefix << R"(ops_core.hpp"
+#include ")" << prefix << R"(abi.hpp"
+)";
+        if (options.profile_steps) {
+            oss << "#include \"" << prefix << "probe.hpp\"\n";
+        }
+        oss << "\n";
+        return;
+    }
+    
+    oss << R"(#include <cmath>
 #include <string>
 #include <vector>
 #include <sstream>
 #include <stdexcept>
 #include <cstdint>
+#include <cstddef>
 
-// 引入算子库（使用绝对路径）
-#include "/workspace/turbograph_jit/include/ops.hpp"
-
+// 引入算子库
+#include ")" << prefix << R"(ops.hpp"
+#include ")" << prefix << R"(abi.hpp"
 )";
+    if (options.profile_steps) {
+        oss << "#include \"" << prefix << "probe.hpp\"\n";
+    }
+    oss << "\n";
+}
+
+bool CodeGenerator::uses_core_only() const {
+    if (!options_.minimal_includes) {
+        return false;
+    }
+    
+    auto& registry = OperatorRegistry::instance();
+    for (const auto& step : config_.steps) {
+        const auto* meta = registry.get_operator(step.op_name);
+        if (!meta || !meta->core) {
+            return false;
+        }
+    }
+    
+    for (const auto& [name, type] : variables_) {
+        if (!is_abi_scalar(type)) {
+            return false;
+        }
+    }
+    for (const auto* fields : {&config_.inputs, &config_.outputs, &config_.variables}) {
+        for (const auto& field : *fields) {
+            if (!is_abi_scalar(field.type)) {
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 void CodeGenerator::generate_namespace_begin(std::ostream& oss) {
@@ -287,8 +743,42 @@ void CodeGenerator::generate_namespace_end(std::ostream& oss) {
 }  // namespace )" << ns_name << R"(
 }  // namespace generated
 }  // namespace turbograph
+)";
+}
 
-#endif  // TURBOGRAPH_GENERATED_)" << config_.fingerprint << R"(
+void CodeGenerator::generate_info_functions(std::ostream& oss, bool unsuffixed) {
+    std::string ns_name = make_valid_identifier(config_.fingerprint);
+    
+    oss << R"(
+// ============================================================
+// 管道信息 (C链接)
+// ============================================================
+
+extern "C" {
+
+const char* pipeline_name_)" << ns_name << R"(() {
+    return ")" << config_.name << R"(";
+}
+
+const char* pipeline_fingerprint_)" << ns_name << R"(() {
+    return ")" << config_.fingerprint << R"(";
+}
+)";
+    
+    if (unsuffixed) {
+        oss << R"(
+const char* pipeline_name() {
+    return ")" << config_.name << R"(";
+}
+
+const char* pipeline_fingerprint() {
+    return ")" << config_.fingerprint << R"(";
+}
+)";
+    }
+    
+    oss << R"(
+}  // extern "C"
 )";
 }
 
@@ -300,11 +790,14 @@ void CodeGenerator::generate_context_struct(std::ostream& oss) {
 struct PipelineContext {
 )";
     
+    // 成员均值初始化：按输出掩码执行时未运行步骤的结果不被写入，GCC无法证明其不会被读取
+    // （-Wmaybe-uninitialized）；上下文每次调用或每个批次只构造一次
+    
     // 生成输入变量
     if (!config_.inputs.empty()) {
         oss << "    // 输入变量\n";
         for (const auto& input : config_.inputs) {
-            oss << "    " << get_cpp_type_name(input.type) << " " << input.name << ";\n";
+            oss << "    " << context_type_name(input) << " " << input.name << "{};\n";
         }
     }
     
@@ -312,9 +805,11 @@ struct PipelineContext {
     if (!config_.variables.empty() || !config_.steps.empty()) {
         oss << "    // 中间变量\n";
         for (const auto& var : config_.variables) {
-            oss << "    " << get_cpp_type_name(var.type) << " " << var.name << ";\n";
+            if (!locals_.count(var.name)) {
+                oss << "    " << get_cpp_type_name(var.type) << " " << var.name << "{};\n";
+            }
         }
-        // 步骤输出变量（只添加不在inputs、variables和steps中的）
+        // 步骤输出变量（只添加不在inputs、variables中的）
         std::set<std::string> defined_vars;
         for (const auto& input : config_.inputs) {
             defined_vars.insert(input.name);
@@ -323,17 +818,13 @@ struct PipelineContext {
             defined_vars.insert(var.name);
         }
         for (const auto& step : config_.steps) {
-            defined_vars.insert(step.output_var);
-        }
-        std::set<std::string> output_vars;
-        for (const auto& step : config_.steps) {
-            output_vars.insert(step.output_var);
-        }
-        for (const auto& var_name : output_vars) {
-            if (defined_vars.find(var_name) == defined_vars.end()) {
+            const auto& var_name = step.output_var;
+            if (defined_vars.insert(var_name).second && !locals_.count(var_name)) {
                 auto it = variables_.find(var_name);
                 if (it != variables_.end()) {
-                    oss << "    " << get_cpp_type_name(it->second) << " " << var_name << ";\n";
+                    std::string type_name = arena_strings_.count(var_name) ? "std::string_view"
+                                                                           : get_cpp_type_name(it->second);
+                    oss << "    " << type_name << " " << var_name << "{};\n";
                 }
             }
         }
@@ -356,7 +847,7 @@ struct PipelineContext {
         // 只输出不在已定义集合中的变量
         for (const auto& output : config_.outputs) {
             if (all_defined.find(output.name) == all_defined.end()) {
-                oss << "    " << get_cpp_type_name(output.type) << " " << output.name << ";\n";
+                oss << "    " << get_cpp_type_name(output.type) << " " << output.name << "{};\n";
             }
         }
     }
@@ -400,13 +891,79 @@ void CodeGenerator::generate_execute_function(std::ostream& oss) {
 // ============================================================
 // 主执行函数
 // ============================================================
-
-bool execute_internal(PipelineContext& ctx) {
 )";
     
+    if (!arena_strings_.empty()) {
+        // 字符串中间结果的缓冲区，每次执行开始时回绕，稳定后不再分配内存
+        oss << "\nthread_local ::turbograph::ops::StringArena t_arena;\n";
+    }
+    if (options_.profile_steps) {
+        // 插桩：宿主通过pipeline_profile_<fp>挂接计数数组，未挂接时只读取计时器不记录
+        oss << "\n// 步骤计数（宿主挂接，每步一项）\n";
+        oss << "static ::turbograph::StepCounter* g_step_counters = nullptr;\n";
+        if (!config_.steps.empty()) {
+            oss << "static const char* const kStepNames[] = {\n";
+            for (const auto& step : config_.steps) {
+                oss << "    \"" << step.op_name << ":" << step.output_var << "\",\n";
+            }
+            oss << "};\n";
+        }
+    }
+    // 有掩码入口时按kMasked实例化两份：kMasked为false时步骤不带判断，与无掩码入口的代码相同
+    const bool masked = has_masked_entry();
+    const std::string step_param = masked ? ", const uint64_t* steps = nullptr" : "";
+    if (!lookups_.empty()) {
+        // 批量入口传入预构建的查找结构，逐行入口传空指针（退回列表扫描）
+        oss << "\nstruct PipelineLookups {\n";
+        for (const auto& name : lookups_) {
+            oss << "    ::turbograph::ops::ListLookup<" << get_cpp_type_name(variables_.at(name)) << "> "
+                << name << ";\n";
+        }
+        oss << "};\n";
+    }
+    oss << "\n";
+    if (masked) {
+        oss << "template<bool kMasked = false>\n";
+    }
+    if (lookups_.empty()) {
+        oss << "inline bool execute_internal(PipelineContext& ctx" << step_param << ") {\n";
+    } else {
+        oss << "inline bool execute_internal(PipelineContext& ctx, const PipelineLookups* lookups = nullptr"
+            << step_param << ") {\n";
+    }
+    
+    // 中间变量
+    if (!locals_.empty()) {
+        std::map<std::string, DataType> ordered(locals_.begin(), locals_.end());
+        for (const auto& [name, type] : ordered) {
+            std::string type_name = arena_strings_.count(name) ? "std::string_view" : get_cpp_type_name(type);
+            oss << "    " << type_name << " " << local_name(name) << "{};\n";
+        }
+        oss << "\n";
+    }
+    if (!arena_strings_.empty()) {
+        oss << "    t_arena.reset();\n\n";
+    }
+    if (options_.profile_steps) {
+        oss << "    ::turbograph::StepCounter* const step_counters = __atomic_load_n(&g_step_counters, __ATOMIC_ACQUIRE);\n\n";
+    }
+    
     // 生成算子调用代码
-    for (const auto& step : config_.steps) {
-        generate_op_call(oss, step);
+    for (size_t i = 0; i < config_.steps.size(); i++) {
+        if (options_.profile_steps) {
+            oss << "    const uint64_t step_start_" << i << " = ::turbograph::probe::now();\n";
+        }
+        if (masked) {
+            // 步骤位图由掩码入口按请求的输出计算
+            oss << "    if (!kMasked || ((steps[" << i / 64 << "] >> " << i % 64 << ") & 1)) {\n";
+            generate_op_call(oss, config_.steps[i]);
+            oss << "    }\n";
+        } else {
+            generate_op_call(oss, config_.steps[i]);
+        }
+        if (options_.profile_steps) {
+            oss << "    ::turbograph::probe::record(step_counters, " << i << ", step_start_" << i << ");\n\n";
+        }
     }
     
     // 生成输出赋值
@@ -437,15 +994,34 @@ void CodeGenerator::generate_op_call(std::ostream& oss, const OpCall& step) {
         args_oss << arg_str;
     }
     
+    // 写入缓冲区的字符串中间变量调用带StringArena参数的重载
+    std::string args_str = args_oss.str();
+    if (arena_strings_.count(step.output_var)) {
+        args_str = args_str.empty() ? "t_arena" : "t_arena, " + args_str;
+    }
+    
     // 生成算子调用代码
-    std::string op_call = generate_op_call_code(step, args_oss.str());
+    std::string op_call = generate_op_call_code(step, args_str);
+    
+    // 有预构建查找结构时查找结构代替列表参数（只有catein_set_cross*接受查找结构）
+    if ((step.op_name == "catein_set_cross" || step.op_name == "catein_set_cross_count") &&
+        !step.args.empty() && step.args[0].type == ArgType::VARIABLE &&
+        std::find(lookups_.begin(), lookups_.end(), step.args[0].value) != lookups_.end()) {
+        std::string rest;
+        for (size_t i = 1; i < step.args.size(); i++) {
+            rest += ", " + generate_arg_code(step.args[i]);
+        }
+        op_call = field_ref(step.output_var) + " = lookups ? ::turbograph::ops::" + step.op_name +
+                  "(lookups->" + step.args[0].value + rest + ") : ::turbograph::ops::" + step.op_name +
+                  "(" + args_oss.str() + ");";
+    }
     
     oss << "    " << op_call << "\n\n";
 }
 
 std::string CodeGenerator::generate_arg_code(const Arg& arg) {
     if (arg.type == ArgType::VARIABLE) {
-        return "ctx." + arg.value;
+        return field_ref(arg.value);
     } else {
         // 字面量
         return arg.value;
@@ -458,7 +1034,9 @@ std::string CodeGenerator::generate_op_call_code(const OpCall& step, const std::
     
     if (meta) {
         // 使用注册表中的信息生成调用
-        std::string call_code = "ctx." + step.output_var + " = ::turbograph::ops::" + meta->function_name;
+        const std::string& function_name = options_.use_fast_math && !meta->fast_function_name.empty()
+            ? meta->fast_function_name : meta->function_name;
+        std::string call_code = field_ref(step.output_var) + " = ::turbograph::ops::" + function_name;
         
         if (meta->needs_template) {
             // 需要模板参数
@@ -472,7 +1050,25 @@ std::string CodeGenerator::generate_op_call_code(const OpCall& step, const std::
     }
     
     // 未知算子，使用通用处理
-    return "ctx." + step.output_var + " = ::turbograph::ops::" + step.op_name + "(" + args_str + ");";
+    return field_ref(step.output_var) + " = ::turbograph::ops::" + step.op_name + "(" + args_str + ");";
+}
+
+std::string CodeGenerator::local_name(const std::string& name) {
+    return "l_" + name;
+}
+
+std::string CodeGenerator::field_ref(const std::string& name) const {
+    return locals_.count(name) ? local_name(name) : "ctx." + name;
+}
+
+std::string CodeGenerator::context_type_name(const PipelineConfig::IOField& input) const {
+    if (!views_.count(input.name)) {
+        return get_cpp_type_name(input.type);
+    }
+    if (input.type == DataType::STRING) {
+        return "std::string_view";
+    }
+    return "::turbograph::ListView<" + get_cpp_type_name(get_list_element_type(input.type)) + ">";
 }
 
 std::string CodeGenerator::map_operator_name(const std::string& op_name) {
@@ -504,78 +1100,355 @@ void CodeGenerator::generate_export_function(std::ostream& oss) {
 
 extern "C" {
 
-bool pipeline_execute_)" << ns_name << R"((void* input_data, void* output_data) {
+// 输入输出结构布局描述符，宿主按偏移直接填充PipelineInput/PipelineOutput
+extern const ::turbograph::AbiLayout pipeline_abi_)" << ns_name << R"( = {
+    ::turbograph::kAbiVersion,
+    )" << abi_struct_size(config_.inputs, true) << ", " << abi_struct_alignment(config_.inputs, true) << ", "
+        << config_.inputs.size() << ", " << (config_.inputs.empty() ? "nullptr" : "kInputFields") << R"(,
+    )" << abi_struct_size(config_.outputs, false) << ", " << abi_struct_alignment(config_.outputs, false) << ", "
+        << config_.outputs.size() << ", " << (config_.outputs.empty() ? "nullptr" : "kOutputFields") << R"(
+};
+
+)";
+    
+    if (options_.profile_steps) {
+        oss << "// 插桩描述符，宿主向*counters写入计数数组后开始计数\n"
+            << "extern const ::turbograph::StepProfile pipeline_profile_" << ns_name << " = {\n"
+            << "    " << config_.steps.size() << ", " << (config_.steps.empty() ? "nullptr" : "kStepNames")
+            << ", &g_step_counters\n};\n\n";
+    }
+    
+    oss << R"(bool pipeline_execute_)" << ns_name << R"((void* input_data, void* output_data) {
     PipelineContext ctx;
     
     // 解析输入数据
+    if (input_data) {
+        const PipelineInput* in = static_cast<const PipelineInput*>(input_data);
 )";
     
     // 生成输入解析代码
-    size_t offset = 0;
     for (const auto& input : config_.inputs) {
-        std::string type_name = get_cpp_type_name(input.type);
-        oss << "    // 输入: " << input.name << " (" << type_name << ")\n";
-        oss << "    if (input_data) {\n";
-        if (type_name == "double") {
-            oss << "        double* arr = static_cast<double*>(input_data);\n";
-            oss << "        ctx." << input.name << " = arr[" << offset << "];\n";
-        } else if (type_name == "int32_t") {
-            oss << "        int32_t* arr = static_cast<int32_t*>(input_data);\n";
-            oss << "        ctx." << input.name << " = arr[" << offset << "];\n";
-        } else if (type_name == "int64_t") {
-            oss << "        int64_t* arr = static_cast<int64_t*>(input_data);\n";
-            oss << "        ctx." << input.name << " = arr[" << offset << "];\n";
-        }
-        offset++;
-        oss << "    }\n\n";
+        if (is_abi_scalar(input.type) || (views_.count(input.name) && input.type != DataType::STRING)) {
+            oss << "        ctx." << input.name << " = in->" << input.name << ";\n";
+        } else if (views_.count(input.name)) {
+            oss << "        ctx." << input.name << " = std::string_view(in->" << input.name << ".data(), in->"
+                << input.name << ".size());\n";
+        } else {
+            // 被步骤改写的输入拷贝到上下文自有的对象
+            oss << "        ctx." << input.name << ".assign(in->" << input.name << ".begin(), in->"
+                << input.name << ".end());\n";
+        }
     }
     
     // 执行内部逻辑
-    oss << R"(
+    oss << R"(    }
+    
     // 执行管道
     bool result = execute_internal(ctx);
     
     // 写入输出数据
     if (output_data && result) {
+        PipelineOutput* out = static_cast<PipelineOutput*>(output_data);
 )";
     
     // 生成输出写入代码
-    offset = 0;
     for (const auto& output : config_.outputs) {
-        std::string type_name = get_cpp_type_name(output.type);
-        oss << "        // 输出: " << output.name << "\n";
-        if (type_name == "double") {
-            oss << "        {\n";
-            oss << "            double* arr = static_cast<double*>(output_data);\n";
-            oss << "            arr[" << offset << "] = static_cast<double>(ctx." << output.name << ");\n";
-            oss << "        }\n";
-        } else if (type_name == "int32_t") {
-            oss << "        {\n";
-            oss << "            int32_t* arr = static_cast<int32_t*>(output_data);\n";
-            oss << "            arr[" << offset << "] = static_cast<int32_t>(ctx." << output.name << ");\n";
-            oss << "        }\n";
-        } else if (type_name == "int64_t") {
-            oss << "        {\n";
-            oss << "            int64_t* arr = static_cast<int64_t*>(output_data);\n";
-            oss << "            arr[" << offset << "] = static_cast<int64_t>(ctx." << output.name << ");\n";
-            oss << "        }\n";
-        }
-        offset++;
+        if (is_abi_scalar(output.type)) {
+            oss << "        out->" << output.name << " = static_cast<" << get_cpp_type_name(output.type)
+                << ">(ctx." << output.name << ");\n";
+        } else if (views_.count(output.name)) {
+            // 视图输入直接作为输出时拷贝元素
+            oss << "        if (out->" << output.name << ") out->" << output.name << "->assign(ctx."
+                << output.name << ".begin(), ctx." << output.name << ".end());\n";
+        } else if (arena_strings_.count(output.name)) {
+            // 缓冲区中的字符串拷贝到调用方对象，复用其容量
+            oss << "        if (out->" << output.name << ") out->" << output.name << "->assign(ctx."
+                << output.name << ");\n";
+        } else {
+            oss << "        if (out->" << output.name << ") *out->" << output.name
+                << " = std::move(ctx." << output.name << ");\n";
+        }
     }
     
-    oss << R"(
-    }
+    oss << R"(    }
     
     return result;
 }
 
-// 获取执行器信息
-const char* pipeline_name() {
-    return ")" << config_.name << R"(";
+}  // extern "C"
+)";
 }
 
-const char* pipeline_fingerprint() {
-    return ")" << config_.fingerprint << R"(";
+void CodeGenerator::generate_abi_structs(std::ostream& oss) {
+    auto emit_struct = [&oss](const std::string& struct_name,
+                              const std::vector<PipelineConfig::IOField>& fields,
+                              bool is_input) {
+        AbiStructLayout layout = compute_abi_layout(fields, is_input);
+        
+        oss << "struct " << struct_name << " {\n";
+        for (const auto& field : layout.fields) {
+            std::string type_name = get_cpp_type_name(field.type);
+            if (!is_abi_scalar(field.type) && !is_input) {
+                type_name += "*";
+            } else if (field.type == DataType::STRING) {
+                type_name = "::turbograph::StringView";
+            } else if (!is_abi_scalar(field.type)) {
+                type_name = "::turbograph::ListView<" + get_cpp_type_name(get_list_element_type(field.type)) + ">";
+            }
+            oss << "    " << type_name << " " << field.name << ";  // offset " << field.offset << "\n";
+        }
+        oss << "};\n";
+        
+        for (const auto& field : layout.fields) {
+            oss << "static_assert(offsetof(" << struct_name << ", " << field.name << ") == "
+                << field.offset << ", \"ABI offset mismatch: " << field.name << "\");\n";
+        }
+        if (!layout.fields.empty()) {
+            oss << "static_assert(sizeof(" << struct_name << ") == " << layout.size
+                << ", \"ABI size mismatch: " << struct_name << "\");\n";
+        }
+        oss << "\n";
+        
+        if (!layout.fields.empty()) {
+            oss << "static const ::turbograph::AbiField k" << (is_input ? "Input" : "Output") << "Fields[] = {\n";
+            for (const auto& field : layout.fields) {
+                oss << "    {\"" << field.name << "\", " << static_cast<uint32_t>(field.type) << ", "
+                    << field.offset << ", " << field.size << "},\n";
+            }
+            oss << "};\n\n";
+        }
+    };
+    
+    oss << R"(
+// ============================================================
+// 输入输出ABI结构（偏移与导出的布局描述符一致）
+// ============================================================
+)";
+    
+    emit_struct("PipelineInput", config_.inputs, true);
+    emit_struct("PipelineOutput", config_.outputs, false);
+}
+
+void CodeGenerator::generate_batch_function(std::ostream& oss, bool offsets, bool masked) {
+    std::string ns_name = make_valid_identifier(config_.fingerprint);
+    
+    if (masked) {
+        oss << R"(
+extern "C" {
+
+// 输出掩码入口：mask第j位对应第j个输出，只执行被请求输出依赖的步骤，未请求的输出列不写入
+bool pipeline_execute_batch_masked_)" << ns_name << R"((const ::turbograph::ColumnBatch* input,
+                             ::turbograph::OutputBatch* output,
+                             size_t n, const uint64_t* mask) {
+)";
+    } else if (offsets) {
+        oss << R"(
+extern "C" {
+
+// 偏移编码列入口：字符串/列表输入直接引用调用方的值缓冲区与偏移数组（Arrow布局）
+bool pipeline_execute_offsets_)" << ns_name << R"((const ::turbograph::OffsetBatch* input,
+                             ::turbograph::OutputBatch* output,
+                             size_t n) {
+)";
+    } else {
+        oss << R"(
+// ============================================================
+// 批量导出接口 (C链接，列式输入输出)
+// ============================================================
+
+extern "C" {
+
+bool pipeline_execute_batch_)" << ns_name << R"((const ::turbograph::ColumnBatch* input,
+                             ::turbograph::OutputBatch* output,
+                             size_t n) {
+)";
+    }
+    oss << R"(    if (!input || !output)" << (masked ? " || !mask" : "") << R"() return false;
+    if (input->num_columns < )" << config_.inputs.size() << R"( || output->num_columns < )" << config_.outputs.size() << R"() return false;
+    
+)";
+    
+    if (masked) {
+        // 请求的输出 -> 需要执行的步骤（每个步骤只执行一次，被多个输出共用时也是）
+        const size_t words = (config_.outputs.size() + 63) / 64;
+        oss << "    uint64_t steps[" << std::max<size_t>((config_.steps.size() + 63) / 64, 1) << "] = {};\n";
+        if (!config_.steps.empty()) {
+            oss << "    static const uint64_t kStepOutputs[" << config_.steps.size() << "][" << words << "] = {\n";
+            for (const auto& bits : step_outputs_) {
+                oss << "        {";
+                for (size_t w = 0; w < words; w++) {
+                    oss << (w ? ", " : "") << bits[w] << "ull";
+                }
+                oss << "},\n";
+            }
+            oss << "    };\n"
+                << "    for (size_t s = 0; s < " << config_.steps.size() << "; s++) {\n"
+                << "        for (size_t w = 0; w < " << words << "; w++) {\n"
+                << "            if (mask[w] & kStepOutputs[s][w]) {\n"
+                << "                steps[s / 64] |= uint64_t(1) << (s % 64);\n"
+                << "                break;\n"
+                << "            }\n"
+                << "        }\n"
+                << "    }\n";
+        }
+        for (size_t i = 0; i < config_.outputs.size(); i++) {
+            oss << "    const bool want_" << i << " = (mask[" << i / 64 << "] >> " << i % 64 << ") & 1;\n";
+        }
+        oss << "\n";
+    }
+    
+    // 每个输入/输出字段一段连续缓冲区，循环外取出列指针
+    for (size_t i = 0; i < config_.inputs.size(); i++) {
+        const auto& input = config_.inputs[i];
+        std::string idx = std::to_string(i);
+        if (!offsets) {
+            std::string type_name = get_cpp_type_name(input.type);
+            oss << "    const " << type_name << "* __restrict in_" << idx
+                << " = static_cast<const " << type_name << "*>(input->columns[" << idx << "]);\n";
+            continue;
+        }
+        std::string value_type = get_cpp_type_name(input.type);
+        if (input.type == DataType::STRING || input.type == DataType::STRING_LIST) {
+            value_type = "char";
+        } else if (is_list_type(input.type)) {
+            value_type = get_cpp_type_name(get_list_element_type(input.type));
+        }
+        oss << "    const " << value_type << "* __restrict in_" << idx
+            << " = static_cast<const " << value_type << "*>(input->columns[" << idx << "].values);\n";
+        if (input.type == DataType::STRING || is_list_type(input.type)) {
+            oss << "    const int32_t* __restrict off_" << idx << " = input->columns[" << idx << "].offsets;\n";
+        }
+        if (input.type == DataType::STRING_LIST) {
+            // 上下文中的字符串列表为std::string元素，逐行物化到复用的缓冲区
+            oss << "    const int32_t* __restrict voff_" << idx << " = input->columns[" << idx << "].value_offsets;\n";
+            if (views_.count(input.name)) {
+                oss << "    std::vector<std::string> sl_" << idx << ";\n";
+            }
+        }
+    }
+    for (size_t i = 0; i < config_.outputs.size(); i++) {
+        std::string type_name = get_cpp_type_name(config_.outputs[i].type);
+        oss << "    " << type_name << "* __restrict out_" << i
+            << " = static_cast<" << type_name << "*>(output->columns[" << i << "]);\n";
+    }
+    
+    // 将第row行输入写入上下文的语句
+    auto load_input = [&](size_t i, const std::string& row, const std::string& indent) {
+        const auto& input = config_.inputs[i];
+        const std::string idx = std::to_string(i);
+        const std::string in = "in_" + idx;
+        const std::string target = "ctx." + input.name;
+        const bool view = views_.count(input.name) > 0;
+        if (!offsets) {
+            std::string value = in + "[" + row + "]";
+            if (view) {
+                // 列表/字符串列只引用当前行的元素
+                oss << indent << target << " = {" << value << ".data(), " << value << ".size()};\n";
+            } else {
+                oss << indent << target << " = " << value << ";\n";
+            }
+            return;
+        }
+        const std::string off = "off_" + idx;
+        const std::string begin = off + "[" + row + "]";
+        const std::string end = off + "[" + row + " + 1]";
+        if (input.type == DataType::STRING_LIST) {
+            const std::string list = view ? "sl_" + idx : target;
+            const std::string voff = "voff_" + idx;
+            oss << indent << list << ".resize(" << end << " - " << begin << ");\n"
+                << indent << "for (int32_t k = " << begin << "; k < " << end << "; k++) {\n"
+                << indent << "    " << list << "[k - " << begin << "].assign(" << in << " + " << voff
+                << "[k], " << voff << "[k + 1] - " << voff << "[k]);\n"
+                << indent << "}\n";
+            if (view) {
+                oss << indent << target << " = {" << list << ".data(), " << list << ".size()};\n";
+            }
+        } else if (input.type == DataType::STRING && view) {
+            oss << indent << target << " = std::string_view(" << in << " + " << begin << ", "
+                << end << " - " << begin << ");\n";
+        } else if (input.type == DataType::STRING) {
+            oss << indent << target << ".assign(" << in << " + " << begin << ", " << end << " - " << begin << ");\n";
+        } else if (is_list_type(input.type) && view) {
+            oss << indent << target << " = {" << in << " + " << begin << ", size_t(" << end << " - " << begin << ")};\n";
+        } else if (is_list_type(input.type)) {
+            oss << indent << target << ".assign(" << in << " + " << begin << ", " << in << " + " << end << ");\n";
+        } else {
+            oss << indent << target << " = " << in << "[" << row << "];\n";
+        }
+    };
+    
+    // 上下文在整个批次内复用；请求级常量输入（没有步骤改写时）只在循环外读取一次
+    std::set<std::string> written;
+    for (const auto& step : config_.steps) {
+        written.insert(step.output_var);
+    }
+    std::set<std::string> hoisted;
+    for (const auto& input : config_.inputs) {
+        if (input.broadcast && !written.count(input.name)) {
+            hoisted.insert(input.name);
+        }
+    }
+    
+    oss << "\n    PipelineContext ctx;\n";
+    if (!hoisted.empty()) {
+        oss << "    if (n == 0) return true;\n";
+        for (size_t i = 0; i < config_.inputs.size(); i++) {
+            if (hoisted.count(config_.inputs[i].name)) {
+                load_input(i, "0", "    ");
+            }
+        }
+    }
+    if (!lookups_.empty()) {
+        oss << "    PipelineLookups lookups;\n";
+        for (const auto& name : lookups_) {
+            oss << "    lookups." << name << " = ::turbograph::ops::ListLookup<"
+                << get_cpp_type_name(variables_.at(name)) << ">(ctx." << name << ");\n";
+        }
+    }
+    
+    oss << R"(
+    bool result = true;
+    for (size_t i = 0; i < n; i++) {
+)";
+    
+    for (size_t i = 0; i < config_.inputs.size(); i++) {
+        const auto& input = config_.inputs[i];
+        if (hoisted.count(input.name)) {
+            continue;
+        }
+        load_input(i, input.broadcast ? "0" : "i", "        ");
+    }
+    
+    if (masked) {
+        oss << (lookups_.empty() ? "        result &= execute_internal<true>(ctx, steps);\n"
+                                 : "        result &= execute_internal<true>(ctx, &lookups, steps);\n");
+    } else {
+        oss << (lookups_.empty() ? "        result &= execute_internal(ctx);\n"
+                                 : "        result &= execute_internal(ctx, &lookups);\n");
+    }
+    
+    for (size_t i = 0; i < config_.outputs.size(); i++) {
+        const auto& output = config_.outputs[i];
+        bool movable = is_list_type(output.type) || output.type == DataType::STRING;
+        // 掩码入口只写入请求的输出列
+        oss << (masked ? "        if (want_" + std::to_string(i) + ") " : std::string("        "));
+        if (views_.count(output.name)) {
+            // 视图输入作为输出时拷贝元素
+            oss << "out_" << i << "[i].assign(ctx." << output.name << ".begin(), ctx."
+                << output.name << ".end());\n";
+        } else if (arena_strings_.count(output.name)) {
+            oss << "out_" << i << "[i].assign(ctx." << output.name << ");\n";
+        } else if (movable) {
+            oss << "out_" << i << "[i] = std::move(ctx." << output.name << ");\n";
+        } else {
+            oss << "out_" << i << "[i] = static_cast<" << get_cpp_type_name(output.type)
+                << ">(ctx." << output.name << ");\n";
+        }
+    }
+    
+    oss << R"(    }
+    
+    return result;
 }
 
 }  // extern "C"
@@ -641,8 +1514,8 @@ std::string SimpleCodeGenerator::generate() {
     oss << "#include <cstdint>\n";
     oss << "#include <iostream>\n\n";
     
-    // 使用绝对路径引入算子库
-    oss << "#include \"/workspace/turbograph_jit/include/ops.hpp\"\n\n";
+    // 按-I搜索路径引入算子库
+    oss << "#include \"ops.hpp\"\n\n";
     
     oss << "using namespace turbograph::ops;\n\n";
     
@@ -1,15 +1,29 @@
 #include "compiler.hpp"
+#include "compiler_backend.hpp"
+#include "hash.hpp"
+#include "stats.hpp"
+#include "abi.hpp"
+#include "thread_pool.hpp"
+#include <json.hpp>
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
 namespace turbograph {
 
+using json = nlohmann::json;
+
 // ============================================
 // 编译器封装实现
 // ============================================
@@ -72,36 +86,53 @@ bool Compiler::compile_from_string(const std::string& source_code,
     return result;
 }
 
-std::string Compiler::build_compile_command(const std::string& source_path, 
-                                            const std::string& output_path,
-                                            const CompileOptions& options) {
-    std::ostringstream cmd;
+std::string Compiler::build_flags(const CompileOptions& options) {
+    std::ostringstream flags;
     
-    // 编译器
-    cmd << options.compiler_path << " ";
-    
-    // 优化选项
-    cmd << "-O3 ";
+    // 优化选项（含架构优化）
+    flags << options.optimization << " ";
     
     // 位置无关代码（生成SO必需）
-    cmd << "-shared -fPIC ";
-    
-    // 架构优化
-    cmd << "-march=native ";
+    flags << "-shared -fPIC ";
     
     // C++标准
-    cmd << "-std=c++17 ";
+    flags << "-std=c++17 ";
     
     // 包含路径
-    cmd << "-I" << options.include_dir << " ";
+    flags << "-I" << options.include_dir << " ";
     
     // 额外标志
     if (!options.extra_flags.empty()) {
-        cmd << options.extra_flags << " ";
+        flags << options.extra_flags << " ";
+    }
+    
+    // PGO：插桩版本的计数器需原子更新（多个线程并发执行同一SO）
+    if (options.profile == ProfileMode::GENERATE) {
+        flags << "-fprofile-generate=" << options.profile_dir << " -fprofile-update=atomic ";
+    } else if (options.profile == ProfileMode::USE) {
+        flags << "-fprofile-use=" << options.profile_dir
+              << " -fprofile-correction -Wno-missing-profile -Wno-error=coverage-mismatch ";
     }
     
     // 警告抑制（可选）
-    cmd << "-w ";
+    flags << "-w";
+    
+    return flags.str();
+}
+
+std::string Compiler::build_compile_command(const std::string& source_path, 
+                                            const std::string& output_path,
+                                            const CompileOptions& options) {
+    std::ostringstream cmd;
+    
+    // 编译器与编译选项
+    cmd << options.compiler_path << " ";
+    cmd << build_flags(options) << " ";
+    
+    // 预编译头（需先于源文件中的任何include）
+    if (!options.pch_header.empty()) {
+        cmd << "-include " << options.pch_header << " ";
+    }
     
     // 输入输出
     cmd << source_path << " ";
@@ -113,6 +144,37 @@ std::string Compiler::build_compile_command(const std::string& source_path,
     return cmd.str();
 }
 
+std::string Compiler::compiler_version(const std::string& compiler_path) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::string> versions;
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = versions.find(compiler_path);
+    if (it != versions.end()) {
+        return it->second;
+    }
+    
+    std::string version;
+    std::string cmd = compiler_path + " --version 2>/dev/null";
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (pipe) {
+        char buffer[512];
+        if (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+            version = buffer;
+        }
+        pclose(pipe);
+    }
+    while (!version.empty() && (version.back() == '\n' || version.back() == '\r')) {
+        version.pop_back();
+    }
+    if (version.empty()) {
+        version = "unknown:" + compiler_path;
+    }
+    
+    versions[compiler_path] = version;
+    return version;
+}
+
 int Compiler::execute_command(const std::string& cmd) {
     // 使用popen执行命令
     FILE* pipe = popen(cmd.c_str(), "r");
@@ -154,6 +216,14 @@ long long Compiler::file_size(const std::string& path) {
     return buffer.st_size;
 }
 
+long long Compiler::file_mtime(const std::string& path) {
+    struct stat buffer;
+    if (stat(path.c_str(), &buffer) != 0) {
+        return -1;
+    }
+    return static_cast<long long>(buffer.st_mtim.tv_sec) * 1000000000LL + buffer.st_mtim.tv_nsec;
+}
+
 std::string Compiler::read_file(const std::string& path) {
     std::ifstream file(path);
     if (!file.is_open()) {
@@ -175,107 +245,517 @@ bool Compiler::write_file(const std::string& path, const std::string& content) {
     return true;
 }
 
+std::string Compiler::temp_path(const std::string& path) {
+    static std::atomic<uint64_t> counter{0};
+    return path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(counter++);
+}
+
+bool Compiler::write_file_atomic(const std::string& path, const std::string& content) {
+    std::string temp = temp_path(path);
+    if (!write_file(temp, content)) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
 bool Compiler::create_directory(const std::string& path) {
-    // 使用mkdir -p创建目录
-    std::string cmd = "mkdir -p " + path;
-    return system(cmd.c_str()) == 0;
+    // 逐级mkdir(2)（等同mkdir -p，不经shell，路径无需转义）；已存在的目录不算错误，
+    // 其他进程同时创建时同样返回EEXIST
+    if (path.empty()) {
+        return false;
+    }
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+        std::string dir = path.substr(0, pos);
+        if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            return false;
+        }
+        if (pos == std::string::npos) {
+            break;
+        }
+    }
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+// ============================================
+// 跨进程文件锁实现
+// ============================================
+
+FileLock::FileLock(const std::string& path) {
+    // O_CLOEXEC：编译器子进程不继承锁
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Failed to open lock file " << path << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+    int rc;
+    do {
+        rc = ::flock(fd_, LOCK_EX);
+    } while (rc != 0 && errno == EINTR);
+    if (rc != 0) {
+        std::cerr << "Failed to lock " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+FileLock::~FileLock() {
+    if (fd_ >= 0) {
+        ::flock(fd_, LOCK_UN);
+        ::close(fd_);
+    }
+}
+
+// ============================================
+// 优化层级
+// ============================================
+
+const char* optimization_tier_name(OptimizationTier tier) {
+    switch (tier) {
+        case OptimizationTier::BASELINE: return "BASELINE";
+        case OptimizationTier::OPTIMIZED: return "OPTIMIZED";
+        case OptimizationTier::PROFILING: return "PROFILING";
+        case OptimizationTier::PROFILED: return "PROFILED";
+        default: return "UNKNOWN";
+    }
+}
+
+CompileOptions tier_compile_options(OptimizationTier tier, const CodeGenOptions& gen_options,
+                                    CompileOptions base, const std::string& baseline_optimization) {
+    if (tier == OptimizationTier::BASELINE) {
+        base.optimization = baseline_optimization;
+        return base;
+    }
+    
+    // 与use_fast_math选择的向量变体一致，只放开求值顺序，保留NaN/Inf语义
+    if (gen_options.use_fast_math) {
+        base.optimization += " -fno-math-errno -fno-trapping-math -fno-signed-zeros -fassociative-math";
+    }
+    if (tier == OptimizationTier::PROFILING) {
+        base.profile = ProfileMode::GENERATE;
+    } else if (tier == OptimizationTier::PROFILED) {
+        base.profile = ProfileMode::USE;
+    }
+    return base;
 }
 
 // ============================================
 // 编译缓存实现
 // ============================================
 
-bool CompilationCache::is_valid(const std::string& fingerprint) const {
-    auto it = cache_.find(fingerprint);
-    if (it == cache_.end()) {
+// 清单格式版本，不一致时忽略整个清单
+static constexpr int kManifestVersion = 2;
+
+/**
+ * @brief 检查SO文件是否与记录一致（调用方持有锁）
+ */
+static bool entry_files_valid(const CacheEntry& entry) {
+    long long so_time = Compiler::file_mtime(entry.so_path);
+    if (so_time < 0) {
         return false;
     }
     
-    // 检查文件是否存在且有效
-    if (!Compiler::file_exists(it->second.so_path)) {
+    // SO在记录后被替换或截断
+    if (so_time != entry.so_mtime || Compiler::file_size(entry.so_path) != entry.so_size) {
         return false;
     }
     
-    // 检查文件修改时间
-    long long src_time = Compiler::file_size(it->second.source_path);
-    long long so_time = Compiler::file_size(it->second.so_path);
+    // SO应该比源文件新（源文件可能未保留）
+    long long src_time = Compiler::file_mtime(entry.source_path);
+    if (src_time >= 0 && so_time < src_time) {
+        return false;
+    }
     
-    if (src_time < 0 || so_time < 0) {
+    return true;
+}
+
+bool CompilationCache::is_valid(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+        return false;
+    }
+    return entry_files_valid(it->second);
+}
+
+bool CompilationCache::is_valid(const std::string& key, const BuildIdentity& build) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
         return false;
     }
     
-    // SO应该比源文件新
-    // 这里简化处理，实际应该比较修改时间
+    const BuildIdentity& cached = it->second.build;
+    if (cached.compiler_version != build.compiler_version ||
+        cached.flags != build.flags ||
+        cached.ops_hash != build.ops_hash) {
+        return false;
+    }
     
-    return true;
+    return entry_files_valid(it->second);
 }
 
-void CompilationCache::add(const std::string& fingerprint, 
+void CompilationCache::add(const std::string& key, 
                           const CacheEntry& entry) {
-    cache_[fingerprint] = entry;
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_[key] = entry;
 }
 
-void CompilationCache::remove(const std::string& fingerprint) {
-    cache_.erase(fingerprint);
+void CompilationCache::remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.erase(key);
 }
 
 void CompilationCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
     cache_.clear();
 }
 
-std::optional<CacheEntry> CompilationCache::get(const std::string& fingerprint) const {
-    auto it = cache_.find(fingerprint);
+std::optional<CacheEntry> CompilationCache::get(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
     if (it != cache_.end()) {
         return it->second;
     }
     return std::nullopt;
 }
 
+void CompilationCache::touch(const std::string& key, long long now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) {
+        it->second.last_used = now;
+    }
+}
+
 size_t CompilationCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return cache_.size();
 }
 
+long long CompilationCache::total_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // 合并编译单元的多个条目共享同一SO，只计一次
+    std::unordered_map<std::string, long long> files;
+    for (const auto& [key, entry] : cache_) {
+        files[entry.so_path] = entry.so_size;
+    }
+    long long total = 0;
+    for (const auto& [path, size] : files) {
+        total += size;
+    }
+    return total;
+}
+
+bool CompilationCache::references(const std::string& so_path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [key, entry] : cache_) {
+        if (entry.so_path == so_path) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<CacheEntry> CompilationCache::evict(size_t max_entries, long long max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<CacheEntry> evicted;
+    
+    // 每个SO文件的引用数和大小
+    std::unordered_map<std::string, std::pair<size_t, long long>> files;
+    long long total = 0;
+    std::vector<const CacheEntry*> order;
+    order.reserve(cache_.size());
+    for (const auto& [key, entry] : cache_) {
+        auto& file = files[entry.so_path];
+        if (file.first++ == 0) {
+            file.second = entry.so_size;
+            total += entry.so_size;
+        }
+        order.push_back(&entry);
+    }
+    
+    bool over_entries = max_entries > 0 && cache_.size() > max_entries;
+    bool over_bytes = max_bytes > 0 && total > max_bytes;
+    if (!over_entries && !over_bytes) {
+        return evicted;
+    }
+    
+    // 最久未使用的排在前面
+    std::sort(order.begin(), order.end(), [](const CacheEntry* a, const CacheEntry* b) {
+        return a->last_used < b->last_used;
+    });
+    
+    size_t remaining = cache_.size();
+    for (const CacheEntry* entry : order) {
+        over_entries = max_entries > 0 && remaining > max_entries;
+        over_bytes = max_bytes > 0 && total > max_bytes;
+        if (!over_entries && !over_bytes) {
+            break;
+        }
+        // SO的最后一个引用被淘汰时才释放其空间
+        auto& file = files[entry->so_path];
+        if (--file.first == 0) {
+            total -= file.second;
+        }
+        remaining--;
+        evicted.push_back(*entry);
+    }
+    
+    for (const auto& entry : evicted) {
+        cache_.erase(entry.key);
+    }
+    return evicted;
+}
+
+bool CompilationCache::load(const std::string& manifest_path) {
+    std::string content = Compiler::read_file(manifest_path);
+    if (content.empty()) {
+        return false;
+    }
+    
+    json manifest = json::parse(content, nullptr, false);
+    if (manifest.is_discarded() || manifest.value("version", 0) != kManifestVersion ||
+        !manifest.contains("entries") || !manifest["entries"].is_array()) {
+        std::cerr << "Ignoring unreadable cache manifest: " << manifest_path << std::endl;
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& item : manifest["entries"]) {
+        CacheEntry entry;
+        entry.key = item.value("key", "");
+        entry.fingerprint = item.value("fingerprint", "");
+        entry.source_path = item.value("source_path", "");
+        entry.so_path = item.value("so_path", "");
+        entry.build.compiler_version = item.value("compiler_version", "");
+        entry.build.flags = item.value("flags", "");
+        entry.build.ops_hash = item.value("ops_hash", "");
+        entry.build.ops_mtime = item.value("ops_mtime", 0LL);
+        entry.so_mtime = item.value("so_mtime", 0LL);
+        entry.so_size = item.value("so_size", 0LL);
+        entry.last_used = item.value("last_used", 0LL);
+        entry.compile_time = std::chrono::steady_clock::now();
+        
+        if (entry.key.empty() || !Compiler::file_exists(entry.so_path)) {
+            continue;
+        }
+        // 内存中的条目仍有效时保留（LRU时间可能更新），SO已被其他进程替换时取清单中的记录
+        auto [it, inserted] = cache_.emplace(entry.key, entry);
+        if (!inserted && !entry_files_valid(it->second)) {
+            it->second = entry;
+        }
+    }
+    return true;
+}
+
+bool CompilationCache::save(const std::string& manifest_path) const {
+    json entries = json::array();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [fp, entry] : cache_) {
+            entries.push_back({
+                {"key", entry.key},
+                {"fingerprint", entry.fingerprint},
+                {"source_path", entry.source_path},
+                {"so_path", entry.so_path},
+                {"compiler_version", entry.build.compiler_version},
+                {"flags", entry.build.flags},
+                {"ops_hash", entry.build.ops_hash},
+                {"ops_mtime", entry.build.ops_mtime},
+                {"so_mtime", entry.so_mtime},
+                {"so_size", entry.so_size},
+                {"last_used", entry.last_used}
+            });
+        }
+    }
+    
+    json manifest = {{"version", kManifestVersion}, {"entries", entries}};
+    
+    // 先写临时文件再重命名，读者不会看到写了一半的清单
+    return Compiler::write_file_atomic(manifest_path, manifest.dump(2));
+}
+
 // ============================================
 // JIT编译器实现
 // ============================================
 
+static long long unix_now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+JITCompiler::JITCompiler() : gcc_backend_(std::make_shared<GccBackend>()) {
+    const char* env = std::getenv("TURBOGRAPH_SHARED_CACHE");
+    shared_cache_ = env != nullptr && *env != '\0' && std::strcmp(env, "0") != 0;
+}
+
 JITCompiler& JITCompiler::instance() {
     static JITCompiler compiler;
     return compiler;
 }
 
+std::unique_ptr<CompiledModule> JITCompiler::load(const PipelineConfig& config,
+                                                  const CodeGenOptions& gen_options,
+                                                  const CompileOptions& comp_options,
+                                                  bool rebuild) {
+    std::shared_ptr<ICompilerBackend> selected = backend();
+    // 进程内后端直接生成IR，不经过CodeGenerator，插桩模式固定使用g++后端
+    if (selected != gcc_backend_ && selected->supports(config) && !gen_options.profile_steps) {
+        uint64_t start = kStatsCompiled ? stats_now_ns() : 0;
+        if (auto module = selected->load(config, gen_options, comp_options, rebuild)) {
+            if constexpr (kStatsCompiled) {
+                // 进程内后端每次加载都完整编译，计为一次未命中
+                if (auto stats = StatsRegistry::instance().pipeline(config.name, config.fingerprint)) {
+                    uint64_t elapsed = stats_now_ns() - start;
+                    stats->record_compile(elapsed);
+                    stats->record_load(0, false);
+                }
+            }
+            return module;
+        }
+        std::cerr << "Backend " << selected->name() << " failed, falling back to "
+                  << gcc_backend_->name() << ": " << config.name << std::endl;
+    }
+    return gcc_backend_->load(config, gen_options, comp_options, rebuild);
+}
+
+void JITCompiler::set_backend(std::shared_ptr<ICompilerBackend> backend) {
+    std::lock_guard<std::mutex> lock(backend_mutex_);
+    backend_ = std::move(backend);
+}
+
+std::shared_ptr<ICompilerBackend> JITCompiler::backend() const {
+    std::lock_guard<std::mutex> lock(backend_mutex_);
+    return backend_ ? backend_ : gcc_backend_;
+}
+
 bool JITCompiler::compile(const PipelineConfig& config, 
                           const CodeGenOptions& gen_options,
-                          const CompileOptions& comp_options) {
+                          const CompileOptions& requested,
+                          bool rebuild) {
+    CompileOptions comp_options = resolve_options(gen_options, requested);
+    
+    // 指纹为空时按内容计算，生成代码中的符号名同样依赖指纹
+    PipelineConfig keyed = config;
+    if (keyed.fingerprint.empty()) {
+        keyed.compute_fingerprint();
+    }
+    
     // 生成代码
-    CodeGenerator generator(config, gen_options);
+    CodeGenerator generator(keyed, gen_options);
     std::string code = generator.generate();
     
-    // 生成指纹
-    std::string fingerprint = config.fingerprint;
-    if (fingerprint.empty()) {
-        // 需要修改config来计算指纹，但config是const引用
-        // 这里使用config的数据重新计算
-        std::ostringstream oss;
-        oss << config.name << "|";
-        for (const auto& step : config.steps) {
-            oss << step.op_name << "(";
-            for (size_t i = 0; i < step.args.size(); i++) {
-                oss << step.args[i].value;
-                if (i < step.args.size() - 1) oss << ",";
+    // 确定输出路径（按缓存键命名，不同构建环境的SO互不覆盖）
+    std::string key = cache_key(keyed.fingerprint, gen_options, comp_options);
+    return build_and_register(code, get_cache_path(key), {{keyed.fingerprint, key}},
+                              gen_options, comp_options, rebuild);
+}
+
+std::vector<bool> JITCompiler::compile_many(const std::vector<PipelineConfig>& configs,
+                                            const CodeGenOptions& gen_options,
+                                            const CompileOptions& requested,
+                                            const BatchCompileOptions& batch_options) {
+    CompileOptions comp_options = resolve_options(gen_options, requested);
+    std::vector<bool> results(configs.size(), false);
+    
+    // 计算指纹与缓存键，跳过已缓存和重复的配置
+    std::vector<PipelineConfig> keyed(configs);
+    std::vector<std::string> keys(configs.size());
+    std::unordered_map<std::string, size_t> first_index;
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < keyed.size(); i++) {
+        if (keyed[i].fingerprint.empty()) {
+            keyed[i].compute_fingerprint();
+        }
+        keys[i] = cache_key(keyed[i].fingerprint, gen_options, comp_options);
+        if (batch_options.skip_cached && get_so_path(keyed[i].fingerprint, requested, gen_options)) {
+            results[i] = true;
+            continue;
+        }
+        if (first_index.emplace(keys[i], i).second) {
+            pending.push_back(i);
+        }
+    }
+    
+    // 按pipelines_per_unit分组，每组生成一个编译单元
+    size_t per_unit = std::max<size_t>(1, batch_options.pipelines_per_unit);
+    std::vector<std::vector<size_t>> units;
+    for (size_t i = 0; i < pending.size(); i += per_unit) {
+        units.emplace_back(pending.begin() + i,
+                           pending.begin() + std::min(pending.size(), i + per_unit));
+    }
+    
+    if (!units.empty()) {
+        size_t parallel = batch_options.max_parallel;
+        if (parallel == 0) {
+            parallel = std::max(1u, std::thread::hardware_concurrency());
+        }
+        parallel = std::min(parallel, units.size());
+        
+        // 同时运行的编译器进程数不超过parallel
+        std::vector<char> unit_ok(units.size(), 0);
+        {
+            ThreadPool pool(parallel, units.size());
+            for (size_t u = 0; u < units.size(); u++) {
+                pool.submit([&, u] {
+                    const auto& unit = units[u];
+                    if (unit.size() == 1) {
+                        unit_ok[u] = compile(keyed[unit[0]], gen_options, requested);
+                        return;
+                    }
+                    
+                    std::vector<PipelineConfig> members;
+                    std::vector<std::pair<std::string, std::string>> member_keys;
+                    HashBuilder unit_hasher;
+                    unit_hasher.add("turbograph-unit");
+                    for (size_t index : unit) {
+                        members.push_back(keyed[index]);
+                        member_keys.emplace_back(keyed[index].fingerprint, keys[index]);
+                        unit_hasher.add(keys[index]);
+                    }
+                    
+                    std::string code = CodeGenerator::generate_unit(members, gen_options);
+                    std::string so_path = cache_dir_ + "/libpipeline_unit_" + unit_hasher.finish().hex() + ".so";
+                    unit_ok[u] = build_and_register(code, so_path, member_keys, gen_options, comp_options);
+                });
+            }
+            pool.wait_idle();
+        }
+        
+        for (size_t u = 0; u < units.size(); u++) {
+            for (size_t index : units[u]) {
+                results[index] = unit_ok[u] != 0;
+            }
+        }
+    }
+    
+    // 重复配置沿用首次出现的结果
+    for (size_t i = 0; i < keyed.size(); i++) {
+        if (!results[i]) {
+            auto it = first_index.find(keys[i]);
+            if (it != first_index.end()) {
+                results[i] = results[it->second];
             }
-            oss << ")->" << step.output_var << ";";
         }
-        std::hash<std::string> hasher;
-        size_t hash = hasher(oss.str());
-        std::ostringstream hash_oss;
-        hash_oss << std::hex << hash;
-        fingerprint = hash_oss.str();
     }
     
-    // 确定输出路径
-    std::string so_path = get_cache_path(fingerprint);
+    return results;
+}
+
+bool JITCompiler::build_and_register(const std::string& code, const std::string& so_path,
+                                     const std::vector<std::pair<std::string, std::string>>& members,
+                                     const CodeGenOptions& gen_options,
+                                     const CompileOptions& comp_options,
+                                     bool rebuild) {
     std::string source_path = so_path + ".cpp";
+    CompileOptions options = comp_options;
     
     // 确保目录存在
     std::string dir = so_path.substr(0, so_path.find_last_of('/'));
@@ -284,61 +764,421 @@ bool JITCompiler::compile(const PipelineConfig& config,
         return false;
     }
     
-    // 保存源文件
-    if (!Compiler::write_file(source_path, code)) {
-        std::cerr << "Failed to write source file: " << source_path << std::endl;
-        return false;
+    // 插桩与按计数编译的两个版本需使用同一源文件路径和辅助文件名，计数文件才能对应
+    if (comp_options.profile != ProfileMode::NONE) {
+        if (!Compiler::create_directory(comp_options.profile_dir)) {
+            std::cerr << "Failed to create profile directory: " << comp_options.profile_dir << std::endl;
+            return false;
+        }
+        std::string base = "pipeline_" + members.front().first;
+        source_path = comp_options.profile_dir + "/" + base + ".cpp";
+        if (!options.extra_flags.empty()) options.extra_flags += " ";
+        options.extra_flags += "-dumpdir " + comp_options.profile_dir + "/ -dumpbase " + base;
+        options.use_pch = false;
     }
     
-    // 编译
-    if (!Compiler::compile(source_path, so_path, comp_options)) {
-        std::cerr << "Compilation failed for: " << fingerprint << std::endl;
-        // 只有在不保留源文件时才删除
-        if (!comp_options.keep_source) {
-            std::remove(source_path.c_str());
+    // 共享缓存模式：同一SO同时只由一个进程编译。SO按缓存键命名且只以重命名写入，
+    // 持锁后已存在的SO即同一配置和构建环境的完整编译结果（可能在加锁前就已由其他进程写入、
+    // 只是清单尚未合并），直接登记复用；强制重新编译时已有SO正是要替换的对象，不复用
+    std::optional<FileLock> build_lock;
+    if (shared_cache_) {
+        build_lock.emplace(lock_path(so_path.substr(so_path.find_last_of('/') + 1)));
+    }
+    bool adopted = !rebuild && build_lock && build_lock->locked() && Compiler::file_mtime(so_path) >= 0;
+    
+    if (adopted) {
+        adopted_builds_++;
+        if (gen_options.verbose) {
+            std::cout << "Reusing SO built by another process: " << so_path << std::endl;
+        }
+    } else {
+        // 保存源文件
+        if (!Compiler::write_file_atomic(source_path, code)) {
+            std::cerr << "Failed to write source file: " << source_path << std::endl;
+            return false;
+        }
+        
+        // 编译到临时文件再重命名，其他进程只会dlopen完整的SO
+        // （预编译头只影响编译速度，不参与缓存校验）
+        options.pch_header = options.use_pch ? ensure_pch(comp_options) : "";
+        std::string temp_so = Compiler::temp_path(so_path);
+        bool compiled = Compiler::compile(source_path, temp_so, options);
+        if (compiled && std::rename(temp_so.c_str(), so_path.c_str()) != 0) {
+            std::cerr << "Failed to move " << temp_so << " to " << so_path << ": "
+                      << std::strerror(errno) << std::endl;
+            compiled = false;
+        }
+        if (!compiled) {
+            std::cerr << "Compilation failed for: " << so_path << std::endl;
+            std::remove(temp_so.c_str());
+            // 只有在不保留源文件时才删除
+            if (!comp_options.keep_source) {
+                std::remove(source_path.c_str());
+            }
+            return false;
         }
-        return false;
     }
     
-    // 添加到缓存
+    // 添加到缓存并持久化（合并编译单元中的每个管道各占一个条目，共享同一SO）
     CacheEntry entry;
-    entry.fingerprint = fingerprint;
     entry.source_path = source_path;
     entry.so_path = so_path;
     entry.compile_time = std::chrono::steady_clock::now();
+    entry.build = current_build(comp_options);
+    entry.so_mtime = Compiler::file_mtime(so_path);
+    entry.so_size = Compiler::file_size(so_path);
+    entry.last_used = unix_now();
     
-    cache_.add(fingerprint, entry);
-    
-    if (gen_options.verbose) {
-        std::cout << "Compiled: " << fingerprint << " -> " << so_path << std::endl;
+    ensure_loaded();
+    for (const auto& [fingerprint, key] : members) {
+        entry.key = key;
+        entry.fingerprint = fingerprint;
+        cache_.add(key, entry);
+        
+        if (gen_options.verbose) {
+            std::cout << "Compiled: " << fingerprint << " -> " << so_path << std::endl;
+        }
     }
+    evict_and_save();
     
     return true;
 }
 
-std::optional<std::string> JITCompiler::get_so_path(const std::string& fingerprint) const {
-    auto entry = cache_.get(fingerprint);
-    if (entry.has_value() && Compiler::file_exists(entry->so_path)) {
-        return entry->so_path;
+std::optional<std::string> JITCompiler::get_so_path(const std::string& fingerprint,
+                                                    const CompileOptions& requested,
+                                                    const CodeGenOptions& gen_options) {
+    CompileOptions comp_options = resolve_options(gen_options, requested);
+    ensure_loaded();
+    std::string key = cache_key(fingerprint, gen_options, comp_options);
+    BuildIdentity build = current_build(comp_options);
+    if (!cache_.is_valid(key, build)) {
+        // 其他进程可能已编译并登记到共享清单
+        if (!shared_cache_) {
+            return std::nullopt;
+        }
+        refresh_shared();
+        if (!cache_.is_valid(key, build)) {
+            return std::nullopt;
+        }
     }
-    return std::nullopt;
+    
+    auto entry = cache_.get(key);
+    if (!entry.has_value()) {
+        return std::nullopt;
+    }
+    
+    // 命中时只更新内存中的LRU时间，下次编译或flush时写入清单
+    cache_.touch(key, unix_now());
+    dirty_ = true;
+    return entry->so_path;
+}
+
+CompileOptions JITCompiler::resolve_options(const CodeGenOptions& gen_options,
+                                            const CompileOptions& comp_options) const {
+    CompileOptions resolved = comp_options;
+    std::string extra = resolved.extra_flags;
+    auto append = [&extra](const std::string& flags) {
+        if (!extra.empty()) extra += " ";
+        extra += flags;
+    };
+    if (!gen_options.compiler_flags.empty()) {
+        append(gen_options.compiler_flags);
+    }
+    if (!gen_options.enable_inline) {
+        append("-fno-inline");
+    }
+    if (!gen_options.enable_vectorize) {
+        append("-fno-tree-vectorize -fno-tree-slp-vectorize");
+    }
+    resolved.extra_flags = extra;
+    if (resolved.profile != ProfileMode::NONE && resolved.profile_dir.empty()) {
+        resolved.profile_dir = cache_dir_ + "/profile";
+    }
+    return resolved;
+}
+
+BuildIdentity JITCompiler::current_build(const CompileOptions& options) {
+    BuildIdentity build;
+    build.compiler_version = Compiler::compiler_version(options.compiler_path);
+    build.flags = Compiler::build_flags(options);
+    
+    // 生成代码可能包含的算子库头文件
+    static const char* const kHeaders[] = {"ops.hpp", "ops_core.hpp", "simd.hpp", "abi.hpp", "probe.hpp"};
+    long long mtime = -1;
+    for (const char* header : kHeaders) {
+        mtime = std::max(mtime, Compiler::file_mtime(options.include_dir + "/" + header));
+    }
+    build.ops_mtime = mtime;
+    
+    std::lock_guard<std::mutex> lock(ops_mutex_);
+    auto it = ops_hashes_.find(options.include_dir);
+    if (it != ops_hashes_.end() && it->second.first == mtime) {
+        build.ops_hash = it->second.second;
+        return build;
+    }
+    
+    if (mtime >= 0) {
+        HashBuilder hasher;
+        for (const char* header : kHeaders) {
+            hasher.add(header).add(Compiler::read_file(options.include_dir + "/" + header));
+        }
+        build.ops_hash = hasher.finish().hex();
+    } else {
+        build.ops_hash = "missing";
+    }
+    ops_hashes_[options.include_dir] = {mtime, build.ops_hash};
+    return build;
 }
 
-std::string JITCompiler::get_cache_path(const std::string& fingerprint) const {
-    return cache_dir_ + "/libpipeline_" + fingerprint + ".so";
+std::string JITCompiler::ensure_pch(const CompileOptions& options) {
+    if (!options.use_pch) {
+        return "";
+    }
+    
+    BuildIdentity build = current_build(options);
+    HashBuilder hasher;
+    hasher.add("turbograph-pch").add(build.compiler_version).add(build.flags).add(build.ops_hash);
+    std::string id = hasher.finish().hex();
+    
+    std::lock_guard<std::mutex> lock(pch_mutex_);
+    auto it = pch_headers_.find(id);
+    if (it != pch_headers_.end()) {
+        return it->second;
+    }
+    
+    std::string dir = cache_dir_ + "/pch/" + id;
+    std::string header = dir + "/turbograph_pch.hpp";
+    std::string gch = header + ".gch";
+    
+    // 共享缓存模式下同一预编译头只由一个进程生成，其余进程等锁后复用
+    std::optional<FileLock> build_lock;
+    if (shared_cache_) {
+        build_lock.emplace(lock_path("pch_" + id));
+    }
+    
+    // 其他进程已生成时直接复用
+    if (Compiler::file_exists(gch) && Compiler::file_exists(header)) {
+        pch_headers_[id] = header;
+        return header;
+    }
+    
+    std::string content = R"(// 预编译头：生成代码使用的标准库与算子库
+#include <cmath>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include "ops.hpp"
+#include "abi.hpp"
+)";
+    
+    bool ok = Compiler::create_directory(dir) && Compiler::write_file_atomic(header, content);
+    if (ok) {
+        // 先写临时文件再重命名，并发生成时不会读到不完整的gch
+        std::string temp_gch = Compiler::temp_path(gch);
+        std::string cmd = options.compiler_path + " " + build.flags + " -x c++-header " +
+                          header + " -o " + temp_gch + " 2>&1";
+        if (options.verbose) {
+            std::cout << "Building PCH: " << cmd << std::endl;
+        }
+        ok = Compiler::execute_command(cmd) == 0 && std::rename(temp_gch.c_str(), gch.c_str()) == 0;
+        if (!ok) {
+            std::remove(temp_gch.c_str());
+        }
+    }
+    
+    if (!ok) {
+        std::cerr << "Failed to build precompiled header, compiling without it" << std::endl;
+        pch_headers_[id] = "";
+        return "";
+    }
+    
+    pch_headers_[id] = header;
+    return header;
+}
+
+/**
+ * @brief 递归收集目录下以suffix结尾的文件
+ */
+static void find_files_with_suffix(const std::string& dir_path, const std::string& suffix,
+                                   std::vector<std::string>& files) {
+    DIR* dir = ::opendir(dir_path.c_str());
+    if (!dir) {
+        return;
+    }
+    while (const dirent* entry = ::readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string path = dir_path + "/" + name;
+        struct stat st;
+        if (::lstat(path.c_str(), &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            find_files_with_suffix(path, suffix, files);
+        } else if (name.size() >= suffix.size() &&
+                   name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            files.push_back(path);
+        }
+    }
+    ::closedir(dir);
+}
+
+/**
+ * @brief 读取管道的PGO计数文件内容
+ * -fprofile-generate=<dir>按编译输出路径放置计数文件（绝对路径拼接为子目录，
+ * 相对路径将'/'替换为'#'），以"pipeline_<指纹>.gcda"结尾的文件即该管道的计数
+ */
+static std::string read_profile_data(const std::string& profile_dir, const std::string& fingerprint) {
+    std::vector<std::string> files;
+    find_files_with_suffix(profile_dir, "pipeline_" + fingerprint + ".gcda", files);
+    std::sort(files.begin(), files.end());
+    std::string data;
+    for (const auto& file : files) {
+        data += Compiler::read_file(file);
+    }
+    return data;
+}
+
+std::string JITCompiler::cache_key(const std::string& fingerprint,
+                                   const CodeGenOptions& gen_options,
+                                   const CompileOptions& comp_options) {
+    BuildIdentity build = current_build(comp_options);
+    
+    // output_dir/use_cache/verbose不影响生成的SO，不参与
+    HashBuilder hasher;
+    hasher.add("turbograph-so")
+          .add(fingerprint)
+          .add(static_cast<uint64_t>(kCodegenVersion))
+          .add(static_cast<uint64_t>(kAbiVersion))
+          .add(gen_options.enable_inline)
+          .add(gen_options.enable_vectorize)
+          .add(gen_options.use_fast_math)
+          .add(gen_options.optimize)
+          .add(gen_options.profile_steps)
+          .add(gen_options.compiler_flags)
+          .add(build.compiler_version)
+          .add(build.flags)
+          .add(build.ops_hash);
+    
+    // 按计数编译的SO还取决于计数内容，重启后插桩版本累积的新计数会得到新的SO
+    if (comp_options.profile == ProfileMode::USE) {
+        hasher.add(read_profile_data(comp_options.profile_dir, fingerprint));
+    }
+    return hasher.finish().hex();
+}
+
+std::string JITCompiler::get_cache_path(const std::string& key) const {
+    return cache_dir_ + "/libpipeline_" + key + ".so";
+}
+
+std::string JITCompiler::manifest_path() const {
+    return cache_dir_ + "/manifest.json";
+}
+
+std::string JITCompiler::lock_path(const std::string& name) const {
+    std::string dir = cache_dir_ + "/locks";
+    ::mkdir(dir.c_str(), 0755);
+    return dir + "/" + name + ".lock";
+}
+
+void JITCompiler::refresh_shared() {
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
+    long long mtime = Compiler::file_mtime(manifest_path());
+    if (mtime < 0 || mtime == manifest_mtime_) {
+        return;
+    }
+    manifest_mtime_ = mtime;
+    cache_.load(manifest_path());
 }
 
 void JITCompiler::set_cache_dir(const std::string& dir) {
+    flush();
+    
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
     cache_dir_ = dir;
     Compiler::create_directory(cache_dir_);
+    cache_.clear();
+    manifest_loaded_ = false;
+}
+
+void JITCompiler::set_cache_limits(size_t max_entries, long long max_bytes) {
+    max_entries_ = max_entries;
+    max_bytes_ = max_bytes;
+    ensure_loaded();
+    evict_and_save();
 }
 
 void JITCompiler::clear_cache() {
-    // 清理缓存
+    // 清理缓存索引（SO文件保留，但不再被复用）
+    ensure_loaded();
     cache_.clear();
     
-    // 可选：删除缓存目录中的文件
-    // 这里简化处理，只清理内存缓存
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
+    cache_.save(manifest_path());
+    dirty_ = false;
+}
+
+bool JITCompiler::flush() {
+    if (!dirty_.exchange(false)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
+    
+    // 共享缓存模式：持有清单锁，先合并其他进程登记的条目再写回
+    std::optional<FileLock> shared;
+    if (shared_cache_) {
+        shared.emplace(lock_path("manifest"));
+        cache_.load(manifest_path());
+    }
+    bool ok = cache_.save(manifest_path());
+    manifest_mtime_ = Compiler::file_mtime(manifest_path());
+    return ok;
+}
+
+JITCompiler::~JITCompiler() {
+    flush();
+}
+
+void JITCompiler::ensure_loaded() {
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
+    if (manifest_loaded_) {
+        return;
+    }
+    manifest_loaded_ = true;
+    manifest_mtime_ = Compiler::file_mtime(manifest_path());
+    cache_.load(manifest_path());
+}
+
+void JITCompiler::evict_and_save() {
+    std::lock_guard<std::mutex> lock(manifest_mutex_);
+    bool dir_ok = Compiler::create_directory(cache_dir_);
+    
+    // 共享缓存模式：持有清单锁，先合并其他进程登记的条目，上限按整个缓存目录计算
+    std::optional<FileLock> shared;
+    if (shared_cache_ && dir_ok) {
+        shared.emplace(lock_path("manifest"));
+        cache_.load(manifest_path());
+    }
+    
+    for (const auto& entry : cache_.evict(max_entries_, max_bytes_)) {
+        // 合并编译单元的SO仍被其他条目引用时保留
+        if (cache_.references(entry.so_path)) {
+            continue;
+        }
+        std::remove(entry.so_path.c_str());
+        std::remove(entry.source_path.c_str());
+    }
+    
+    if (!dir_ok || !cache_.save(manifest_path())) {
+        std::cerr << "Failed to write cache manifest: " << manifest_path() << std::endl;
+    }
+    manifest_mtime_ = Compiler::file_mtime(manifest_path());
+    dirty_ = false;
 }
 
 } // namespace turbograph
@@ -0,0 +1,87 @@
+#include "compiler_backend.hpp"
+#include "stats.hpp"
+#include <dlfcn.h>
+#include <iostream>
+
+namespace turbograph {
+
+// ============================================
+// g++后端实现
+// ============================================
+
+namespace {
+
+/**
+ * @brief dlopen加载的SO
+ */
+class SharedObjectModule : public CompiledModule {
+public:
+    explicit SharedObjectModule(void* handle) : handle_(handle) {}
+    ~SharedObjectModule() override { dlclose(handle_); }
+
+    SharedObjectModule(const SharedObjectModule&) = delete;
+    SharedObjectModule& operator=(const SharedObjectModule&) = delete;
+
+    void* symbol(const std::string& name) const override {
+        return dlsym(handle_, name.c_str());
+    }
+
+    const char* backend() const override { return "gcc"; }
+
+private:
+    void* handle_;
+};
+
+} // namespace
+
+std::unique_ptr<CompiledModule> GccBackend::load(const PipelineConfig& config,
+                                                 const CodeGenOptions& gen_options,
+                                                 const CompileOptions& comp_options,
+                                                 bool rebuild) {
+    PipelineConfig keyed = config;
+    if (keyed.fingerprint.empty()) {
+        keyed.compute_fingerprint();
+    }
+
+    auto& compiler = JITCompiler::instance();
+
+    std::shared_ptr<PipelineStats> stats;
+    if constexpr (kStatsCompiled) {
+        stats = StatsRegistry::instance().pipeline(keyed.name, keyed.fingerprint);
+    }
+
+    // 持久化缓存中有与当前构建环境一致的SO时直接加载
+    std::optional<std::string> so_path;
+    if (!rebuild) {
+        so_path = compiler.get_so_path(keyed.fingerprint, comp_options, gen_options);
+    }
+    const bool cache_hit = so_path.has_value();
+    if (!so_path.has_value()) {
+        uint64_t start = stats ? stats_now_ns() : 0;
+        bool compiled = compiler.compile(keyed, gen_options, comp_options, rebuild);
+        if (stats) {
+            stats->record_compile(stats_now_ns() - start);
+        }
+        if (!compiled) {
+            std::cerr << "Failed to compile pipeline: " << keyed.fingerprint << std::endl;
+            return nullptr;
+        }
+        so_path = compiler.get_so_path(keyed.fingerprint, comp_options, gen_options);
+        if (!so_path.has_value()) {
+            return nullptr;
+        }
+    }
+
+    uint64_t start = stats ? stats_now_ns() : 0;
+    void* handle = dlopen(so_path->c_str(), RTLD_LAZY | RTLD_LOCAL);
+    if (!handle) {
+        std::cerr << "Failed to load SO: " << dlerror() << std::endl;
+        return nullptr;
+    }
+    if (stats) {
+        stats->record_load(stats_now_ns() - start, cache_hit);
+    }
+    return std::make_unique<SharedObjectModule>(handle);
+}
+
+} // namespace turbograph
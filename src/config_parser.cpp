@@ -1,9 +1,17 @@
 #include "config.hpp"
+#include "hash.hpp"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 #include <iostream>
 #include <regex>
 #include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using json = nlohmann::json;
 
@@ -13,29 +21,62 @@ namespace turbograph {
 // PipelineConfig 实现
 // ============================================
 
-std::string PipelineConfig::compute_fingerprint() {
-    std::ostringstream oss;
-    oss << name << "|";
-    for (const auto& input : inputs) {
-        oss << input.name << ":" << data_type_to_string(input.type) << ",";
+/**
+ * @brief 写入IO字段列表
+ */
+static void hash_fields(HashBuilder& hasher, const char* tag,
+                        const std::vector<PipelineConfig::IOField>& fields) {
+    hasher.add(tag).add(static_cast<uint64_t>(fields.size()));
+    for (const auto& field : fields) {
+        hasher.add(field.name)
+              .add(static_cast<uint64_t>(field.type))
+              .add(field.required);
+        // 未设置时不写入，已有配置的指纹保持不变
+        if (field.broadcast) {
+            hasher.add("broadcast");
+        }
     }
-    oss << "|";
-    for (const auto& step : steps) {
-        oss << step.op_name << "(";
-        for (size_t i = 0; i < step.args.size(); i++) {
-            oss << step.args[i].value;
-            if (i < step.args.size() - 1) oss << ",";
+}
+
+std::string compute_config_fingerprint(const PipelineConfig& config) {
+    // 规范化序列化：字段按声明顺序写入（顺序决定槽位和ABI布局），
+    // 算子选项按键排序，与unordered_map的遍历顺序无关
+    HashBuilder hasher;
+    hasher.add("turbograph-config").add(static_cast<uint64_t>(kConfigHashVersion));
+    hasher.add(config.name);
+    
+    hash_fields(hasher, "inputs", config.inputs);
+    hash_fields(hasher, "variables", config.variables);
+    hash_fields(hasher, "outputs", config.outputs);
+    // 默认精度不写入，已有配置的指纹保持不变
+    if (config.precision != Precision::DOUBLE) {
+        hasher.add("precision").add(static_cast<uint64_t>(config.precision));
+    }
+    
+    hasher.add("steps").add(static_cast<uint64_t>(config.steps.size()));
+    for (const auto& step : config.steps) {
+        hasher.add(step.op_name).add(step.output_var);
+        
+        hasher.add(static_cast<uint64_t>(step.args.size()));
+        for (const auto& arg : step.args) {
+            hasher.add(static_cast<uint64_t>(arg.type))
+                  .add(static_cast<uint64_t>(arg.data_type))
+                  .add(arg.value);
+        }
+        
+        std::vector<std::pair<std::string, std::string>> options(step.options.begin(), step.options.end());
+        std::sort(options.begin(), options.end());
+        hasher.add(static_cast<uint64_t>(options.size()));
+        for (const auto& [key, value] : options) {
+            hasher.add(key).add(value);
         }
-        oss << ")->" << step.output_var << ";";
     }
     
-    // 计算SHA256哈希
-    std::string str = oss.str();
-    std::hash<std::string> hasher;
-    size_t hash = hasher(str);
-    std::ostringstream hash_oss;
-    hash_oss << std::hex << hash;
-    fingerprint = hash_oss.str();
+    return hasher.finish().hex();
+}
+
+std::string PipelineConfig::compute_fingerprint() {
+    fingerprint = compute_config_fingerprint(*this);
     return fingerprint;
 }
 
@@ -43,6 +84,84 @@ std::string PipelineConfig::compute_fingerprint() {
 // JsonConfigParser 实现
 // ============================================
 
+/**
+ * @brief 解析精度策略名称
+ */
+static Precision parse_precision(const std::string& precision) {
+    if (precision == "float") {
+        return Precision::FLOAT;
+    }
+    if (precision != "double") {
+        throw std::runtime_error("Unknown precision: " + precision);
+    }
+    return Precision::DOUBLE;
+}
+
+/**
+ * @brief 未指定任何键时的IO字段（required缺省为true）
+ */
+static PipelineConfig::IOField default_field() {
+    PipelineConfig::IOField field;
+    field.type = DataType::UNKNOWN;
+    field.required = true;
+    return field;
+}
+
+/**
+ * @brief 设置IO字段的一个键，未知的键忽略
+ */
+static void set_field(PipelineConfig::IOField& field, const std::string& key, const json& value) {
+    if (key == "name") {
+        field.name = value.get<std::string>();
+    } else if (key == "type") {
+        std::string type_str = value.get<std::string>();
+        field.type = string_to_data_type(type_str);
+        if (field.type == DataType::UNKNOWN) {
+            std::cerr << "Unknown type: " << type_str << std::endl;
+        }
+    } else if (key == "required") {
+        field.required = value.get<bool>();
+    } else if (key == "broadcast") {
+        field.broadcast = value.get<bool>();
+    }
+}
+
+/**
+ * @brief 设置缓存策略的标量键（ttl_ms、capacity），未知的键忽略
+ */
+static void set_cache_field(PipelineConfig::CachePolicy& cache, const std::string& key, const json& value) {
+    if (key == "ttl_ms") {
+        cache.ttl_ms = value.get<uint64_t>();
+    } else if (key == "capacity") {
+        cache.capacity = value.get<size_t>();
+    } else if (key == "keys") {
+        throw std::runtime_error("cache keys must be an array");
+    }
+}
+
+/**
+ * @brief 解析缓存策略：{"keys": [...], "ttl_ms": ..., "capacity": ...}
+ */
+static PipelineConfig::CachePolicy parse_cache(const json& obj) {
+    if (!obj.is_object()) {
+        throw std::runtime_error("cache must be an object");
+    }
+    PipelineConfig::CachePolicy cache;
+    for (const auto& [key, value] : obj.items()) {
+        if (key != "keys") {
+            set_cache_field(cache, key, value);
+            continue;
+        }
+        if (!value.is_array()) {
+            throw std::runtime_error("cache keys must be an array");
+        }
+        for (const auto& name : value) {
+            cache.keys.push_back(name.get<std::string>());
+        }
+    }
+    return cache;
+}
+
 PipelineConfig JsonConfigParser::parse(const std::string& config_path) {
     std::ifstream file(config_path);
     if (!file.is_open()) {
@@ -63,6 +182,11 @@ PipelineConfig JsonConfigParser::parse_string(const std::string& json_str) {
         config.name = j["name"].get<std::string>();
     }
     
+    // 解析精度策略
+    if (j.contains("precision")) {
+        config.precision = parse_precision(j["precision"].get<std::string>());
+    }
+    
     // 解析IO定义
     if (j.contains("inputs")) {
         config.inputs = parse_io_fields(j["inputs"], "inputs");
@@ -79,6 +203,11 @@ PipelineConfig JsonConfigParser::parse_string(const std::string& json_str) {
         config.steps = parse_steps(j["steps"]);
     }
     
+    // 解析结果缓存策略
+    if (j.contains("cache")) {
+        config.cache = parse_cache(j["cache"]);
+    }
+    
     // 计算指纹
     config.compute_fingerprint();
     
@@ -118,6 +247,14 @@ bool JsonConfigParser::validate(const PipelineConfig& config) {
         defined_vars.insert(step.output_var);
     }
     
+    // 检查结果缓存策略
+    try {
+        validate_cache_policy(config);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return false;
+    }
+    
     return true;
 }
 
@@ -132,26 +269,12 @@ std::vector<PipelineConfig::IOField> JsonConfigParser::parse_io_fields(
     }
     
     for (const auto& item : arr) {
-        PipelineConfig::IOField field;
-        
-        if (item.contains("name")) {
-            field.name = item["name"].get<std::string>();
-        }
-        
-        if (item.contains("type")) {
-            std::string type_str = item["type"].get<std::string>();
-            field.type = string_to_data_type(type_str);
-            if (field.type == DataType::UNKNOWN) {
-                std::cerr << "Unknown type: " << type_str << std::endl;
+        PipelineConfig::IOField field = default_field();
+        if (item.is_object()) {
+            for (const auto& [key, value] : item.items()) {
+                set_field(field, key, value);
             }
         }
-        
-        if (item.contains("required")) {
-            field.required = item["required"].get<bool>();
-        } else {
-            field.required = true;
-        }
-        
         result.push_back(field);
     }
     
@@ -271,6 +394,269 @@ DataType JsonConfigParser::infer_arg_type(const nlohmann::json& arg, const Pipel
     return DataType::UNKNOWN;
 }
 
+// ============================================
+// 流式批量解析（SAX）
+// ============================================
+
+/**
+ * @brief 将SAX事件直接解析为PipelineConfig
+ * 标量事件包装为单个json值后复用parse_arg与字段设置逻辑，与DOM解析的语义一致
+ */
+class ConfigSaxHandler {
+public:
+    ConfigSaxHandler(JsonConfigParser& parser, const JsonConfigParser::ConfigCallback& on_config)
+        : parser_(parser), on_config_(on_config) {}
+    
+    const BulkParseResult& result() const { return result_; }
+    
+    // SAX接口
+    bool null() { return scalar(json()); }
+    bool boolean(bool value) { return scalar(json(value)); }
+    bool number_integer(json::number_integer_t value) { return scalar(json(value)); }
+    bool number_unsigned(json::number_unsigned_t value) { return scalar(json(value)); }
+    bool number_float(json::number_float_t value, const std::string&) { return scalar(json(value)); }
+    bool string(std::string& value) { return scalar(json(std::move(value))); }
+    template<typename Binary>
+    bool binary(Binary&) { return scalar(json()); }
+    
+    bool key(std::string& key) {
+        key_ = std::move(key);
+        return true;
+    }
+    
+    bool start_object(std::size_t) {
+        check_container();
+        switch (scope()) {
+            case Scope::LIST:
+                config_ = PipelineConfig();
+                return enter(Scope::CONFIG);
+            case Scope::FIELDS:
+                field_ = default_field();
+                return enter(Scope::FIELD);
+            case Scope::STEPS:
+                step_ = OpCall();
+                return enter(Scope::STEP);
+            case Scope::CONFIG:
+                if (key_ == "inputs" || key_ == "outputs" || key_ == "variables" || key_ == "steps") {
+                    throw std::runtime_error(key_ + " must be an array");
+                }
+                if (key_ == "cache") {
+                    config_.cache = PipelineConfig::CachePolicy();
+                    return enter(Scope::CACHE);
+                }
+                return enter(Scope::SKIP);
+            case Scope::CACHE_KEYS:
+                throw std::runtime_error("cache keys must be strings");
+            case Scope::STEP:
+                return enter(key_ == "options" ? Scope::OPTIONS : Scope::SKIP);
+            case Scope::ARGS:
+                throw std::runtime_error("Nested argument values are not supported in config streams");
+            case Scope::ROOT:
+                throw std::runtime_error("Config stream must be an array of pipeline configs");
+            default:
+                return enter(Scope::SKIP);
+        }
+    }
+    
+    bool end_object() {
+        Scope ended = leave();
+        if (ended == Scope::CONFIG) {
+            finish_config();
+        } else if (ended == Scope::FIELD) {
+            fields_->push_back(std::move(field_));
+        } else if (ended == Scope::STEP) {
+            config_.steps.push_back(std::move(step_));
+        }
+        return true;
+    }
+    
+    bool start_array(std::size_t) {
+        check_container();
+        switch (scope()) {
+            case Scope::ROOT:
+                return enter(Scope::LIST);
+            case Scope::CONFIG:
+                if (key_ == "inputs" || key_ == "outputs" || key_ == "variables") {
+                    fields_ = key_ == "inputs" ? &config_.inputs
+                            : key_ == "outputs" ? &config_.outputs : &config_.variables;
+                    fields_->clear();
+                    return enter(Scope::FIELDS);
+                }
+                if (key_ == "steps") {
+                    config_.steps.clear();
+                    return enter(Scope::STEPS);
+                }
+                if (key_ == "cache") {
+                    throw std::runtime_error("cache must be an object");
+                }
+                return enter(Scope::SKIP);
+            case Scope::CACHE:
+                if (key_ == "keys") {
+                    config_.cache.keys.clear();
+                    return enter(Scope::CACHE_KEYS);
+                }
+                return enter(Scope::SKIP);
+            case Scope::CACHE_KEYS:
+                throw std::runtime_error("cache keys must be strings");
+            case Scope::STEP:
+                if (key_ == "args") {
+                    step_.args.clear();
+                    return enter(Scope::ARGS);
+                }
+                return enter(Scope::SKIP);
+            case Scope::FIELDS:
+                // 与DOM解析一致：不是对象的条目为缺省字段/空步骤
+                fields_->push_back(default_field());
+                return enter(Scope::SKIP);
+            case Scope::STEPS:
+                config_.steps.emplace_back();
+                return enter(Scope::SKIP);
+            case Scope::ARGS:
+                throw std::runtime_error("Nested argument values are not supported in config streams");
+            case Scope::LIST:
+                throw std::runtime_error("Config stream entries must be objects");
+            default:
+                return enter(Scope::SKIP);
+        }
+    }
+    
+    bool end_array() {
+        leave();
+        return true;
+    }
+    
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) {
+        throw std::runtime_error("Config stream parse error at byte " + std::to_string(position) + ": " + e.what());
+    }
+    
+private:
+    enum class Scope { ROOT, LIST, CONFIG, FIELDS, FIELD, STEPS, STEP, ARGS, OPTIONS, CACHE, CACHE_KEYS, SKIP };
+    
+    JsonConfigParser& parser_;
+    const JsonConfigParser::ConfigCallback& on_config_;
+    BulkParseResult result_;
+    
+    std::vector<Scope> scopes_;
+    std::string key_;
+    PipelineConfig config_;
+    std::vector<PipelineConfig::IOField>* fields_ = nullptr;
+    PipelineConfig::IOField field_;
+    OpCall step_;
+    
+    Scope scope() const { return scopes_.empty() ? Scope::ROOT : scopes_.back(); }
+    
+    /**
+     * @brief 取值为字符串/布尔/数组的已知键不接受对象或（非预期的）数组
+     */
+    void check_container() const {
+        static const std::unordered_set<std::string> config_keys = {
+            "name", "precision", "inputs", "outputs", "variables", "steps"};
+        static const std::unordered_set<std::string> field_keys = {"name", "type", "required", "broadcast"};
+        static const std::unordered_set<std::string> step_keys = {"op", "output"};
+        Scope current = scope();
+        bool known = (current == Scope::CONFIG && config_keys.count(key_)) ||
+                     (current == Scope::FIELD && field_keys.count(key_)) ||
+                     (current == Scope::STEP && step_keys.count(key_)) ||
+                     current == Scope::OPTIONS;
+        // 列表键的数组在start_array中处理
+        bool list_key = current == Scope::CONFIG &&
+                        (key_ == "inputs" || key_ == "outputs" || key_ == "variables" || key_ == "steps");
+        if (known && !list_key) {
+            throw std::runtime_error("Invalid value for " + key_ + " in config stream");
+        }
+    }
+    
+    bool enter(Scope next) {
+        // 跳过的值内部的容器全部跳过
+        scopes_.push_back(scope() == Scope::SKIP ? Scope::SKIP : next);
+        return true;
+    }
+    
+    Scope leave() {
+        Scope ended = scopes_.back();
+        scopes_.pop_back();
+        return ended;
+    }
+    
+    bool scalar(json value) {
+        switch (scope()) {
+            case Scope::CONFIG:
+                if (key_ == "name") {
+                    config_.name = value.get<std::string>();
+                } else if (key_ == "precision") {
+                    config_.precision = parse_precision(value.get<std::string>());
+                } else if (key_ == "inputs" || key_ == "outputs" || key_ == "variables" || key_ == "steps") {
+                    throw std::runtime_error(key_ + " must be an array");
+                } else if (key_ == "cache") {
+                    throw std::runtime_error("cache must be an object");
+                }
+                break;
+            case Scope::CACHE:
+                set_cache_field(config_.cache, key_, value);
+                break;
+            case Scope::CACHE_KEYS:
+                config_.cache.keys.push_back(value.get<std::string>());
+                break;
+            case Scope::FIELD:
+                set_field(field_, key_, value);
+                break;
+            case Scope::STEP:
+                if (key_ == "op") {
+                    step_.op_name = value.get<std::string>();
+                } else if (key_ == "output") {
+                    step_.output_var = value.get<std::string>();
+                } else if (key_ == "args") {
+                    throw std::runtime_error("args must be an array");
+                }
+                break;
+            case Scope::ARGS:
+                step_.args.push_back(parser_.parse_arg(value));
+                break;
+            case Scope::OPTIONS:
+                step_.options[key_] = value.get<std::string>();
+                break;
+            case Scope::FIELDS:
+                fields_->push_back(default_field());
+                break;
+            case Scope::STEPS:
+                config_.steps.emplace_back();
+                break;
+            case Scope::LIST:
+                throw std::runtime_error("Config stream entries must be objects");
+            case Scope::ROOT:
+                throw std::runtime_error("Config stream must be an array of pipeline configs");
+            default:
+                break;
+        }
+        return true;
+    }
+    
+    void finish_config() {
+        config_.compute_fingerprint();
+        if (!parser_.validate(config_)) {
+            std::cerr << "Skipping invalid config in stream: " << config_.name << std::endl;
+            result_.rejected++;
+            return;
+        }
+        result_.accepted++;
+        on_config_(std::move(config_));
+    }
+};
+
+BulkParseResult JsonConfigParser::parse_bulk(std::istream& input, const ConfigCallback& on_config) {
+    ConfigSaxHandler handler(*this, on_config);
+    json::sax_parse(input, &handler);
+    return handler.result();
+}
+
+BulkParseResult JsonConfigParser::parse_bulk_file(const std::string& path, const ConfigCallback& on_config) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open config file: " + path);
+    }
+    return parse_bulk(file, on_config);
+}
+
 // ============================================
 // ConfigGenerator 实现
 // ============================================
@@ -287,6 +673,9 @@ std::string ConfigGenerator::generate_json(const PipelineConfig& config) {
         field["name"] = input.name;
         field["type"] = data_type_to_string(input.type);
         field["required"] = input.required;
+        if (input.broadcast) {
+            field["broadcast"] = true;
+        }
         j["inputs"].push_back(field);
     }
     
@@ -326,6 +715,13 @@ std::string ConfigGenerator::generate_json(const PipelineConfig& config) {
         j["steps"].push_back(step_obj);
     }
     
+    // 生成结果缓存策略
+    if (config.cache.enabled()) {
+        j["cache"]["keys"] = config.cache.keys;
+        j["cache"]["ttl_ms"] = config.cache.ttl_ms;
+        j["cache"]["capacity"] = config.cache.capacity;
+    }
+    
     return j.dump(2);
 }
 
@@ -339,6 +735,309 @@ bool ConfigGenerator::save_to_file(const PipelineConfig& config, const std::stri
     return true;
 }
 
+// ============================================
+// 二进制配置格式
+// ============================================
+
+namespace {
+
+constexpr char kBinaryConfigMagic[4] = {'T', 'G', 'P', 'C'};
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr size_t kBinaryHeaderSize = 32;
+
+// 各类记录的最小编码长度（字符串至少含4字节长度前缀）
+constexpr size_t kStringRecordSize = sizeof(uint32_t);
+constexpr size_t kFieldRecordSize = kStringRecordSize + 2;
+constexpr size_t kArgRecordSize = 2 + kStringRecordSize;
+constexpr size_t kOptionRecordSize = 2 * kStringRecordSize;
+constexpr size_t kStepRecordSize = 2 * kStringRecordSize + 2 * sizeof(uint32_t);
+
+/**
+ * @brief 二进制配置写入
+ */
+class BinaryWriter {
+public:
+    void u8(uint8_t value) { out_.push_back(static_cast<char>(value)); }
+    void u32(uint32_t value) { out_.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void u64(uint64_t value) { out_.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    
+    void str(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        out_.append(value);
+    }
+    
+    void patch_u64(size_t offset, uint64_t value) {
+        std::memcpy(&out_[offset], &value, sizeof(value));
+    }
+    
+    size_t size() const { return out_.size(); }
+    std::string& data() { return out_; }
+    
+private:
+    std::string out_;
+};
+
+/**
+ * @brief 带越界检查的二进制配置读取
+ */
+class BinaryReader {
+public:
+    BinaryReader(const unsigned char* data, size_t length, size_t offset)
+        : data_(data), length_(length), pos_(offset) {}
+    
+    uint8_t u8() { return read<uint8_t>(); }
+    uint32_t u32() { return read<uint32_t>(); }
+    uint64_t u64() { return read<uint64_t>(); }
+    
+    std::string_view str() {
+        uint32_t size = u32();
+        require(size);
+        std::string_view value(reinterpret_cast<const char*>(data_ + pos_), size);
+        pos_ += size;
+        return value;
+    }
+    
+    /**
+     * @brief 读取元素个数，按每个元素的最小编码长度检查剩余字节，避免按损坏的计数分配内存
+     */
+    uint32_t count(size_t min_record_size) {
+        uint32_t value = u32();
+        require(static_cast<size_t>(value) * min_record_size);
+        return value;
+    }
+    
+    /**
+     * @brief 读取单字节枚举值，超出[0, last]时报错
+     */
+    template<typename E>
+    E enumeration(E last) {
+        uint8_t value = u8();
+        if (value > static_cast<uint8_t>(last)) {
+            throw std::runtime_error("Invalid enum value in binary config file: " + std::to_string(value));
+        }
+        return static_cast<E>(value);
+    }
+    
+private:
+    const unsigned char* data_;
+    size_t length_;
+    size_t pos_;
+    
+    void require(size_t size) const {
+        if (pos_ > length_ || size > length_ - pos_) {
+            throw std::runtime_error("Truncated binary config file");
+        }
+    }
+    
+    template<typename T>
+    T read() {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+};
+
+void write_fields(BinaryWriter& writer, const std::vector<PipelineConfig::IOField>& fields) {
+    writer.u32(static_cast<uint32_t>(fields.size()));
+    for (const auto& field : fields) {
+        writer.str(field.name);
+        writer.u8(static_cast<uint8_t>(field.type));
+        writer.u8(static_cast<uint8_t>((field.required ? 1 : 0) | (field.broadcast ? 2 : 0)));
+    }
+}
+
+void read_fields(BinaryReader& reader, std::vector<PipelineConfig::IOField>& fields) {
+    fields.resize(reader.count(kFieldRecordSize));
+    for (auto& field : fields) {
+        field.name = reader.str();
+        field.type = reader.enumeration(DataType::UNKNOWN);
+        uint8_t flags = reader.u8();
+        field.required = (flags & 1) != 0;
+        field.broadcast = (flags & 2) != 0;
+    }
+}
+
+} // namespace
+
+std::string ConfigGenerator::generate_binary(const std::vector<PipelineConfig>& configs) {
+    BinaryWriter writer;
+    writer.data().append(kBinaryConfigMagic, sizeof(kBinaryConfigMagic));
+    writer.u32(kBinaryConfigVersion);
+    writer.u32(kConfigHashVersion);
+    writer.u32(kByteOrderMark);
+    writer.u64(configs.size());
+    writer.u64(0);  // 文件长度，写完后回填
+    
+    size_t table = writer.size();
+    for (size_t i = 0; i < configs.size(); i++) {
+        writer.u64(0);
+    }
+    
+    for (size_t i = 0; i < configs.size(); i++) {
+        const PipelineConfig& config = configs[i];
+        writer.patch_u64(table + i * sizeof(uint64_t), writer.size());
+        
+        writer.str(config.name);
+        writer.str(config.fingerprint.empty() ? compute_config_fingerprint(config) : config.fingerprint);
+        writer.u8(static_cast<uint8_t>(config.precision));
+        writer.u32(static_cast<uint32_t>(config.cache.keys.size()));
+        for (const auto& key : config.cache.keys) {
+            writer.str(key);
+        }
+        writer.u64(config.cache.ttl_ms);
+        writer.u64(config.cache.capacity);
+        write_fields(writer, config.inputs);
+        write_fields(writer, config.variables);
+        write_fields(writer, config.outputs);
+        
+        writer.u32(static_cast<uint32_t>(config.steps.size()));
+        for (const auto& step : config.steps) {
+            writer.str(step.op_name);
+            writer.str(step.output_var);
+            writer.u32(static_cast<uint32_t>(step.args.size()));
+            for (const auto& arg : step.args) {
+                writer.u8(static_cast<uint8_t>(arg.type));
+                writer.u8(static_cast<uint8_t>(arg.data_type));
+                writer.str(arg.value);
+            }
+            // 选项按键排序，同一配置的输出稳定
+            std::vector<std::pair<std::string, std::string>> options(step.options.begin(), step.options.end());
+            std::sort(options.begin(), options.end());
+            writer.u32(static_cast<uint32_t>(options.size()));
+            for (const auto& [key, value] : options) {
+                writer.str(key);
+                writer.str(value);
+            }
+        }
+    }
+    
+    writer.patch_u64(kBinaryHeaderSize - sizeof(uint64_t), writer.size());
+    return std::move(writer.data());
+}
+
+bool ConfigGenerator::save_binary(const std::vector<PipelineConfig>& configs, const std::string& path) {
+    std::string data = generate_binary(configs);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+// ============================================
+// MappedConfigFile 实现
+// ============================================
+
+MappedConfigFile::MappedConfigFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open config file: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kBinaryHeaderSize)) {
+        ::close(fd);
+        throw std::runtime_error("Not a binary config file: " + path);
+    }
+    void* mapped = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to map config file: " + path);
+    }
+    data_ = static_cast<const unsigned char*>(mapped);
+    length_ = static_cast<size_t>(st.st_size);
+    
+    try {
+        BinaryReader header(data_, length_, sizeof(kBinaryConfigMagic));
+        uint32_t version = header.u32();
+        uint32_t hash_version = header.u32();
+        uint32_t byte_order = header.u32();
+        uint64_t count = header.u64();
+        uint64_t length = header.u64();
+        if (std::memcmp(data_, kBinaryConfigMagic, sizeof(kBinaryConfigMagic)) != 0 ||
+            byte_order != kByteOrderMark) {
+            throw std::runtime_error("Not a binary config file: " + path);
+        }
+        if (version != kBinaryConfigVersion) {
+            throw std::runtime_error("Unsupported binary config version " + std::to_string(version) + ": " + path);
+        }
+        if (length != length_ || count > (length_ - kBinaryHeaderSize) / sizeof(uint64_t)) {
+            throw std::runtime_error("Truncated binary config file: " + path);
+        }
+        count_ = static_cast<size_t>(count);
+        fingerprints_valid_ = hash_version == kConfigHashVersion;
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(data_), length_);
+        throw;
+    }
+}
+
+MappedConfigFile::~MappedConfigFile() {
+    ::munmap(const_cast<unsigned char*>(data_), length_);
+}
+
+size_t MappedConfigFile::record_offset(size_t index) const {
+    if (index >= count_) {
+        throw std::runtime_error("Binary config index out of range: " + std::to_string(index));
+    }
+    uint64_t offset;
+    std::memcpy(&offset, data_ + kBinaryHeaderSize + index * sizeof(uint64_t), sizeof(offset));
+    return static_cast<size_t>(offset);
+}
+
+std::string_view MappedConfigFile::name(size_t index) const {
+    BinaryReader reader(data_, length_, record_offset(index));
+    return reader.str();
+}
+
+std::string_view MappedConfigFile::fingerprint(size_t index) const {
+    BinaryReader reader(data_, length_, record_offset(index));
+    reader.str();
+    std::string_view fingerprint = reader.str();
+    return fingerprints_valid_ ? fingerprint : std::string_view();
+}
+
+PipelineConfig MappedConfigFile::config(size_t index) const {
+    BinaryReader reader(data_, length_, record_offset(index));
+    PipelineConfig config;
+    config.name = reader.str();
+    config.fingerprint = reader.str();
+    config.precision = reader.enumeration(Precision::FLOAT);
+    config.cache.keys.resize(reader.count(kStringRecordSize));
+    for (auto& key : config.cache.keys) {
+        key = reader.str();
+    }
+    config.cache.ttl_ms = reader.u64();
+    config.cache.capacity = static_cast<size_t>(reader.u64());
+    read_fields(reader, config.inputs);
+    read_fields(reader, config.variables);
+    read_fields(reader, config.outputs);
+    
+    config.steps.resize(reader.count(kStepRecordSize));
+    for (auto& step : config.steps) {
+        step.op_name = reader.str();
+        step.output_var = reader.str();
+        step.args.resize(reader.count(kArgRecordSize));
+        for (auto& arg : step.args) {
+            arg.type = reader.enumeration(ArgType::EXPRESSION);
+            arg.data_type = reader.enumeration(DataType::UNKNOWN);
+            arg.value = reader.str();
+        }
+        uint32_t options = reader.count(kOptionRecordSize);
+        for (uint32_t i = 0; i < options; i++) {
+            std::string key(reader.str());
+            step.options[key] = reader.str();
+        }
+    }
+    
+    if (!fingerprints_valid_) {
+        config.compute_fingerprint();
+    }
+    return config;
+}
+
 // ============================================
 // OpRegistry 实现
 // ============================================
@@ -372,4 +1071,36 @@ std::vector<std::string> OpRegistry::list_ops() const {
     return result;
 }
 
+// ============================================
+// 缓存策略校验
+// ============================================
+
+void validate_cache_policy(const PipelineConfig& config) {
+    const auto& policy = config.cache;
+    if (!policy.enabled()) {
+        return;
+    }
+    if (policy.capacity == 0) {
+        throw std::runtime_error("Cache capacity must be positive: " + config.name);
+    }
+
+    std::unordered_set<std::string> keys;
+    for (const auto& key : policy.keys) {
+        bool found = std::any_of(config.inputs.begin(), config.inputs.end(),
+                                 [&](const PipelineConfig::IOField& input) { return input.name == key; });
+        if (!found) {
+            throw std::runtime_error("Cache key is not an input of " + config.name + ": " + key);
+        }
+        if (!keys.insert(key).second) {
+            throw std::runtime_error("Duplicate cache key in " + config.name + ": " + key);
+        }
+    }
+    for (const auto& output : config.outputs) {
+        if (output.type != DataType::INT32 && output.type != DataType::INT64 &&
+            output.type != DataType::DOUBLE && output.type != DataType::FLOAT) {
+            throw std::runtime_error("Cached pipeline " + config.name + " has non-scalar output: " + output.name);
+        }
+    }
+}
+
 } // namespace turbograph
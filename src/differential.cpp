@@ -0,0 +1,896 @@
+#include "differential.hpp"
+#include "batch_scheduler.hpp"
+#include "pipeline.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <variant>
+
+namespace turbograph {
+
+const char* differential_mode_name(DifferentialMode mode) {
+    switch (mode) {
+        case DifferentialMode::INTERPRETER: return "interpreter";
+        case DifferentialMode::BYTECODE: return "bytecode";
+        case DifferentialMode::JIT_ROW: return "jit_row";
+        case DifferentialMode::JIT_BATCH: return "jit_batch";
+        case DifferentialMode::SCHEDULER: return "scheduler";
+        default: return "unknown";
+    }
+}
+
+namespace {
+
+// ============================================
+// 列存数据
+// ============================================
+
+/**
+ * @brief 一列输入或输出，元素类型顺序与ValueVariant一致
+ */
+using ColumnVector = std::variant<
+    std::vector<int32_t>,
+    std::vector<int64_t>,
+    std::vector<double>,
+    std::vector<float>,
+    std::vector<std::string>,
+    std::vector<std::vector<int32_t>>,
+    std::vector<std::vector<int64_t>>,
+    std::vector<std::vector<double>>,
+    std::vector<std::vector<std::string>>
+>;
+
+ColumnVector make_column(DataType type, size_t n) {
+    switch (type) {
+        case DataType::INT32: return std::vector<int32_t>(n);
+        case DataType::INT64: return std::vector<int64_t>(n);
+        case DataType::FLOAT: return std::vector<float>(n);
+        case DataType::STRING: return std::vector<std::string>(n);
+        case DataType::INT32_LIST: return std::vector<std::vector<int32_t>>(n);
+        case DataType::INT64_LIST: return std::vector<std::vector<int64_t>>(n);
+        case DataType::DOUBLE_LIST: return std::vector<std::vector<double>>(n);
+        case DataType::STRING_LIST: return std::vector<std::vector<std::string>>(n);
+        default: return std::vector<double>(n);
+    }
+}
+
+void* column_data(ColumnVector& column) {
+    return std::visit([](auto& v) -> void* { return v.data(); }, column);
+}
+
+ValueVariant column_value(const ColumnVector& column, size_t row) {
+    return std::visit([row](const auto& v) -> ValueVariant { return v[row]; }, column);
+}
+
+/**
+ * @brief 按数值转换取值（与执行器的转换规则一致），类型不兼容时为缺省值
+ */
+template<typename T>
+T value_as(const ValueVariant& value) {
+    return std::visit([](const auto& v) -> T {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<V>) {
+            return static_cast<T>(v);
+        } else if constexpr (std::is_same_v<T, V>) {
+            return v;
+        } else {
+            return T{};
+        }
+    }, value);
+}
+
+/**
+ * @brief 将结果规范化为输出字段的类型，缺失的值取缺省值
+ */
+ValueVariant normalize(DataType type, const ValueVariant* value) {
+    static const ValueVariant kMissing = 0.0;
+    const ValueVariant& v = value ? *value : kMissing;
+    switch (type) {
+        case DataType::INT32: return value_as<int32_t>(v);
+        case DataType::INT64: return value_as<int64_t>(v);
+        case DataType::FLOAT: return value_as<float>(v);
+        case DataType::STRING: return value_as<std::string>(v);
+        default: return value_as<double>(v);
+    }
+}
+
+bool values_match(const ValueVariant& expected, const ValueVariant& actual, double tolerance) {
+    if (expected.index() != actual.index()) {
+        return false;
+    }
+    if (std::holds_alternative<double>(expected) || std::holds_alternative<float>(expected)) {
+        double x = value_as<double>(expected);
+        double y = value_as<double>(actual);
+        if (std::isnan(x) || std::isnan(y)) {
+            return std::isnan(x) && std::isnan(y);
+        }
+        if (x == y) {
+            return true;
+        }
+        if (std::isinf(x) || std::isinf(y)) {
+            return false;
+        }
+        return std::abs(x - y) <= tolerance * std::max({1.0, std::abs(x), std::abs(y)});
+    }
+    return expected == actual;
+}
+
+std::string format_value(const ValueVariant& value) {
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+    std::visit([&oss](const auto& v) {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<V>) {
+            oss << v;
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            oss << '"' << v << '"';
+        } else {
+            oss << "[" << v.size() << " items]";
+        }
+    }, value);
+    return oss.str();
+}
+
+// ============================================
+// 随机输入
+// ============================================
+
+/**
+ * @brief 字符串取值（含空串与多字节字符）
+ */
+const char* const kWords[] = {"", "a", "bc", "item_7", "x|y", "特征"};
+constexpr size_t kNumWords = sizeof(kWords) / sizeof(kWords[0]);
+
+/**
+ * @brief 按类型生成随机值
+ * 整数列表与部分整数标量取小范围，使列表交叉有命中；int64取到2^40，经double的转换仍精确
+ */
+ValueVariant random_value(DataType type, std::mt19937_64& rng, size_t max_list_size) {
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::uniform_int_distribution<int32_t> small(-20, 20);
+    std::uniform_int_distribution<int32_t> medium(-1000, 1000);
+    std::uniform_int_distribution<int64_t> wide(-(int64_t(1) << 40), int64_t(1) << 40);
+    std::uniform_int_distribution<size_t> word(0, kNumWords - 1);
+    std::uniform_int_distribution<size_t> length(0, max_list_size);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    auto list = [&](auto make) {
+        using E = decltype(make());
+        std::vector<E> values(length(rng));
+        for (auto& v : values) {
+            v = make();
+        }
+        return values;
+    };
+
+    switch (type) {
+        case DataType::INT32:
+            return percent(rng) < 40 ? small(rng) : medium(rng);
+        case DataType::INT64:
+            return percent(rng) < 40 ? int64_t(small(rng)) : wide(rng);
+        case DataType::FLOAT:
+            return static_cast<float>(real(rng) / 10.0);
+        case DataType::STRING:
+            return std::string(kWords[word(rng)]);
+        case DataType::INT32_LIST:
+            return list([&] { return small(rng); });
+        case DataType::INT64_LIST:
+            return list([&] { return percent(rng) < 80 ? int64_t(small(rng)) : wide(rng); });
+        case DataType::DOUBLE_LIST:
+            return list([&] { return real(rng); });
+        case DataType::STRING_LIST:
+            return list([&] { return std::string(kWords[word(rng)]); });
+        default:
+            return percent(rng) < 10 ? 0.0 : real(rng);
+    }
+}
+
+// ============================================
+// 随机配置
+// ============================================
+
+/**
+ * @brief 生成配置使用的输入字段
+ */
+const PipelineConfig::IOField kInputs[] = {
+    {"d_a", DataType::DOUBLE, true},
+    {"d_b", DataType::DOUBLE, true},
+    {"f_a", DataType::FLOAT, true},
+    {"i_a", DataType::INT32, true},
+    {"i_b", DataType::INT32, true},
+    {"l_a", DataType::INT64, true},
+    {"s_a", DataType::STRING, true},
+    {"il", DataType::INT32_LIST, true},
+    {"ll", DataType::INT64_LIST, true},
+    {"dl", DataType::DOUBLE_LIST, true},
+    {"sl", DataType::STRING_LIST, true},
+    {"bl", DataType::INT64_LIST, true, true}
+};
+
+constexpr double kUnbounded = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief 作用域中的变量及其取值的绝对值上界（决定能否安全地转换为整数）
+ */
+struct ScopeVar {
+    std::string name;
+    DataType type;
+    double bound;
+};
+
+bool is_numeric(DataType type) {
+    return type == DataType::INT32 || type == DataType::INT64 ||
+           type == DataType::DOUBLE || type == DataType::FLOAT;
+}
+
+bool is_list(DataType type) {
+    return type == DataType::INT32_LIST || type == DataType::INT64_LIST ||
+           type == DataType::DOUBLE_LIST || type == DataType::STRING_LIST;
+}
+
+double type_bound(DataType type) {
+    switch (type) {
+        case DataType::INT32: return 1000.0;
+        case DataType::INT64: return static_cast<double>(int64_t(1) << 40);
+        case DataType::FLOAT: return 100.0;
+        case DataType::DOUBLE: return 1000.0;
+        default: return 0.0;
+    }
+}
+
+class RandomConfigGenerator {
+public:
+    RandomConfigGenerator(const DifferentialOptions& options)
+        : options_(options), rng_(options.seed) {
+        // 只生成有参数规则的算子，注册表中新增的算子在报告中显示为未覆盖
+        for (const auto& name : OperatorRegistry::instance().get_all_operator_names()) {
+            if (knows(name)) {
+                operators_.push_back(name);
+            }
+        }
+        std::sort(operators_.begin(), operators_.end());
+    }
+
+    PipelineConfig next(size_t index) {
+        PipelineConfig config;
+        config.name = "differential_" + std::to_string(options_.seed) + "_" + std::to_string(index);
+        config.inputs.assign(std::begin(kInputs), std::end(kInputs));
+        scope_.clear();
+        for (const auto& input : config.inputs) {
+            scope_.push_back({input.name, input.type, type_bound(input.type)});
+        }
+
+        size_t steps = std::uniform_int_distribution<size_t>(1, std::max<size_t>(1, options_.max_steps))(rng_);
+        for (size_t s = 0; s < steps && !operators_.empty(); s++) {
+            OpCall step;
+            double bound = 0.0;
+            // 当前算子无可用参数时顺延到下一个
+            for (size_t attempt = 0; attempt < operators_.size(); attempt++) {
+                step = OpCall(next_operator());
+                step.args.clear();
+                if (make_args(step, bound)) {
+                    break;
+                }
+                step.op_name.clear();
+            }
+            if (step.op_name.empty()) {
+                break;
+            }
+            step.output_var = "v";
+            step.output_var += std::to_string(s);
+            DataType type = compute_step_type(config, step);
+            config.steps.push_back(step);
+            config.outputs.push_back({step.output_var, type, true});
+            scope_.push_back({step.output_var, type, bound});
+        }
+        config.compute_fingerprint();
+        return config;
+    }
+
+private:
+    const DifferentialOptions& options_;
+    std::mt19937_64 rng_;
+    std::vector<std::string> operators_;
+    std::vector<std::string> order_;
+    size_t cursor_ = 0;
+    std::vector<ScopeVar> scope_;
+
+    static bool knows(const std::string& op) {
+        static const char* const kKnown[] = {
+            "abs", "square", "sqrt", "get_sign", "direct_output_double", "direct_output_int64",
+            "direct_output_int32", "floor", "ceil", "direct_output_string", "add", "sub", "mul",
+            "div", "max", "min", "percent", "price_diff", "if_else", "avg_avg_log", "len",
+            "list_to_string", "catein_list_cross", "catein_list_cross_count", "catein_set_cross",
+            "catein_set_cross_count", "moving_average", "vector_sum", "vector_avg"
+        };
+        return std::find_if(std::begin(kKnown), std::end(kKnown),
+                            [&op](const char* known) { return op == known; }) != std::end(kKnown);
+    }
+
+    /**
+     * @brief 按打乱的顺序轮流取算子，每轮覆盖全部算子
+     */
+    const std::string& next_operator() {
+        if (cursor_ == order_.size()) {
+            order_ = operators_;
+            std::shuffle(order_.begin(), order_.end(), rng_);
+            cursor_ = 0;
+        }
+        return order_[cursor_++];
+    }
+
+    bool chance(int percent) {
+        return std::uniform_int_distribution<int>(0, 99)(rng_) < percent;
+    }
+
+    /**
+     * @brief 随机选取满足条件的变量，没有时返回nullptr
+     */
+    template<typename Pred>
+    const ScopeVar* pick(Pred pred) {
+        std::vector<const ScopeVar*> candidates;
+        for (const auto& var : scope_) {
+            if (pred(var)) {
+                candidates.push_back(&var);
+            }
+        }
+        if (candidates.empty()) {
+            return nullptr;
+        }
+        return candidates[std::uniform_int_distribution<size_t>(0, candidates.size() - 1)(rng_)];
+    }
+
+    static Arg var_arg(const ScopeVar& var) {
+        return Arg::variable(var.name, var.type);
+    }
+
+    /**
+     * @brief 数值参数：变量或字面量，返回参数及上界
+     * @param max_bound 变量取值上界需小于该值
+     */
+    bool numeric_arg(std::vector<Arg>& args, double& bound, double max_bound = kUnbounded) {
+        const ScopeVar* var = pick([&](const ScopeVar& v) { return is_numeric(v.type) && v.bound < max_bound; });
+        if (!var || chance(15)) {
+            int32_t value = std::uniform_int_distribution<int32_t>(-9, 9)(rng_);
+            args.push_back(chance(50) ? Arg::literal(std::to_string(value), DataType::INT32)
+                                      : Arg::literal(std::to_string(value) + ".5", DataType::DOUBLE));
+            bound = std::abs(value) + 1.0;
+            return true;
+        }
+        args.push_back(var_arg(*var));
+        bound = var->bound;
+        return true;
+    }
+
+    /**
+     * @brief 类型相同的两个数值参数（按参数推导模板类型的算子）
+     */
+    bool same_type_args(std::vector<Arg>& args, double& a, double& b) {
+        const ScopeVar* first = pick([](const ScopeVar& v) { return is_numeric(v.type); });
+        if (!first) {
+            return false;
+        }
+        args.push_back(var_arg(*first));
+        a = first->bound;
+        // INT32与DOUBLE可用同类型的字面量
+        if (chance(20) && (first->type == DataType::INT32 || first->type == DataType::DOUBLE)) {
+            std::string literal = std::to_string(std::uniform_int_distribution<int32_t>(-9, 9)(rng_));
+            if (first->type == DataType::DOUBLE) literal += ".5";
+            args.push_back(Arg::literal(literal, first->type));
+            b = 10.0;
+            return true;
+        }
+        DataType type = first->type;
+        const ScopeVar* second = pick([type](const ScopeVar& v) { return v.type == type; });
+        args.push_back(var_arg(*second));
+        b = second->bound;
+        return true;
+    }
+
+    bool make_args(OpCall& step, double& bound) {
+        const std::string& op = step.op_name;
+        auto& args = step.args;
+        double a = 0.0, b = 0.0;
+
+        if (op == "abs" || op == "direct_output_double") {
+            return numeric_arg(args, bound);
+        }
+        if (op == "square") {
+            numeric_arg(args, a);
+            bound = a * a;
+            return true;
+        }
+        if (op == "sqrt") {
+            numeric_arg(args, a);
+            bound = std::sqrt(a);
+            return true;
+        }
+        if (op == "get_sign") {
+            numeric_arg(args, a);
+            bound = 1.0;
+            return true;
+        }
+        if (op == "direct_output_int64") {
+            return numeric_arg(args, bound, 9e18);
+        }
+        if (op == "direct_output_int32") {
+            // int64转int32按补码截断（各执行方式一致），浮点需在int32范围内
+            const ScopeVar* var = pick([](const ScopeVar& v) {
+                return v.type == DataType::INT32 || v.type == DataType::INT64 || (is_numeric(v.type) && v.bound < 2e9);
+            });
+            if (!var) return numeric_arg(args, bound, 2e9);
+            args.push_back(var_arg(*var));
+            bound = std::min(var->bound, 2147483648.0);
+            return true;
+        }
+        if (op == "floor" || op == "ceil") {
+            numeric_arg(args, a, 2e9);
+            bound = a + 1.0;
+            return true;
+        }
+        if (op == "direct_output_string") {
+            const ScopeVar* var = pick([](const ScopeVar& v) { return is_numeric(v.type) || v.type == DataType::STRING; });
+            args.push_back(var_arg(*var));
+            return true;
+        }
+        if (op == "add" || op == "sub" || op == "mul" || op == "div" || op == "max" || op == "min") {
+            numeric_arg(args, a);
+            numeric_arg(args, b);
+            if (op == "mul") bound = a * b;
+            else if (op == "div") bound = kUnbounded;
+            else if (op == "max" || op == "min") bound = std::max(a, b);
+            else bound = a + b;
+            return true;
+        }
+        if (op == "percent" || op == "price_diff") {
+            if (!same_type_args(args, a, b)) return false;
+            bound = op == "percent" ? kUnbounded : a + b;
+            return true;
+        }
+        if (op == "if_else") {
+            double cond = 0.0;
+            numeric_arg(args, cond);
+            if (!same_type_args(args, a, b)) return false;
+            bound = std::max(a, b);
+            return true;
+        }
+        if (op == "avg_avg_log") {
+            numeric_arg(args, a, 1e15);
+            if (chance(50)) {
+                // 分段参数：threshold2不小于inter2，保证对数段的商至少为1
+                auto uniform = [this](int32_t lo, int32_t hi) {
+                    return std::uniform_int_distribution<int32_t>(lo, hi)(rng_);
+                };
+                int32_t inter1 = uniform(1, 2000);
+                int32_t threshold1 = uniform(inter1, 30000);
+                int32_t inter2 = uniform(1, 10000);
+                int32_t threshold2 = uniform(std::max(threshold1 + 1, inter2), 500000);
+                for (int32_t value : {inter1, threshold1, inter2, threshold2}) {
+                    args.push_back(Arg::literal(std::to_string(value), DataType::INT32));
+                }
+            }
+            bound = 1e4;
+            return true;
+        }
+        if (op == "len") {
+            const ScopeVar* var = pick([](const ScopeVar& v) { return is_list(v.type) || v.type == DataType::STRING; });
+            args.push_back(var_arg(*var));
+            bound = 1e4;
+            return true;
+        }
+        if (op == "list_to_string") {
+            const ScopeVar* var = pick([](const ScopeVar& v) { return is_list(v.type); });
+            args.push_back(var_arg(*var));
+            if (chance(60)) {
+                static const char* const kDelimiters[] = {"\"|\"", "\", \"", "\";\"", "\"\""};
+                args.push_back(Arg::literal(kDelimiters[std::uniform_int_distribution<size_t>(0, 3)(rng_)],
+                                            DataType::STRING));
+            }
+            return true;
+        }
+        if (op.rfind("catein_", 0) == 0) {
+            const ScopeVar* list = pick([](const ScopeVar& v) { return is_list(v.type); });
+            args.push_back(var_arg(*list));
+            // 查找值与列表元素类型匹配：整数列表取整数查找值，字符串列表取字符串
+            DataType element = list->type;
+            const ScopeVar* item = pick([element](const ScopeVar& v) {
+                switch (element) {
+                    case DataType::INT32_LIST: return v.type == DataType::INT32;
+                    case DataType::INT64_LIST: return v.type == DataType::INT32 || v.type == DataType::INT64;
+                    case DataType::DOUBLE_LIST: return is_numeric(v.type);
+                    default: return v.type == DataType::STRING;
+                }
+            });
+            if (!item || chance(20)) {
+                if (element == DataType::STRING_LIST) {
+                    std::string literal = "\"";
+                    literal += kWords[std::uniform_int_distribution<size_t>(1, 3)(rng_)];
+                    literal += '"';
+                    args.push_back(Arg::literal(literal, DataType::STRING));
+                } else {
+                    args.push_back(Arg::literal(std::to_string(std::uniform_int_distribution<int32_t>(-20, 20)(rng_)),
+                                                DataType::INT32));
+                }
+            } else {
+                args.push_back(var_arg(*item));
+            }
+            bound = 1e4;
+            return true;
+        }
+        if (op == "moving_average") {
+            const ScopeVar* list = pick([](const ScopeVar& v) { return v.type == DataType::DOUBLE_LIST; });
+            if (!list) return false;
+            args.push_back(var_arg(*list));
+            const ScopeVar* window = pick([](const ScopeVar& v) { return v.type == DataType::INT32 && v.bound < 2e9; });
+            if (window && chance(50)) {
+                args.push_back(var_arg(*window));
+            } else {
+                int32_t size = static_cast<int32_t>(options_.max_list_size);
+                args.push_back(Arg::literal(std::to_string(std::uniform_int_distribution<int32_t>(0, size + 2)(rng_)),
+                                            DataType::INT32));
+            }
+            bound = 1e3;
+            return true;
+        }
+        if (op == "vector_sum" || op == "vector_avg") {
+            const ScopeVar* list = pick([](const ScopeVar& v) { return v.type == DataType::DOUBLE_LIST; });
+            if (!list) return false;
+            args.push_back(var_arg(*list));
+            bound = 1e3 * static_cast<double>(std::max<size_t>(1, options_.max_list_size));
+            return true;
+        }
+        return false;
+    }
+};
+
+// ============================================
+// 执行与比较
+// ============================================
+
+/**
+ * @brief 一个配置的随机输入列（broadcast输入只有一行）
+ */
+struct InputData {
+    std::vector<ColumnVector> columns;
+    std::vector<const void*> pointers;
+
+    ColumnBatch batch() const { return {pointers.data(), pointers.size()}; }
+};
+
+InputData make_inputs(const PipelineConfig& config, size_t rows, size_t max_list_size, std::mt19937_64& rng) {
+    InputData data;
+    for (const auto& input : config.inputs) {
+        size_t n = input.broadcast ? 1 : rows;
+        ColumnVector column = make_column(input.type, n);
+        std::visit([&](auto& values) {
+            using E = typename std::decay_t<decltype(values)>::value_type;
+            for (auto& value : values) {
+                ValueVariant v = random_value(input.type, rng, max_list_size);
+                if (auto* typed = std::get_if<E>(&v)) {
+                    value = std::move(*typed);
+                }
+            }
+        }, column);
+        data.columns.push_back(std::move(column));
+    }
+    for (auto& column : data.columns) {
+        data.pointers.push_back(column_data(column));
+    }
+    return data;
+}
+
+/**
+ * @brief 一种执行方式的结果：results[输出][行]
+ */
+using Results = std::vector<std::vector<ValueVariant>>;
+
+/**
+ * @brief 逐行执行：每行重置上下文并写入输入，只计执行耗时
+ */
+bool run_rows(IPipelineExecutor& executor, const PipelineConfig& config, const InputData& inputs,
+              size_t rows, size_t iterations, std::vector<uint64_t>& samples, Results& results) {
+    ExecutionContext ctx = executor.create_context();
+    results.assign(config.outputs.size(), std::vector<ValueVariant>(rows));
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t row = 0; row < rows; row++) {
+            ctx.reset();
+            for (size_t i = 0; i < config.inputs.size(); i++) {
+                const auto& input = config.inputs[i];
+                ctx.set_variable(input.name, input.type, column_value(inputs.columns[i], input.broadcast ? 0 : row));
+            }
+            uint64_t start = stats_now_ns();
+            bool ok = executor.execute(ctx);
+            samples.push_back(stats_now_ns() - start);
+            if (!ok) {
+                return false;
+            }
+            if (it == 0) {
+                for (size_t j = 0; j < config.outputs.size(); j++) {
+                    results[j][row] = normalize(config.outputs[j].type, ctx.find(config.outputs[j].name));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 批量执行：每次调用处理全部行
+ */
+template<typename Run>
+bool run_batches(const PipelineConfig& config, size_t rows, size_t iterations,
+                 std::vector<uint64_t>& samples, Results& results, Run run) {
+    std::vector<ColumnVector> columns;
+    std::vector<void*> pointers;
+    for (const auto& output : config.outputs) {
+        columns.push_back(make_column(output.type, rows));
+    }
+    for (auto& column : columns) {
+        pointers.push_back(column_data(column));
+    }
+    OutputBatch output{pointers.data(), pointers.size()};
+    for (size_t it = 0; it < iterations; it++) {
+        uint64_t start = stats_now_ns();
+        bool ok = run(output);
+        samples.push_back(stats_now_ns() - start);
+        if (!ok) {
+            return false;
+        }
+    }
+    results.assign(config.outputs.size(), std::vector<ValueVariant>(rows));
+    for (size_t j = 0; j < config.outputs.size(); j++) {
+        for (size_t row = 0; row < rows; row++) {
+            ValueVariant value = column_value(columns[j], row);
+            results[j][row] = normalize(config.outputs[j].type, &value);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 各执行方式的累计数据
+ */
+struct ModeState {
+    DifferentialTiming timing;
+    std::vector<uint64_t> samples;
+};
+
+uint64_t percentile(std::vector<uint64_t>& samples, size_t pct) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t index = std::min(samples.size() - 1, samples.size() * pct / 100);
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return samples[index];
+}
+
+} // namespace
+
+// ============================================
+// 差分测试实现
+// ============================================
+
+std::vector<PipelineConfig> generate_differential_configs(const DifferentialOptions& options) {
+    RandomConfigGenerator generator(options);
+    std::vector<PipelineConfig> configs;
+    for (size_t i = 0; i < options.num_configs; i++) {
+        configs.push_back(generator.next(i));
+    }
+    return configs;
+}
+
+DifferentialReport run_differential(const DifferentialOptions& options) {
+    return run_differential(generate_differential_configs(options), options);
+}
+
+DifferentialReport run_differential(const std::vector<PipelineConfig>& configs,
+                                    const DifferentialOptions& options) {
+    DifferentialReport report;
+    report.seed = options.seed;
+    report.configs = configs.size();
+    report.rows = options.rows;
+    for (const auto& name : OperatorRegistry::instance().get_all_operator_names()) {
+        report.operator_coverage[name] = 0;
+    }
+
+    std::vector<ModeState> modes(kDifferentialModes);
+    for (size_t m = 0; m < kDifferentialModes; m++) {
+        modes[m].timing.mode = static_cast<DifferentialMode>(m);
+    }
+
+    // 每块行数固定为min_chunk_rows，少量行也切成多块并行执行
+    BatchSchedulerOptions scheduler_options;
+    scheduler_options.num_threads = options.num_threads;
+    scheduler_options.parallel_threshold = 0;
+    scheduler_options.min_chunk_rows = std::max<size_t>(1, options.min_chunk_rows);
+    scheduler_options.max_chunk_rows = scheduler_options.min_chunk_rows;
+    BatchScheduler scheduler(scheduler_options);
+
+    const size_t rows = std::max<size_t>(1, options.rows);
+    const size_t iterations = std::max<size_t>(1, options.iterations);
+    std::mt19937_64 rng(options.seed ^ 0x9e3779b97f4a7c15ULL);
+
+    for (const auto& config : configs) {
+        for (const auto& step : config.steps) {
+            report.operator_coverage[step.op_name]++;
+        }
+        InputData inputs = make_inputs(config, rows, options.max_list_size, rng);
+        ColumnBatch input = inputs.batch();
+        bool failing = false;
+
+        auto fail = [&](DifferentialMode mode, const std::string& what) {
+            auto& timing = modes[static_cast<size_t>(mode)].timing;
+            timing.failures++;
+            timing.mismatches++;
+            report.total_mismatches++;
+            if (report.mismatches.size() < options.max_reported) {
+                report.mismatches.push_back({config.name, mode, DifferentialMismatch::npos, "", "", what});
+            }
+            failing = true;
+        };
+        auto record = [&](DifferentialMode mode, uint64_t mode_rows, uint64_t calls) {
+            auto& timing = modes[static_cast<size_t>(mode)].timing;
+            timing.rows += mode_rows;
+            timing.calls += calls;
+        };
+
+        // 参考结果
+        Results expected;
+        InterpreterExecutor interpreter(config);
+        if (!run_rows(interpreter, config, inputs, rows, iterations,
+                      modes[0].samples, expected)) {
+            fail(DifferentialMode::INTERPRETER, "<execution failed>");
+            report.failing_configs.push_back(config);
+            continue;
+        }
+        record(DifferentialMode::INTERPRETER, rows * iterations, rows * iterations);
+
+        auto compare = [&](DifferentialMode mode, const Results& actual) {
+            auto& timing = modes[static_cast<size_t>(mode)].timing;
+            for (size_t j = 0; j < config.outputs.size(); j++) {
+                for (size_t row = 0; row < rows; row++) {
+                    if (values_match(expected[j][row], actual[j][row], options.tolerance)) {
+                        continue;
+                    }
+                    timing.mismatches++;
+                    report.total_mismatches++;
+                    failing = true;
+                    if (report.mismatches.size() < options.max_reported) {
+                        report.mismatches.push_back({config.name, mode, row, config.outputs[j].name,
+                                                     format_value(expected[j][row]),
+                                                     format_value(actual[j][row])});
+                    }
+                }
+            }
+        };
+
+        Results actual;
+        BytecodeExecutor bytecode(config);
+        if (run_rows(bytecode, config, inputs, rows, iterations, modes[1].samples, actual)) {
+            record(DifferentialMode::BYTECODE, rows * iterations, rows * iterations);
+            compare(DifferentialMode::BYTECODE, actual);
+        } else {
+            fail(DifferentialMode::BYTECODE, "<execution failed>");
+        }
+
+        // 编译不计入耗时：先以一行批量执行触发编译
+        JITExecutor jit(config);
+        jit.set_options(options.gen_options);
+        {
+            Results warmup;
+            std::vector<uint64_t> ignored;
+            InputData first = make_inputs(config, 1, options.max_list_size, rng);
+            ColumnBatch first_input = first.batch();
+            if (!run_batches(config, 1, 1, ignored, warmup, [&](OutputBatch& output) {
+                    return jit.execute_batch(first_input, output, 1);
+                })) {
+                fail(DifferentialMode::JIT_ROW, "<compile failed>");
+                fail(DifferentialMode::JIT_BATCH, "<compile failed>");
+                fail(DifferentialMode::SCHEDULER, "<compile failed>");
+                report.failing_configs.push_back(config);
+                continue;
+            }
+        }
+
+        if (run_rows(jit, config, inputs, rows, iterations, modes[2].samples, actual)) {
+            record(DifferentialMode::JIT_ROW, rows * iterations, rows * iterations);
+            compare(DifferentialMode::JIT_ROW, actual);
+        } else {
+            fail(DifferentialMode::JIT_ROW, "<execution failed>");
+        }
+
+        if (run_batches(config, rows, iterations, modes[3].samples, actual, [&](OutputBatch& output) {
+                return jit.execute_batch(input, output, rows);
+            })) {
+            record(DifferentialMode::JIT_BATCH, rows * iterations, iterations);
+            compare(DifferentialMode::JIT_BATCH, actual);
+        } else {
+            fail(DifferentialMode::JIT_BATCH, "<execution failed>");
+        }
+
+        if (run_batches(config, rows, iterations, modes[4].samples, actual, [&](OutputBatch& output) {
+                return scheduler.run(jit, config, input, output, rows);
+            })) {
+            record(DifferentialMode::SCHEDULER, rows * iterations, iterations);
+            compare(DifferentialMode::SCHEDULER, actual);
+        } else {
+            fail(DifferentialMode::SCHEDULER, "<execution failed>");
+        }
+
+        if (failing) {
+            report.failing_configs.push_back(config);
+        }
+    }
+
+    for (auto& mode : modes) {
+        for (uint64_t ns : mode.samples) {
+            mode.timing.total_ns += ns;
+        }
+        mode.timing.p50_ns = percentile(mode.samples, 50);
+        mode.timing.p99_ns = percentile(mode.samples, 99);
+        report.modes.push_back(mode.timing);
+    }
+    return report;
+}
+
+std::vector<std::string> DifferentialReport::uncovered_operators() const {
+    std::vector<std::string> uncovered;
+    for (const auto& [name, count] : operator_coverage) {
+        if (count == 0) {
+            uncovered.push_back(name);
+        }
+    }
+    return uncovered;
+}
+
+void DifferentialReport::print(std::ostream& os) const {
+    std::vector<std::string> uncovered = uncovered_operators();
+    os << "差分测试: " << configs << "个配置 x " << rows << "行, 种子 " << seed << "\n";
+    os << "算子覆盖: " << (operator_coverage.size() - uncovered.size()) << "/" << operator_coverage.size();
+    if (!uncovered.empty()) {
+        os << " (未覆盖:";
+        for (const auto& name : uncovered) {
+            os << " " << name;
+        }
+        os << ")";
+    }
+    os << "\n";
+
+    // 表头含中文（setw按字节计宽），按显示宽度手工对齐到下面各列
+    os << "模式         " << "        行数" << "     吞吐(行/秒)"
+       << "  p50(ns/调用)" << "  p99(ns/调用)" << "    不一致" << "\n";
+    for (const auto& mode : modes) {
+        os << std::left << std::setw(13) << differential_mode_name(mode.mode) << std::right
+           << std::setw(12) << mode.rows
+           << std::setw(16) << std::fixed << std::setprecision(0) << mode.rows_per_sec()
+           << std::setw(14) << mode.p50_ns << std::setw(14) << mode.p99_ns
+           << std::setw(10) << mode.mismatches << "\n";
+    }
+    os.unsetf(std::ios::fixed);
+    os << std::setprecision(6);
+
+    if (ok()) {
+        os << "所有执行方式与解释执行结果一致\n";
+        return;
+    }
+    os << "不一致 " << total_mismatches << " 处（" << failing_configs.size() << "个配置）：\n";
+    for (const auto& m : mismatches) {
+        os << "  [" << m.config << "] " << differential_mode_name(m.mode);
+        if (m.row == DifferentialMismatch::npos) {
+            os << " " << m.actual << "\n";
+            continue;
+        }
+        os << " row=" << m.row << " " << m.output << ": expected " << m.expected
+           << ", got " << m.actual << "\n";
+    }
+    if (total_mismatches > mismatches.size()) {
+        os << "  ...\n";
+    }
+}
+
+} // namespace turbograph
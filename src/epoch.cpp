@@ -0,0 +1,107 @@
+#include "epoch.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace turbograph {
+
+// ============================================
+// 读者临界区
+// ============================================
+
+EpochDomain::Guard::Guard(EpochDomain& domain) : slot_(domain.acquire_slot()) {}
+
+// ============================================
+// 纪元回收域实现
+// ============================================
+
+EpochDomain& EpochDomain::instance() {
+    static EpochDomain domain;
+    return domain;
+}
+
+EpochDomain::EpochDomain() = default;
+
+std::atomic<uint64_t>* EpochDomain::acquire_slot() {
+    // 每个线程从各自的起始槽位开始找，无竞争时第一次CAS即成功，不与其他读者共享缓存行
+    static std::atomic<size_t> next_hint{0};
+    thread_local size_t hint = next_hint.fetch_add(1, std::memory_order_relaxed) % kSlots;
+
+    while (true) {
+        for (size_t i = 0; i < kSlots; i++) {
+            std::atomic<uint64_t>& slot = slots_[(hint + i) % kSlots].epoch;
+            uint64_t expected = 0;
+            // 先登记纪元再读取发布的指针：写者在替换指针之后推进纪元，
+            // 读到旧指针的读者登记的纪元一定不大于旧对象的retire纪元
+            uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            if (slot.compare_exchange_strong(expected, epoch, std::memory_order_seq_cst)) {
+                return &slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void EpochDomain::retire(std::function<void()> deleter) {
+    if (!deleter) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        retired_.push_back({epoch, std::move(deleter)});
+    }
+    reclaim();
+}
+
+size_t EpochDomain::reclaim() {
+    // 只回收在本次扫描前推进过纪元的对象：其可能的读者都已登记在槽位中
+    uint64_t safe = epoch_.load(std::memory_order_seq_cst);
+    for (const Slot& slot : slots_) {
+        uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+        if (epoch != 0) {
+            safe = std::min(safe, epoch);
+        }
+    }
+
+    std::vector<std::function<void()>> ready;
+    size_t remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::stable_partition(retired_.begin(), retired_.end(),
+                                        [safe](const Retired& r) { return r.epoch >= safe; });
+        for (auto r = it; r != retired_.end(); ++r) {
+            ready.push_back(std::move(r->deleter));
+        }
+        retired_.erase(it, retired_.end());
+        remaining = retired_.size();
+    }
+
+    // deleter可能较慢（dlclose），在锁外执行
+    for (auto& deleter : ready) {
+        deleter();
+    }
+    return remaining;
+}
+
+void EpochDomain::synchronize() {
+    uint64_t target = epoch_.load(std::memory_order_seq_cst);
+    while (true) {
+        reclaim();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            bool waiting = std::any_of(retired_.begin(), retired_.end(),
+                                       [target](const Retired& r) { return r.epoch < target; });
+            if (!waiting) {
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+size_t EpochDomain::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return retired_.size();
+}
+
+} // namespace turbograph
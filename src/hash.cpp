@@ -0,0 +1,143 @@
+#include "hash.hpp"
+#include <cstring>
+
+namespace turbograph {
+
+// ============================================
+// MurmurHash3 x64_128 实现
+// ============================================
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+/**
+ * @brief 按小端读取64位，保证不同字节序平台结果一致
+ */
+static inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+Hash128 murmur3_128(const void* data, size_t len, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    const size_t nblocks = len / 16;
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    // 主体：每次处理16字节
+    for (size_t i = 0; i < nblocks; i++) {
+        uint64_t k1 = load_le64(bytes + i * 16);
+        uint64_t k2 = load_le64(bytes + i * 16 + 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // 尾部：不足16字节的部分
+    const uint8_t* tail = bytes + nblocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    switch (len & 15) {
+        case 15: k2 ^= static_cast<uint64_t>(tail[14]) << 48; [[fallthrough]];
+        case 14: k2 ^= static_cast<uint64_t>(tail[13]) << 40; [[fallthrough]];
+        case 13: k2 ^= static_cast<uint64_t>(tail[12]) << 32; [[fallthrough]];
+        case 12: k2 ^= static_cast<uint64_t>(tail[11]) << 24; [[fallthrough]];
+        case 11: k2 ^= static_cast<uint64_t>(tail[10]) << 16; [[fallthrough]];
+        case 10: k2 ^= static_cast<uint64_t>(tail[9]) << 8; [[fallthrough]];
+        case 9:
+            k2 ^= static_cast<uint64_t>(tail[8]);
+            k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+            [[fallthrough]];
+        case 8: k1 ^= static_cast<uint64_t>(tail[7]) << 56; [[fallthrough]];
+        case 7: k1 ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+        case 6: k1 ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+        case 5: k1 ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+        case 4: k1 ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+        case 3: k1 ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+        case 2: k1 ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
+        case 1:
+            k1 ^= static_cast<uint64_t>(tail[0]);
+            k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+            break;
+        default:
+            break;
+    }
+
+    // 收尾混合
+    h1 ^= static_cast<uint64_t>(len);
+    h2 ^= static_cast<uint64_t>(len);
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    Hash128 result;
+    result.lo = h1;
+    result.hi = h2;
+    return result;
+}
+
+std::string Hash128::hex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(32, '0');
+    for (int i = 0; i < 16; i++) {
+        out[15 - i] = digits[(hi >> (i * 4)) & 0xf];
+        out[31 - i] = digits[(lo >> (i * 4)) & 0xf];
+    }
+    return out;
+}
+
+// ============================================
+// HashBuilder 实现
+// ============================================
+
+void HashBuilder::append_u64(uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buffer_.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+HashBuilder& HashBuilder::add(std::string_view value) {
+    buffer_.push_back('s');
+    append_u64(value.size());
+    buffer_.append(value.data(), value.size());
+    return *this;
+}
+
+HashBuilder& HashBuilder::add(uint64_t value) {
+    buffer_.push_back('u');
+    append_u64(value);
+    return *this;
+}
+
+Hash128 HashBuilder::finish() const {
+    return murmur3_128(buffer_.data(), buffer_.size());
+}
+
+} // namespace turbograph
@@ -1,4 +1,5 @@
 #include "loader.hpp"
+#include "epoch.hpp"
 #include <dlfcn.h>
 #include <iostream>
 #include <memory>
@@ -27,6 +28,14 @@ static std::string make_valid_identifier(const std::string& str) {
     return result;
 }
 
+/**
+ * @brief 延迟卸载动态库：正在执行其中函数的读者离开回收域后才dlclose
+ */
+static void retire_loader(DllLoader&& loader) {
+    auto retired = std::make_shared<DllLoader>(std::move(loader));
+    EpochDomain::instance().retire([retired] { retired->unload(); });
+}
+
 // ============================================
 // 动态库加载器实现
 // ============================================
@@ -89,7 +98,10 @@ const std::string& DllLoader::path() const {
 PipelineLoader::PipelineLoader() = default;
 
 PipelineLoader::~PipelineLoader() {
-    unload_all();
+    // 析构时不应再有执行方，直接卸载
+    loaders_.clear();
+    functions_.clear();
+    names_.clear();
 }
 
 bool PipelineLoader::load(const std::string& fingerprint, const std::string& so_path) {
@@ -100,7 +112,8 @@ bool PipelineLoader::load(const std::string& fingerprint, const std::string& so_
             return true;
         }
         // 路径不同，重新加载
-        it->second.unload();
+        retire_loader(std::move(it->second));
+        loaders_.erase(it);
     }
     
     DllLoader loader;
@@ -152,12 +165,19 @@ bool PipelineLoader::load(const std::string& fingerprint, const std::string& so_
 }
 
 void PipelineLoader::unload(const std::string& fingerprint) {
-    loaders_.erase(fingerprint);
+    auto it = loaders_.find(fingerprint);
+    if (it != loaders_.end()) {
+        retire_loader(std::move(it->second));
+        loaders_.erase(it);
+    }
     functions_.erase(fingerprint);
     names_.erase(fingerprint);
 }
 
 void PipelineLoader::unload_all() {
+    for (auto& [fingerprint, loader] : loaders_) {
+        retire_loader(std::move(loader));
+    }
     loaders_.clear();
     functions_.clear();
     names_.clear();
@@ -209,10 +229,15 @@ LoadManager& LoadManager::instance() {
 }
 
 bool LoadManager::load_pipeline(const PipelineConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return load_pipeline_locked(config);
+}
+
+bool LoadManager::load_pipeline_locked(const PipelineConfig& config) {
     std::string fingerprint = config.fingerprint;
     if (fingerprint.empty()) {
-        // 指纹为空时不使用缓存，直接编译
-        fingerprint = "dynamic_" + std::to_string(std::hash<std::string>{}(config.name));
+        // 指纹为空时按内容计算（与JITCompiler::compile一致）
+        fingerprint = compute_config_fingerprint(config);
     }
     
     // 检查是否已加载
@@ -220,24 +245,23 @@ bool LoadManager::load_pipeline(const PipelineConfig& config) {
         return true;
     }
     
-    // 获取SO路径
-    auto so_path = JITCompiler::instance().get_so_path(fingerprint);
+    // 获取SO路径（缓存条目需与本次编译选项一致）
+    CompileOptions comp_opts;
+    comp_opts.keep_source = true;
+    
+    auto so_path = JITCompiler::instance().get_so_path(fingerprint, comp_opts);
     if (!so_path.has_value()) {
         // 需要编译
         CodeGenOptions gen_opts;
         gen_opts.output_dir = cache_dir_;
         gen_opts.verbose = false;
         
-        CompileOptions comp_opts;
-        comp_opts.include_dir = "/workspace/turbograph_jit/include";
-        comp_opts.keep_source = true;
-        
         if (!JITCompiler::instance().compile(config, gen_opts, comp_opts)) {
             std::cerr << "Failed to compile pipeline: " << fingerprint << std::endl;
             return false;
         }
         
-        so_path = JITCompiler::instance().get_so_path(fingerprint);
+        so_path = JITCompiler::instance().get_so_path(fingerprint, comp_opts);
         if (!so_path.has_value()) {
             std::cerr << "Failed to get SO path: " << fingerprint << std::endl;
             return false;
@@ -256,29 +280,43 @@ bool LoadManager::execute(const PipelineConfig& config,
         fingerprint = config.fingerprint;
     }
     
-    if (!loader_.is_loaded(fingerprint)) {
-        if (!load_pipeline(config)) {
+    // 只在查找（及首次加载）时持锁，执行不串行化；
+    // 执行期间处于回收域临界区，并发卸载的SO在返回后才dlclose
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    PipelineLoader::ExecuteFunc func = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loader_.is_loaded(fingerprint) && !load_pipeline_locked(config)) {
             return false;
         }
+        func = loader_.get_function(fingerprint);
+    }
+    if (!func) {
+        std::cerr << "Pipeline not loaded: " << fingerprint << std::endl;
+        return false;
     }
     
-    return loader_.execute(fingerprint, input_data, output_data);
+    return func(input_data, output_data);
 }
 
 void LoadManager::unload_pipeline(const std::string& fingerprint) {
+    std::lock_guard<std::mutex> lock(mutex_);
     loader_.unload(fingerprint);
 }
 
 void LoadManager::unload_all() {
+    std::lock_guard<std::mutex> lock(mutex_);
     loader_.unload_all();
 }
 
 void LoadManager::set_cache_dir(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
     cache_dir_ = dir;
     JITCompiler::instance().set_cache_dir(dir);
 }
 
 void LoadManager::set_include_dir(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
     include_dir_ = dir;
 }
 
@@ -287,10 +325,12 @@ bool LoadManager::is_loaded(const PipelineConfig& config) const {
     if (fingerprint.empty()) {
         return false;
     }
+    std::lock_guard<std::mutex> lock(mutex_);
     return loader_.is_loaded(fingerprint);
 }
 
 size_t LoadManager::loaded_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     return loader_.loaded_count();
 }
 
@@ -0,0 +1,492 @@
+#include "optimizer.hpp"
+#include "code_generator.hpp"
+#include "ops_core.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace turbograph {
+
+// ============================================
+// 数据流图实现
+// ============================================
+
+DataflowGraph DataflowGraph::build(const PipelineConfig& config) {
+    DataflowGraph graph;
+    std::unordered_map<std::string, int> reaching;
+
+    for (size_t i = 0; i < config.steps.size(); i++) {
+        const auto& step = config.steps[i];
+        DataflowNode node;
+        node.step = i;
+        for (const auto& arg : step.args) {
+            int def = -1;
+            if (arg.type == ArgType::VARIABLE) {
+                auto it = reaching.find(arg.value);
+                if (it != reaching.end()) {
+                    def = it->second;
+                }
+            }
+            node.deps.push_back(def);
+        }
+        graph.nodes.push_back(std::move(node));
+        reaching[step.output_var] = static_cast<int>(i);
+    }
+
+    for (const auto& output : config.outputs) {
+        auto it = reaching.find(output.name);
+        graph.output_defs.push_back(it != reaching.end() ? it->second : -1);
+    }
+    return graph;
+}
+
+std::vector<bool> DataflowGraph::live_steps() const {
+    return live_steps(std::vector<bool>(output_defs.size(), true));
+}
+
+std::vector<bool> DataflowGraph::live_steps(const std::vector<bool>& outputs) const {
+    std::vector<bool> live(nodes.size(), false);
+    std::vector<int> pending;
+    for (size_t j = 0; j < output_defs.size() && j < outputs.size(); j++) {
+        if (outputs[j]) {
+            pending.push_back(output_defs[j]);
+        }
+    }
+    while (!pending.empty()) {
+        int def = pending.back();
+        pending.pop_back();
+        if (def < 0 || live[def]) {
+            continue;
+        }
+        live[def] = true;
+        pending.insert(pending.end(), nodes[def].deps.begin(), nodes[def].deps.end());
+    }
+    return live;
+}
+
+// ============================================
+// 常量求值（语义与生成代码中的ops_core.hpp调用一致）
+// ============================================
+
+namespace {
+
+/**
+ * @brief 带静态类型的标量常量
+ */
+struct Scalar {
+    DataType type = DataType::INT32;
+    int64_t i = 0;
+    double d = 0.0;
+
+    double as_double() const { return is_int() ? static_cast<double>(i) : d; }
+    bool is_int() const { return type == DataType::INT32 || type == DataType::INT64; }
+
+    static Scalar of_int(DataType type, int64_t value) {
+        Scalar s;
+        s.type = type;
+        s.i = value;
+        return s;
+    }
+
+    static Scalar of_double(double value) {
+        Scalar s;
+        s.type = DataType::DOUBLE;
+        s.d = value;
+        return s;
+    }
+};
+
+/**
+ * @brief 解析数值字面量
+ * 生成代码原样输出字面量文本，C++类型由文本决定（整数为int/long，带小数点或指数为double），
+ * 只有与声明类型一致时才参与折叠；true/false在C++中为bool，不参与折叠
+ */
+std::optional<Scalar> parse_scalar(const Arg& arg) {
+    if (arg.type != ArgType::LITERAL || arg.value.empty()) {
+        return std::nullopt;
+    }
+    const char* begin = arg.value.c_str();
+    char* end = nullptr;
+    bool floating = arg.value.find_first_of(".eE") != std::string::npos;
+    if (floating) {
+        if (arg.data_type != DataType::DOUBLE) {
+            return std::nullopt;
+        }
+        double value = std::strtod(begin, &end);
+        if (end != begin + arg.value.size() || !std::isfinite(value)) {
+            return std::nullopt;
+        }
+        return Scalar::of_double(value);
+    }
+    if (arg.data_type != DataType::INT32 && arg.data_type != DataType::INT64) {
+        return std::nullopt;
+    }
+    errno = 0;
+    long long value = std::strtoll(begin, &end, 10);
+    if (end != begin + arg.value.size() || errno == ERANGE) {
+        return std::nullopt;
+    }
+    bool fits_int = value >= std::numeric_limits<int32_t>::min() + 1LL &&
+                    value <= std::numeric_limits<int32_t>::max();
+    return Scalar::of_int(fits_int ? DataType::INT32 : DataType::INT64, value);
+}
+
+/**
+ * @brief C++隐式转换，浮点转整数超出范围（未定义行为）时返回空
+ */
+std::optional<Scalar> convert(const Scalar& value, DataType to) {
+    if (to == DataType::DOUBLE) {
+        return Scalar::of_double(value.as_double());
+    }
+    if (to != DataType::INT32 && to != DataType::INT64) {
+        return std::nullopt;
+    }
+    if (value.is_int()) {
+        return Scalar::of_int(to, to == DataType::INT32 ? static_cast<int32_t>(value.i) : value.i);
+    }
+    double truncated = std::trunc(value.d);
+    double limit = to == DataType::INT32 ? 2147483648.0 : 9223372036854775808.0;
+    if (!(truncated >= -limit && truncated < limit)) {
+        return std::nullopt;
+    }
+    return Scalar::of_int(to, static_cast<int64_t>(truncated));
+}
+
+/**
+ * @brief 按推导类型T调用非模板算子
+ */
+template<typename F>
+std::optional<Scalar> dispatch_deduced(const Scalar& sample, F&& f) {
+    switch (sample.type) {
+        case DataType::INT32: return f(int32_t{});
+        case DataType::INT64: return f(int64_t{});
+        case DataType::DOUBLE: return f(double{});
+        default: return std::nullopt;
+    }
+}
+
+template<typename T>
+T scalar_as(const Scalar& s) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(s.as_double());
+    } else {
+        return static_cast<T>(s.i);
+    }
+}
+
+template<typename T>
+Scalar make_scalar(T value) {
+    if constexpr (std::is_same_v<T, int32_t>) {
+        return Scalar::of_int(DataType::INT32, value);
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return Scalar::of_int(DataType::INT64, value);
+    } else {
+        return Scalar::of_double(static_cast<double>(value));
+    }
+}
+
+/**
+ * @brief 对参数全为常量的步骤求值
+ * 只处理数值核心算子；可能触发未定义行为（溢出的浮点转整数）时不折叠
+ */
+std::optional<Scalar> evaluate(const std::string& op, const std::vector<Scalar>& args) {
+    using namespace turbograph::ops;
+
+    // 模板算子：生成代码以<double>实例化，实参先转换为double
+    auto d = [&](size_t i) { return args[i].as_double(); };
+    if (op == "add") return Scalar::of_double(add_op<double>(d(0), d(1)));
+    if (op == "sub") return Scalar::of_double(sub_op<double>(d(0), d(1)));
+    if (op == "mul") return Scalar::of_double(mul_op<double>(d(0), d(1)));
+    if (op == "div") return Scalar::of_double(div_op<double>(d(0), d(1)));
+    if (op == "max") return Scalar::of_double(max_op<double>(d(0), d(1)));
+    if (op == "min") return Scalar::of_double(min_op<double>(d(0), d(1)));
+    if (op == "abs") return Scalar::of_double(abs_op<double>(d(0)));
+    if (op == "square") return Scalar::of_double(square_op<double>(d(0)));
+    if (op == "sqrt") return Scalar::of_double(sqrt_op<double>(d(0)));
+    if (op == "floor" || op == "ceil") {
+        double rounded = op == "floor" ? std::floor(d(0)) : std::ceil(d(0));
+        return convert(Scalar::of_double(rounded), DataType::INT32);
+    }
+    if (op == "direct_output_int32") return convert(args[0], DataType::INT32);
+    if (op == "direct_output_int64") return convert(args[0], DataType::INT64);
+    if (op == "direct_output_double") return convert(args[0], DataType::DOUBLE);
+
+    // 非模板算子：按实参推导T，需要同类型的参数类型不一致时生成代码无法编译，不折叠
+    if (op == "get_sign") {
+        return dispatch_deduced(args[0], [&](auto tag) -> std::optional<Scalar> {
+            using T = decltype(tag);
+            return make_scalar<int32_t>(get_sign<T>(scalar_as<T>(args[0])));
+        });
+    }
+    if (op == "price_diff" || op == "percent") {
+        if (args[0].type != args[1].type) {
+            return std::nullopt;
+        }
+        bool diff = op == "price_diff";
+        return dispatch_deduced(args[0], [&](auto tag) -> std::optional<Scalar> {
+            using T = decltype(tag);
+            T a = scalar_as<T>(args[0]);
+            T b = scalar_as<T>(args[1]);
+            if (diff) {
+                if constexpr (std::is_integral_v<T>) {
+                    T result;
+                    if (a != 0 && __builtin_sub_overflow(a, b, &result)) {
+                        return std::nullopt;
+                    }
+                }
+                return make_scalar<T>(price_diff<T>(a, b));
+            }
+            return Scalar::of_double(percent_op<T>(a, b));
+        });
+    }
+    if (op == "if_else") {
+        if (args[1].type != args[2].type) {
+            return std::nullopt;
+        }
+        bool condition = args[0].is_int() ? args[0].i != 0 : args[0].d != 0.0;
+        return condition ? args[1] : args[2];
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief 常量写成字面量，只有C++字面量类型与变量类型一致时可以替换
+ * （int32为int字面量，double为带小数点的浮点字面量）
+ */
+std::optional<Arg> to_literal(const Scalar& value, DataType type) {
+    auto converted = convert(value, type);
+    if (!converted) {
+        return std::nullopt;
+    }
+    // INT32_MIN的字面量在C++中为-(2147483648L)，类型为long
+    if (type == DataType::INT32 && converted->i != std::numeric_limits<int32_t>::min()) {
+        return Arg::literal(std::to_string(converted->i), DataType::INT32);
+    }
+    if (type == DataType::DOUBLE && std::isfinite(converted->d)) {
+        char buffer[40];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", converted->d);
+        std::string text = buffer;
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        return Arg::literal(text, DataType::DOUBLE);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief 拷贝算子：公共子表达式结果需要写入另一个变量时使用
+ */
+const char* copy_operator(DataType type) {
+    switch (type) {
+        case DataType::INT32: return "direct_output_int32";
+        case DataType::INT64: return "direct_output_int64";
+        case DataType::DOUBLE: return "direct_output_double";
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief 变量在原配置中的赋值与读取情况
+ */
+struct VarUsage {
+    size_t writes = 0;
+    size_t first_write = 0;
+    bool read_before_write = false;  // 首次赋值前（含赋值步骤自身的参数）被读取
+};
+
+} // namespace
+
+// ============================================
+// 优化器实现
+// ============================================
+
+PipelineConfig PipelineOptimizer::optimize(const PipelineConfig& config,
+                                           const OptimizerOptions& options,
+                                           OptimizerStats* stats) {
+    OptimizerStats local_stats;
+    OptimizerStats& st = stats ? *stats : local_stats;
+    st = OptimizerStats{};
+
+    auto& registry = OperatorRegistry::instance();
+    auto types = compute_field_types(config);
+
+    std::unordered_set<std::string> fixed;  // 输入与输出：名称对外可见，不能被替换
+    for (const auto& input : config.inputs) {
+        fixed.insert(input.name);
+    }
+    for (const auto& output : config.outputs) {
+        fixed.insert(output.name);
+    }
+
+    std::unordered_map<std::string, VarUsage> usage;
+    for (size_t i = 0; i < config.steps.size(); i++) {
+        const auto& step = config.steps[i];
+        for (const auto& arg : step.args) {
+            if (arg.type == ArgType::VARIABLE) {
+                auto& u = usage[arg.value];
+                if (u.writes == 0) {
+                    u.read_before_write = true;
+                }
+            }
+        }
+        auto& u = usage[step.output_var];
+        if (u.writes++ == 0) {
+            u.first_write = i;
+        }
+    }
+
+    // 单次赋值的中间变量：定义后值不再改变，读取处可以直接替换
+    auto replaceable = [&](const std::string& name) {
+        auto it = usage.find(name);
+        return !fixed.count(name) && it != usage.end() &&
+               it->second.writes == 1 && !it->second.read_before_write;
+    };
+
+    PipelineConfig result = config;
+    result.steps.clear();
+
+    std::unordered_map<std::string, Arg> constants;        // 变量 -> 折叠后的字面量
+    std::unordered_map<std::string, std::string> aliases;  // 变量 -> 持有相同值的变量
+    std::unordered_map<std::string, size_t> versions;      // 变量 -> 已赋值次数
+    std::unordered_map<std::string, std::string> available; // 表达式 -> 持有结果的单次赋值变量
+
+    for (const auto& original : config.steps) {
+        OpCall step = original;
+        const auto* meta = registry.get_operator(step.op_name);
+
+        // 替换已折叠的常量和公共子表达式别名
+        for (auto& arg : step.args) {
+            if (arg.type != ArgType::VARIABLE) {
+                continue;
+            }
+            if (auto it = constants.find(arg.value); it != constants.end()) {
+                arg = it->second;
+            } else if (auto alias = aliases.find(arg.value); alias != aliases.end()) {
+                arg.value = alias->second;
+            }
+        }
+
+        DataType out_type = types.at(step.output_var);
+
+        // 常量折叠
+        if (options.fold_constants && meta && meta->core && replaceable(step.output_var)) {
+            std::vector<Scalar> values;
+            for (const auto& arg : step.args) {
+                auto value = parse_scalar(arg);
+                if (!value) {
+                    break;
+                }
+                values.push_back(*value);
+            }
+            if (values.size() == step.args.size() && static_cast<int>(values.size()) == meta->param_count) {
+                auto folded = evaluate(step.op_name, values);
+                auto literal = folded ? to_literal(*folded, out_type) : std::nullopt;
+                if (literal) {
+                    constants[step.output_var] = *literal;
+                    st.folded++;
+                    continue;
+                }
+            }
+        }
+
+        // 公共子表达式：算子、参数（变量按赋值版本区分）、选项和结果类型均相同
+        std::string key;
+        if (options.eliminate_common && meta) {
+            key = step.op_name + "|" + std::to_string(static_cast<int>(out_type));
+            for (const auto& arg : step.args) {
+                if (arg.type == ArgType::VARIABLE) {
+                    key += "|v:" + arg.value + "#" + std::to_string(versions[arg.value]);
+                } else {
+                    key += "|l:" + std::to_string(static_cast<int>(arg.data_type)) + ":" + arg.value;
+                }
+            }
+            std::vector<std::pair<std::string, std::string>> opts(step.options.begin(), step.options.end());
+            std::sort(opts.begin(), opts.end());
+            for (const auto& [k, v] : opts) {
+                key += "|o:" + k + "=" + v;
+            }
+
+            auto hit = available.find(key);
+            if (hit != available.end()) {
+                const std::string& holder = hit->second;
+                if (replaceable(step.output_var)) {
+                    aliases[step.output_var] = holder;
+                    st.common++;
+                    continue;
+                }
+                // 输出或多次赋值的变量仍需写入，用拷贝代替重复计算
+                const char* copy = copy_operator(out_type);
+                if (copy && step.op_name != copy) {
+                    step.op_name = copy;
+                    step.args = {Arg::variable(holder, out_type)};
+                    step.options.clear();
+                    key.clear();
+                    st.common++;
+                }
+            }
+        }
+
+        versions[step.output_var]++;
+        if (!key.empty() && replaceable(step.output_var)) {
+            available.emplace(key, step.output_var);
+        }
+        result.steps.push_back(std::move(step));
+    }
+
+    if (options.eliminate_dead) {
+        DataflowGraph graph = DataflowGraph::build(result);
+        std::vector<bool> live = graph.live_steps();
+        std::vector<OpCall> kept;
+        for (size_t i = 0; i < result.steps.size(); i++) {
+            if (live[i]) {
+                kept.push_back(std::move(result.steps[i]));
+            } else {
+                st.dead++;
+            }
+        }
+        result.steps = std::move(kept);
+    }
+
+    // 不再被引用的中间变量声明一并删除
+    std::unordered_set<std::string> referenced;
+    for (const auto& step : result.steps) {
+        referenced.insert(step.output_var);
+        for (const auto& arg : step.args) {
+            if (arg.type == ArgType::VARIABLE) {
+                referenced.insert(arg.value);
+            }
+        }
+    }
+    result.variables.erase(
+        std::remove_if(result.variables.begin(), result.variables.end(),
+                       [&](const PipelineConfig::IOField& var) {
+                           return !referenced.count(var.name) && !fixed.count(var.name);
+                       }),
+        result.variables.end());
+
+    // 未声明的中间变量类型取最后一次赋值的算子，删除步骤后可能改变，按原类型显式声明
+    auto optimized_types = compute_field_types(result);
+    std::unordered_set<std::string> declared;
+    for (const auto& var : result.variables) {
+        declared.insert(var.name);
+    }
+    for (const auto& step : result.steps) {
+        const auto& name = step.output_var;
+        if (!fixed.count(name) && !declared.count(name) &&
+            optimized_types.at(name) != types.at(name)) {
+            result.variables.push_back({name, types.at(name), false});
+            declared.insert(name);
+        }
+    }
+
+    return result;
+}
+
+} // namespace turbograph
@@ -0,0 +1,786 @@
+#include "compiler_backend.hpp"
+#include "abi.hpp"
+#include "optimizer.hpp"
+
+#ifdef TURBOGRAPH_WITH_LLVM
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace turbograph {
+
+namespace {
+
+// ============================================
+// 辅助函数
+// ============================================
+
+/**
+ * @brief 生成合法的C++标识符（与code_generator保持一致，导出符号名相同）
+ */
+std::string make_valid_identifier(const std::string& str) {
+    if (str.empty()) return "p_invalid";
+    std::string result = str;
+    if (std::isdigit(result[0])) {
+        result = "p_" + result;
+    }
+    for (char& c : result) {
+        if (!std::isalnum(c) && c != '_') {
+            c = '_';
+        }
+    }
+    return result;
+}
+
+bool is_scalar(DataType type) {
+    return type == DataType::INT32 || type == DataType::INT64 ||
+           type == DataType::DOUBLE || type == DataType::FLOAT;
+}
+
+bool is_floating(DataType type) {
+    return type == DataType::DOUBLE || type == DataType::FLOAT;
+}
+
+// ============================================
+// 支持的算子（语义与ops_core.hpp逐一对应）
+// ============================================
+
+enum class IrOp {
+    ADD, SUB, MUL, DIV, MAX, MIN, ABS, SQUARE, SQRT, FLOOR, CEIL,
+    TO_INT32, TO_INT64, TO_DOUBLE,
+    GET_SIGN, PRICE_DIFF, IF_ELSE, PERCENT
+};
+
+struct IrOpInfo {
+    const char* op_name;
+    IrOp op;
+    size_t argc;
+    // 非模板算子按实参推导类型T，需要类型一致的参数区间 [same_from, same_to)
+    size_t same_from;
+    size_t same_to;
+};
+
+const IrOpInfo kIrOps[] = {
+    {"add", IrOp::ADD, 2, 0, 0},
+    {"sub", IrOp::SUB, 2, 0, 0},
+    {"mul", IrOp::MUL, 2, 0, 0},
+    {"div", IrOp::DIV, 2, 0, 0},
+    {"max", IrOp::MAX, 2, 0, 0},
+    {"min", IrOp::MIN, 2, 0, 0},
+    {"abs", IrOp::ABS, 1, 0, 0},
+    {"square", IrOp::SQUARE, 1, 0, 0},
+    {"sqrt", IrOp::SQRT, 1, 0, 0},
+    {"floor", IrOp::FLOOR, 1, 0, 0},
+    {"ceil", IrOp::CEIL, 1, 0, 0},
+    {"direct_output_int32", IrOp::TO_INT32, 1, 0, 0},
+    {"direct_output_int64", IrOp::TO_INT64, 1, 0, 0},
+    {"direct_output_double", IrOp::TO_DOUBLE, 1, 0, 0},
+    {"get_sign", IrOp::GET_SIGN, 1, 0, 0},
+    {"price_diff", IrOp::PRICE_DIFF, 2, 0, 2},
+    {"if_else", IrOp::IF_ELSE, 3, 1, 3},
+    {"percent", IrOp::PERCENT, 2, 0, 2},
+};
+
+const IrOpInfo* find_ir_op(const std::string& op_name) {
+    for (const auto& info : kIrOps) {
+        if (op_name == info.op_name) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 解析数值字面量，C++字面量true/false按整数处理
+ */
+bool parse_number(const Arg& arg, double& number) {
+    if (arg.value == "true" || arg.value == "false") {
+        number = arg.value == "true" ? 1.0 : 0.0;
+        return true;
+    }
+    const char* begin = arg.value.c_str();
+    char* end = nullptr;
+    number = std::strtod(begin, &end);
+    return !arg.value.empty() && end == begin + arg.value.size();
+}
+
+/**
+ * @brief 参数在生成代码中的静态类型
+ */
+DataType arg_type(const Arg& arg, const std::unordered_map<std::string, DataType>& types) {
+    if (arg.type == ArgType::VARIABLE) {
+        auto it = types.find(arg.value);
+        return it != types.end() ? it->second : DataType::UNKNOWN;
+    }
+    double number = 0.0;
+    if (arg.data_type == DataType::STRING || !parse_number(arg, number)) {
+        return DataType::UNKNOWN;
+    }
+    return arg.data_type == DataType::INT64 || arg.data_type == DataType::DOUBLE
+        ? arg.data_type : DataType::INT32;
+}
+
+/**
+ * @brief 检查配置能否降级为IR，返回不支持的原因（为空表示支持）
+ */
+std::string unsupported_reason(const PipelineConfig& config) {
+    // 降级按注册表返回类型实例化算子，低精度策略交给g++后端
+    if (config.precision != Precision::DOUBLE) {
+        return "reduced precision policy";
+    }
+    for (const auto* fields : {&config.inputs, &config.outputs, &config.variables}) {
+        for (const auto& field : *fields) {
+            if (!is_scalar(field.type)) {
+                return "non-scalar field: " + field.name;
+            }
+        }
+    }
+    for (const auto& input : config.inputs) {
+        if (input.broadcast) {
+            return "broadcast input: " + input.name;
+        }
+    }
+
+    auto types = compute_field_types(config);
+    for (const auto& step : config.steps) {
+        const auto* info = find_ir_op(step.op_name);
+        if (!info) {
+            return "unsupported operator: " + step.op_name;
+        }
+        if (step.args.size() != info->argc) {
+            return "wrong argument count for operator: " + step.op_name;
+        }
+        for (const auto& arg : step.args) {
+            if (arg_type(arg, types) == DataType::UNKNOWN) {
+                return "unsupported argument: " + arg.value;
+            }
+        }
+        for (size_t i = info->same_from + 1; i < info->same_to; i++) {
+            if (arg_type(step.args[i], types) != arg_type(step.args[info->same_from], types)) {
+                return "mismatched argument types for operator: " + step.op_name;
+            }
+        }
+    }
+    return "";
+}
+
+// ============================================
+// 配置 -> LLVM IR
+// ============================================
+
+/**
+ * @brief 将管道降级为LLVM IR
+ * 导出与生成C++代码相同签名的 pipeline_execute_<fp> 和 pipeline_execute_batch_<fp>，
+ * 输入输出结构按compute_abi_layout的偏移读写
+ */
+class IrLowering {
+public:
+    IrLowering(const PipelineConfig& config, llvm::Module& module)
+        : config_(config), module_(module), ctx_(module.getContext()), b_(ctx_),
+          types_(compute_field_types(config)) {}
+
+    void emit_execute(const std::string& name) {
+        auto* i8p = b_.getInt8PtrTy();
+        auto* fn = llvm::Function::Create(
+            llvm::FunctionType::get(b_.getInt8Ty(), {i8p, i8p}, false),
+            llvm::Function::ExternalLinkage, name, module_);
+        auto* entry = llvm::BasicBlock::Create(ctx_, "entry", fn);
+        auto* store_bb = llvm::BasicBlock::Create(ctx_, "store_outputs", fn);
+        auto* done_bb = llvm::BasicBlock::Create(ctx_, "done", fn);
+        b_.SetInsertPoint(entry);
+
+        // 输入指针为空时从全零缓冲区读取，对应生成代码中未赋值的输入
+        AbiStructLayout in_layout = compute_abi_layout(config_.inputs, true);
+        llvm::Value* in = fn->getArg(0);
+        if (!in_layout.fields.empty()) {
+            auto* zero_type = llvm::ArrayType::get(b_.getInt8Ty(), in_layout.size);
+            auto* zeros = new llvm::GlobalVariable(
+                module_, zero_type, true, llvm::GlobalValue::PrivateLinkage,
+                llvm::ConstantAggregateZero::get(zero_type), "zero_input");
+            zeros->setAlignment(llvm::Align(in_layout.alignment));
+            in = b_.CreateSelect(b_.CreateIsNull(in), b_.CreateBitCast(zeros, i8p), in);
+        }
+
+        Values values;
+        for (const auto& field : in_layout.fields) {
+            llvm::Type* type = type_of(field.type);
+            values[field.name] = b_.CreateAlignedLoad(
+                type, field_ptr(in, field.offset, type), llvm::MaybeAlign(field.size));
+        }
+
+        emit_steps(values);
+
+        llvm::Value* out = fn->getArg(1);
+        b_.CreateCondBr(b_.CreateIsNull(out), done_bb, store_bb);
+        b_.SetInsertPoint(store_bb);
+        AbiStructLayout out_layout = compute_abi_layout(config_.outputs, false);
+        for (const auto& field : out_layout.fields) {
+            llvm::Type* type = type_of(field.type);
+            llvm::Value* value = convert(read(values, field.name), types_.at(field.name), field.type);
+            b_.CreateAlignedStore(value, field_ptr(out, field.offset, type), llvm::MaybeAlign(field.size));
+        }
+        b_.CreateBr(done_bb);
+
+        b_.SetInsertPoint(done_bb);
+        b_.CreateRet(b_.getInt8(1));
+    }
+
+    void emit_batch(const std::string& name) {
+        auto* i8p = b_.getInt8PtrTy();
+        auto* size_type = b_.getInt64Ty();
+        auto* fn = llvm::Function::Create(
+            llvm::FunctionType::get(b_.getInt8Ty(), {i8p, i8p, size_type}, false),
+            llvm::Function::ExternalLinkage, name, module_);
+        auto* entry = llvm::BasicBlock::Create(ctx_, "entry", fn);
+        auto* check_bb = llvm::BasicBlock::Create(ctx_, "check_columns", fn);
+        auto* setup_bb = llvm::BasicBlock::Create(ctx_, "setup", fn);
+        auto* loop_bb = llvm::BasicBlock::Create(ctx_, "loop", fn);
+        auto* body_bb = llvm::BasicBlock::Create(ctx_, "body", fn);
+        auto* done_bb = llvm::BasicBlock::Create(ctx_, "done", fn);
+        auto* fail_bb = llvm::BasicBlock::Create(ctx_, "fail", fn);
+
+        // ColumnBatch/OutputBatch: { columns指针数组, num_columns }
+        llvm::Value* input = fn->getArg(0);
+        llvm::Value* output = fn->getArg(1);
+        llvm::Value* n = fn->getArg(2);
+
+        b_.SetInsertPoint(entry);
+        b_.CreateCondBr(b_.CreateOr(b_.CreateIsNull(input), b_.CreateIsNull(output)), fail_bb, check_bb);
+
+        b_.SetInsertPoint(check_bb);
+        auto* num_in = b_.CreateAlignedLoad(size_type, field_ptr(input, sizeof(void*), size_type),
+                                            llvm::MaybeAlign(sizeof(size_t)));
+        auto* num_out = b_.CreateAlignedLoad(size_type, field_ptr(output, sizeof(void*), size_type),
+                                             llvm::MaybeAlign(sizeof(size_t)));
+        auto* too_few = b_.CreateOr(
+            b_.CreateICmpULT(num_in, b_.getInt64(config_.inputs.size())),
+            b_.CreateICmpULT(num_out, b_.getInt64(config_.outputs.size())));
+        b_.CreateCondBr(too_few, fail_bb, setup_bb);
+
+        // 循环外取出列指针
+        b_.SetInsertPoint(setup_bb);
+        auto load_columns = [&](llvm::Value* batch, const std::vector<PipelineConfig::IOField>& fields) {
+            llvm::Value* columns = b_.CreateAlignedLoad(i8p->getPointerTo(), field_ptr(batch, 0, i8p->getPointerTo()),
+                                                        llvm::MaybeAlign(sizeof(void*)));
+            std::vector<llvm::Value*> result;
+            for (size_t i = 0; i < fields.size(); i++) {
+                llvm::Value* column = b_.CreateAlignedLoad(
+                    i8p, b_.CreateConstInBoundsGEP1_64(i8p, columns, i), llvm::MaybeAlign(sizeof(void*)));
+                result.push_back(b_.CreateBitCast(column, type_of(fields[i].type)->getPointerTo()));
+            }
+            return result;
+        };
+        std::vector<llvm::Value*> in_columns = load_columns(input, config_.inputs);
+        std::vector<llvm::Value*> out_columns = load_columns(output, config_.outputs);
+        b_.CreateBr(loop_bb);
+
+        b_.SetInsertPoint(loop_bb);
+        auto* index = b_.CreatePHI(size_type, 2, "i");
+        index->addIncoming(b_.getInt64(0), setup_bb);
+        b_.CreateCondBr(b_.CreateICmpULT(index, n), body_bb, done_bb);
+
+        b_.SetInsertPoint(body_bb);
+        Values values;
+        for (size_t i = 0; i < config_.inputs.size(); i++) {
+            const auto& field = config_.inputs[i];
+            llvm::Type* type = type_of(field.type);
+            values[field.name] = b_.CreateAlignedLoad(
+                type, b_.CreateInBoundsGEP(type, in_columns[i], index),
+                llvm::MaybeAlign(module_.getDataLayout().getABITypeAlignment(type)));
+        }
+        emit_steps(values);
+        for (size_t i = 0; i < config_.outputs.size(); i++) {
+            const auto& field = config_.outputs[i];
+            llvm::Type* type = type_of(field.type);
+            llvm::Value* value = convert(read(values, field.name), types_.at(field.name), field.type);
+            b_.CreateAlignedStore(value, b_.CreateInBoundsGEP(type, out_columns[i], index),
+                                  llvm::MaybeAlign(module_.getDataLayout().getABITypeAlignment(type)));
+        }
+        index->addIncoming(b_.CreateAdd(index, b_.getInt64(1)), b_.GetInsertBlock());
+        b_.CreateBr(loop_bb);
+
+        b_.SetInsertPoint(done_bb);
+        b_.CreateRet(b_.getInt8(1));
+
+        b_.SetInsertPoint(fail_bb);
+        b_.CreateRet(b_.getInt8(0));
+    }
+
+private:
+    using Values = std::unordered_map<std::string, llvm::Value*>;
+
+    enum class Cmp { LT, GT, GE, EQ, NE };
+
+    llvm::Type* type_of(DataType type) {
+        switch (type) {
+            case DataType::INT32: return b_.getInt32Ty();
+            case DataType::INT64: return b_.getInt64Ty();
+            case DataType::FLOAT: return b_.getFloatTy();
+            default: return b_.getDoubleTy();
+        }
+    }
+
+    llvm::Value* zero(DataType type) {
+        return llvm::Constant::getNullValue(type_of(type));
+    }
+
+    /**
+     * @brief C++隐式算术转换
+     */
+    llvm::Value* convert(llvm::Value* value, DataType from, DataType to) {
+        if (from == to) {
+            return value;
+        }
+        llvm::Type* target = type_of(to);
+        if (is_floating(from) && is_floating(to)) {
+            return b_.CreateFPCast(value, target);
+        }
+        if (is_floating(from)) {
+            return b_.CreateFPToSI(value, target);
+        }
+        if (is_floating(to)) {
+            return b_.CreateSIToFP(value, target);
+        }
+        return b_.CreateSExtOrTrunc(value, target);
+    }
+
+    llvm::Value* field_ptr(llvm::Value* base, size_t offset, llvm::Type* type) {
+        llvm::Value* byte_ptr = b_.CreateConstInBoundsGEP1_64(b_.getInt8Ty(), base, offset);
+        return b_.CreateBitCast(byte_ptr, type->getPointerTo());
+    }
+
+    /**
+     * @brief 读取字段当前值，尚未赋值的字段为零
+     */
+    llvm::Value* read(Values& values, const std::string& name) {
+        auto it = values.find(name);
+        if (it != values.end()) {
+            return it->second;
+        }
+        llvm::Value* value = zero(types_.at(name));
+        values[name] = value;
+        return value;
+    }
+
+    llvm::Value* compare(Cmp cmp, llvm::Value* a, llvm::Value* b, DataType type) {
+        if (is_floating(type)) {
+            switch (cmp) {
+                case Cmp::LT: return b_.CreateFCmpOLT(a, b);
+                case Cmp::GT: return b_.CreateFCmpOGT(a, b);
+                case Cmp::GE: return b_.CreateFCmpOGE(a, b);
+                case Cmp::EQ: return b_.CreateFCmpOEQ(a, b);
+                case Cmp::NE: return b_.CreateFCmpUNE(a, b);
+            }
+        }
+        switch (cmp) {
+            case Cmp::LT: return b_.CreateICmpSLT(a, b);
+            case Cmp::GT: return b_.CreateICmpSGT(a, b);
+            case Cmp::GE: return b_.CreateICmpSGE(a, b);
+            case Cmp::EQ: return b_.CreateICmpEQ(a, b);
+            case Cmp::NE: return b_.CreateICmpNE(a, b);
+        }
+        return nullptr;
+    }
+
+    llvm::Value* arithmetic(IrOp op, llvm::Value* a, llvm::Value* b, DataType type) {
+        bool fp = is_floating(type);
+        switch (op) {
+            case IrOp::ADD: return fp ? b_.CreateFAdd(a, b) : b_.CreateAdd(a, b);
+            case IrOp::SUB: return fp ? b_.CreateFSub(a, b) : b_.CreateSub(a, b);
+            case IrOp::MUL: return fp ? b_.CreateFMul(a, b) : b_.CreateMul(a, b);
+            default: return fp ? b_.CreateFDiv(a, b) : b_.CreateSDiv(a, b);
+        }
+    }
+
+    void emit_steps(Values& values) {
+        for (const auto& step : config_.steps) {
+            const auto* info = find_ir_op(step.op_name);
+            const auto* meta = OperatorRegistry::instance().get_operator(step.op_name);
+
+            std::vector<llvm::Value*> args;
+            std::vector<DataType> arg_types;
+            for (const auto& arg : step.args) {
+                DataType type = arg_type(arg, types_);
+                arg_types.push_back(type);
+                if (arg.type == ArgType::VARIABLE) {
+                    args.push_back(read(values, arg.value));
+                } else {
+                    double number = 0.0;
+                    parse_number(arg, number);
+                    args.push_back(is_floating(type)
+                        ? llvm::ConstantFP::get(type_of(type), number)
+                        : llvm::ConstantInt::get(type_of(type),
+                              static_cast<uint64_t>(std::strtoll(arg.value.c_str(), nullptr, 10)), true));
+                    if (arg.value == "true") {
+                        args.back() = llvm::ConstantInt::get(type_of(type), 1);
+                    }
+                }
+            }
+
+            DataType result_type = DataType::DOUBLE;
+            llvm::Value* result = emit_op(info->op, meta->return_type, args, arg_types, result_type);
+            values[step.output_var] = convert(result, result_type, types_.at(step.output_var));
+        }
+    }
+
+    /**
+     * @param template_type 模板算子的显式模板参数（注册表中的返回类型）
+     */
+    llvm::Value* emit_op(IrOp op, DataType template_type, std::vector<llvm::Value*>& args,
+                         const std::vector<DataType>& arg_types, DataType& result_type) {
+        switch (op) {
+            case IrOp::ADD:
+            case IrOp::SUB:
+            case IrOp::MUL:
+            case IrOp::DIV:
+            case IrOp::MAX:
+            case IrOp::MIN: {
+                DataType t = template_type;
+                llvm::Value* a = convert(args[0], arg_types[0], t);
+                llvm::Value* b = convert(args[1], arg_types[1], t);
+                result_type = t;
+                if (op == IrOp::MAX) {
+                    return b_.CreateSelect(compare(Cmp::GT, a, b, t), a, b);
+                }
+                if (op == IrOp::MIN) {
+                    return b_.CreateSelect(compare(Cmp::LT, a, b, t), a, b);
+                }
+                if (op == IrOp::DIV) {
+                    // 整数除零不能推测执行，除数为零时先换成1
+                    llvm::Value* is_zero = compare(Cmp::EQ, b, zero(t), t);
+                    llvm::Value* divisor = is_floating(t) ? b
+                        : b_.CreateSelect(is_zero, llvm::ConstantInt::get(type_of(t), 1), b);
+                    return b_.CreateSelect(is_zero, zero(t), arithmetic(op, a, divisor, t));
+                }
+                return arithmetic(op, a, b, t);
+            }
+            case IrOp::ABS: {
+                DataType t = template_type;
+                llvm::Value* v = convert(args[0], arg_types[0], t);
+                llvm::Value* negated = is_floating(t) ? b_.CreateFNeg(v) : b_.CreateNeg(v);
+                result_type = t;
+                return b_.CreateSelect(compare(Cmp::GE, v, zero(t), t), v, negated);
+            }
+            case IrOp::SQUARE: {
+                DataType t = template_type;
+                llvm::Value* v = convert(args[0], arg_types[0], t);
+                result_type = t;
+                return arithmetic(IrOp::MUL, v, v, t);
+            }
+            case IrOp::SQRT: {
+                DataType t = template_type;
+                llvm::Value* v = convert(args[0], arg_types[0], t);
+                llvm::Value* as_double = convert(v, t, DataType::DOUBLE);
+                llvm::Value* root = b_.CreateUnaryIntrinsic(llvm::Intrinsic::sqrt, as_double);
+                result_type = DataType::DOUBLE;
+                return b_.CreateSelect(compare(Cmp::LT, v, zero(t), t), zero(DataType::DOUBLE), root);
+            }
+            case IrOp::FLOOR:
+            case IrOp::CEIL: {
+                llvm::Value* v = convert(args[0], arg_types[0], DataType::DOUBLE);
+                llvm::Value* rounded = b_.CreateUnaryIntrinsic(
+                    op == IrOp::FLOOR ? llvm::Intrinsic::floor : llvm::Intrinsic::ceil, v);
+                result_type = DataType::INT32;
+                return convert(rounded, DataType::DOUBLE, DataType::INT32);
+            }
+            case IrOp::TO_INT32:
+            case IrOp::TO_INT64:
+            case IrOp::TO_DOUBLE:
+                result_type = template_type;
+                return convert(args[0], arg_types[0], template_type);
+            case IrOp::GET_SIGN: {
+                DataType t = arg_types[0];
+                llvm::Value* v = args[0];
+                result_type = DataType::INT32;
+                llvm::Value* positive = b_.CreateSelect(compare(Cmp::GT, v, zero(t), t),
+                                                        b_.getInt32(1), b_.getInt32(0));
+                return b_.CreateSelect(compare(Cmp::LT, v, zero(t), t),
+                                       b_.getInt32(static_cast<uint32_t>(-1)), positive);
+            }
+            case IrOp::PRICE_DIFF: {
+                DataType t = arg_types[0];
+                result_type = t;
+                return b_.CreateSelect(compare(Cmp::EQ, args[0], zero(t), t), zero(t),
+                                       arithmetic(IrOp::SUB, args[0], args[1], t));
+            }
+            case IrOp::IF_ELSE: {
+                DataType t = arg_types[1];
+                result_type = t;
+                llvm::Value* condition = compare(Cmp::NE, args[0], zero(arg_types[0]), arg_types[0]);
+                return b_.CreateSelect(condition, args[1], args[2]);
+            }
+            case IrOp::PERCENT: {
+                DataType t = arg_types[0];
+                result_type = DataType::DOUBLE;
+                llvm::Value* part = convert(args[0], t, DataType::DOUBLE);
+                llvm::Value* total = convert(args[1], t, DataType::DOUBLE);
+                llvm::Value* ratio = b_.CreateFMul(b_.CreateFDiv(part, total),
+                                                   llvm::ConstantFP::get(b_.getDoubleTy(), 100.0));
+                return b_.CreateSelect(compare(Cmp::EQ, args[1], zero(t), t),
+                                       zero(DataType::DOUBLE), ratio);
+            }
+        }
+        result_type = DataType::DOUBLE;
+        return zero(DataType::DOUBLE);
+    }
+
+    const PipelineConfig& config_;
+    llvm::Module& module_;
+    llvm::LLVMContext& ctx_;
+    llvm::IRBuilder<> b_;
+    std::unordered_map<std::string, DataType> types_;
+};
+
+// ============================================
+// 进程内模块与后端
+// ============================================
+
+void initialize_llvm() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+    });
+}
+
+/**
+ * @brief 从CompileOptions::optimization中取优化级别（-O0 ~ -O3，默认-O2）
+ */
+int optimization_level(const CompileOptions& options) {
+    size_t pos = options.optimization.find("-O");
+    if (pos == std::string::npos || pos + 2 >= options.optimization.size()) {
+        return 2;
+    }
+    char level = options.optimization[pos + 2];
+    return level >= '0' && level <= '3' ? level - '0' : 2;
+}
+
+void optimize_module(llvm::Module& module, llvm::TargetMachine* target, int level) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+
+    llvm::PassBuilder builder(target);
+    builder.registerModuleAnalyses(mam);
+    builder.registerCGSCCAnalyses(cgam);
+    builder.registerFunctionAnalyses(fam);
+    builder.registerLoopAnalyses(lam);
+    builder.crossRegisterProxies(lam, fam, cgam, mam);
+
+    static const llvm::OptimizationLevel kLevels[] = {
+        llvm::OptimizationLevel::O0, llvm::OptimizationLevel::O1,
+        llvm::OptimizationLevel::O2, llvm::OptimizationLevel::O3
+    };
+    llvm::ModulePassManager passes = level == 0
+        ? builder.buildO0DefaultPipeline(kLevels[0])
+        : builder.buildPerModuleDefaultPipeline(kLevels[level]);
+    passes.run(module, mam);
+}
+
+/**
+ * @brief ORC JIT编译的模块，代码位于本进程的可执行内存
+ * 布局描述符由宿主按compute_abi_layout构造，与生成SO导出的内容相同
+ */
+class OrcModule : public CompiledModule {
+public:
+    OrcModule(std::unique_ptr<llvm::orc::LLJIT> jit, const PipelineConfig& config)
+        : jit_(std::move(jit)),
+          abi_name_("pipeline_abi_" + make_valid_identifier(config.fingerprint)) {
+        AbiStructLayout in_layout = compute_abi_layout(config.inputs, true);
+        AbiStructLayout out_layout = compute_abi_layout(config.outputs, false);
+
+        // 先填满名称表，AbiField中的指针才保持稳定
+        for (const auto* layout : {&in_layout, &out_layout}) {
+            for (const auto& field : layout->fields) {
+                names_.push_back(field.name);
+            }
+        }
+        size_t index = 0;
+        for (const auto& field : in_layout.fields) {
+            inputs_.push_back({names_[index++].c_str(), static_cast<uint32_t>(field.type),
+                               static_cast<uint32_t>(field.offset), static_cast<uint32_t>(field.size)});
+        }
+        for (const auto& field : out_layout.fields) {
+            outputs_.push_back({names_[index++].c_str(), static_cast<uint32_t>(field.type),
+                                static_cast<uint32_t>(field.offset), static_cast<uint32_t>(field.size)});
+        }
+
+        abi_.version = kAbiVersion;
+        abi_.input_size = static_cast<uint32_t>(in_layout.size);
+        abi_.input_align = static_cast<uint32_t>(in_layout.alignment);
+        abi_.num_inputs = static_cast<uint32_t>(inputs_.size());
+        abi_.inputs = inputs_.empty() ? nullptr : inputs_.data();
+        abi_.output_size = static_cast<uint32_t>(out_layout.size);
+        abi_.output_align = static_cast<uint32_t>(out_layout.alignment);
+        abi_.num_outputs = static_cast<uint32_t>(outputs_.size());
+        abi_.outputs = outputs_.empty() ? nullptr : outputs_.data();
+    }
+
+    void* symbol(const std::string& name) const override {
+        if (name == abi_name_) {
+            return const_cast<AbiLayout*>(&abi_);
+        }
+        auto sym = jit_->lookup(name);
+        if (!sym) {
+            llvm::consumeError(sym.takeError());
+            return nullptr;
+        }
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(sym->getAddress()));
+    }
+
+    const char* backend() const override { return "llvm-orc"; }
+
+private:
+    std::unique_ptr<llvm::orc::LLJIT> jit_;
+    std::string abi_name_;
+    std::vector<std::string> names_;
+    std::vector<AbiField> inputs_;
+    std::vector<AbiField> outputs_;
+    AbiLayout abi_{};
+};
+
+class OrcBackend : public ICompilerBackend {
+public:
+    OrcBackend() { initialize_llvm(); }
+
+    const char* name() const override { return "llvm-orc"; }
+
+    bool supports(const PipelineConfig& config) const override {
+        return unsupported_reason(config).empty();
+    }
+
+    std::unique_ptr<CompiledModule> load(const PipelineConfig& config,
+                                         const CodeGenOptions& gen_options,
+                                         const CompileOptions& comp_options,
+                                         bool /*rebuild*/) override {
+        PipelineConfig keyed = config;
+        if (keyed.fingerprint.empty()) {
+            keyed.compute_fingerprint();
+        }
+        std::string reason = unsupported_reason(keyed);
+        if (!reason.empty()) {
+            std::cerr << "In-process backend cannot compile " << keyed.name << ": " << reason << std::endl;
+            return nullptr;
+        }
+
+        std::string ns_name = make_valid_identifier(keyed.fingerprint);
+        int level = optimization_level(comp_options);
+
+        // 目标机器取本机CPU与特性，相当于-march=native
+        auto target_builder = llvm::orc::JITTargetMachineBuilder::detectHost();
+        if (!target_builder) {
+            return fail("detect host", target_builder.takeError());
+        }
+        static const llvm::CodeGenOpt::Level kCodeGenLevels[] = {
+            llvm::CodeGenOpt::None, llvm::CodeGenOpt::Less,
+            llvm::CodeGenOpt::Default, llvm::CodeGenOpt::Aggressive
+        };
+        target_builder->setCodeGenOptLevel(kCodeGenLevels[level]);
+        auto target = target_builder->createTargetMachine();
+        if (!target) {
+            return fail("create target machine", target.takeError());
+        }
+
+        auto context = std::make_unique<llvm::LLVMContext>();
+        auto module = std::make_unique<llvm::Module>("pipeline_" + ns_name, *context);
+        module->setDataLayout((*target)->createDataLayout());
+        module->setTargetTriple((*target)->getTargetTriple().str());
+
+        // 与g++后端一致：生成前做数据流优化
+        PipelineConfig lowered = gen_options.optimize ? PipelineOptimizer::optimize(keyed) : keyed;
+        IrLowering lowering(lowered, *module);
+        lowering.emit_execute("pipeline_execute_" + ns_name);
+        lowering.emit_batch("pipeline_execute_batch_" + ns_name);
+
+        std::string verify_message;
+        llvm::raw_string_ostream verify_stream(verify_message);
+        if (llvm::verifyModule(*module, &verify_stream)) {
+            std::cerr << "Invalid IR for pipeline " << keyed.name << ": " << verify_stream.str() << std::endl;
+            return nullptr;
+        }
+        optimize_module(*module, target->get(), level);
+
+        if (comp_options.verbose) {
+            std::cout << "Compiling in-process (llvm-orc, -O" << level << "): " << keyed.name << std::endl;
+        }
+
+        auto jit = llvm::orc::LLJITBuilder()
+            .setJITTargetMachineBuilder(std::move(*target_builder))
+            .create();
+        if (!jit) {
+            return fail("create LLJIT", jit.takeError());
+        }
+
+        // 未内联的libm调用（如floor）从宿主进程解析
+        auto host_symbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+            (*jit)->getDataLayout().getGlobalPrefix());
+        if (!host_symbols) {
+            return fail("resolve host symbols", host_symbols.takeError());
+        }
+        (*jit)->getMainJITDylib().addGenerator(std::move(*host_symbols));
+
+        if (auto err = (*jit)->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+            return fail("add module", std::move(err));
+        }
+
+        // 查找入口时完成机器码生成，编译错误在这里暴露而不是首次执行时
+        auto entry = (*jit)->lookup("pipeline_execute_" + ns_name);
+        if (!entry) {
+            return fail("materialize", entry.takeError());
+        }
+
+        return std::make_unique<OrcModule>(std::move(*jit), keyed);
+    }
+
+private:
+    static std::unique_ptr<CompiledModule> fail(const char* stage, llvm::Error err) {
+        std::cerr << "In-process backend failed to " << stage << ": "
+                  << llvm::toString(std::move(err)) << std::endl;
+        return nullptr;
+    }
+};
+
+} // namespace
+
+bool inprocess_backend_available() {
+    return true;
+}
+
+std::shared_ptr<ICompilerBackend> make_inprocess_backend() {
+    return std::make_shared<OrcBackend>();
+}
+
+} // namespace turbograph
+
+#else // !TURBOGRAPH_WITH_LLVM
+
+namespace turbograph {
+
+bool inprocess_backend_available() {
+    return false;
+}
+
+std::shared_ptr<ICompilerBackend> make_inprocess_backend() {
+    return nullptr;
+}
+
+} // namespace turbograph
+
+#endif // TURBOGRAPH_WITH_LLVM
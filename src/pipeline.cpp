@@ -1,13 +1,24 @@
 #include "pipeline.hpp"
 #include "code_generator.hpp"
 #include "compiler.hpp"
+#include "compiler_backend.hpp"
 #include "loader.hpp"
+#include "optimizer.hpp"
+#include "epoch.hpp"
+#include "registry.hpp"
+#include "result_cache.hpp"
+#include "stats.hpp"
 #include "ops.hpp"
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
-#include <dlfcn.h>
 #include <cctype>
+#include <type_traits>
+#include <cstring>
+#include <condition_variable>
 
 namespace turbograph {
 
@@ -31,126 +42,644 @@ static std::string make_valid_identifier(const std::string& str) {
     return result;
 }
 
+// ============================================
+// 辅助函数：列式批次与执行上下文之间的转换
+// ============================================
+
+template<typename T>
+struct TypeTag {
+    using type = T;
+};
+
+/**
+ * @brief 按DataType分派到对应的C++类型
+ */
+template<typename F>
+static bool visit_data_type(DataType type, F&& f) {
+    switch (type) {
+        case DataType::INT32: f(TypeTag<int32_t>{}); return true;
+        case DataType::INT64: f(TypeTag<int64_t>{}); return true;
+        case DataType::DOUBLE: f(TypeTag<double>{}); return true;
+        case DataType::FLOAT: f(TypeTag<float>{}); return true;
+        case DataType::STRING: f(TypeTag<std::string>{}); return true;
+        case DataType::INT32_LIST: f(TypeTag<std::vector<int32_t>>{}); return true;
+        case DataType::INT64_LIST: f(TypeTag<std::vector<int64_t>>{}); return true;
+        case DataType::DOUBLE_LIST: f(TypeTag<std::vector<double>>{}); return true;
+        case DataType::STRING_LIST: f(TypeTag<std::vector<std::string>>{}); return true;
+        default: return false;
+    }
+}
+
+template<typename T>
+static T variant_as(const ValueVariant& value) {
+    return std::visit([](const auto& v) -> T {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<V>) {
+            return static_cast<T>(v);
+        } else if constexpr (std::is_same_v<T, V>) {
+            return v;
+        } else {
+            return T{};
+        }
+    }, value);
+}
+
+/**
+ * @brief 读取IO字段：slots非空时按槽位访问，否则按名称查找
+ */
+static const ValueVariant* read_field(const ExecutionContext& ctx, const PipelineConfig::IOField& field,
+                                      const size_t* slots, size_t index) {
+    if (slots) {
+        return ctx.has_slot(slots[index]) ? &ctx.slot_ref(slots[index]) : nullptr;
+    }
+    return ctx.find(field.name);
+}
+
+template<typename T>
+static void write_field(ExecutionContext& ctx, const PipelineConfig::IOField& field,
+                        const size_t* slots, size_t index, const T& value) {
+    if (slots) {
+        ctx.set_slot(slots[index], value);
+    } else {
+        ctx.set_variable(field.name, field.type, value);
+    }
+}
+
+/**
+ * @brief 获取IO字段的可写存储
+ */
+static ValueVariant& field_ref(ExecutionContext& ctx, const PipelineConfig::IOField& field,
+                               const size_t* slots, size_t index) {
+    if (slots) {
+        ctx.mark_slot(slots[index]);
+        return ctx.slot_ref(slots[index]);
+    }
+    auto& var = ctx.variables[field.name];
+    var.name = field.name;
+    var.type = field.type;
+    return var.value;
+}
+
+/**
+ * @brief 将批次中第row行的输入写入上下文
+ */
+static void load_batch_row(const PipelineConfig& config, const ColumnBatch& input,
+                           size_t row, ExecutionContext& ctx, const size_t* slots) {
+    for (size_t i = 0; i < config.inputs.size(); i++) {
+        const auto& field = config.inputs[i];
+        const void* column = input.columns[i];
+        size_t index = field.broadcast ? 0 : row;
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            write_field(ctx, field, slots, i, static_cast<const T*>(column)[index]);
+        });
+    }
+}
+
+/**
+ * @brief 将偏移编码批次中第row行的输入写入上下文（复用槽位中已有对象的存储）
+ */
+static void load_offset_row(const PipelineConfig& config, const OffsetBatch& input,
+                            size_t row, ExecutionContext& ctx, const size_t* slots) {
+    for (size_t i = 0; i < config.inputs.size(); i++) {
+        const auto& field = config.inputs[i];
+        const OffsetColumn& column = input.columns[i];
+        size_t index = field.broadcast ? 0 : row;
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (std::is_arithmetic_v<T>) {
+                write_field(ctx, field, slots, i, static_cast<const T*>(column.values)[index]);
+            } else {
+                ValueVariant& storage = field_ref(ctx, field, slots, i);
+                T* value = std::get_if<T>(&storage);
+                if (!value) {
+                    value = &storage.template emplace<T>();
+                }
+                const int32_t begin = column.offsets[index];
+                const int32_t end = column.offsets[index + 1];
+                if constexpr (std::is_same_v<T, std::string>) {
+                    value->assign(static_cast<const char*>(column.values) + begin, end - begin);
+                } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+                    const char* chars = static_cast<const char*>(column.values);
+                    value->resize(end - begin);
+                    for (int32_t k = begin; k < end; k++) {
+                        (*value)[k - begin].assign(chars + column.value_offsets[k],
+                                                   column.value_offsets[k + 1] - column.value_offsets[k]);
+                    }
+                } else {
+                    const auto* items = static_cast<const typename T::value_type*>(column.values);
+                    value->assign(items + begin, items + end);
+                }
+            }
+        });
+    }
+}
+
+/**
+ * @brief 将上下文中的输出写入批次第row行
+ */
+static void store_batch_row(const PipelineConfig& config, const ExecutionContext& ctx,
+                            OutputBatch& output, size_t row, const size_t* slots,
+                            const OutputMask* mask = nullptr) {
+    for (size_t i = 0; i < config.outputs.size(); i++) {
+        if (mask && !mask->test(i)) {
+            continue;
+        }
+        const auto& field = config.outputs[i];
+        void* column = output.columns[i];
+        const ValueVariant* value = read_field(ctx, field, slots, i);
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            static_cast<T*>(column)[row] = value ? variant_as<T>(*value) : T{};
+        });
+    }
+}
+
+/**
+ * @brief 按布局描述符将上下文输入填充到PipelineInput结构
+ */
+static void marshal_inputs(const PipelineConfig& config, const AbiLayout& abi,
+                           const ExecutionContext& ctx, const size_t* slots, unsigned char* buffer) {
+    for (size_t i = 0; i < config.inputs.size(); i++) {
+        const auto& field = config.inputs[i];
+        unsigned char* dst = buffer + abi.inputs[i].offset;
+        const ValueVariant* value = read_field(ctx, field, slots, i);
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (std::is_arithmetic_v<T>) {
+                T v = value ? variant_as<T>(*value) : T{};
+                std::memcpy(dst, &v, sizeof(T));
+            } else {
+                // 非标量输入传视图，生成代码直接读取上下文中的元素；缺失时为空视图
+                const T* ptr = value ? std::get_if<T>(value) : nullptr;
+                ListView<typename T::value_type> view;
+                if (ptr) view = {ptr->data(), ptr->size()};
+                std::memcpy(dst, &view, sizeof(view));
+            }
+        });
+    }
+}
+
+/**
+ * @brief 为非标量输出准备目标对象，并将其地址写入PipelineOutput结构
+ */
+static void bind_outputs(const PipelineConfig& config, const AbiLayout& abi,
+                         ExecutionContext& ctx, const size_t* slots, unsigned char* buffer) {
+    for (size_t i = 0; i < config.outputs.size(); i++) {
+        const auto& field = config.outputs[i];
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (!std::is_arithmetic_v<T>) {
+                ValueVariant& value = field_ref(ctx, field, slots, i);
+                if (!std::holds_alternative<T>(value)) {
+                    value.template emplace<T>();
+                }
+                T* ptr = &std::get<T>(value);
+                std::memcpy(buffer + abi.outputs[i].offset, &ptr, sizeof(ptr));
+            }
+        });
+    }
+}
+
+/**
+ * @brief 将PipelineOutput结构中的标量输出写回上下文
+ */
+static void unmarshal_outputs(const PipelineConfig& config, const AbiLayout& abi,
+                              const unsigned char* buffer, ExecutionContext& ctx, const size_t* slots) {
+    for (size_t i = 0; i < config.outputs.size(); i++) {
+        const auto& field = config.outputs[i];
+        visit_data_type(field.type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (std::is_arithmetic_v<T>) {
+                T value;
+                std::memcpy(&value, buffer + abi.outputs[i].offset, sizeof(T));
+                write_field(ctx, field, slots, i, value);
+            }
+        });
+    }
+}
+
+/**
+ * @brief 校验SO导出的布局描述符与配置一致
+ */
+static bool validate_abi(const PipelineConfig& config, const AbiLayout& abi) {
+    if (abi.version != kAbiVersion) {
+        std::cerr << "ABI version mismatch: " << abi.version << " != " << kAbiVersion << std::endl;
+        return false;
+    }
+    auto check_fields = [](const std::vector<PipelineConfig::IOField>& fields,
+                           const AbiField* abi_fields, uint32_t count) {
+        if (fields.size() != count) return false;
+        for (size_t i = 0; i < fields.size(); i++) {
+            if (fields[i].name != abi_fields[i].name ||
+                static_cast<uint32_t>(fields[i].type) != abi_fields[i].type) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!check_fields(config.inputs, abi.inputs, abi.num_inputs) ||
+        !check_fields(config.outputs, abi.outputs, abi.num_outputs)) {
+        std::cerr << "ABI layout does not match config: " << config.name << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 逐行执行批次（无批量入口时的通用实现）
+ */
+static bool execute_batch_by_row(IPipelineExecutor& executor, const PipelineConfig& config,
+                                 const IOSlots& io_slots,
+                                 const ColumnBatch& input, OutputBatch& output, size_t n) {
+    if (input.num_columns < config.inputs.size() || output.num_columns < config.outputs.size()) {
+        std::cerr << "Batch column count mismatch for pipeline: " << config.name << std::endl;
+        return false;
+    }
+    
+    // 每个线程一个绑定布局的临时上下文，跨批次复用（上下文持有布局，比较地址不会误判）
+    thread_local ExecutionContext scratch;
+    if (scratch.layout() != executor.context_layout().get()) {
+        scratch = executor.create_context();
+    }
+    ExecutionContext& ctx = scratch;
+    for (size_t row = 0; row < n; row++) {
+        ctx.reset();
+        load_batch_row(config, input, row, ctx, io_slots.inputs.data());
+        if (!executor.execute(ctx)) {
+            return false;
+        }
+        store_batch_row(config, ctx, output, row, io_slots.outputs.data());
+    }
+    return true;
+}
+
+/**
+ * @brief 按生成代码导出的布局打包上下文并调用单行入口
+ * @param slots 上下文绑定执行器布局时为IO槽位，否则为nullptr（按名称查找）
+ */
+static bool execute_marshalled(const PipelineConfig& config, const AbiLayout& abi,
+                               bool (*execute)(void*, void*), ExecutionContext& context,
+                               const IOSlots* slots) {
+    // 按SO导出的布局直接填充输入输出结构（线程局部缓冲区，稳态无分配）
+    static thread_local std::vector<uint64_t> scratch;
+    size_t input_words = (abi.input_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    size_t output_words = (abi.output_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    if (scratch.size() < input_words + output_words) {
+        scratch.resize(input_words + output_words);
+    }
+    auto* input_data = reinterpret_cast<unsigned char*>(scratch.data());
+    auto* output_data = reinterpret_cast<unsigned char*>(scratch.data() + input_words);
+    std::memset(output_data, 0, output_words * sizeof(uint64_t));
+    
+    const size_t* input_slots = slots ? slots->inputs.data() : nullptr;
+    const size_t* output_slots = slots ? slots->outputs.data() : nullptr;
+    marshal_inputs(config, abi, context, input_slots, input_data);
+    bind_outputs(config, abi, context, output_slots, output_data);
+    
+    // 调用生成的函数
+    bool result = execute(input_data, output_data);
+    
+    // 将标量结果写回上下文（非标量输出已直接写入上下文）
+    if (result) {
+        unmarshal_outputs(config, abi, output_data, context, output_slots);
+    }
+    return result;
+}
+
+/**
+ * @brief 偏移编码批次的逐行执行（没有对应入口的执行器使用）
+ */
+static bool execute_offsets_by_row(IPipelineExecutor& executor, const PipelineConfig& config,
+                                   const IOSlots& io_slots,
+                                   const OffsetBatch& input, OutputBatch& output, size_t n) {
+    if (input.num_columns < config.inputs.size() || output.num_columns < config.outputs.size()) {
+        std::cerr << "Batch column count mismatch for pipeline: " << config.name << std::endl;
+        return false;
+    }
+    
+    thread_local ExecutionContext scratch;
+    if (scratch.layout() != executor.context_layout().get()) {
+        scratch = executor.create_context();
+    }
+    ExecutionContext& ctx = scratch;
+    for (size_t row = 0; row < n; row++) {
+        ctx.reset();
+        load_offset_row(config, input, row, ctx, io_slots.inputs.data());
+        if (!executor.execute(ctx)) {
+            return false;
+        }
+        store_batch_row(config, ctx, output, row, io_slots.outputs.data());
+    }
+    return true;
+}
+
+/**
+ * @brief 输出掩码的公共处理：掩码大小不符时失败；未请求任何输出时不执行；
+ * 请求全部输出时走完整的批量入口
+ * @return 已处理时返回true，结果写入result
+ */
+static bool run_trivial_mask(IPipelineExecutor& executor, const PipelineConfig& config,
+                             const ColumnBatch& input, OutputBatch& output, size_t n,
+                             const OutputMask& mask, bool& result) {
+    if (mask.size() != config.outputs.size()) {
+        std::cerr << "Output mask size mismatch for pipeline: " << config.name << std::endl;
+        result = false;
+        return true;
+    }
+    if (mask.none()) {
+        result = true;
+        return true;
+    }
+    if (mask.all()) {
+        result = executor.execute_batch(input, output, n);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 逐行执行批次，只写入请求的输出（没有掩码入口的执行器使用）
+ * @param run 执行一行，默认执行全部步骤
+ */
+template<typename Run>
+static bool execute_masked_by_row(IPipelineExecutor& executor, const PipelineConfig& config,
+                                  const IOSlots& io_slots, const ColumnBatch& input, OutputBatch& output,
+                                  size_t n, const OutputMask& mask, Run&& run) {
+    if (input.num_columns < config.inputs.size() || output.num_columns < config.outputs.size()) {
+        std::cerr << "Batch column count mismatch for pipeline: " << config.name << std::endl;
+        return false;
+    }
+    
+    thread_local ExecutionContext scratch;
+    if (scratch.layout() != executor.context_layout().get()) {
+        scratch = executor.create_context();
+    }
+    ExecutionContext& ctx = scratch;
+    for (size_t row = 0; row < n; row++) {
+        ctx.reset();
+        load_batch_row(config, input, row, ctx, io_slots.inputs.data());
+        if (!run(ctx)) {
+            return false;
+        }
+        store_batch_row(config, ctx, output, row, io_slots.outputs.data(), &mask);
+    }
+    return true;
+}
+
+static bool execute_masked_by_row(IPipelineExecutor& executor, const PipelineConfig& config,
+                                  const IOSlots& io_slots, const ColumnBatch& input, OutputBatch& output,
+                                  size_t n, const OutputMask& mask) {
+    return execute_masked_by_row(executor, config, io_slots, input, output, n, mask,
+                                 [&](ExecutionContext& ctx) { return executor.execute(ctx); });
+}
+
+IOSlots IOSlots::resolve(const PipelineConfig& config, const ContextLayout& layout) {
+    IOSlots slots;
+    for (const auto& input : config.inputs) {
+        slots.inputs.push_back(layout.slot_of(input.name));
+    }
+    for (const auto& output : config.outputs) {
+        slots.outputs.push_back(layout.slot_of(output.name));
+    }
+    return slots;
+}
+
 // ============================================
 // 解释执行器实现
 // ============================================
 
 InterpreterExecutor::InterpreterExecutor(const PipelineConfig& config)
     : config_(config) {
+    layout_ = make_context_layout(config_);
+    io_slots_ = IOSlots::resolve(config_, *layout_);
+    
+    // 预先解析每个步骤的参数和输出槽位
+    for (const auto& step : config_.steps) {
+        StepSlots slots;
+        slots.output = layout_->slot_of(step.output_var);
+        for (const auto& arg : step.args) {
+            slots.args.push_back(arg.type == ArgType::VARIABLE ? layout_->slot_of(arg.value)
+                                                               : ContextLayout::npos);
+        }
+        step_slots_.push_back(std::move(slots));
+    }
+    graph_ = DataflowGraph::build(config_);
 }
 
 bool InterpreterExecutor::execute(ExecutionContext& context) {
-    for (const auto& step : config_.steps) {
-        if (!execute_op(step, context)) {
+    // 上下文绑定同一布局时按槽位访问
+    const bool bound = context.layout() == layout_.get();
+    for (size_t i = 0; i < config_.steps.size(); i++) {
+        if (!execute_op(config_.steps[i], bound ? &step_slots_[i] : nullptr, context)) {
             return false;
         }
     }
     return true;
 }
 
-bool InterpreterExecutor::execute_op(const OpCall& op, ExecutionContext& ctx) {
+bool InterpreterExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    return execute_batch_by_row(*this, config_, io_slots_, input, output, n);
+}
+
+bool InterpreterExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    return execute_offsets_by_row(*this, config_, io_slots_, input, output, n);
+}
+
+bool InterpreterExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                               const OutputMask& mask) {
+    bool result = false;
+    if (run_trivial_mask(*this, config_, input, output, n, mask, result)) {
+        return result;
+    }
+    
+    // 只执行请求的输出依赖的步骤
+    std::vector<bool> requested(config_.outputs.size());
+    for (size_t j = 0; j < requested.size(); j++) {
+        requested[j] = mask.test(j);
+    }
+    std::vector<bool> live = graph_.live_steps(requested);
+    return execute_masked_by_row(*this, config_, io_slots_, input, output, n, mask, [&](ExecutionContext& ctx) {
+        for (size_t i = 0; i < config_.steps.size(); i++) {
+            if (live[i] && !execute_op(config_.steps[i], &step_slots_[i], ctx)) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void InterpreterExecutor::set_output(ExecutionContext& ctx, const StepSlots* slots, const OpCall& op,
+                                     DataType type, const ValueVariant& value) {
+    if (slots) {
+        ctx.set_slot(slots->output, value);
+    } else {
+        ctx.set_variable(op.output_var, type, value);
+    }
+}
+
+/**
+ * @brief 解释执行器的数值参数（整数与浮点统一转换为double，非数值为0）
+ */
+static double as_number(const ValueVariant& value) {
+    return variant_as<double>(value);
+}
+
+/**
+ * @brief 列表参数，类型不符时返回nullptr
+ */
+template<typename T>
+static const std::vector<T>* as_list(const ValueVariant& value) {
+    return std::get_if<std::vector<T>>(&value);
+}
+
+/**
+ * @brief 列表包含/计数：查找值转换为列表元素类型后比较（与字节码一致）
+ */
+static int interpret_cross(const ValueVariant& list, const ValueVariant& item, bool count) {
+    return std::visit([&](const auto& v) -> int {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::vector<std::string>>) {
+            const auto* s = std::get_if<std::string>(&item);
+            if (!s) return 0;
+            return count ? ops::catein_list_cross_count(v, *s) : ops::catein_list_cross(v, *s);
+        } else if constexpr (!std::is_arithmetic_v<V> && !std::is_same_v<V, std::string>) {
+            using E = typename V::value_type;
+            E key = variant_as<E>(item);
+            return count ? ops::catein_list_cross_count(v, key) : ops::catein_list_cross(v, key);
+        } else {
+            return 0;
+        }
+    }, list);
+}
+
+bool InterpreterExecutor::execute_op(const OpCall& op, const StepSlots* slots, ExecutionContext& ctx) {
     // 获取参数值
     std::vector<ValueVariant> args;
-    for (const auto& arg : op.args) {
-        args.push_back(get_arg_value(arg, ctx));
+    for (size_t i = 0; i < op.args.size(); i++) {
+        args.push_back(get_arg_value(op.args[i], slots ? slots->args[i] : ContextLayout::npos, ctx));
     }
+    auto number = [&args](size_t i) { return args.size() > i ? as_number(args[i]) : 0.0; };
     
-    // 执行算子（这里简化处理，实际需要更复杂的分派逻辑）
+    // 执行算子：逐个比较算子名，计算委托给ops中的实现（与JIT/字节码语义一致）
     try {
         if (op.op_name == "add") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, a + b);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::add_op(number(0), number(1)));
         }
         else if (op.op_name == "sub") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, a - b);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::sub_op(number(0), number(1)));
         }
         else if (op.op_name == "mul") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, a * b);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::mul_op(number(0), number(1)));
         }
         else if (op.op_name == "div") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            double result = (b != 0) ? (a / b) : 0.0;
-            ctx.set_variable(op.output_var, DataType::DOUBLE, result);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::div_op(number(0), number(1)));
         }
         else if (op.op_name == "get_sign") {
-            double a = std::get<double>(args[0]);
-            int sign = (a > 0) ? 1 : ((a < 0) ? -1 : 0);
-            ctx.set_variable(op.output_var, DataType::INT32, sign);
+            set_output(ctx, slots, op, DataType::INT32, ops::get_sign(number(0)));
         }
         else if (op.op_name == "abs") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, std::abs(a));
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::abs_op(number(0)));
         }
         else if (op.op_name == "sqrt") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, std::sqrt(std::abs(a)));
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::sqrt_op(number(0)));
         }
         else if (op.op_name == "if_else") {
-            int32_t cond = std::get<int32_t>(args[0]);
-            double true_val = std::get<double>(args[1]);
-            double false_val = std::get<double>(args[2]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, cond ? true_val : false_val);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::if_else(number(0) != 0.0, number(1), number(2)));
         }
         else if (op.op_name == "max") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, std::max(a, b));
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::max_op(number(0), number(1)));
         }
         else if (op.op_name == "min") {
-            double a = std::get<double>(args[0]);
-            double b = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, std::min(a, b));
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::min_op(number(0), number(1)));
         }
         else if (op.op_name == "square") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, a * a);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::square_op(number(0)));
         }
         else if (op.op_name == "percent") {
-            double part = std::get<double>(args[0]);
-            double total = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, 
-                            total != 0 ? (part / total * 100.0) : 0.0);
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::percent_op(number(0), number(1)));
         }
         else if (op.op_name == "floor") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::INT32, 
-                            static_cast<int32_t>(std::floor(a)));
+            set_output(ctx, slots, op, DataType::INT32, ops::floor_op<double>(number(0)));
+        }
+        else if (op.op_name == "ceil") {
+            set_output(ctx, slots, op, DataType::INT32, ops::ceil_op<double>(number(0)));
         }
         else if (op.op_name == "direct_output_int32") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::INT32,
-                            static_cast<int32_t>(a));
+            // 整数按整数转换，避免int64经double丢失精度
+            set_output(ctx, slots, op, DataType::INT32, variant_as<int32_t>(args.at(0)));
         }
         else if (op.op_name == "direct_output_int64") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::INT64,
-                            static_cast<int64_t>(a));
+            set_output(ctx, slots, op, DataType::INT64, variant_as<int64_t>(args.at(0)));
         }
         else if (op.op_name == "direct_output_double") {
-            double a = std::get<double>(args[0]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE, a);
+            set_output(ctx, slots, op, DataType::DOUBLE, number(0));
+        }
+        else if (op.op_name == "direct_output_string") {
+            // 数值按参数的实际类型格式化，字符串原样输出
+            std::string text = std::visit([](const auto& v) -> std::string {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_arithmetic_v<V> || std::is_same_v<V, std::string>) {
+                    return ops::direct_output_string(v);
+                } else {
+                    return std::string();
+                }
+            }, args.at(0));
+            set_output(ctx, slots, op, DataType::STRING, std::move(text));
         }
         else if (op.op_name == "price_diff") {
-            double discount = std::get<double>(args[0]);
-            double original = std::get<double>(args[1]);
-            ctx.set_variable(op.output_var, DataType::DOUBLE,
-                            (discount == 0) ? 0.0 : (discount - original));
+            set_output(ctx, slots, op, DataType::DOUBLE, ops::price_diff(number(0), number(1)));
         }
         else if (op.op_name == "avg_avg_log") {
-            double origin = std::get<double>(args[0]);
-            int32_t inter1 = args.size() > 1 ? std::get<int32_t>(args[1]) : 1000;
-            int32_t threshold1 = args.size() > 2 ? std::get<int32_t>(args[2]) : 15000;
-            int32_t inter2 = args.size() > 3 ? std::get<int32_t>(args[3]) : 5000;
-            int32_t threshold2 = args.size() > 4 ? std::get<int32_t>(args[4]) : 250000;
-            
-            int64_t result = ops::avg_avg_log(origin, inter1, threshold1, inter2, threshold2);
-            ctx.set_variable(op.output_var, DataType::INT64, result);
+            // 分桶参数截断为整数，缺省值与ops::avg_avg_log一致
+            auto param = [&](size_t i, int32_t fallback) {
+                return args.size() > i ? static_cast<int32_t>(number(i)) : fallback;
+            };
+            int64_t result = ops::avg_avg_log(number(0), param(1, 1000), param(2, 15000),
+                                              param(3, 5000), param(4, 250000));
+            set_output(ctx, slots, op, DataType::INT64, result);
+        }
+        else if (op.op_name == "len") {
+            int64_t length = std::visit([](const auto& v) -> int64_t {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_arithmetic_v<V>) {
+                    return 0;
+                } else {
+                    return static_cast<int64_t>(ops::len(v));
+                }
+            }, args.at(0));
+            set_output(ctx, slots, op, DataType::INT64, length);
+        }
+        else if (op.op_name == "list_to_string") {
+            const auto* delim = args.size() > 1 ? std::get_if<std::string>(&args[1]) : nullptr;
+            std::string_view delimiter = delim ? std::string_view(*delim) : std::string_view("|");
+            std::string text = std::visit([&](const auto& v) -> std::string {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (!std::is_arithmetic_v<V> && !std::is_same_v<V, std::string>) {
+                    return ops::list_to_string(v, delimiter);
+                } else {
+                    return std::string();
+                }
+            }, args.at(0));
+            set_output(ctx, slots, op, DataType::STRING, std::move(text));
+        }
+        else if (op.op_name == "catein_list_cross" || op.op_name == "catein_set_cross") {
+            set_output(ctx, slots, op, DataType::INT32, interpret_cross(args.at(0), args.at(1), false));
+        }
+        else if (op.op_name == "catein_list_cross_count" || op.op_name == "catein_set_cross_count") {
+            set_output(ctx, slots, op, DataType::INT32, interpret_cross(args.at(0), args.at(1), true));
+        }
+        else if (op.op_name == "moving_average") {
+            const auto* history = as_list<double>(args.at(0));
+            if (!history) throw std::runtime_error("expected double_list");
+            set_output(ctx, slots, op, DataType::DOUBLE,
+                       ops::moving_average(*history, static_cast<int32_t>(number(1))));
+        }
+        else if (op.op_name == "vector_sum" || op.op_name == "vector_avg") {
+            const auto* vec = as_list<double>(args.at(0));
+            if (!vec) throw std::runtime_error("expected double_list");
+            set_output(ctx, slots, op, DataType::DOUBLE,
+                       op.op_name == "vector_sum" ? ops::vector_sum(*vec) : ops::vector_avg(*vec));
         }
         else {
             std::cerr << "Unknown operator: " << op.op_name << std::endl;
@@ -165,250 +694,770 @@ bool InterpreterExecutor::execute_op(const OpCall& op, ExecutionContext& ctx) {
     return true;
 }
 
-ValueVariant InterpreterExecutor::get_arg_value(const Arg& arg, const ExecutionContext& ctx) {
+ValueVariant InterpreterExecutor::get_arg_value(const Arg& arg, size_t slot, const ExecutionContext& ctx) {
     if (arg.type == ArgType::VARIABLE) {
-        // 从上下文获取变量值，尝试多种类型
-        if (ctx.has_variable(arg.value)) {
-            try {
-                return ctx.get<double>(arg.value);
-            } catch (...) {
-                // 不是double，尝试int32_t
-            }
-            try {
-                return static_cast<double>(ctx.get<int32_t>(arg.value));
-            } catch (...) {
-                // 不是int32_t，尝试int64_t
-            }
-            try {
-                return static_cast<double>(ctx.get<int64_t>(arg.value));
-            } catch (...) {}
-        }
-        // 如果是输入变量，可能不在上下文中
+        // 按槽位或名称读取，缺失的变量按0处理
+        const ValueVariant* value = slot != ContextLayout::npos
+            ? (ctx.has_slot(slot) ? &ctx.slot_ref(slot) : nullptr)
+            : ctx.find(arg.value);
+        return value ? *value : ValueVariant(0.0);
+    }
+    if (arg.data_type == DataType::STRING) {
+        return arg.string_value();
+    }
+    // 数值字面量，无法解析时为0
+    try {
+        return std::stod(arg.value);
+    } catch (...) {
         return 0.0;
-    } else {
-        // 字面量 - 尝试解析为数字
-        try {
-            return std::stod(arg.value);
-        } catch (...) {
-            // 不是数字，返回0
-            return 0.0;
+    }
+}
+
+// ============================================
+// 字节码解释执行器实现
+// ============================================
+
+BytecodeExecutor::BytecodeExecutor(const PipelineConfig& config,
+                                   std::shared_ptr<const ContextLayout> layout,
+                                   bool optimize)
+    : config_(config), layout_(std::move(layout)) {
+    if (!layout_) {
+        layout_ = make_context_layout(config_);
+    }
+    io_slots_ = IOSlots::resolve(config_, *layout_);
+    // 布局按原配置计算，优化后的步骤只引用其中的槽位
+    program_ = BytecodeCompiler::compile(optimize ? PipelineOptimizer::optimize(config_) : config_, layout_);
+}
+
+bool BytecodeExecutor::execute(ExecutionContext& context) {
+    if (context.layout() == layout_.get()) {
+        return program_.run(context);
+    }
+    
+    // 未绑定布局的上下文：按名称拷入临时上下文执行，再写回
+    ExecutionContext scratch(layout_);
+    for (size_t slot = 0; slot < layout_->size(); slot++) {
+        if (const ValueVariant* value = context.find(layout_->name(slot))) {
+            scratch.set_slot(slot, *value);
         }
     }
+    if (!program_.run(scratch)) {
+        return false;
+    }
+    for (const auto& ins : program_.code) {
+        context.set_variable(layout_->name(ins.output), ins.output_type, scratch.slot_ref(ins.output));
+    }
+    return true;
+}
+
+bool BytecodeExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    return execute_batch_by_row(*this, config_, io_slots_, input, output, n);
+}
+
+bool BytecodeExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    return execute_offsets_by_row(*this, config_, io_slots_, input, output, n);
+}
+
+bool BytecodeExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                            const OutputMask& mask) {
+    bool result = false;
+    if (run_trivial_mask(*this, config_, input, output, n, mask, result)) {
+        return result;
+    }
+    // 字节码程序按整体执行，只跳过未请求输出的写入
+    return execute_masked_by_row(*this, config_, io_slots_, input, output, n, mask);
 }
 
 // ============================================
 // JIT执行器实现
 // ============================================
 
-JITExecutor::JITExecutor(const PipelineConfig& config)
-    : config_(config) {
+struct JITExecutor::LoadedModule {
+    std::unique_ptr<CompiledModule> module;
+    ExecuteFunc execute = nullptr;
+    ExecuteBatchFunc execute_batch = nullptr;   // 旧版本SO没有批量入口时为空
+    ExecuteOffsetsFunc execute_offsets = nullptr;   // 旧版本SO与进程内后端没有偏移编码入口
+    ExecuteMaskedFunc execute_masked = nullptr;     // 单输出管道与进程内后端没有输出掩码入口
+    const AbiLayout* abi = nullptr;             // SO导出的输入输出结构布局
+    OptimizationTier tier = OptimizationTier::OPTIMIZED;
+    std::shared_ptr<PipelineStats> stats;       // 统计关闭时为空
+};
+
+struct JITExecutor::Promotion {
+    std::mutex mutex;              // 升级任务运行期间持有
+    JITExecutor* owner = nullptr;  // 执行器析构时置空
+};
+
+JITExecutor::JITExecutor(const PipelineConfig& config,
+                         std::shared_ptr<const ContextLayout> layout)
+    : config_(config), layout_(std::move(layout)) {
     fingerprint_ = config_.fingerprint;
     if (fingerprint_.empty()) {
         config_.compute_fingerprint();
         fingerprint_ = config_.fingerprint;
     }
+    if (!layout_) {
+        layout_ = make_context_layout(config_);
+    }
+    io_slots_ = IOSlots::resolve(config_, *layout_);
 }
 
 JITExecutor::~JITExecutor() {
-    unload_so();
+    // 等待正在运行的升级任务，排队中的任务之后直接返回
+    if (promotion_) {
+        std::lock_guard<std::mutex> lock(promotion_->mutex);
+        promotion_->owner = nullptr;
+    }
+    // 析构时不应再有执行方，当前模块直接释放（已替换的旧模块仍由回收域释放）
+    delete loaded_.exchange(nullptr);
 }
 
 bool JITExecutor::execute(ExecutionContext& context) {
-    // 检查是否需要重新编译
-    if (needs_recompile_) {
-        recompile();
+    // 按需编译并加载SO
+    if (!prepare()) {
+        return false;
     }
     
-    // 加载SO
-    if (!load_so()) {
+    // 调用期间处于读者临界区，并发替换的旧模块不会在此期间卸载
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    if (!loaded) {
         return false;
     }
     
-    // 执行 - 需要将ExecutionContext转换为原始数据
-    if (execute_func_) {
-        // 准备输入数据
-        std::vector<double> input_doubles;
-        std::vector<int32_t> input_int32s;
-        
-        for (const auto& input : config_.inputs) {
-            if (input.type == DataType::DOUBLE) {
-                input_doubles.push_back(context.get<double>(input.name));
-            } else if (input.type == DataType::INT32) {
-                input_int32s.push_back(context.get<int32_t>(input.name));
-            }
+    if (counting_.load(std::memory_order_relaxed)) {
+        count_rows(1);
+    }
+    
+    uint64_t start = 0;
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            start = stats_now_ns();
         }
-        
-        // 准备输出数据
-        std::vector<double> output_doubles(config_.outputs.size(), 0.0);
-        std::vector<int32_t> output_int32s(config_.outputs.size(), 0);
-        
-        // 调用生成的函数
-        bool result = execute_func_(input_doubles.data(), output_doubles.data());
-        
-        // 将结果写回上下文 - 写回所有输出变量
-        size_t out_idx = 0;
-        for (const auto& output : config_.outputs) {
-            if (output.type == DataType::DOUBLE) {
-                context.set_variable(output.name, DataType::DOUBLE, output_doubles[out_idx]);
-            } else if (output.type == DataType::INT32) {
-                context.set_variable(output.name, DataType::INT32, output_int32s[out_idx]);
-            } else if (output.type == DataType::INT64) {
-                context.set_variable(output.name, DataType::INT64, static_cast<int64_t>(output_doubles[out_idx]));
-            }
-            out_idx++;
+    }
+    
+    bool result = execute_marshalled(config_, *loaded->abi, loaded->execute, context,
+                                     context.layout() == layout_.get() ? &io_slots_ : nullptr);
+    
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            loaded->stats->record_execute(stats_now_ns() - start, 1, result);
         }
-        
-        // 额外：将最后一个中间变量的结果也写回（为了兼容测试）
-        // 找到最后一个步骤的输出变量
-        if (!config_.steps.empty()) {
-            const auto& last_step = config_.steps.back();
-            // 如果最后一个步骤的输出变量不在outputs中，则手动设置
-            bool found_in_outputs = false;
-            for (const auto& output : config_.outputs) {
-                if (output.name == last_step.output_var) {
-                    found_in_outputs = true;
-                    break;
-                }
-            }
-            if (!found_in_outputs) {
-                // 尝试从output_doubles获取最后一个double值
-                if (!output_doubles.empty()) {
-                    context.set_variable(last_step.output_var, DataType::DOUBLE, output_doubles[0]);
-                }
-            }
+    }
+    return result;
+}
+
+bool JITExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    if (!prepare()) {
+        return false;
+    }
+    
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    if (!loaded) {
+        return false;
+    }
+    
+    if (counting_.load(std::memory_order_relaxed)) {
+        count_rows(n);
+    }
+    
+    uint64_t start = 0;
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            start = stats_now_ns();
         }
-        
+    }
+    
+    // 旧版本SO没有批量入口，退化为逐行执行
+    bool result = loaded->execute_batch ? loaded->execute_batch(&input, &output, n)
+                                        : execute_batch_by_row(*this, config_, io_slots_, input, output, n);
+    
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            loaded->stats->record_execute(stats_now_ns() - start, n, result);
+        }
+    }
+    return result;
+}
+
+bool JITExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    if (!prepare()) {
+        return false;
+    }
+    
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    if (!loaded) {
+        return false;
+    }
+    
+    if (counting_.load(std::memory_order_relaxed)) {
+        count_rows(n);
+    }
+    
+    uint64_t start = 0;
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            start = stats_now_ns();
+        }
+    }
+    
+    // 没有偏移编码入口时退化为逐行执行
+    bool result = loaded->execute_offsets ? loaded->execute_offsets(&input, &output, n)
+                                          : execute_offsets_by_row(*this, config_, io_slots_, input, output, n);
+    
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            loaded->stats->record_execute(stats_now_ns() - start, n, result);
+        }
+    }
+    return result;
+}
+
+bool JITExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                       const OutputMask& mask) {
+    bool result = false;
+    if (run_trivial_mask(*this, config_, input, output, n, mask, result)) {
         return result;
     }
+    if (!prepare()) {
+        return false;
+    }
     
-    return false;
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    if (!loaded) {
+        return false;
+    }
+    
+    if (counting_.load(std::memory_order_relaxed)) {
+        count_rows(n);
+    }
+    
+    uint64_t start = 0;
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            start = stats_now_ns();
+        }
+    }
+    
+    // 没有掩码入口时逐行执行全部步骤，只写入请求的输出
+    result = loaded->execute_masked ? loaded->execute_masked(&input, &output, n, mask.words())
+                                    : execute_masked_by_row(*this, config_, io_slots_, input, output, n, mask);
+    
+    if constexpr (kStatsCompiled) {
+        if (loaded->stats) {
+            loaded->stats->record_execute(stats_now_ns() - start, n, result);
+        }
+    }
+    return result;
 }
 
 bool JITExecutor::needs_recompile() const {
     return needs_recompile_;
 }
 
-void JITExecutor::recompile() {
-    // 卸载旧SO
-    unload_so();
-    
-    // 编译
-    CodeGenOptions gen_opts;
-    gen_opts.output_dir = "./generated";
-    gen_opts.verbose = false;
-    
+/**
+ * @brief JIT执行器使用的编译选项（缓存查找与编译必须一致）
+ */
+static CompileOptions jit_compile_options() {
     CompileOptions comp_opts;
-    comp_opts.include_dir = "/workspace/turbograph_jit/include";
     comp_opts.keep_source = true;
-    comp_opts.verbose = true;
-    
-    if (JITCompiler::instance().compile(config_, gen_opts, comp_opts)) {
-        needs_recompile_ = false;
+    return comp_opts;
+}
+
+void JITExecutor::recompile() {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    // 先编译新模块，期间执行方继续使用旧模块
+    auto next = load_module(true, tier_.load());
+    needs_recompile_ = next == nullptr;
+    publish_module(std::move(next));
+}
+
+bool JITExecutor::prepare() {
+    // 已加载且选项未变时无锁返回；加载串行化，并发调用方等待同一次编译
+    if (loaded_.load(std::memory_order_acquire) && !needs_recompile_.load(std::memory_order_acquire)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    if (needs_recompile_ || !loaded_.load(std::memory_order_relaxed)) {
+        auto next = load_module(false, tier_.load());
+        needs_recompile_ = next == nullptr;
+        publish_module(std::move(next));
     }
+    return loaded_.load(std::memory_order_relaxed) != nullptr;
 }
 
 void JITExecutor::set_options(const CodeGenOptions& options) {
+    std::lock_guard<std::mutex> lock(load_mutex_);
     gen_options_ = options;
+    needs_recompile_ = true;
 }
 
-bool JITExecutor::check_cache() {
-    auto so_path = JITCompiler::instance().get_so_path(fingerprint_);
-    if (so_path.has_value()) {
-        return true;
-    }
-    return false;
+const char* JITExecutor::backend_name() const {
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    return loaded ? loaded->module->backend() : "";
 }
 
-bool JITExecutor::load_so() {
-    if (so_handle_) {
-        return true;
-    }
+std::unique_ptr<JITExecutor::LoadedModule> JITExecutor::load_module(bool rebuild, OptimizationTier tier) {
+    CodeGenOptions gen_opts = gen_options_;
+    gen_opts.verbose = false;
     
-    // 检查缓存
-    auto so_path = JITCompiler::instance().get_so_path(fingerprint_);
-    if (!so_path.has_value()) {
-        // 需要编译
-        CodeGenOptions gen_opts;
-        gen_opts.output_dir = "./generated";
-        gen_opts.verbose = false;
-        
-        CompileOptions comp_opts;
-        comp_opts.include_dir = "/workspace/turbograph_jit/include";
-        comp_opts.keep_source = true;
-        
-        if (!JITCompiler::instance().compile(config_, gen_opts, comp_opts)) {
-            std::cerr << "Failed to compile pipeline: " << fingerprint_ << std::endl;
-            return false;
-        }
-        
-        so_path = JITCompiler::instance().get_so_path(fingerprint_);
-        if (!so_path.has_value()) {
-            return false;
-        }
-    }
+    CompileOptions comp_opts = tier_compile_options(tier, gen_opts, jit_compile_options(),
+                                                    tier_options_.baseline_optimization);
+    comp_opts.verbose = true;
     
-    // 加载SO
-    so_handle_ = dlopen(so_path->c_str(), RTLD_LAZY | RTLD_LOCAL);
-    if (!so_handle_) {
-        std::cerr << "Failed to load SO: " << dlerror() << std::endl;
-        return false;
+    auto module = JITCompiler::instance().load(config_, gen_opts, comp_opts, rebuild);
+    if (!module) {
+        return nullptr;
     }
     
     // 获取函数（使用转换后的标识符）
-    std::string func_name = "pipeline_execute_" + make_valid_identifier(fingerprint_);
-    auto func = dlsym(so_handle_, func_name.c_str());
+    auto func = module->symbol("pipeline_execute_" + make_valid_identifier(fingerprint_));
     if (!func) {
         // 尝试原始名称
-        func = dlsym(so_handle_, ("pipeline_execute_" + fingerprint_).c_str());
+        func = module->symbol("pipeline_execute_" + fingerprint_);
     }
     if (!func) {
         // 尝试通用名称
-        func = dlsym(so_handle_, "pipeline_execute");
+        func = module->symbol("pipeline_execute");
     }
     
     if (!func) {
-        std::cerr << "Failed to find execute function: " << dlerror() << std::endl;
-        dlclose(so_handle_);
-        so_handle_ = nullptr;
-        return false;
+        std::cerr << "Failed to find execute function: " << fingerprint_ << std::endl;
+        return nullptr;
     }
     
-    execute_func_ = reinterpret_cast<ExecuteFunc>(func);
-    return true;
+    // 获取布局描述符
+    std::string abi_name = "pipeline_abi_" + make_valid_identifier(fingerprint_);
+    auto abi = static_cast<const AbiLayout*>(module->symbol(abi_name));
+    if (!abi || !validate_abi(config_, *abi)) {
+        std::cerr << "Invalid or missing ABI descriptor: " << abi_name << std::endl;
+        return nullptr;
+    }
+    
+    auto loaded = std::make_unique<LoadedModule>();
+    loaded->tier = tier;
+    loaded->abi = abi;
+    loaded->execute = reinterpret_cast<ExecuteFunc>(func);
+    
+    // 批量入口（可选）
+    std::string batch_func_name = "pipeline_execute_batch_" + make_valid_identifier(fingerprint_);
+    loaded->execute_batch = reinterpret_cast<ExecuteBatchFunc>(module->symbol(batch_func_name));
+    std::string offsets_func_name = "pipeline_execute_offsets_" + make_valid_identifier(fingerprint_);
+    loaded->execute_offsets = reinterpret_cast<ExecuteOffsetsFunc>(module->symbol(offsets_func_name));
+    std::string masked_func_name = "pipeline_execute_batch_masked_" + make_valid_identifier(fingerprint_);
+    loaded->execute_masked = reinterpret_cast<ExecuteMaskedFunc>(module->symbol(masked_func_name));
+    
+    if constexpr (kStatsCompiled) {
+        // 插桩模块挂接步骤计数；同一SO被多个执行器加载时共用同一统计对象的计数数组
+        loaded->stats = StatsRegistry::instance().pipeline(config_.name, fingerprint_);
+        auto profile = static_cast<const StepProfile*>(
+            module->symbol("pipeline_profile_" + make_valid_identifier(fingerprint_)));
+        if (loaded->stats && profile) {
+            StepCounter* counters = loaded->stats->attach_steps(profile->names, profile->num_steps);
+            __atomic_store_n(profile->counters, counters, __ATOMIC_RELEASE);
+        }
+    }
+    
+    loaded->module = std::move(module);
+    return loaded;
+}
+
+void JITExecutor::publish_module(std::unique_ptr<LoadedModule> next) {
+    LoadedModule* old = loaded_.exchange(next.release(), std::memory_order_seq_cst);
+    if (old) {
+        EpochDomain::instance().retire([old] { delete old; });
+    }
+}
+
+void JITExecutor::set_tier_options(const JitTierOptions& options, ThreadPool& pool) {
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    tier_options_ = options;
+    tier_pool_ = &pool;
+    if (!options.enabled) {
+        counting_.store(false, std::memory_order_relaxed);
+        return;
+    }
+    if (!promotion_) {
+        promotion_ = std::make_shared<Promotion>();
+        promotion_->owner = this;
+    }
+    if (!loaded_.load(std::memory_order_relaxed)) {
+        tier_ = OptimizationTier::BASELINE;
+    }
+    promote_at_.store(executed_rows_.load() + options.promote_after, std::memory_order_relaxed);
+    counting_.store(tier_.load() == OptimizationTier::BASELINE, std::memory_order_relaxed);
+}
+
+OptimizationTier JITExecutor::tier() const {
+    EpochDomain::Guard guard = EpochDomain::instance().enter();
+    const LoadedModule* loaded = loaded_.load(std::memory_order_seq_cst);
+    return loaded ? loaded->tier : tier_.load();
+}
+
+bool JITExecutor::wait_for_tier(OptimizationTier tier, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(tier_mutex_);
+    tier_cv_.wait_for(lock, timeout, [&] {
+        return this->tier() >= tier ||
+               (!counting_.load(std::memory_order_acquire) && !promoting_.load(std::memory_order_acquire));
+    });
+    return this->tier() >= tier;
+}
+
+void JITExecutor::count_rows(size_t rows) {
+    uint64_t total = executed_rows_.fetch_add(rows, std::memory_order_relaxed) + rows;
+    if (total < promote_at_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    bool expected = false;
+    if (!promoting_.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    
+    // 任务只持有共享状态，执行器先析构时任务直接返回
+    std::shared_ptr<Promotion> promotion = promotion_;
+    bool submitted = tier_pool_->submit([promotion] {
+        std::lock_guard<std::mutex> lock(promotion->mutex);
+        if (promotion->owner) {
+            promotion->owner->promote();
+        }
+    });
+    
+    // 编译队列已满，下次执行时重试
+    if (!submitted) {
+        promoting_.store(false, std::memory_order_release);
+    }
+}
+
+void JITExecutor::promote() {
+    OptimizationTier current = tier_.load();
+    OptimizationTier next = OptimizationTier::OPTIMIZED;
+    if (current == OptimizationTier::BASELINE && tier_options_.use_pgo) {
+        next = OptimizationTier::PROFILING;
+    } else if (current == OptimizationTier::PROFILING) {
+        next = OptimizationTier::PROFILED;
+    }
+    
+    if (next == OptimizationTier::PROFILED) {
+        // 先换上不插桩的版本；插桩模块在读者离开后卸载（dlclose时写出计数文件）
+        {
+            std::lock_guard<std::mutex> lock(load_mutex_);
+            if (auto optimized = load_module(false, OptimizationTier::OPTIMIZED)) {
+                publish_module(std::move(optimized));
+                tier_ = OptimizationTier::OPTIMIZED;
+            }
+        }
+        EpochDomain::instance().synchronize();
+    }
+    
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(load_mutex_);
+        auto module = load_module(false, next);
+        ok = module != nullptr;
+        if (ok) {
+            publish_module(std::move(module));
+            tier_ = next;
+            needs_recompile_ = false;
+        } else {
+            std::cerr << "JIT tier promotion to " << optimization_tier_name(next) << " failed, staying at "
+                      << optimization_tier_name(tier_.load()) << ": " << config_.name << std::endl;
+        }
+        
+        // 插桩版本运行一段时间后再按计数重新编译，其余情况升级结束
+        if (ok && next == OptimizationTier::PROFILING) {
+            promote_at_.store(executed_rows_.load() + tier_options_.profile_rows, std::memory_order_relaxed);
+        } else {
+            counting_.store(false, std::memory_order_release);
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        promoting_.store(false, std::memory_order_release);
+    }
+    tier_cv_.notify_all();
+}
+
+// ============================================
+// 分层执行器实现
+// ============================================
+
+const char* jit_state_name(JitState state) {
+    switch (state) {
+        case JitState::INTERPRETING: return "INTERPRETING";
+        case JitState::COMPILING: return "COMPILING";
+        case JitState::JIT: return "JIT";
+        case JitState::FAILED: return "FAILED";
+        default: return "UNKNOWN";
+    }
+}
+
+struct TieredExecutor::SharedState {
+    PipelineConfig config;
+    std::shared_ptr<const ContextLayout> layout;
+    
+    std::atomic<JitState> state{JitState::INTERPRETING};
+    
+    // 编译线程在发布ready前写入jit，之后不再修改
+    std::unique_ptr<JITExecutor> jit;
+    std::atomic<JITExecutor*> ready{nullptr};
+    
+    std::mutex mutex;
+    std::condition_variable done_cv;
+};
+
+TieredExecutor::TieredExecutor(const PipelineConfig& config, ThreadPool& pool)
+    : layout_(make_context_layout(config)),
+      interpreter_(config, layout_),
+      pool_(pool),
+      shared_(std::make_shared<SharedState>()) {
+    shared_->config = config;
+    shared_->layout = layout_;
+    try_submit();
+}
+
+TieredExecutor::~TieredExecutor() = default;
+
+void TieredExecutor::try_submit() {
+    JitState expected = JitState::INTERPRETING;
+    if (!shared_->state.compare_exchange_strong(expected, JitState::COMPILING)) {
+        return;
+    }
+    
+    // 任务只持有共享状态，执行器先析构时编译仍可安全完成
+    std::shared_ptr<SharedState> shared = shared_;
+    bool submitted = pool_.submit([shared] {
+        auto jit = std::make_unique<JITExecutor>(shared->config, shared->layout);
+        bool ok = jit->prepare();
+        
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        if (ok) {
+            shared->jit = std::move(jit);
+            shared->ready.store(shared->jit.get(), std::memory_order_release);
+            shared->state.store(JitState::JIT, std::memory_order_release);
+        } else {
+            std::cerr << "Background JIT failed, staying on interpreter: "
+                      << shared->config.name << std::endl;
+            shared->state.store(JitState::FAILED, std::memory_order_release);
+        }
+        shared->done_cv.notify_all();
+    });
+    
+    // 编译队列已满，下次执行时重试
+    if (!submitted) {
+        shared_->state.store(JitState::INTERPRETING, std::memory_order_release);
+    }
+}
+
+bool TieredExecutor::execute(ExecutionContext& context) {
+    if (JITExecutor* jit = shared_->ready.load(std::memory_order_acquire)) {
+        return jit->execute(context);
+    }
+    if (shared_->state.load(std::memory_order_relaxed) == JitState::INTERPRETING) {
+        try_submit();
+    }
+    return interpreter_.execute(context);
+}
+
+bool TieredExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    if (JITExecutor* jit = shared_->ready.load(std::memory_order_acquire)) {
+        return jit->execute_batch(input, output, n);
+    }
+    if (shared_->state.load(std::memory_order_relaxed) == JitState::INTERPRETING) {
+        try_submit();
+    }
+    return interpreter_.execute_batch(input, output, n);
 }
 
-void JITExecutor::unload_so() {
-    if (so_handle_) {
-        dlclose(so_handle_);
-        so_handle_ = nullptr;
-        execute_func_ = nullptr;
+bool TieredExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    if (JITExecutor* jit = shared_->ready.load(std::memory_order_acquire)) {
+        return jit->execute_offsets(input, output, n);
     }
+    if (shared_->state.load(std::memory_order_relaxed) == JitState::INTERPRETING) {
+        try_submit();
+    }
+    return interpreter_.execute_offsets(input, output, n);
+}
+
+bool TieredExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                          const OutputMask& mask) {
+    if (JITExecutor* jit = shared_->ready.load(std::memory_order_acquire)) {
+        return jit->execute_batch_masked(input, output, n, mask);
+    }
+    if (shared_->state.load(std::memory_order_relaxed) == JitState::INTERPRETING) {
+        try_submit();
+    }
+    return interpreter_.execute_batch_masked(input, output, n, mask);
+}
+
+JitState TieredExecutor::state() const {
+    return shared_->state.load(std::memory_order_acquire);
+}
+
+bool TieredExecutor::wait_for_jit(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->done_cv.wait_for(lock, timeout, [this] {
+        JitState current = shared_->state.load(std::memory_order_acquire);
+        return current == JitState::JIT || current == JitState::FAILED;
+    });
+    return shared_->state.load(std::memory_order_acquire) == JitState::JIT;
+}
+
+// ============================================
+// AOT执行器实现
+// ============================================
+
+AotExecutor::AotExecutor(const PipelineConfig& config, const AotPipeline& pipeline)
+    : config_(config), pipeline_(pipeline) {
+    if (config_.fingerprint.empty()) {
+        config_.compute_fingerprint();
+    }
+    layout_ = make_context_layout(config_);
+    io_slots_ = IOSlots::resolve(config_, *layout_);
+}
+
+bool AotExecutor::execute(ExecutionContext& context) {
+    return execute_marshalled(config_, *pipeline_.abi, pipeline_.execute, context,
+                              context.layout() == layout_.get() ? &io_slots_ : nullptr);
+}
+
+bool AotExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    return pipeline_.execute_batch(&input, &output, n);
+}
+
+bool AotExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    return pipeline_.execute_offsets(&input, &output, n);
+}
+
+bool AotExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                       const OutputMask& mask) {
+    bool result = false;
+    if (run_trivial_mask(*this, config_, input, output, n, mask, result)) {
+        return result;
+    }
+    return pipeline_.execute_batch_masked
+        ? pipeline_.execute_batch_masked(&input, &output, n, mask.words())
+        : execute_masked_by_row(*this, config_, io_slots_, input, output, n, mask);
 }
 
 // ============================================
 // 管道管理器实现
 // ============================================
 
+PipelineManager::PipelineManager() {
+    // 先构造JITCompiler单例，保证其晚于本对象（及编译线程池）析构，
+    // 退出时仍在运行的后台编译任务不会访问已销毁的编译器
+    JITCompiler::instance();
+    registry_ = std::make_unique<PipelineRegistry>();
+}
+
+PipelineManager::~PipelineManager() = default;
+
 PipelineManager& PipelineManager::instance() {
     static PipelineManager manager;
     return manager;
 }
 
+void PipelineManager::set_compile_pool_size(size_t num_threads, size_t max_pending) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (compile_pool_) {
+        std::cerr << "Compile pool already started, size change ignored" << std::endl;
+        return;
+    }
+    compile_threads_ = num_threads;
+    compile_max_pending_ = max_pending;
+}
+
+ThreadPool& PipelineManager::compile_pool() {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!compile_pool_) {
+        compile_pool_ = std::make_unique<ThreadPool>(compile_threads_, compile_max_pending_);
+    }
+    return *compile_pool_;
+}
+
+void PipelineManager::set_batch_scheduler_options(const BatchSchedulerOptions& options) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (batch_scheduler_) {
+        std::cerr << "Batch scheduler already started, options change ignored" << std::endl;
+        return;
+    }
+    batch_options_ = options;
+}
+
+BatchScheduler& PipelineManager::batch_scheduler() {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!batch_scheduler_) {
+        batch_scheduler_ = std::make_unique<BatchScheduler>(batch_options_);
+    }
+    return *batch_scheduler_;
+}
+
 std::unique_ptr<IPipelineExecutor> PipelineManager::create_interpreter(const PipelineConfig& config) {
     return std::make_unique<InterpreterExecutor>(config);
 }
 
+std::unique_ptr<IPipelineExecutor> PipelineManager::create_bytecode(const PipelineConfig& config) {
+    return std::make_unique<BytecodeExecutor>(config);
+}
+
 std::unique_ptr<IPipelineExecutor> PipelineManager::create_jit(const PipelineConfig& config) {
-    return std::make_unique<JITExecutor>(config);
+    auto jit = std::make_unique<JITExecutor>(config);
+    CodeGenOptions options;
+    JitTierOptions tiers;
+    bool instrumented;
+    {
+        std::lock_guard<std::mutex> lock(settings_mutex_);
+        options = jit_options_;
+        tiers = jit_tier_options_;
+        instrumented = instrumented_;
+    }
+    options.profile_steps = options.profile_steps || instrumented;
+    jit->set_options(options);
+    if (tiers.enabled) {
+        jit->set_tier_options(tiers, compile_pool());
+    }
+    return jit;
+}
+
+std::unique_ptr<IPipelineExecutor> PipelineManager::create_tiered(const PipelineConfig& config) {
+    return std::make_unique<TieredExecutor>(config, compile_pool());
 }
 
 std::unique_ptr<IPipelineExecutor> PipelineManager::create(const PipelineConfig& config, PipelineMode mode) {
+    auto executor = create_uncached(config, mode);
+    if (executor && config.cache.enabled()) {
+        return std::make_unique<CachedExecutor>(config, std::move(executor),
+                                                ResultCacheRegistry::instance().cache(config));
+    }
+    return executor;
+}
+
+std::unique_ptr<IPipelineExecutor> PipelineManager::create_uncached(const PipelineConfig& config, PipelineMode mode) {
+    // 构建期已生成并链接的管道直接使用，不编译
+    if (mode == PipelineMode::JIT || mode == PipelineMode::AUTO) {
+        std::string fingerprint = config.fingerprint;
+        if (fingerprint.empty()) {
+            fingerprint = PipelineConfig(config).compute_fingerprint();
+        }
+        if (const AotPipeline* aot = AotRegistry::instance().find(fingerprint)) {
+            return std::make_unique<AotExecutor>(config, *aot);
+        }
+    }
+    
     switch (mode) {
         case PipelineMode::INTERPRETER:
             return create_interpreter(config);
+        case PipelineMode::BYTECODE:
+            return create_bytecode(config);
         case PipelineMode::JIT:
-        case PipelineMode::AUTO:
             return create_jit(config);
+        case PipelineMode::AUTO:
+            return create_tiered(config);
         default:
             return create_jit(config);
     }
@@ -428,11 +1477,202 @@ std::unique_ptr<IPipelineExecutor> PipelineManager::create_from_file(
     return create(config, mode);
 }
 
+/**
+ * @brief 批量发布（同update）：JIT模式下提交到编译线程池并行编译加载，
+ * 队列满时以及其他模式下在调用线程上发布
+ */
+class BulkPublisher {
+public:
+    BulkPublisher(PipelineManager& manager, PipelineMode mode)
+        : manager_(manager), mode_(mode), progress_(std::make_shared<Progress>()) {}
+    
+    void submit(PipelineConfig config) {
+        {
+            std::lock_guard<std::mutex> lock(progress_->mutex);
+            progress_->running++;
+        }
+        std::function<void()> task = [&manager = manager_, progress = progress_, mode = mode_,
+                                      config = std::move(config)] {
+            bool ok = manager.update(config.name, config, mode) != 0;
+            std::lock_guard<std::mutex> lock(progress->mutex);
+            progress->published += ok;
+            if (--progress->running == 0) {
+                progress->done.notify_all();
+            }
+        };
+        // 只有JIT模式需要在发布前编译；其他模式创建即可用（AUTO在后台编译）
+        if (mode_ != PipelineMode::JIT || !manager_.compile_pool().submit(task)) {
+            task();
+        }
+    }
+    
+    /**
+     * @brief 等待已提交的全部完成
+     * @return 成功发布的管道数
+     */
+    size_t wait() {
+        std::unique_lock<std::mutex> lock(progress_->mutex);
+        progress_->done.wait(lock, [&] { return progress_->running == 0; });
+        return progress_->published;
+    }
+    
+private:
+    // 任务可能在线程池中晚于提交方返回，计数单独共享
+    struct Progress {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t running = 0;
+        size_t published = 0;
+    };
+    
+    PipelineManager& manager_;
+    PipelineMode mode_;
+    std::shared_ptr<Progress> progress_;
+};
+
+size_t PipelineManager::load_bulk(std::istream& input, PipelineMode mode) {
+    BulkPublisher publisher(*this, mode);
+    JsonConfigParser parser;
+    try {
+        parser.parse_bulk(input, [&](PipelineConfig&& config) {
+            publisher.submit(std::move(config));
+        });
+    } catch (...) {
+        publisher.wait();
+        throw;
+    }
+    return publisher.wait();
+}
+
+size_t PipelineManager::load_bulk(const std::string& path, PipelineMode mode) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open config file: " + path);
+    }
+    return load_bulk(file, mode);
+}
+
+size_t PipelineManager::load_binary(const std::string& path, PipelineMode mode) {
+    MappedConfigFile file(path);
+    BulkPublisher publisher(*this, mode);
+    try {
+        for (size_t i = 0; i < file.size(); i++) {
+            publisher.submit(file.config(i));
+        }
+    } catch (...) {
+        publisher.wait();
+        throw;
+    }
+    return publisher.wait();
+}
+
+uint64_t PipelineManager::update(const std::string& name, const PipelineConfig& new_config,
+                                 PipelineMode mode) {
+    std::unique_ptr<IPipelineExecutor> executor;
+    try {
+        executor = create(new_config, mode);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create pipeline update for " << name << ": " << e.what() << std::endl;
+        return 0;
+    }
+    
+    // JIT版本在发布前完成编译与加载，读者切换后不会等待编译
+    IPipelineExecutor* target = executor.get();
+    if (auto* cached = dynamic_cast<CachedExecutor*>(target)) {
+        target = &cached->inner();
+    }
+    if (auto* jit = dynamic_cast<JITExecutor*>(target)) {
+        if (!jit->prepare()) {
+            std::cerr << "Failed to prepare pipeline update, keeping current version: " << name << std::endl;
+            return 0;
+        }
+    }
+    return registry_->publish(name, new_config, std::move(executor));
+}
+
+/**
+ * @brief 数值变量的值，非数值类型返回false
+ */
+static bool numeric_value(const ValueVariant& value, double& out) {
+    return std::visit([&](const auto& v) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(v)>>) {
+            out = static_cast<double>(v);
+            return true;
+        } else {
+            return false;
+        }
+    }, value);
+}
+
+PrecisionReport PipelineManager::validate_precision(const PipelineConfig& config,
+                                                    const std::vector<ExecutionContext>& samples,
+                                                    PipelineMode mode) {
+    PrecisionReport report;
+    InterpreterExecutor reference(config);
+    auto candidate = create(config, mode);
+    
+    for (size_t row = 0; row < samples.size(); row++) {
+        ExecutionContext expected = samples[row];
+        ExecutionContext actual = samples[row];
+        if (!reference.execute(expected) || !candidate->execute(actual)) {
+            report.failed_rows++;
+            continue;
+        }
+        report.rows++;
+        
+        for (const auto& output : config.outputs) {
+            const ValueVariant* e = expected.find(output.name);
+            const ValueVariant* a = actual.find(output.name);
+            double reference_value = 0.0;
+            double value = 0.0;
+            if (!e || !a || !numeric_value(*e, reference_value) || !numeric_value(*a, value)) {
+                continue;
+            }
+            if (std::isnan(reference_value) && std::isnan(value)) {
+                continue;
+            }
+            double abs_error = std::fabs(value - reference_value);
+            if (std::isnan(abs_error)) {
+                abs_error = std::numeric_limits<double>::infinity();
+            }
+            double rel_error = abs_error / std::max(1.0, std::fabs(reference_value));
+            report.max_abs_error = std::max(report.max_abs_error, abs_error);
+            if (rel_error > report.max_rel_error || report.worst_output.empty()) {
+                report.max_rel_error = rel_error;
+                report.worst_output = output.name;
+                report.worst_row = row;
+            }
+        }
+    }
+    return report;
+}
+
 void PipelineManager::set_jit_options(const CodeGenOptions& options) {
+    std::lock_guard<std::mutex> lock(settings_mutex_);
     jit_options_ = options;
 }
 
+void PipelineManager::set_jit_tier_options(const JitTierOptions& options) {
+    std::lock_guard<std::mutex> lock(settings_mutex_);
+    jit_tier_options_ = options;
+}
+
+void PipelineManager::set_instrumentation(bool enabled) {
+    std::lock_guard<std::mutex> lock(settings_mutex_);
+    instrumented_ = enabled && kStatsCompiled;
+    StatsRegistry::instance().set_enabled(enabled);
+}
+
+std::vector<PipelineStatsSnapshot> PipelineManager::stats() const {
+    return StatsRegistry::instance().snapshot();
+}
+
+std::string PipelineManager::dump_metrics() const {
+    return StatsRegistry::format_prometheus(stats());
+}
+
 void PipelineManager::set_cache_dir(const std::string& dir) {
+    std::lock_guard<std::mutex> lock(settings_mutex_);
     cache_dir_ = dir;
     JITCompiler::instance().set_cache_dir(dir);
 }
@@ -0,0 +1,285 @@
+#include "pipeline_group.hpp"
+#include "code_generator.hpp"
+#include "hash.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace turbograph {
+
+namespace {
+
+/**
+ * @brief 生成合法的C++标识符（与code_generator保持一致）
+ */
+std::string make_valid_identifier(const std::string& str) {
+    if (str.empty()) return "p_invalid";
+    std::string result = str;
+    if (std::isdigit(static_cast<unsigned char>(result[0]))) {
+        result = "p_" + result;
+    }
+    for (char& c : result) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            c = '_';
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 按输出类型复制一列（数值相同的成员输出）
+ */
+template<typename T>
+void copy_as(const void* src, void* dst, size_t n) {
+    std::copy_n(static_cast<const T*>(src), n, static_cast<T*>(dst));
+}
+
+void copy_column(DataType type, const void* src, void* dst, size_t n) {
+    switch (type) {
+        case DataType::INT32: copy_as<int32_t>(src, dst, n); break;
+        case DataType::INT64: copy_as<int64_t>(src, dst, n); break;
+        case DataType::DOUBLE: copy_as<double>(src, dst, n); break;
+        case DataType::FLOAT: copy_as<float>(src, dst, n); break;
+        case DataType::STRING: copy_as<std::string>(src, dst, n); break;
+        case DataType::INT32_LIST: copy_as<std::vector<int32_t>>(src, dst, n); break;
+        case DataType::INT64_LIST: copy_as<std::vector<int64_t>>(src, dst, n); break;
+        case DataType::DOUBLE_LIST: copy_as<std::vector<double>>(src, dst, n); break;
+        case DataType::STRING_LIST: copy_as<std::vector<std::string>>(src, dst, n); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief 输出类型不同时用于转换的算子（与优化器的拷贝算子一致）
+ */
+const char* convert_operator(DataType type) {
+    switch (type) {
+        case DataType::INT32: return "direct_output_int32";
+        case DataType::INT64: return "direct_output_int64";
+        case DataType::DOUBLE: return "direct_output_double";
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief 步骤指纹：算子、结果类型、参数（变量已解析为融合后的单次赋值变量）与排序后的选项
+ */
+std::string step_fingerprint(const OpCall& step, DataType out_type) {
+    HashBuilder builder;
+    builder.add(step.op_name).add(static_cast<uint64_t>(out_type));
+    builder.add(static_cast<uint64_t>(step.args.size()));
+    for (const auto& arg : step.args) {
+        builder.add(static_cast<uint64_t>(arg.type)).add(static_cast<uint64_t>(arg.data_type)).add(arg.value);
+    }
+    std::vector<std::pair<std::string, std::string>> options(step.options.begin(), step.options.end());
+    std::sort(options.begin(), options.end());
+    for (const auto& [key, value] : options) {
+        builder.add(key).add(value);
+    }
+    return builder.finish().hex();
+}
+
+} // namespace
+
+// ============================================
+// 管道组实现
+// ============================================
+
+PipelineGroup::PipelineGroup(const std::string& name, std::vector<PipelineConfig> members) {
+    if (members.empty()) {
+        throw std::runtime_error("Pipeline group has no members: " + name);
+    }
+    fused_.name = name;
+    fused_.precision = members[0].precision;
+
+    std::unordered_set<std::string> member_names;
+    std::unordered_set<std::string> taken;              // 融合配置中已使用的变量名
+    std::unordered_map<std::string, size_t> input_index;
+
+    for (auto& config : members) {
+        if (!member_names.insert(config.name).second) {
+            throw std::runtime_error("Duplicate pipeline in group " + name + ": " + config.name);
+        }
+        if (config.precision != fused_.precision) {
+            throw std::runtime_error("Mixed precision in pipeline group " + name + ": " + config.name);
+        }
+        Member member;
+        for (const auto& input : config.inputs) {
+            auto it = input_index.find(input.name);
+            if (it == input_index.end()) {
+                it = input_index.emplace(input.name, fused_.inputs.size()).first;
+                fused_.inputs.push_back(input);
+                taken.insert(input.name);
+            } else {
+                auto& shared = fused_.inputs[it->second];
+                if (shared.type != input.type || shared.broadcast != input.broadcast) {
+                    throw std::runtime_error("Conflicting input " + input.name + " in pipeline group " +
+                                             name + ": " + config.name);
+                }
+                shared.required = shared.required || input.required;
+            }
+            member.inputs.push_back(it->second);
+        }
+        member.config = std::move(config);
+        members_.push_back(std::move(member));
+    }
+
+    // 新变量名：成员名前缀，重复赋值或冲突时追加序号
+    auto fresh = [&](const std::string& base) {
+        std::string candidate = base;
+        for (size_t n = 1; !taken.insert(candidate).second; n++) {
+            candidate = base + "_" + std::to_string(n);
+        }
+        return candidate;
+    };
+
+    std::unordered_map<std::string, std::string> available;         // 步骤指纹 -> 持有结果的变量
+    std::map<std::pair<std::string, DataType>, size_t> output_index;  // (变量, 类型) -> 融合输出列
+    std::unordered_set<std::string> output_vars;
+
+    for (size_t k = 0; k < members_.size(); k++) {
+        const PipelineConfig& config = members_[k].config;
+        const std::string prefix = make_valid_identifier(config.name) + "__";
+
+        std::unordered_map<std::string, DataType> declared;   // 步骤输出的声明类型
+        for (const auto& input : config.inputs) {
+            declared.emplace(input.name, input.type);
+        }
+        for (const auto& var : config.variables) {
+            declared.emplace(var.name, var.type);
+        }
+
+        // 成员变量 -> 融合配置中当前的到达定义
+        std::unordered_map<std::string, std::string> env;
+        for (const auto& input : config.inputs) {
+            env.emplace(input.name, input.name);
+        }
+        auto resolve = [&](const std::string& var) {
+            auto it = env.find(var);
+            if (it != env.end()) {
+                return it->second;
+            }
+            // 未赋值就读取的声明变量保持缺省值
+            std::string renamed = fresh(prefix + var);
+            for (const auto& decl : config.variables) {
+                if (decl.name == var) {
+                    fused_.variables.push_back({renamed, decl.type, false});
+                    break;
+                }
+            }
+            env.emplace(var, renamed);
+            return renamed;
+        };
+
+        for (const auto& original : config.steps) {
+            member_steps_++;
+            OpCall step = original;
+            for (auto& arg : step.args) {
+                if (arg.type == ArgType::VARIABLE) {
+                    arg.value = resolve(arg.value);
+                }
+            }
+            auto decl = declared.find(original.output_var);
+            DataType out_type = decl != declared.end() ? decl->second : compute_step_type(config, original);
+
+            std::string key = step_fingerprint(step, out_type);
+            auto hit = available.find(key);
+            if (hit != available.end()) {
+                env[original.output_var] = hit->second;
+                continue;
+            }
+            step.output_var = fresh(prefix + original.output_var);
+            if (decl != declared.end()) {
+                fused_.variables.push_back({step.output_var, decl->second, false});
+            }
+            available.emplace(key, step.output_var);
+            env[original.output_var] = step.output_var;
+            fused_.steps.push_back(std::move(step));
+        }
+
+        for (size_t j = 0; j < config.outputs.size(); j++) {
+            const auto& output = config.outputs[j];
+            std::string var = resolve(output.name);
+            auto it = output_index.find({var, output.type});
+            if (it == output_index.end()) {
+                if (!output_vars.insert(var).second) {
+                    // 同一变量已按其他类型输出：生成代码按变量名读取输出，转换到新变量
+                    const char* convert = convert_operator(output.type);
+                    if (!convert) {
+                        throw std::runtime_error("Conflicting output type for " + output.name +
+                                                 " in pipeline group " + name + ": " + config.name);
+                    }
+                    OpCall step = OpCallBuilder(convert)
+                        .output(fresh(prefix + output.name))
+                        .arg(Arg::variable(var, DataType::UNKNOWN))
+                        .build();
+                    var = step.output_var;
+                    output_vars.insert(var);
+                    fused_.steps.push_back(std::move(step));
+                }
+                it = output_index.emplace(std::make_pair(var, output.type), fused_.outputs.size()).first;
+                fused_.outputs.push_back({var, output.type, output.required});
+                owners_.push_back({k, j});
+            }
+            members_[k].outputs.push_back(it->second);
+        }
+    }
+
+    fused_.compute_fingerprint();
+}
+
+size_t PipelineGroup::find(const std::string& name) const {
+    for (size_t i = 0; i < members_.size(); i++) {
+        if (members_[i].config.name == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+std::unique_ptr<IPipelineExecutor> PipelineGroup::create(PipelineMode mode) const {
+    return PipelineManager::instance().create(fused_, mode);
+}
+
+bool PipelineGroup::execute_batch(IPipelineExecutor& executor, const ColumnBatch& input,
+                                  const std::vector<OutputBatch>& outputs, size_t n) const {
+    if (outputs.size() != members_.size()) {
+        std::cerr << "Pipeline group " << fused_.name << " expects " << members_.size()
+                  << " output batches, got " << outputs.size() << std::endl;
+        return false;
+    }
+    for (size_t k = 0; k < members_.size(); k++) {
+        if (outputs[k].num_columns < members_[k].outputs.size()) {
+            std::cerr << "Pipeline group " << fused_.name << ": missing output columns for "
+                      << members_[k].config.name << std::endl;
+            return false;
+        }
+    }
+
+    // 每个融合输出列直接写入其所属成员的缓冲区
+    std::vector<void*> columns(owners_.size());
+    for (size_t c = 0; c < owners_.size(); c++) {
+        columns[c] = outputs[owners_[c].member].columns[owners_[c].output];
+    }
+    OutputBatch fused_output{columns.data(), columns.size()};
+    if (!executor.execute_batch(input, fused_output, n)) {
+        return false;
+    }
+
+    for (size_t k = 0; k < members_.size(); k++) {
+        for (size_t j = 0; j < members_[k].outputs.size(); j++) {
+            size_t c = members_[k].outputs[j];
+            if (owners_[c].member != k || owners_[c].output != j) {
+                copy_column(fused_.outputs[c].type, columns[c], outputs[k].columns[j], n);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace turbograph
@@ -0,0 +1,95 @@
+#include "registry.hpp"
+#include <iostream>
+
+namespace turbograph {
+
+// ============================================
+// 管道注册表实现
+// ============================================
+
+PipelineRegistry::PipelineRegistry(EpochDomain& domain)
+    : domain_(domain), current_(new Snapshot()) {}
+
+PipelineRegistry::~PipelineRegistry() {
+    delete current_.load(std::memory_order_acquire);
+}
+
+PipelineHandle PipelineRegistry::acquire(const std::string& name) const {
+    EpochDomain::Guard guard = domain_.enter();
+    const Snapshot* snapshot = current_.load(std::memory_order_seq_cst);
+    auto it = snapshot->find(name);
+    if (it == snapshot->end()) {
+        return {};
+    }
+    return PipelineHandle(std::move(guard), it->second.get());
+}
+
+bool PipelineRegistry::execute(const std::string& name, ExecutionContext& context) const {
+    PipelineHandle handle = acquire(name);
+    if (!handle) {
+        std::cerr << "Pipeline not registered: " << name << std::endl;
+        return false;
+    }
+    return handle.executor()->execute(context);
+}
+
+bool PipelineRegistry::execute_batch(const std::string& name, const ColumnBatch& input,
+                                     OutputBatch& output, size_t n) const {
+    PipelineHandle handle = acquire(name);
+    if (!handle) {
+        std::cerr << "Pipeline not registered: " << name << std::endl;
+        return false;
+    }
+    return handle.executor()->execute_batch(input, output, n);
+}
+
+uint64_t PipelineRegistry::publish(const std::string& name, const PipelineConfig& config,
+                                   std::unique_ptr<IPipelineExecutor> executor) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    auto version = std::make_shared<PipelineVersion>();
+    version->name = name;
+    version->version = ++last_versions_[name];
+    version->config = config;
+    version->executor = std::move(executor);
+    uint64_t number = version->version;
+
+    auto next = std::make_unique<Snapshot>(*current_.load(std::memory_order_relaxed));
+    (*next)[name] = std::move(version);
+    swap_snapshot(std::move(next));
+    return number;
+}
+
+bool PipelineRegistry::remove(const std::string& name) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    const Snapshot* snapshot = current_.load(std::memory_order_relaxed);
+    if (snapshot->find(name) == snapshot->end()) {
+        return false;
+    }
+    auto next = std::make_unique<Snapshot>(*snapshot);
+    next->erase(name);
+    swap_snapshot(std::move(next));
+    return true;
+}
+
+uint64_t PipelineRegistry::version(const std::string& name) const {
+    return acquire(name).version();
+}
+
+std::vector<std::string> PipelineRegistry::names() const {
+    EpochDomain::Guard guard = domain_.enter();
+    const Snapshot* snapshot = current_.load(std::memory_order_seq_cst);
+    std::vector<std::string> result;
+    result.reserve(snapshot->size());
+    for (const auto& [name, version] : *snapshot) {
+        result.push_back(name);
+    }
+    return result;
+}
+
+void PipelineRegistry::swap_snapshot(std::unique_ptr<Snapshot> next) {
+    const Snapshot* old = current_.exchange(next.release(), std::memory_order_seq_cst);
+    // 仍被新快照引用的版本只减少引用计数，被替换的版本随旧快照一起析构
+    domain_.retire([old] { delete old; });
+}
+
+} // namespace turbograph
@@ -0,0 +1,551 @@
+#include "result_cache.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace turbograph {
+
+namespace {
+
+/**
+ * @brief 列中每个元素的字节数（与get_cpp_type_name对应的C++类型一致）
+ */
+size_t column_stride(DataType type) {
+    switch (type) {
+        case DataType::INT32: return sizeof(int32_t);
+        case DataType::INT64: return sizeof(int64_t);
+        case DataType::DOUBLE: return sizeof(double);
+        case DataType::FLOAT: return sizeof(float);
+        case DataType::STRING: return sizeof(std::string);
+        case DataType::INT32_LIST: return sizeof(std::vector<int32_t>);
+        case DataType::INT64_LIST: return sizeof(std::vector<int64_t>);
+        case DataType::DOUBLE_LIST: return sizeof(std::vector<double>);
+        case DataType::STRING_LIST: return sizeof(std::vector<std::string>);
+        default: return 0;
+    }
+}
+
+size_t next_pow2(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief 每个分片的组数：条目数按分片与路数向上取整为2的幂
+ */
+size_t sets_per_shard(size_t capacity) {
+    const size_t per_set = ResultCache::kShards * ResultCache::kWays;
+    return next_pow2(std::max<size_t>(1, (capacity + per_set - 1) / per_set));
+}
+
+// ---------- 缓存键序列化 ----------
+// 每个值以类型标记开头（DataType与ValueVariant的下标顺序一致，列与上下文得到相同的键），
+// 字符串与列表带长度前缀
+
+template<typename T>
+void append_key(std::string& buffer, const T& value) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        uint64_t size = value.size();
+        buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        buffer.append(value);
+    } else {
+        uint64_t size = value.size();
+        buffer.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+            buffer.append(reinterpret_cast<const char*>(value.data()), size * sizeof(typename T::value_type));
+        } else {
+            for (const auto& item : value) {
+                append_key(buffer, item);
+            }
+        }
+    }
+}
+
+template<typename T>
+void append_cell(std::string& buffer, const void* column, size_t row) {
+    append_key(buffer, static_cast<const T*>(column)[row]);
+}
+
+void append_column(std::string& buffer, DataType type, const void* column, size_t row) {
+    buffer.push_back(static_cast<char>(type));
+    switch (type) {
+        case DataType::INT32: append_cell<int32_t>(buffer, column, row); break;
+        case DataType::INT64: append_cell<int64_t>(buffer, column, row); break;
+        case DataType::DOUBLE: append_cell<double>(buffer, column, row); break;
+        case DataType::FLOAT: append_cell<float>(buffer, column, row); break;
+        case DataType::STRING: append_cell<std::string>(buffer, column, row); break;
+        case DataType::INT32_LIST: append_cell<std::vector<int32_t>>(buffer, column, row); break;
+        case DataType::INT64_LIST: append_cell<std::vector<int64_t>>(buffer, column, row); break;
+        case DataType::DOUBLE_LIST: append_cell<std::vector<double>>(buffer, column, row); break;
+        case DataType::STRING_LIST: append_cell<std::vector<std::string>>(buffer, column, row); break;
+        default: break;
+    }
+}
+
+void append_variant(std::string& buffer, const ValueVariant& value) {
+    buffer.push_back(static_cast<char>(value.index()));
+    std::visit([&](const auto& v) { append_key(buffer, v); }, value);
+}
+
+// ---------- 标量输出与64位字的转换 ----------
+
+uint64_t pack_cell(DataType type, const void* column, size_t row) {
+    size_t stride = column_stride(type);
+    uint64_t word = 0;
+    std::memcpy(&word, static_cast<const char*>(column) + row * stride, stride);
+    return word;
+}
+
+void unpack_cell(DataType type, uint64_t word, void* column, size_t row) {
+    size_t stride = column_stride(type);
+    std::memcpy(static_cast<char*>(column) + row * stride, &word, stride);
+}
+
+template<typename T>
+uint64_t pack_as(const ValueVariant& value) {
+    T typed = std::visit([](const auto& v) -> T {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_arithmetic_v<V>) {
+            return static_cast<T>(v);
+        } else {
+            return T{};
+        }
+    }, value);
+    uint64_t word = 0;
+    std::memcpy(&word, &typed, sizeof(T));
+    return word;
+}
+
+/**
+ * @brief 上下文中的输出值转换为输出类型后取位模式，不是数值时返回false
+ */
+bool pack_value(DataType type, const ValueVariant& value, uint64_t& word) {
+    if (value.index() > static_cast<size_t>(DataType::FLOAT)) {
+        return false;
+    }
+    switch (type) {
+        case DataType::INT32: word = pack_as<int32_t>(value); return true;
+        case DataType::INT64: word = pack_as<int64_t>(value); return true;
+        case DataType::DOUBLE: word = pack_as<double>(value); return true;
+        case DataType::FLOAT: word = pack_as<float>(value); return true;
+        default: return false;
+    }
+}
+
+template<typename T>
+ValueVariant unpack_as(uint64_t word) {
+    T value;
+    std::memcpy(&value, &word, sizeof(T));
+    return value;
+}
+
+ValueVariant unpack_value(DataType type, uint64_t word) {
+    switch (type) {
+        case DataType::INT32: return unpack_as<int32_t>(word);
+        case DataType::INT64: return unpack_as<int64_t>(word);
+        case DataType::FLOAT: return unpack_as<float>(word);
+        default: return unpack_as<double>(word);
+    }
+}
+
+// ---------- 未命中行的子批次 ----------
+
+/**
+ * @brief 按行号收集的输入列
+ */
+struct GatheredColumn {
+    std::shared_ptr<void> owner;
+    const void* data = nullptr;
+};
+
+template<typename T>
+GatheredColumn gather_as(const void* column, const std::vector<size_t>& rows) {
+    auto values = std::make_shared<std::vector<T>>();
+    values->reserve(rows.size());
+    for (size_t row : rows) {
+        values->push_back(static_cast<const T*>(column)[row]);
+    }
+    return {values, values->data()};
+}
+
+GatheredColumn gather_column(DataType type, const void* column, const std::vector<size_t>& rows) {
+    switch (type) {
+        case DataType::INT32: return gather_as<int32_t>(column, rows);
+        case DataType::INT64: return gather_as<int64_t>(column, rows);
+        case DataType::DOUBLE: return gather_as<double>(column, rows);
+        case DataType::FLOAT: return gather_as<float>(column, rows);
+        case DataType::STRING: return gather_as<std::string>(column, rows);
+        case DataType::INT32_LIST: return gather_as<std::vector<int32_t>>(column, rows);
+        case DataType::INT64_LIST: return gather_as<std::vector<int64_t>>(column, rows);
+        case DataType::DOUBLE_LIST: return gather_as<std::vector<double>>(column, rows);
+        case DataType::STRING_LIST: return gather_as<std::vector<std::string>>(column, rows);
+        default: return {};
+    }
+}
+
+struct Hash128Hasher {
+    size_t operator()(const Hash128& key) const { return static_cast<size_t>(key.lo); }
+};
+
+} // namespace
+
+// ============================================
+// ResultCache 实现
+// ============================================
+
+ResultCache::ResultCache(std::string name, std::string fingerprint, size_t capacity, size_t width)
+    : name_(std::move(name)),
+      fingerprint_(std::move(fingerprint)),
+      width_(width),
+      sets_per_shard_(sets_per_shard(capacity)),
+      num_slots_(kShards * sets_per_shard_ * kWays),
+      slots_(new Slot[num_slots_]),
+      values_(new std::atomic<uint64_t>[num_slots_ * std::max<size_t>(width, 1)]) {
+    for (size_t i = 0; i < num_slots_ * std::max<size_t>(width, 1); i++) {
+        values_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t ResultCache::first_slot(const Hash128& key) const {
+    size_t shard = static_cast<size_t>(key.hi & (kShards - 1));
+    size_t set = static_cast<size_t>(key.lo & (sets_per_shard_ - 1));
+    return (shard * sets_per_shard_ + set) * kWays;
+}
+
+bool ResultCache::lookup(const Hash128& key, uint64_t now_ns, uint64_t* values) {
+    Shard& shard = shards_[key.hi & (kShards - 1)];
+    size_t base = first_slot(key);
+    for (size_t w = 0; w < kWays; w++) {
+        Slot& slot = slots_[base + w];
+        uint64_t version = slot.version.load(std::memory_order_acquire);
+        if (version == 0 || (version & 1) ||
+            slot.key_lo.load(std::memory_order_relaxed) != key.lo ||
+            slot.key_hi.load(std::memory_order_relaxed) != key.hi) {
+            continue;
+        }
+        uint64_t expires = slot.expires_ns.load(std::memory_order_relaxed);
+        const std::atomic<uint64_t>* src = &values_[(base + w) * width_];
+        for (size_t k = 0; k < width_; k++) {
+            values[k] = src[k].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != version) {
+            continue;   // 读取期间被改写
+        }
+        if (expires != 0 && expires <= now_ns) {
+            shard.expired.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(1, std::memory_order_relaxed);
+        }
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ResultCache::insert(const Hash128& key, uint64_t now_ns, uint64_t expires_ns, const uint64_t* values) {
+    Shard& shard = shards_[key.hi & (kShards - 1)];
+    size_t base = first_slot(key);
+
+    // 同键 > 空条目 > 已过期条目 > CLOCK淘汰
+    size_t victim = kWays;
+    size_t stale = kWays;
+    for (size_t w = 0; w < kWays; w++) {
+        Slot& slot = slots_[base + w];
+        uint64_t version = slot.version.load(std::memory_order_acquire);
+        if (version == 0) {
+            if (victim == kWays) {
+                victim = w;
+            }
+            continue;
+        }
+        if (slot.key_lo.load(std::memory_order_relaxed) == key.lo &&
+            slot.key_hi.load(std::memory_order_relaxed) == key.hi) {
+            victim = w;
+            break;
+        }
+        uint64_t expires = slot.expires_ns.load(std::memory_order_relaxed);
+        if (stale == kWays && expires != 0 && expires <= now_ns) {
+            stale = w;
+        }
+    }
+    bool evict = false;
+    if (victim == kWays) {
+        victim = stale;
+    }
+    if (victim == kWays) {
+        size_t start = shard.hand.fetch_add(1, std::memory_order_relaxed) % kWays;
+        victim = start;
+        for (size_t i = 0; i < kWays; i++) {
+            size_t w = (start + i) % kWays;
+            if (!slots_[base + w].referenced.exchange(0, std::memory_order_relaxed)) {
+                victim = w;
+                break;
+            }
+        }
+        evict = true;
+    }
+
+    Slot& slot = slots_[base + victim];
+    uint64_t version = slot.version.load(std::memory_order_relaxed);
+    if ((version & 1) || !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+        return;   // 其他写者正在写入该条目
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.key_lo.store(key.lo, std::memory_order_relaxed);
+    slot.key_hi.store(key.hi, std::memory_order_relaxed);
+    slot.expires_ns.store(expires_ns, std::memory_order_relaxed);
+    slot.referenced.store(0, std::memory_order_relaxed);
+    std::atomic<uint64_t>* dst = &values_[(base + victim) * width_];
+    for (size_t k = 0; k < width_; k++) {
+        dst[k].store(values[k], std::memory_order_relaxed);
+    }
+    slot.version.store(version + 2, std::memory_order_release);
+
+    shard.inserts.fetch_add(1, std::memory_order_relaxed);
+    if (evict) {
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ResultCacheStats ResultCache::stats() const {
+    ResultCacheStats stats;
+    stats.name = name_;
+    stats.fingerprint = fingerprint_;
+    stats.capacity = num_slots_;
+    for (const auto& shard : shards_) {
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.expired += shard.expired.load(std::memory_order_relaxed);
+        stats.inserts += shard.inserts.load(std::memory_order_relaxed);
+        stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// ============================================
+// ResultCacheRegistry 实现
+// ============================================
+
+ResultCacheRegistry& ResultCacheRegistry::instance() {
+    static ResultCacheRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<ResultCache> ResultCacheRegistry::cache(const PipelineConfig& config) {
+    std::string fingerprint = config.fingerprint;
+    if (fingerprint.empty()) {
+        fingerprint = compute_config_fingerprint(config);
+    }
+    size_t capacity = ResultCache::kShards * sets_per_shard(config.cache.capacity) * ResultCache::kWays;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& cache = caches_[fingerprint];
+    if (!cache || cache->capacity() != capacity || cache->width() != config.outputs.size()) {
+        cache = std::make_shared<ResultCache>(config.name, fingerprint, config.cache.capacity,
+                                              config.outputs.size());
+    }
+    return cache;
+}
+
+std::vector<ResultCacheStats> ResultCacheRegistry::stats() const {
+    std::vector<ResultCacheStats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [fingerprint, cache] : caches_) {
+            result.push_back(cache->stats());
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const ResultCacheStats& a, const ResultCacheStats& b) {
+        return a.name != b.name ? a.name < b.name : a.fingerprint < b.fingerprint;
+    });
+    return result;
+}
+
+void ResultCacheRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    caches_.clear();
+}
+
+// ============================================
+// CachedExecutor 实现
+// ============================================
+
+CachedExecutor::CachedExecutor(const PipelineConfig& config, std::unique_ptr<IPipelineExecutor> inner,
+                               std::shared_ptr<ResultCache> cache)
+    : config_(config), inner_(std::move(inner)), cache_(std::move(cache)) {
+    if (!config_.cache.enabled()) {
+        throw std::runtime_error("Pipeline has no cache policy: " + config_.name);
+    }
+    validate_cache_policy(config_);
+    if (config_.fingerprint.empty()) {
+        config_.compute_fingerprint();
+    }
+    if (!cache_) {
+        cache_ = ResultCacheRegistry::instance().cache(config_);
+    }
+    for (const auto& key : config_.cache.keys) {
+        for (size_t i = 0; i < config_.inputs.size(); i++) {
+            if (config_.inputs[i].name == key) {
+                keys_.push_back(i);
+                break;
+            }
+        }
+    }
+    seed_ = murmur3_128(config_.fingerprint.data(), config_.fingerprint.size()).lo;
+    ttl_ns_ = config_.cache.ttl_ms * 1000000ULL;
+}
+
+bool CachedExecutor::execute(ExecutionContext& context) {
+    thread_local std::string buffer;
+    thread_local std::vector<uint64_t> values;
+    buffer.clear();
+    for (size_t i : keys_) {
+        const ValueVariant* value = context.find(config_.inputs[i].name);
+        if (!value) {
+            return inner_->execute(context);   // 缺少键输入，由内层执行器处理
+        }
+        append_variant(buffer, *value);
+    }
+    Hash128 key = murmur3_128(buffer.data(), buffer.size(), seed_);
+    uint64_t now = stats_now_ns();
+    values.resize(config_.outputs.size());
+
+    if (cache_->lookup(key, now, values.data())) {
+        for (size_t j = 0; j < config_.outputs.size(); j++) {
+            const auto& output = config_.outputs[j];
+            context.set_variable(output.name, output.type, unpack_value(output.type, values[j]));
+        }
+        return true;
+    }
+
+    if (!inner_->execute(context)) {
+        return false;
+    }
+    for (size_t j = 0; j < config_.outputs.size(); j++) {
+        const ValueVariant* value = context.find(config_.outputs[j].name);
+        if (!value || !pack_value(config_.outputs[j].type, *value, values[j])) {
+            return true;   // 输出不完整时不缓存
+        }
+    }
+    cache_->insert(key, now, expires_at(now), values.data());
+    return true;
+}
+
+bool CachedExecutor::execute_batch(const ColumnBatch& input, OutputBatch& output, size_t n) {
+    const size_t width = config_.outputs.size();
+    if (input.num_columns < config_.inputs.size() || output.num_columns < width) {
+        return inner_->execute_batch(input, output, n);   // 由内层执行器报告列数错误
+    }
+
+    thread_local std::string buffer;
+    std::vector<uint64_t> values(width);
+    std::vector<size_t> miss_rows;                  // 需要计算的行
+    std::vector<Hash128> miss_keys;
+    std::vector<std::pair<size_t, size_t>> repeats; // (行, 键相同的未命中下标)
+    std::unordered_map<Hash128, size_t, Hash128Hasher> pending;
+    uint64_t now = stats_now_ns();
+
+    for (size_t i = 0; i < n; i++) {
+        buffer.clear();
+        for (size_t c : keys_) {
+            const auto& field = config_.inputs[c];
+            append_column(buffer, field.type, input.columns[c], field.broadcast ? 0 : i);
+        }
+        Hash128 key = murmur3_128(buffer.data(), buffer.size(), seed_);
+        if (cache_->lookup(key, now, values.data())) {
+            for (size_t j = 0; j < width; j++) {
+                unpack_cell(config_.outputs[j].type, values[j], output.columns[j], i);
+            }
+            continue;
+        }
+        auto [it, inserted] = pending.emplace(key, miss_rows.size());
+        if (!inserted) {
+            repeats.emplace_back(i, it->second);
+            continue;
+        }
+        miss_rows.push_back(i);
+        miss_keys.push_back(key);
+    }
+    if (miss_rows.empty()) {
+        return true;
+    }
+
+    const size_t m = miss_rows.size();
+    bool ok;
+    std::vector<std::vector<uint64_t>> results;
+    std::vector<void*> result_columns(width);
+    if (m == n) {
+        // 每行都需要计算：直接执行原批次
+        ok = inner_->execute_batch(input, output, n);
+        for (size_t j = 0; j < width; j++) {
+            result_columns[j] = output.columns[j];
+        }
+    } else {
+        std::vector<GatheredColumn> gathered(config_.inputs.size());
+        std::vector<const void*> columns(config_.inputs.size());
+        for (size_t c = 0; c < config_.inputs.size(); c++) {
+            const auto& field = config_.inputs[c];
+            if (field.broadcast) {
+                columns[c] = input.columns[c];
+            } else {
+                gathered[c] = gather_column(field.type, input.columns[c], miss_rows);
+                columns[c] = gathered[c].data;
+            }
+        }
+        // 标量输出不超过8字节，按uint64_t分配足够容纳任一输出类型
+        results.assign(width, std::vector<uint64_t>(m));
+        for (size_t j = 0; j < width; j++) {
+            result_columns[j] = results[j].data();
+        }
+        ColumnBatch sub_input{columns.data(), columns.size()};
+        OutputBatch sub_output{result_columns.data(), result_columns.size()};
+        ok = inner_->execute_batch(sub_input, sub_output, m);
+    }
+    if (!ok) {
+        return false;
+    }
+
+    uint64_t expires = expires_at(now);
+    for (size_t r = 0; r < m; r++) {
+        size_t src = m == n ? miss_rows[r] : r;
+        for (size_t j = 0; j < width; j++) {
+            DataType type = config_.outputs[j].type;
+            values[j] = pack_cell(type, result_columns[j], src);
+            if (m != n) {
+                unpack_cell(type, values[j], output.columns[j], miss_rows[r]);
+            }
+        }
+        cache_->insert(miss_keys[r], now, expires, values.data());
+    }
+    for (const auto& [row, miss] : repeats) {
+        size_t src = m == n ? miss_rows[miss] : miss;
+        for (size_t j = 0; j < width; j++) {
+            DataType type = config_.outputs[j].type;
+            unpack_cell(type, pack_cell(type, result_columns[j], src), output.columns[j], row);
+        }
+    }
+    return true;
+}
+
+bool CachedExecutor::execute_offsets(const OffsetBatch& input, OutputBatch& output, size_t n) {
+    return inner_->execute_offsets(input, output, n);
+}
+
+bool CachedExecutor::execute_batch_masked(const ColumnBatch& input, OutputBatch& output, size_t n,
+                                          const OutputMask& mask) {
+    return inner_->execute_batch_masked(input, output, n, mask);
+}
+
+} // namespace turbograph
@@ -0,0 +1,233 @@
+#include "stats.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace turbograph {
+
+// ============================================
+// 延迟直方图实现
+// ============================================
+
+void LatencyHistogram::record(uint64_t ns) {
+    // 桶i覆盖(2^(i+kMinShift-1), 2^(i+kMinShift)]
+    size_t bucket = 0;
+    if (ns > (uint64_t(1) << kMinShift)) {
+        unsigned bits = 64 - static_cast<unsigned>(__builtin_clzll(ns - 1));
+        bucket = std::min<size_t>(bits - kMinShift, kBuckets - 1);
+    }
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snap;
+    for (size_t i = 0; i < kBuckets; i++) {
+        snap.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        snap.count += snap.counts[i];
+    }
+    snap.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+    return snap;
+}
+
+uint64_t LatencyHistogram::upper_bound_ns(size_t i) {
+    return i + 1 < kBuckets ? uint64_t(1) << (i + kMinShift) : 0;
+}
+
+// ============================================
+// 管道统计实现
+// ============================================
+
+PipelineStats::PipelineStats(std::string name, std::string fingerprint)
+    : name_(std::move(name)), fingerprint_(std::move(fingerprint)) {}
+
+void PipelineStats::record_compile(uint64_t ns) {
+    compiles_.fetch_add(1, std::memory_order_relaxed);
+    compile_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+void PipelineStats::record_load(uint64_t ns, bool cache_hit) {
+    loads_.fetch_add(1, std::memory_order_relaxed);
+    load_ns_.fetch_add(ns, std::memory_order_relaxed);
+    (cache_hit ? cache_hits_ : cache_misses_).fetch_add(1, std::memory_order_relaxed);
+}
+
+StepCounter* PipelineStats::attach_steps(const char* const* names, uint32_t num_steps) {
+    std::lock_guard<std::mutex> lock(steps_mutex_);
+    bool same = step_counters_ && step_names_.size() == num_steps;
+    for (uint32_t i = 0; same && i < num_steps; i++) {
+        same = step_names_[i] == names[i];
+    }
+    if (same) {
+        return step_counters_;
+    }
+
+    step_names_.assign(names, names + num_steps);
+    step_tables_.push_back(std::make_unique<StepCounter[]>(std::max<uint32_t>(num_steps, 1)));
+    step_counters_ = step_tables_.back().get();
+    return step_counters_;
+}
+
+PipelineStatsSnapshot PipelineStats::snapshot() const {
+    PipelineStatsSnapshot snap;
+    snap.name = name_;
+    snap.fingerprint = fingerprint_;
+    snap.compiles = compiles_.load(std::memory_order_relaxed);
+    snap.compile_ns = compile_ns_.load(std::memory_order_relaxed);
+    snap.loads = loads_.load(std::memory_order_relaxed);
+    snap.load_ns = load_ns_.load(std::memory_order_relaxed);
+    snap.cache_hits = cache_hits_.load(std::memory_order_relaxed);
+    snap.cache_misses = cache_misses_.load(std::memory_order_relaxed);
+    snap.executions = executions_.load(std::memory_order_relaxed);
+    snap.failures = failures_.load(std::memory_order_relaxed);
+    snap.rows = rows_.load(std::memory_order_relaxed);
+    snap.latency = latency_.snapshot();
+
+    std::lock_guard<std::mutex> lock(steps_mutex_);
+    for (size_t i = 0; i < step_names_.size(); i++) {
+        StepStats step;
+        const std::string& label = step_names_[i];
+        size_t colon = label.find(':');
+        step.op = label.substr(0, colon);
+        step.output = colon == std::string::npos ? "" : label.substr(colon + 1);
+        step.calls = __atomic_load_n(&step_counters_[i].calls, __ATOMIC_RELAXED);
+        step.ticks = __atomic_load_n(&step_counters_[i].ticks, __ATOMIC_RELAXED);
+        snap.steps.push_back(std::move(step));
+    }
+    return snap;
+}
+
+// ============================================
+// 统计注册表实现
+// ============================================
+
+StatsRegistry& StatsRegistry::instance() {
+    static StatsRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<PipelineStats> StatsRegistry::pipeline(const std::string& name, const std::string& fingerprint) {
+    if (!enabled()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stats = pipelines_[fingerprint];
+    if (!stats) {
+        stats = std::make_shared<PipelineStats>(name, fingerprint);
+    }
+    return stats;
+}
+
+std::vector<PipelineStatsSnapshot> StatsRegistry::snapshot() const {
+    std::vector<PipelineStatsSnapshot> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [fingerprint, stats] : pipelines_) {
+            result.push_back(stats->snapshot());
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const PipelineStatsSnapshot& a, const PipelineStatsSnapshot& b) {
+        return a.name != b.name ? a.name < b.name : a.fingerprint < b.fingerprint;
+    });
+    return result;
+}
+
+// ============================================
+// Prometheus文本格式
+// ============================================
+
+/**
+ * @brief 转义标签值中的反斜杠、双引号与换行
+ */
+static std::string escape_label(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c;
+        }
+    }
+    return out;
+}
+
+static std::string pipeline_labels(const PipelineStatsSnapshot& snap) {
+    return "pipeline=\"" + escape_label(snap.name) + "\",fingerprint=\"" + escape_label(snap.fingerprint) + "\"";
+}
+
+static std::string seconds(uint64_t ns) {
+    std::ostringstream oss;
+    oss.precision(9);
+    oss << static_cast<double>(ns) / 1e9;
+    return oss.str();
+}
+
+std::string StatsRegistry::format_prometheus(const std::vector<PipelineStatsSnapshot>& snapshots) {
+    std::ostringstream oss;
+
+    // 每个指标先输出HELP/TYPE，再逐管道输出样本
+    auto counter = [&](const char* metric, const char* help, auto value) {
+        oss << "# HELP " << metric << " " << help << "\n";
+        oss << "# TYPE " << metric << " counter\n";
+        for (const auto& snap : snapshots) {
+            oss << metric << "{" << pipeline_labels(snap) << "} " << value(snap) << "\n";
+        }
+    };
+
+    counter("turbograph_compiles_total", "Compiler invocations (cache misses).",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.compiles); });
+    counter("turbograph_compile_seconds_total", "Time spent compiling generated code.",
+            [](const PipelineStatsSnapshot& s) { return seconds(s.compile_ns); });
+    counter("turbograph_loads_total", "Modules loaded.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.loads); });
+    counter("turbograph_load_seconds_total", "Time spent loading compiled modules, excluding compilation.",
+            [](const PipelineStatsSnapshot& s) { return seconds(s.load_ns); });
+    counter("turbograph_cache_hits_total", "Module loads served from the shared object cache.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.cache_hits); });
+    counter("turbograph_cache_misses_total", "Module loads that required compilation.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.cache_misses); });
+    counter("turbograph_executions_total", "Calls to execute and execute_batch.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.executions); });
+    counter("turbograph_execution_failures_total", "Calls that returned false.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.failures); });
+    counter("turbograph_rows_total", "Rows processed.",
+            [](const PipelineStatsSnapshot& s) { return std::to_string(s.rows); });
+
+    oss << "# HELP turbograph_execution_latency_seconds Latency of a single execute or execute_batch call.\n";
+    oss << "# TYPE turbograph_execution_latency_seconds histogram\n";
+    for (const auto& snap : snapshots) {
+        std::string labels = pipeline_labels(snap);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < LatencyHistogram::kBuckets; i++) {
+            cumulative += snap.latency.counts[i];
+            uint64_t bound = LatencyHistogram::upper_bound_ns(i);
+            oss << "turbograph_execution_latency_seconds_bucket{" << labels << ",le=\""
+                << (bound ? seconds(bound) : "+Inf") << "\"} " << cumulative << "\n";
+        }
+        oss << "turbograph_execution_latency_seconds_sum{" << labels << "} " << seconds(snap.latency.sum_ns) << "\n";
+        oss << "turbograph_execution_latency_seconds_count{" << labels << "} " << snap.latency.count << "\n";
+    }
+
+    // 逐步骤计数只在插桩模式下有样本
+    auto step_counter = [&](const char* metric, const std::string& help, bool calls) {
+        oss << "# HELP " << metric << " " << help << "\n";
+        oss << "# TYPE " << metric << " counter\n";
+        for (const auto& snap : snapshots) {
+            std::string labels = pipeline_labels(snap);
+            for (size_t i = 0; i < snap.steps.size(); i++) {
+                const StepStats& step = snap.steps[i];
+                oss << metric << "{" << labels << ",step=\"" << i << "\",op=\"" << escape_label(step.op)
+                    << "\",output=\"" << escape_label(step.output) << "\"} "
+                    << (calls ? step.calls : step.ticks) << "\n";
+            }
+        }
+    };
+    step_counter("turbograph_step_calls_total", "Executions of each pipeline step (instrumented builds).", true);
+    step_counter("turbograph_step_ticks_total",
+                 std::string("Time spent in each pipeline step, in ") + probe::kTickUnit + ".", false);
+
+    return oss.str();
+}
+
+} // namespace turbograph
@@ -0,0 +1,85 @@
+#include "thread_pool.hpp"
+#include <iostream>
+
+namespace turbograph {
+
+// ============================================
+// 线程池实现
+// ============================================
+
+ThreadPool::ThreadPool(size_t num_threads, size_t max_pending)
+    : max_pending_(max_pending) {
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    task_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ || queue_.size() >= max_pending_) {
+            return false;
+        }
+        queue_.push_back(std::move(task));
+    }
+    task_cv_.notify_one();
+    return true;
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+}
+
+size_t ThreadPool::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+            active_++;
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Background task failed: " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_--;
+            if (queue_.empty() && active_ == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace turbograph
@@ -0,0 +1,126 @@
+/**
+ * @file turbograph_aot.cpp
+ * @brief 构建期管道代码生成工具
+ *
+ * 将JSON配置生成为一个可静态链接的编译单元及其头文件，链接进程序后
+ * PipelineManager::create按指纹直接使用生成的入口，启动时不编译、不dlopen。
+ * 通常经CMake函数turbograph_add_aot_pipelines调用：
+ *   turbograph_aot --name <名称> --output-dir <目录> config1.json [config2.json ...]
+ * 生成 <目录>/<名称>.cpp 与 <目录>/<名称>.hpp
+ */
+
+#include "config.hpp"
+#include "code_generator.hpp"
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace turbograph;
+
+namespace {
+
+void usage() {
+    std::cerr << "usage: turbograph_aot --name <name> --output-dir <dir> <config.json>...\n";
+}
+
+bool write_file(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for writing: " << path << std::endl;
+        return false;
+    }
+    file << content;
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 与生成代码中的命名空间规则一致
+ */
+std::string identifier(const std::string& name) {
+    std::string result = name.empty() ? "p_invalid" : name;
+    if (std::isdigit(static_cast<unsigned char>(result[0]))) {
+        result = "p_" + result;
+    }
+    for (char& c : result) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_') {
+            c = '_';
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string name;
+    std::string output_dir;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc) {
+            name = argv[++i];
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (name.empty() || output_dir.empty() || paths.empty()) {
+        usage();
+        return 2;
+    }
+
+    std::vector<PipelineConfig> configs;
+    std::set<std::string> fingerprints;
+    std::set<std::string> names;
+    try {
+        JsonConfigParser parser;
+        for (const auto& path : paths) {
+            PipelineConfig config = parser.parse(path);
+            if (!parser.validate(config)) {
+                std::cerr << "Invalid config: " << path << std::endl;
+                return 1;
+            }
+            if (!fingerprints.insert(config.fingerprint).second) {
+                std::cerr << "Duplicate pipeline config: " << path << std::endl;
+                return 1;
+            }
+            // 头文件按管道名生成命名空间，同一编译单元内需唯一
+            if (!names.insert(identifier(config.name)).second) {
+                std::cerr << "Duplicate pipeline name: " << config.name << " (" << path << ")" << std::endl;
+                return 1;
+            }
+            configs.push_back(std::move(config));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "turbograph_aot: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+
+    // 生成代码随程序一起编译，按-I搜索路径引用算子库头文件
+    CodeGenOptions options;
+    std::string guard = "TURBOGRAPH_AOT_" + identifier(name) + "_HPP";
+    for (char& c : guard) {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    if (!write_file(output_dir + "/" + name + ".cpp", CodeGenerator::generate_aot_source(configs, options)) ||
+        !write_file(output_dir + "/" + name + ".hpp", CodeGenerator::generate_aot_header(configs, guard))) {
+        return 1;
+    }
+
+    for (const auto& config : configs) {
+        std::cout << "turbograph_aot: " << config.name << " (" << config.fingerprint << ")\n";
+    }
+    return 0;
+}